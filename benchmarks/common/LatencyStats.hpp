@@ -0,0 +1,116 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace MouseRecorder::Benchmarks
+{
+
+/**
+ * @brief Collects latency samples and reports their distribution
+ */
+class LatencyStats
+{
+  public:
+    void reserve(size_t count)
+    {
+        m_samples.reserve(count);
+    }
+
+    void add(std::chrono::nanoseconds latency)
+    {
+        m_samples.push_back(latency.count());
+        m_sorted = false;
+    }
+
+    size_t count() const noexcept
+    {
+        return m_samples.size();
+    }
+
+    /**
+     * @brief Get a percentile using the nearest-rank method
+     * @param percentile Percentile in [0, 100]
+     * @return latency in milliseconds, or NaN without samples
+     */
+    double percentileMs(double percentile)
+    {
+        if (m_samples.empty())
+        {
+            return std::nan("");
+        }
+        sort();
+
+        double rank = std::ceil(percentile / 100.0 *
+                                static_cast<double>(m_samples.size()));
+        size_t index = rank < 1.0 ? 0 : static_cast<size_t>(rank) - 1;
+        index = std::min(index, m_samples.size() - 1);
+        return toMs(m_samples[index]);
+    }
+
+    double meanMs() const
+    {
+        if (m_samples.empty())
+        {
+            return std::nan("");
+        }
+        long double sum = 0;
+        for (std::int64_t sample : m_samples)
+        {
+            sum += sample;
+        }
+        return toMs(static_cast<double>(sum / m_samples.size()));
+    }
+
+    double maxMs()
+    {
+        return percentileMs(100.0);
+    }
+
+    /**
+     * @brief Print count, mean and common percentiles
+     * @param label Row label
+     */
+    void print(const char* label)
+    {
+        std::printf("%-12s n=%-8zu mean=%8.3f ms  p50=%8.3f  p90=%8.3f  "
+                    "p99=%8.3f  p99.9=%8.3f  max=%8.3f\n",
+                    label,
+                    count(),
+                    meanMs(),
+                    percentileMs(50),
+                    percentileMs(90),
+                    percentileMs(99),
+                    percentileMs(99.9),
+                    maxMs());
+    }
+
+  private:
+    void sort()
+    {
+        if (!m_sorted)
+        {
+            std::sort(m_samples.begin(), m_samples.end());
+            m_sorted = true;
+        }
+    }
+
+    static double toMs(double ns)
+    {
+        return ns / 1e6;
+    }
+
+    std::vector<std::int64_t> m_samples;
+    bool m_sorted{true};
+};
+
+} // namespace MouseRecorder::Benchmarks
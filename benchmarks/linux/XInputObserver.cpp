@@ -0,0 +1,145 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "XInputObserver.hpp"
+#include <X11/extensions/XInput2.h>
+#include <cstring>
+#include <poll.h>
+
+namespace MouseRecorder::Benchmarks
+{
+
+namespace
+{
+
+constexpr int POLL_TIMEOUT_MS = 20;
+
+} // namespace
+
+XInputObserver::~XInputObserver()
+{
+    stop();
+}
+
+bool XInputObserver::start(const std::string& displayName)
+{
+    m_display = XOpenDisplay(displayName.c_str());
+    if (!m_display)
+    {
+        m_lastError = "Cannot open display " + displayName;
+        return false;
+    }
+
+    int event = 0, error = 0;
+    if (!XQueryExtension(
+            m_display, "XInputExtension", &m_xiOpcode, &event, &error))
+    {
+        m_lastError = "XInput2 is not available";
+        XCloseDisplay(m_display);
+        m_display = nullptr;
+        return false;
+    }
+
+    unsigned char mask[XIMaskLen(XI_LASTEVENT)];
+    std::memset(mask, 0, sizeof(mask));
+    XISetMask(mask, XI_Motion);
+    XISetMask(mask, XI_KeyPress);
+    XISetMask(mask, XI_KeyRelease);
+    XISetMask(mask, XI_ButtonPress);
+    XISetMask(mask, XI_ButtonRelease);
+
+    XIEventMask eventMask;
+    eventMask.deviceid = XIAllMasterDevices;
+    eventMask.mask_len = sizeof(mask);
+    eventMask.mask = mask;
+    XISelectEvents(m_display, DefaultRootWindow(m_display), &eventMask, 1);
+    XSync(m_display, False);
+
+    m_stop.store(false);
+    m_thread = std::thread(&XInputObserver::eventLoop, this);
+    return true;
+}
+
+void XInputObserver::stop()
+{
+    m_stop.store(true);
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+    if (m_display)
+    {
+        XCloseDisplay(m_display);
+        m_display = nullptr;
+    }
+}
+
+std::vector<ObservedEvent> XInputObserver::takeEvents()
+{
+    std::lock_guard<std::mutex> lock(m_eventsMutex);
+    return std::move(m_events);
+}
+
+void XInputObserver::eventLoop()
+{
+    pollfd pfd{ConnectionNumber(m_display), POLLIN, 0};
+
+    while (!m_stop.load())
+    {
+        if (XPending(m_display) == 0)
+        {
+            poll(&pfd, 1, POLL_TIMEOUT_MS);
+            continue;
+        }
+
+        XEvent xevent;
+        XNextEvent(m_display, &xevent);
+        auto arrival = std::chrono::steady_clock::now();
+
+        XGenericEventCookie* cookie = &xevent.xcookie;
+        if (cookie->type != GenericEvent || cookie->extension != m_xiOpcode ||
+            !XGetEventData(m_display, cookie))
+        {
+            continue;
+        }
+
+        const auto* data = static_cast<const XIDeviceEvent*>(cookie->data);
+        ObservedEvent observed{ObservedEvent::Kind::Motion,
+                               static_cast<int>(data->root_x),
+                               static_cast<int>(data->root_y),
+                               static_cast<unsigned int>(data->detail),
+                               arrival};
+        bool known = true;
+        switch (cookie->evtype)
+        {
+        case XI_Motion:
+            observed.kind = ObservedEvent::Kind::Motion;
+            break;
+        case XI_KeyPress:
+            observed.kind = ObservedEvent::Kind::KeyDown;
+            break;
+        case XI_KeyRelease:
+            observed.kind = ObservedEvent::Kind::KeyUp;
+            break;
+        case XI_ButtonPress:
+            observed.kind = ObservedEvent::Kind::ButtonDown;
+            break;
+        case XI_ButtonRelease:
+            observed.kind = ObservedEvent::Kind::ButtonUp;
+            break;
+        default:
+            known = false;
+        }
+        XFreeEventData(m_display, cookie);
+
+        if (known)
+        {
+            std::lock_guard<std::mutex> lock(m_eventsMutex);
+            m_events.push_back(observed);
+        }
+    }
+}
+
+} // namespace MouseRecorder::Benchmarks
@@ -0,0 +1,93 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <X11/Xlib.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MouseRecorder::Benchmarks
+{
+
+/**
+ * @brief Input event as delivered by the X server
+ */
+struct ObservedEvent
+{
+    // Not KeyPress etc., which Xlib defines as macros
+    enum class Kind
+    {
+        Motion,
+        KeyDown,
+        KeyUp,
+        ButtonDown,
+        ButtonUp
+    };
+
+    Kind kind;
+    int x{0};
+    int y{0};
+    unsigned int detail{0}; // Keycode or button
+    std::chrono::steady_clock::time_point arrival;
+};
+
+/**
+ * @brief Records the input an X server delivers to its root window
+ *
+ * Uses its own connection and XInput2 device events, independent of the
+ * capture code under test, so it reports what actually arrived.
+ */
+class XInputObserver
+{
+  public:
+    XInputObserver() = default;
+    ~XInputObserver();
+
+    XInputObserver(const XInputObserver&) = delete;
+    XInputObserver& operator=(const XInputObserver&) = delete;
+
+    /**
+     * @brief Connect and start recording
+     * @param displayName X display, e.g. ":42"
+     * @return true if observing
+     */
+    bool start(const std::string& displayName);
+
+    /**
+     * @brief Stop recording and close the connection
+     */
+    void stop();
+
+    /**
+     * @brief Get the events observed so far, in arrival order
+     */
+    std::vector<ObservedEvent> takeEvents();
+
+    const std::string& getLastError() const noexcept
+    {
+        return m_lastError;
+    }
+
+  private:
+    void eventLoop();
+
+  private:
+    Display* m_display{nullptr};
+    int m_xiOpcode{0};
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+
+    std::mutex m_eventsMutex;
+    std::vector<ObservedEvent> m_events;
+
+    std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Benchmarks
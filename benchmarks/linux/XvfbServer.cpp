@@ -0,0 +1,139 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "XvfbServer.hpp"
+#include <X11/Xlib.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace MouseRecorder::Benchmarks
+{
+
+namespace
+{
+
+constexpr int STARTUP_TIMEOUT_MS = 10000;
+
+} // namespace
+
+XvfbServer::~XvfbServer()
+{
+    stop();
+}
+
+bool XvfbServer::start(int width, int height)
+{
+    if (m_pid > 0)
+    {
+        m_lastError = "Xvfb is already running";
+        return false;
+    }
+
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        m_lastError = std::string("pipe failed: ") + std::strerror(errno);
+        return false;
+    }
+
+    std::string screen =
+        std::to_string(width) + "x" + std::to_string(height) + "x24";
+    std::string displayFd = std::to_string(fds[1]);
+
+    m_pid = fork();
+    if (m_pid < 0)
+    {
+        m_lastError = std::string("fork failed: ") + std::strerror(errno);
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if (m_pid == 0)
+    {
+        close(fds[0]);
+        execlp("Xvfb",
+               "Xvfb",
+               "-displayfd",
+               displayFd.c_str(),
+               "-screen",
+               "0",
+               screen.c_str(),
+               "-nolisten",
+               "tcp",
+               "-noreset",
+               static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    close(fds[1]);
+
+    // Xvfb writes the display number once it is ready for connections
+    std::string number;
+    pollfd pfd{fds[0], POLLIN, 0};
+    while (true)
+    {
+        int ready = poll(&pfd, 1, STARTUP_TIMEOUT_MS);
+        if (ready <= 0)
+        {
+            m_lastError = "Timed out waiting for Xvfb to start";
+            break;
+        }
+
+        char buffer[16];
+        ssize_t n = read(fds[0], buffer, sizeof(buffer));
+        if (n <= 0)
+        {
+            m_lastError = "Xvfb exited during startup (is it installed?)";
+            break;
+        }
+        number.append(buffer, static_cast<size_t>(n));
+        if (number.find('\n') != std::string::npos)
+        {
+            number.erase(number.find('\n'));
+            break;
+        }
+    }
+    close(fds[0]);
+
+    if (number.empty())
+    {
+        stop();
+        return false;
+    }
+
+    m_displayName = ":" + number;
+
+    Display* display = XOpenDisplay(m_displayName.c_str());
+    if (!display)
+    {
+        m_lastError = "Cannot connect to Xvfb on " + m_displayName;
+        stop();
+        return false;
+    }
+    XCloseDisplay(display);
+
+    return true;
+}
+
+void XvfbServer::stop()
+{
+    if (m_pid <= 0)
+    {
+        return;
+    }
+
+    kill(m_pid, SIGTERM);
+    int status = 0;
+    waitpid(m_pid, &status, 0);
+    m_pid = -1;
+    m_displayName.clear();
+}
+
+} // namespace MouseRecorder::Benchmarks
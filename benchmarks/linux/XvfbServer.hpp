@@ -0,0 +1,62 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <string>
+#include <sys/types.h>
+
+namespace MouseRecorder::Benchmarks
+{
+
+/**
+ * @brief Private Xvfb server for benchmarks
+ *
+ * Starts Xvfb on a free display number chosen by the server itself
+ * (-displayfd), so several benchmarks can run side by side, and terminates
+ * it on destruction.
+ */
+class XvfbServer
+{
+  public:
+    XvfbServer() = default;
+    ~XvfbServer();
+
+    XvfbServer(const XvfbServer&) = delete;
+    XvfbServer& operator=(const XvfbServer&) = delete;
+
+    /**
+     * @brief Start the server and wait until it accepts connections
+     * @param width Screen width
+     * @param height Screen height
+     * @return true if the server is running
+     */
+    bool start(int width, int height);
+
+    /**
+     * @brief Terminate the server
+     */
+    void stop();
+
+    /**
+     * @brief Get the display name, e.g. ":42"
+     */
+    const std::string& getDisplayName() const noexcept
+    {
+        return m_displayName;
+    }
+
+    const std::string& getLastError() const noexcept
+    {
+        return m_lastError;
+    }
+
+  private:
+    pid_t m_pid{-1};
+    std::string m_displayName;
+    std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Benchmarks
@@ -0,0 +1,407 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// End-to-end capture latency benchmark.
+//
+// Starts a private Xvfb server, injects input through XTest from a second
+// X connection at a fixed rate, and measures the time from injection to the
+// IEventRecorder callback, together with the fraction of injected events
+// that never reached the callback.
+//
+// Motion events are matched by pointer position: every injected event moves
+// the pointer to a position not used before. Key events are matched in
+// order per key and direction.
+//
+// Exits with 1 if a --max-* gate is exceeded, 2 on setup errors.
+
+// Qt includes must come before X11 includes to avoid Bool/QVariant conflicts
+#include "core/QtConfiguration.hpp"
+#include "core/Event.hpp"
+#include "../common/LatencyStats.hpp"
+#include "XvfbServer.hpp"
+#include "platform/linux/LinuxEventCapture.hpp"
+#include <X11/extensions/XTest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Undefine X11 macros that conflict with our enums
+#ifdef KeyPress
+#undef KeyPress
+#endif
+#ifdef KeyRelease
+#undef KeyRelease
+#endif
+
+using namespace MouseRecorder;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+
+constexpr int SCREEN_WIDTH = 1280;
+constexpr int SCREEN_HEIGHT = 1024;
+
+// Letters only, so the capture's modifier buffering never kicks in
+constexpr const char* KEY_NAMES[] = {"a", "b", "c", "d", "e", "f", "g",
+                                     "h", "i", "j", "k", "l", "m", "n",
+                                     "o", "p", "q", "r", "s", "t", "u",
+                                     "v", "w", "x", "y", "z"};
+constexpr size_t KEY_COUNT = sizeof(KEY_NAMES) / sizeof(KEY_NAMES[0]);
+
+struct Options
+{
+    std::string backend{"linux"};
+    std::string mode{"motion"};
+    int rate{1000};
+    int count{5000};
+    int settleMs{500};
+    std::string display;
+    double maxP99Ms{-1.0};
+    double maxLoss{-1.0};
+};
+
+void printUsage(const char* program)
+{
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --backend NAME     Capture backend (linux)\n"
+        "  --mode MODE        Injected input: motion or key (default motion)\n"
+        "  --rate N           Injected events per second (default 1000)\n"
+        "  --count N          Number of injected events (default 5000)\n"
+        "  --settle-ms N      Wait after the last injection (default 500)\n"
+        "  --display NAME     Use an existing X server instead of Xvfb\n"
+        "  --max-p99-ms X     Fail if the p99 latency exceeds X ms\n"
+        "  --max-loss X       Fail if the loss rate exceeds X (0..1)\n",
+        program);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char*
+        {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+
+        const char* value = nullptr;
+        if (arg == "--help" || arg == "-h")
+        {
+            return false;
+        }
+        else if (arg == "--backend" && (value = next()))
+        {
+            options.backend = value;
+        }
+        else if (arg == "--mode" && (value = next()))
+        {
+            options.mode = value;
+        }
+        else if (arg == "--rate" && (value = next()))
+        {
+            options.rate = std::atoi(value);
+        }
+        else if (arg == "--count" && (value = next()))
+        {
+            options.count = std::atoi(value);
+        }
+        else if (arg == "--settle-ms" && (value = next()))
+        {
+            options.settleMs = std::atoi(value);
+        }
+        else if (arg == "--display" && (value = next()))
+        {
+            options.display = value;
+        }
+        else if (arg == "--max-p99-ms" && (value = next()))
+        {
+            options.maxP99Ms = std::atof(value);
+        }
+        else if (arg == "--max-loss" && (value = next()))
+        {
+            options.maxLoss = std::atof(value);
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown or incomplete option: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    if (options.rate <= 0 || options.count <= 0 ||
+        (options.mode != "motion" && options.mode != "key"))
+    {
+        std::fprintf(stderr, "Invalid --rate, --count or --mode\n");
+        return false;
+    }
+
+    // Motion events need a distinct pointer position each
+    if (options.count > (SCREEN_WIDTH - 2) * (SCREEN_HEIGHT - 2))
+    {
+        std::fprintf(stderr, "--count is too large\n");
+        return false;
+    }
+    return true;
+}
+
+using RecorderFactory = std::function<std::unique_ptr<Core::IEventRecorder>(
+    const Core::IConfiguration&)>;
+
+// Capture backends under test; alternate backends register here
+const std::map<std::string, RecorderFactory>& recorderFactories()
+{
+    static const std::map<std::string, RecorderFactory> factories = {
+        {"linux",
+         [](const Core::IConfiguration& config)
+         {
+             return std::make_unique<Platform::Linux::LinuxEventCapture>(
+                 config);
+         }},
+    };
+    return factories;
+}
+
+// Unique pointer position for each injected motion event
+Core::Point motionPosition(int index)
+{
+    const int usableWidth = SCREEN_WIDTH - 2;
+    return {1 + index % usableWidth,
+            1 + (index / usableWidth) % (SCREEN_HEIGHT - 2)};
+}
+
+int motionIndex(const Core::Point& position)
+{
+    const int usableWidth = SCREEN_WIDTH - 2;
+    return (position.y - 1) * usableWidth + (position.x - 1);
+}
+
+/**
+ * @brief Matches callbacks to injections and records latencies
+ */
+class LatencyCollector
+{
+  public:
+    LatencyCollector(const Options& options, Display* injector)
+        : m_options(options), m_injectTimes(options.count),
+          m_delivered(options.count, false)
+    {
+        if (options.mode == "key")
+        {
+            for (size_t k = 0; k < KEY_COUNT; ++k)
+            {
+                m_keyCodes.push_back(XKeysymToKeycode(
+                    injector, XStringToKeysym(KEY_NAMES[k])));
+            }
+        }
+        m_stats.reserve(options.count);
+    }
+
+    /**
+     * @brief Inject event index through XTest and remember when
+     */
+    void inject(Display* injector, int index)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_injectTimes[index] = Clock::now();
+
+        if (m_options.mode == "motion")
+        {
+            Core::Point position = motionPosition(index);
+            XTestFakeMotionEvent(
+                injector, -1, position.x, position.y, CurrentTime);
+        }
+        else
+        {
+            bool press = index % 2 == 0;
+            unsigned int keyCode = m_keyCodes[(index / 2) % KEY_COUNT];
+            m_pendingKeys[{keyCode, press}].push_back(index);
+            XTestFakeKeyEvent(injector, keyCode, press, CurrentTime);
+        }
+        XFlush(injector);
+    }
+
+    void onEvent(std::unique_ptr<Core::Event> event)
+    {
+        Clock::time_point now = Clock::now();
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        int index = -1;
+        if (event->isMouseEvent())
+        {
+            index = motionIndex(event->getMouseData()->position);
+        }
+        else if (event->isKeyboardEvent())
+        {
+            bool press = event->getType() == Core::EventType::KeyPress;
+            auto it = m_pendingKeys.find(
+                {event->getKeyboardData()->keyCode, press});
+            if (it != m_pendingKeys.end() && !it->second.empty())
+            {
+                index = it->second.front();
+                it->second.pop_front();
+            }
+        }
+
+        // Several raw events can resolve to the same pointer position when
+        // the capture thread falls behind; only the first one counts
+        if (index < 0 || index >= m_options.count || m_delivered[index] ||
+            m_injectTimes[index] == Clock::time_point())
+        {
+            ++m_unmatched;
+            return;
+        }
+
+        m_delivered[index] = true;
+        m_stats.add(now - m_injectTimes[index]);
+    }
+
+    Benchmarks::LatencyStats& stats()
+    {
+        return m_stats;
+    }
+
+    size_t unmatched() const
+    {
+        return m_unmatched;
+    }
+
+  private:
+    const Options& m_options;
+    std::mutex m_mutex;
+    std::vector<Clock::time_point> m_injectTimes;
+    std::vector<bool> m_delivered;
+    std::vector<unsigned int> m_keyCodes;
+    std::map<std::pair<unsigned int, bool>, std::deque<int>> m_pendingKeys;
+    Benchmarks::LatencyStats m_stats;
+    size_t m_unmatched{0};
+};
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    auto factory = recorderFactories().find(options.backend);
+    if (factory == recorderFactories().end())
+    {
+        std::fprintf(stderr, "Unknown backend: %s\n", options.backend.c_str());
+        return 2;
+    }
+
+    Benchmarks::XvfbServer xvfb;
+    std::string displayName = options.display;
+    if (displayName.empty())
+    {
+        if (!xvfb.start(SCREEN_WIDTH, SCREEN_HEIGHT))
+        {
+            std::fprintf(stderr,
+                         "Failed to start Xvfb: %s\n",
+                         xvfb.getLastError().c_str());
+            return 2;
+        }
+        displayName = xvfb.getDisplayName();
+    }
+    // The capture backend opens the default display
+    setenv("DISPLAY", displayName.c_str(), 1);
+
+    Display* injector = XOpenDisplay(displayName.c_str());
+    int eventBase = 0, errorBase = 0, major = 0, minor = 0;
+    if (!injector ||
+        !XTestQueryExtension(injector, &eventBase, &errorBase, &major, &minor))
+    {
+        std::fprintf(stderr,
+                     "XTest is not available on %s\n",
+                     displayName.c_str());
+        return 2;
+    }
+
+    Core::QtConfiguration config;
+    auto recorder = factory->second(config);
+    bool motion = options.mode == "motion";
+    recorder->setCaptureMouseEvents(motion);
+    recorder->setCaptureKeyboardEvents(!motion);
+    recorder->setOptimizeMouseMovements(false);
+    recorder->setMouseMovementThreshold(0);
+
+    LatencyCollector collector(options, injector);
+    if (!recorder->startRecording(
+            [&collector](std::unique_ptr<Core::Event> event)
+            {
+                collector.onEvent(std::move(event));
+            }))
+    {
+        std::fprintf(stderr,
+                     "Failed to start recording: %s\n",
+                     recorder->getLastError().c_str());
+        return 2;
+    }
+
+    // Give the capture thread time to select raw events on the root window
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    std::printf("Capture latency: backend=%s mode=%s rate=%d/s count=%d "
+                "display=%s\n",
+                options.backend.c_str(),
+                options.mode.c_str(),
+                options.rate,
+                options.count,
+                displayName.c_str());
+
+    const auto interval = std::chrono::nanoseconds(1000000000LL / options.rate);
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < options.count; ++i)
+    {
+        std::this_thread::sleep_until(start + interval * i);
+        collector.inject(injector, i);
+    }
+    const double injectSeconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(options.settleMs));
+    recorder->stopRecording();
+    XCloseDisplay(injector);
+
+    auto& stats = collector.stats();
+    double loss = 1.0 - static_cast<double>(stats.count()) / options.count;
+
+    stats.print("latency");
+    std::printf("achieved rate %.1f/s, delivered %zu/%d, loss %.4f, "
+                "unmatched callbacks %zu\n",
+                options.count / injectSeconds,
+                stats.count(),
+                options.count,
+                loss,
+                collector.unmatched());
+
+    bool failed = false;
+    if (options.maxP99Ms >= 0 && !(stats.percentileMs(99) <= options.maxP99Ms))
+    {
+        std::printf("FAIL: p99 latency above %.3f ms\n", options.maxP99Ms);
+        failed = true;
+    }
+    if (options.maxLoss >= 0 && loss > options.maxLoss)
+    {
+        std::printf("FAIL: loss rate above %.4f\n", options.maxLoss);
+        failed = true;
+    }
+    return failed ? 1 : 0;
+}
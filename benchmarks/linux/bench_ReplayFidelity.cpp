@@ -0,0 +1,478 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Replay throughput and fidelity benchmark.
+//
+// Starts a private Xvfb server, replays a synthetic recording through an
+// IEventPlayer and records what the server actually delivered with an
+// independent XInput2 listener. Reports the achieved event rate, the
+// per-event timing error against the recording's schedule, and events that
+// were dropped or arrived without being in the recording.
+//
+// The timing error of event i is its arrival time relative to the first
+// event minus its scheduled offset divided by the playback speed, so drift
+// accumulated over the run shows up in the upper percentiles.
+//
+// Exits with 1 if a --max-* gate is exceeded, 2 on setup errors.
+
+#include "core/Event.hpp"
+#include "core/IEventPlayer.hpp"
+#include "../common/LatencyStats.hpp"
+#include "XInputObserver.hpp"
+#include "XvfbServer.hpp"
+#include "platform/linux/LinuxEventReplay.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Undefine X11 macros that conflict with our enums
+#ifdef KeyPress
+#undef KeyPress
+#endif
+#ifdef KeyRelease
+#undef KeyRelease
+#endif
+
+using namespace MouseRecorder;
+using Clock = std::chrono::steady_clock;
+using ObservedEventKind = Benchmarks::ObservedEvent::Kind;
+
+namespace
+{
+
+constexpr int SCREEN_WIDTH = 1280;
+constexpr int SCREEN_HEIGHT = 1024;
+
+// Observed events searched ahead of the last match before giving up on an
+// expected event, bounds the cost of runs with many drops
+constexpr size_t MATCH_WINDOW = 64;
+
+constexpr const char* KEY_NAMES[] = {"a", "b", "c", "d", "e", "f", "g",
+                                     "h", "i", "j", "k", "l", "m", "n",
+                                     "o", "p", "q", "r", "s", "t", "u",
+                                     "v", "w", "x", "y", "z"};
+constexpr size_t KEY_COUNT = sizeof(KEY_NAMES) / sizeof(KEY_NAMES[0]);
+
+struct Options
+{
+    std::string backend{"linux"};
+    std::string mode{"motion"};
+    int count{2000};
+    int intervalMs{1};
+    double speed{1.0};
+    int settleMs{500};
+    std::string display;
+    double maxP99ErrorMs{-1.0};
+    double maxDrop{-1.0};
+};
+
+void printUsage(const char* program)
+{
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --backend NAME        Replay backend (linux)\n"
+        "  --mode MODE           Recording content: motion or key (default "
+        "motion)\n"
+        "  --count N             Number of recorded events (default 2000)\n"
+        "  --interval-ms N       Recorded time between events (default 1)\n"
+        "  --speed X             Playback speed (default 1.0)\n"
+        "  --settle-ms N         Wait after playback completes (default "
+        "500)\n"
+        "  --display NAME        Use an existing X server instead of Xvfb\n"
+        "  --max-p99-error-ms X  Fail if the p99 timing error exceeds X ms\n"
+        "  --max-drop X          Fail if the dropped fraction exceeds X "
+        "(0..1)\n",
+        program);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char*
+        {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+
+        const char* value = nullptr;
+        if (arg == "--help" || arg == "-h")
+        {
+            return false;
+        }
+        else if (arg == "--backend" && (value = next()))
+        {
+            options.backend = value;
+        }
+        else if (arg == "--mode" && (value = next()))
+        {
+            options.mode = value;
+        }
+        else if (arg == "--count" && (value = next()))
+        {
+            options.count = std::atoi(value);
+        }
+        else if (arg == "--interval-ms" && (value = next()))
+        {
+            options.intervalMs = std::atoi(value);
+        }
+        else if (arg == "--speed" && (value = next()))
+        {
+            options.speed = std::atof(value);
+        }
+        else if (arg == "--settle-ms" && (value = next()))
+        {
+            options.settleMs = std::atoi(value);
+        }
+        else if (arg == "--display" && (value = next()))
+        {
+            options.display = value;
+        }
+        else if (arg == "--max-p99-error-ms" && (value = next()))
+        {
+            options.maxP99ErrorMs = std::atof(value);
+        }
+        else if (arg == "--max-drop" && (value = next()))
+        {
+            options.maxDrop = std::atof(value);
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown or incomplete option: %s\n", argv[i]);
+            return false;
+        }
+    }
+
+    if (options.count <= 0 || options.intervalMs < 0 || options.speed <= 0 ||
+        (options.mode != "motion" && options.mode != "key"))
+    {
+        std::fprintf(stderr,
+                     "Invalid --count, --interval-ms, --speed or --mode\n");
+        return false;
+    }
+
+    // Motion events need a distinct pointer position each
+    if (options.count > (SCREEN_WIDTH - 2) * (SCREEN_HEIGHT - 2))
+    {
+        std::fprintf(stderr, "--count is too large\n");
+        return false;
+    }
+    return true;
+}
+
+using PlayerFactory = std::function<std::unique_ptr<Core::IEventPlayer>()>;
+
+// Replay backends under test; alternate backends register here
+const std::map<std::string, PlayerFactory>& playerFactories()
+{
+    static const std::map<std::string, PlayerFactory> factories = {
+        {"linux",
+         []()
+         {
+             return std::make_unique<Platform::Linux::LinuxEventReplay>();
+         }},
+    };
+    return factories;
+}
+
+// Unique pointer position for each recorded motion event
+Core::Point motionPosition(int index)
+{
+    const int usableWidth = SCREEN_WIDTH - 2;
+    return {1 + index % usableWidth,
+            1 + (index / usableWidth) % (SCREEN_HEIGHT - 2)};
+}
+
+/**
+ * @brief What the X server should deliver for one recorded event
+ */
+struct ExpectedEvent
+{
+    ObservedEventKind kind;
+    int x{0};
+    int y{0};
+    unsigned int keyCode{0};
+    std::chrono::milliseconds offset{0};
+};
+
+/**
+ * @brief Build the recording and the events it should produce
+ */
+std::vector<std::unique_ptr<Core::Event>> buildRecording(
+    const Options& options,
+    Display* display,
+    std::vector<ExpectedEvent>& expected)
+{
+    std::vector<std::unique_ptr<Core::Event>> events;
+    events.reserve(options.count);
+    expected.reserve(options.count);
+
+    const Clock::time_point base = Clock::now();
+    for (int i = 0; i < options.count; ++i)
+    {
+        const std::chrono::milliseconds offset(
+            static_cast<long long>(i) * options.intervalMs);
+        ExpectedEvent expect{ObservedEventKind::Motion};
+        expect.offset = offset;
+
+        if (options.mode == "motion")
+        {
+            Core::MouseEventData data;
+            data.position = motionPosition(i);
+            expect.x = data.position.x;
+            expect.y = data.position.y;
+            events.push_back(std::make_unique<Core::Event>(
+                Core::EventType::MouseMove, data, base + offset));
+        }
+        else
+        {
+            bool press = i % 2 == 0;
+            const char* keyName = KEY_NAMES[(i / 2) % KEY_COUNT];
+            Core::KeyboardEventData data;
+            data.keyName = keyName;
+            expect.kind =
+                press ? ObservedEventKind::KeyDown : ObservedEventKind::KeyUp;
+            expect.keyCode =
+                XKeysymToKeycode(display, XStringToKeysym(keyName));
+            events.push_back(std::make_unique<Core::Event>(
+                press ? Core::EventType::KeyPress : Core::EventType::KeyRelease,
+                data,
+                base + offset));
+        }
+        expected.push_back(expect);
+    }
+    return events;
+}
+
+bool matches(const ExpectedEvent& expected,
+             const Benchmarks::ObservedEvent& observed)
+{
+    if (expected.kind != observed.kind)
+    {
+        return false;
+    }
+    if (expected.kind == ObservedEventKind::Motion)
+    {
+        return expected.x == observed.x && expected.y == observed.y;
+    }
+    return expected.keyCode == observed.detail;
+}
+
+/**
+ * @brief Result of aligning the recording with the observed events
+ */
+struct Alignment
+{
+    Benchmarks::LatencyStats timingError;
+    size_t matched{0};
+    size_t dropped{0};
+    size_t unexpected{0};
+};
+
+/**
+ * @brief Align expected and observed events in order
+ *
+ * Observed events skipped over to reach a match count as unexpected;
+ * expected events with no match within MATCH_WINDOW count as dropped.
+ */
+Alignment align(const std::vector<ExpectedEvent>& expected,
+                const std::vector<Benchmarks::ObservedEvent>& observed,
+                double speed)
+{
+    Alignment result;
+    result.timingError.reserve(expected.size());
+
+    size_t cursor = 0;
+    bool haveAnchor = false;
+    Clock::time_point anchorArrival;
+    std::chrono::milliseconds anchorOffset{0};
+
+    for (const auto& expect : expected)
+    {
+        size_t limit = std::min(observed.size(), cursor + MATCH_WINDOW);
+        size_t found = limit;
+        for (size_t j = cursor; j < limit; ++j)
+        {
+            if (matches(expect, observed[j]))
+            {
+                found = j;
+                break;
+            }
+        }
+        if (found == limit)
+        {
+            ++result.dropped;
+            continue;
+        }
+
+        result.unexpected += found - cursor;
+        cursor = found + 1;
+        ++result.matched;
+
+        const Clock::time_point arrival = observed[found].arrival;
+        if (!haveAnchor)
+        {
+            haveAnchor = true;
+            anchorArrival = arrival;
+            anchorOffset = expect.offset;
+        }
+
+        auto scheduled = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double, std::nano>(
+                std::chrono::nanoseconds(expect.offset - anchorOffset)
+                    .count() /
+                speed));
+        auto error = (arrival - anchorArrival) - scheduled;
+        result.timingError.add(error < error.zero() ? -error : error);
+    }
+    result.unexpected += observed.size() - std::min(observed.size(), cursor);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    auto factory = playerFactories().find(options.backend);
+    if (factory == playerFactories().end())
+    {
+        std::fprintf(stderr, "Unknown backend: %s\n", options.backend.c_str());
+        return 2;
+    }
+
+    Benchmarks::XvfbServer xvfb;
+    std::string displayName = options.display;
+    if (displayName.empty())
+    {
+        if (!xvfb.start(SCREEN_WIDTH, SCREEN_HEIGHT))
+        {
+            std::fprintf(stderr,
+                         "Failed to start Xvfb: %s\n",
+                         xvfb.getLastError().c_str());
+            return 2;
+        }
+        displayName = xvfb.getDisplayName();
+    }
+    // The replay backend opens the default display
+    setenv("DISPLAY", displayName.c_str(), 1);
+
+    Benchmarks::XInputObserver observer;
+    if (!observer.start(displayName))
+    {
+        std::fprintf(stderr,
+                     "Failed to observe %s: %s\n",
+                     displayName.c_str(),
+                     observer.getLastError().c_str());
+        return 2;
+    }
+
+    Display* keymap = XOpenDisplay(displayName.c_str());
+    if (!keymap)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", displayName.c_str());
+        return 2;
+    }
+    std::vector<ExpectedEvent> expected;
+    auto events = buildRecording(options, keymap, expected);
+    XCloseDisplay(keymap);
+
+    auto player = factory->second();
+    player->setPlaybackSpeed(options.speed);
+    if (!player->loadEvents(std::move(events)))
+    {
+        std::fprintf(stderr,
+                     "Failed to load events: %s\n",
+                     player->getLastError().c_str());
+        return 2;
+    }
+
+    std::printf("Replay fidelity: backend=%s mode=%s count=%d interval=%dms "
+                "speed=%.2f display=%s\n",
+                options.backend.c_str(),
+                options.mode.c_str(),
+                options.count,
+                options.intervalMs,
+                options.speed,
+                displayName.c_str());
+
+    const Clock::time_point start = Clock::now();
+    if (!player->startPlayback())
+    {
+        std::fprintf(stderr,
+                     "Failed to start playback: %s\n",
+                     player->getLastError().c_str());
+        return 2;
+    }
+
+    // Generous upper bound so a hung player fails instead of blocking CI
+    const auto scheduledDuration = std::chrono::milliseconds(
+        static_cast<long long>(options.count * options.intervalMs /
+                               options.speed));
+    const Clock::time_point deadline =
+        start + scheduledDuration * 4 + std::chrono::seconds(10);
+    while (player->getState() == Core::PlaybackState::Playing &&
+           Clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    const double playSeconds =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    const bool completed =
+        player->getState() == Core::PlaybackState::Completed;
+    player->stopPlayback();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(options.settleMs));
+    observer.stop();
+
+    auto observed = observer.takeEvents();
+    Alignment result = align(expected, observed, options.speed);
+    double dropRate = static_cast<double>(result.dropped) / options.count;
+
+    result.timingError.print("timing error");
+    std::printf("achieved rate %.1f/s (scheduled %.1f/s), matched %zu/%d, "
+                "dropped %zu (%.4f), unexpected %zu\n",
+                options.count / playSeconds,
+                options.intervalMs > 0
+                    ? 1000.0 * options.speed / options.intervalMs
+                    : 0.0,
+                result.matched,
+                options.count,
+                result.dropped,
+                dropRate,
+                result.unexpected);
+
+    bool failed = false;
+    if (!completed)
+    {
+        std::printf("FAIL: playback did not complete\n");
+        failed = true;
+    }
+    if (options.maxP99ErrorMs >= 0 &&
+        !(result.timingError.percentileMs(99) <= options.maxP99ErrorMs))
+    {
+        std::printf("FAIL: p99 timing error above %.3f ms\n",
+                    options.maxP99ErrorMs);
+        failed = true;
+    }
+    if (options.maxDrop >= 0 && dropRate > options.maxDrop)
+    {
+        std::printf("FAIL: dropped fraction above %.4f\n", options.maxDrop);
+        failed = true;
+    }
+    return failed ? 1 : 0;
+}
@@ -10,6 +10,8 @@
 #include "core/SpdlogConfig.hpp"
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/async.h>
+#include <algorithm>
 #include <filesystem>
 #include <atomic>
 #include <cstdlib>
@@ -25,7 +27,15 @@
 namespace MouseRecorder::Application
 {
 
-MouseRecorderApp::MouseRecorderApp()
+namespace
+{
+
+// Messages buffered by the asynchronous logger before the oldest are dropped
+constexpr size_t ASYNC_LOG_QUEUE_SIZE = 8192;
+
+} // namespace
+
+MouseRecorderApp::MouseRecorderApp(Core::IClock& clock) : m_clock(clock)
 {
     spdlog::debug("MouseRecorderApp: Constructor");
 }
@@ -95,6 +105,25 @@ bool MouseRecorderApp::initialize(const std::string& configFile,
         return false;
     }
 
+    startMetricsExport();
+    configureRecordingCache();
+
+    // The budget can change while the application runs; setBudget() is
+    // thread-safe, so it doesn't matter which thread flushed the change
+    m_cacheConfigCallbackId = m_configuration->registerBatchChangeCallback(
+        [this](const std::vector<Core::ConfigChange>& changes)
+        {
+            for (const auto& change : changes)
+            {
+                if (change.key == Core::ConfigKeys::RECORDING_CACHE_MB ||
+                    change.key == "*")
+                {
+                    configureRecordingCache();
+                    return;
+                }
+            }
+        });
+
     m_initialized = true;
     spdlog::info("MouseRecorderApp: Application initialized successfully");
 
@@ -144,6 +173,13 @@ void MouseRecorderApp::shutdown()
             spdlog::warn("Error stopping player during shutdown: {}", e.what());
         }
 
+        // Write the final metrics after recording and playback have stopped
+        if (m_metricsExporter)
+        {
+            m_metricsExporter->stop();
+            m_metricsExporter.reset();
+        }
+
         // Save configuration before destroying components
         if (m_configuration && !m_configFile.empty())
         {
@@ -166,6 +202,12 @@ void MouseRecorderApp::shutdown()
         spdlog::info("MouseRecorderApp: Application shut down successfully");
 
         // Reset components after logging final messages
+        if (m_configuration && m_cacheConfigCallbackId)
+        {
+            m_configuration->unregisterChangeCallback(*m_cacheConfigCallbackId);
+            m_cacheConfigCallbackId.reset();
+        }
+        m_recordingCache.clear();
         m_eventPlayer.reset();
         m_eventRecorder.reset();
         m_configuration.reset();
@@ -214,6 +256,11 @@ std::unique_ptr<Core::IEventStorage> MouseRecorderApp::createStorage(
     return Storage::EventStorageFactory::createStorage(format);
 }
 
+Storage::RecordingCache& MouseRecorderApp::getRecordingCache()
+{
+    return m_recordingCache;
+}
+
 std::string MouseRecorderApp::getVersion()
 {
     return MouseRecorder::Version::VERSION_FULL;
@@ -234,6 +281,7 @@ bool MouseRecorderApp::initializeLogging(Core::IConfiguration& config)
         bool logToFile = config.getBool(Core::ConfigKeys::LOG_TO_FILE, false);
         std::string logFilePath = config.getString(
             Core::ConfigKeys::LOG_FILE_PATH, "mouserecorder.log");
+        bool logAsync = config.getBool(Core::ConfigKeys::LOG_ASYNC, true);
 
         // Convert log level string to spdlog level
         spdlog::level::level_enum level = spdlog::level::info;
@@ -284,17 +332,43 @@ bool MouseRecorderApp::initializeLogging(Core::IConfiguration& config)
         }
 
         // Create logger
-        auto logger = std::make_shared<spdlog::logger>(
-            "mouserecorder", sinks.begin(), sinks.end());
+        std::shared_ptr<spdlog::logger> logger;
+        if (logAsync)
+        {
+            // Sinks are written by a single background thread. The queue is
+            // bounded and overwrites the oldest message when full, so capture
+            // and replay threads never block on console or file I/O. The
+            // thread pool is shared by every logger created here.
+            auto threadPool = spdlog::thread_pool();
+            if (!threadPool)
+            {
+                spdlog::init_thread_pool(ASYNC_LOG_QUEUE_SIZE, 1);
+                threadPool = spdlog::thread_pool();
+            }
+
+            logger = std::make_shared<spdlog::async_logger>(
+                "mouserecorder",
+                sinks.begin(),
+                sinks.end(),
+                threadPool,
+                spdlog::async_overflow_policy::overrun_oldest);
+        }
+        else
+        {
+            logger = std::make_shared<spdlog::logger>(
+                "mouserecorder", sinks.begin(), sinks.end());
+        }
         logger->set_level(level);
         logger->flush_on(spdlog::level::warn);
 
         // Set as default logger
         spdlog::set_default_logger(logger);
 
-        spdlog::info("Logging system initialized (level: {}, file: {})",
-                     logLevel,
-                     logToFile);
+        spdlog::info(
+            "Logging system initialized (level: {}, file: {}, async: {})",
+            logLevel,
+            logToFile,
+            logAsync);
         return true;
     }
     catch (const std::exception& e)
@@ -309,6 +383,14 @@ bool MouseRecorderApp::initializeLogging(Core::IConfiguration& config)
 void MouseRecorderApp::shutdownLogging()
 {
     spdlog::info("Skipping logging shutdown to avoid test issues");
+
+    // Hand queued messages to the sinks; the async writer thread keeps
+    // running for other app instances
+    if (auto logger = spdlog::default_logger())
+    {
+        logger->flush();
+    }
+
     // Don't call spdlog::shutdown() in individual app instances
     // The test framework will handle global shutdown properly
     return;
@@ -327,8 +409,9 @@ bool MouseRecorderApp::setupPlatformComponents()
     {
 #ifdef __linux__
         m_eventRecorder = std::make_unique<Platform::Linux::LinuxEventCapture>(
-            *m_configuration);
-        m_eventPlayer = std::make_unique<Platform::Linux::LinuxEventReplay>();
+            *m_configuration, m_clock);
+        m_eventPlayer =
+            std::make_unique<Platform::Linux::LinuxEventReplay>(m_clock);
         spdlog::info("MouseRecorderApp: Linux platform components initialized");
 #elif _WIN32
         m_eventRecorder =
@@ -346,18 +429,20 @@ bool MouseRecorderApp::setupPlatformComponents()
         // Configure components from settings
         if (m_configuration)
         {
-            bool captureMouseEvents = m_configuration->getBool(
-                Core::ConfigKeys::CAPTURE_MOUSE_EVENTS, true);
-            bool captureKeyboardEvents = m_configuration->getBool(
-                Core::ConfigKeys::CAPTURE_KEYBOARD_EVENTS, true);
-            bool optimizeMouseMovements = m_configuration->getBool(
-                Core::ConfigKeys::OPTIMIZE_MOUSE_MOVEMENTS, true);
-            int mouseMovementThreshold = m_configuration->getInt(
-                Core::ConfigKeys::MOUSE_MOVEMENT_THRESHOLD, 5);
-            double playbackSpeed = m_configuration->getDouble(
-                Core::ConfigKeys::DEFAULT_PLAYBACK_SPEED, 1.0);
-            bool loopPlayback = m_configuration->getBool(
-                Core::ConfigKeys::LOOP_PLAYBACK, false);
+            // Read all settings from one consistent snapshot
+            auto settings = m_configuration->getSnapshot();
+            bool captureMouseEvents = settings->getBool(
+                Core::ConfigKeyId::CaptureMouseEvents, true);
+            bool captureKeyboardEvents = settings->getBool(
+                Core::ConfigKeyId::CaptureKeyboardEvents, true);
+            bool optimizeMouseMovements = settings->getBool(
+                Core::ConfigKeyId::OptimizeMouseMovements, true);
+            int mouseMovementThreshold = settings->getInt(
+                Core::ConfigKeyId::MouseMovementThreshold, 5);
+            double playbackSpeed = settings->getDouble(
+                Core::ConfigKeyId::DefaultPlaybackSpeed, 1.0);
+            bool loopPlayback =
+                settings->getBool(Core::ConfigKeyId::LoopPlayback, false);
 
             m_eventRecorder->setCaptureMouseEvents(captureMouseEvents);
             m_eventRecorder->setCaptureKeyboardEvents(captureKeyboardEvents);
@@ -423,6 +508,39 @@ bool MouseRecorderApp::loadConfiguration(const std::string& configFile)
     }
 }
 
+void MouseRecorderApp::startMetricsExport()
+{
+    auto snapshot = m_configuration->getSnapshot();
+    std::string directory(snapshot->getString(
+        Core::ConfigKeyId::MetricsTextfileDirectory, ""));
+    if (directory.empty())
+    {
+        return;
+    }
+
+    int intervalMs =
+        snapshot->getInt(Core::ConfigKeyId::MetricsExportIntervalMs, 15000);
+
+    m_metricsExporter = std::make_unique<Core::MetricsTextfileExporter>();
+    if (!m_metricsExporter->start(directory,
+                                  std::chrono::milliseconds(intervalMs)))
+    {
+        // Metrics are optional, the application keeps running without them
+        spdlog::warn("MouseRecorderApp: Metrics export disabled: {}",
+                     m_metricsExporter->getLastError());
+        m_metricsExporter.reset();
+    }
+}
+
+void MouseRecorderApp::configureRecordingCache()
+{
+    auto snapshot = m_configuration->getSnapshot();
+    int budgetMb = std::max(
+        snapshot->getInt(Core::ConfigKeyId::RecordingCacheMb, 256), 0);
+    m_recordingCache.setBudget(static_cast<size_t>(budgetMb) * 1024 * 1024);
+    spdlog::info("MouseRecorderApp: Recording cache budget {} MB", budgetMb);
+}
+
 void MouseRecorderApp::setLastError(const std::string& error)
 {
     m_lastError = error;
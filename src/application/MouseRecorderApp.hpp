@@ -5,11 +5,15 @@
 
 #pragma once
 
+#include "core/Clock.hpp"
 #include "core/IConfiguration.hpp"
 #include "core/IEventRecorder.hpp"
 #include "core/IEventPlayer.hpp"
 #include "core/IEventStorage.hpp"
+#include "core/Metrics.hpp"
+#include "storage/RecordingCache.hpp"
 #include <memory>
+#include <optional>
 #include <string>
 #include <atomic>
 
@@ -26,7 +30,12 @@ namespace MouseRecorder::Application
 class MouseRecorderApp
 {
   public:
-    MouseRecorderApp();
+    /**
+     * @param clock Clock handed to the capture and replay components, a
+     * VirtualClock lets tests replay without waiting
+     */
+    explicit MouseRecorderApp(
+        Core::IClock& clock = Core::SystemClock::instance());
     ~MouseRecorderApp();
 
     /**
@@ -86,6 +95,15 @@ class MouseRecorderApp
     std::unique_ptr<Core::IEventStorage> createStorage(
         Core::StorageFormat format);
 
+    /**
+     * @brief Get the cache of recently loaded recordings
+     *
+     * Shared by everything that loads recordings, so switching between
+     * files or reloading one does not decode it again.
+     * @return reference to the cache
+     */
+    Storage::RecordingCache& getRecordingCache();
+
     /**
      * @brief Get application version
      * @return version string
@@ -130,6 +148,18 @@ class MouseRecorderApp
      */
     bool loadConfiguration(const std::string& configFile);
 
+    /**
+     * @brief Start the Prometheus textfile export if a directory is set
+     */
+    void startMetricsExport();
+
+    /**
+     * @brief Apply the configured memory budget to the recording cache
+     *
+     * Called again whenever playback.recording_cache_mb changes.
+     */
+    void configureRecordingCache();
+
     /**
      * @brief Set last error message
      * @param error Error message
@@ -137,9 +167,13 @@ class MouseRecorderApp
     void setLastError(const std::string& error);
 
   private:
+    Core::IClock& m_clock;
     std::unique_ptr<Core::IConfiguration> m_configuration;
     std::unique_ptr<Core::IEventRecorder> m_eventRecorder;
     std::unique_ptr<Core::IEventPlayer> m_eventPlayer;
+    std::unique_ptr<Core::MetricsTextfileExporter> m_metricsExporter;
+    Storage::RecordingCache m_recordingCache;
+    std::optional<size_t> m_cacheConfigCallbackId;
 
     bool m_initialized{false};
     std::atomic<bool> m_shuttingDown{false};
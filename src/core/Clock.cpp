@@ -0,0 +1,63 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "Clock.hpp"
+#include <thread>
+
+namespace MouseRecorder::Core
+{
+
+SystemClock& SystemClock::instance()
+{
+    static SystemClock clock;
+    return clock;
+}
+
+IClock::TimePoint SystemClock::now() const noexcept
+{
+    return std::chrono::steady_clock::now();
+}
+
+void SystemClock::sleepFor(Duration duration)
+{
+    if (duration > Duration::zero())
+    {
+        std::this_thread::sleep_for(duration);
+    }
+}
+
+VirtualClock::VirtualClock(TimePoint start)
+    : m_now(start.time_since_epoch().count())
+{
+}
+
+IClock::TimePoint VirtualClock::now() const noexcept
+{
+    return TimePoint(Duration(m_now.load(std::memory_order_acquire)));
+}
+
+void VirtualClock::sleepFor(Duration duration)
+{
+    if (duration > Duration::zero())
+    {
+        m_slept.fetch_add(duration.count(), std::memory_order_relaxed);
+        advance(duration);
+    }
+}
+
+void VirtualClock::advance(Duration duration) noexcept
+{
+    if (duration > Duration::zero())
+    {
+        m_now.fetch_add(duration.count(), std::memory_order_acq_rel);
+    }
+}
+
+IClock::Duration VirtualClock::getSleptTime() const noexcept
+{
+    return Duration(m_slept.load(std::memory_order_relaxed));
+}
+
+} // namespace MouseRecorder::Core
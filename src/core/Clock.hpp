@@ -0,0 +1,94 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace MouseRecorder::Core
+{
+
+/**
+ * @brief Source of time and sleeping for capture and replay
+ *
+ * Components that schedule or measure in time take an IClock so tests and
+ * simulations can swap the real clock for a VirtualClock.
+ */
+class IClock
+{
+  public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+    using Duration = std::chrono::steady_clock::duration;
+
+    virtual ~IClock() = default;
+
+    /**
+     * @brief Get the current time
+     */
+    virtual TimePoint now() const noexcept = 0;
+
+    /**
+     * @brief Block the calling thread for a duration
+     * @param duration Time to sleep, nothing happens if not positive
+     */
+    virtual void sleepFor(Duration duration) = 0;
+};
+
+/**
+ * @brief IClock backed by std::chrono::steady_clock and real sleeps
+ */
+class SystemClock : public IClock
+{
+  public:
+    /**
+     * @brief Get the process-wide system clock
+     */
+    static SystemClock& instance();
+
+    TimePoint now() const noexcept override;
+    void sleepFor(Duration duration) override;
+};
+
+/**
+ * @brief IClock whose time only moves when told to
+ *
+ * sleepFor() returns immediately after advancing the clock by the requested
+ * duration, so a replay of an hour-long recording runs as fast as events
+ * can be executed while still seeing the schedule it would have had. Safe to
+ * use from several threads.
+ */
+class VirtualClock : public IClock
+{
+  public:
+    /**
+     * @param start Initial time
+     */
+    explicit VirtualClock(TimePoint start = TimePoint{});
+
+    TimePoint now() const noexcept override;
+
+    /**
+     * @brief Advance the clock by duration without blocking
+     */
+    void sleepFor(Duration duration) override;
+
+    /**
+     * @brief Advance the clock, e.g. to let buffered events expire
+     * @param duration Time to add, ignored if not positive
+     */
+    void advance(Duration duration) noexcept;
+
+    /**
+     * @brief Get the total time spent in sleepFor()
+     */
+    Duration getSleptTime() const noexcept;
+
+  private:
+    std::atomic<Duration::rep> m_now;
+    std::atomic<Duration::rep> m_slept{0};
+};
+
+} // namespace MouseRecorder::Core
@@ -0,0 +1,101 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "ConfigSnapshot.hpp"
+
+namespace MouseRecorder::Core
+{
+
+namespace
+{
+
+consteval bool hasUniqueKeyNames()
+{
+    for (std::size_t i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        for (std::size_t j = i + 1; j < CONFIG_KEY_COUNT; ++j)
+        {
+            if (std::string_view(CONFIG_KEY_TABLE[i].name) ==
+                std::string_view(CONFIG_KEY_TABLE[j].name))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(hasUniqueKeyNames(), "Duplicate key in CONFIG_KEY_TABLE");
+static_assert(configKeyId(ConfigKeys::CAPTURE_MOUSE_EVENTS) ==
+              ConfigKeyId::CaptureMouseEvents);
+static_assert(configKeyId(ConfigKeys::FILTER_STOP_RECORDING_SHORTCUT) ==
+              ConfigKeyId::FilterStopRecordingShortcut);
+static_assert(configKeyId(ConfigKeys::AUTOSAVE_JOURNAL) ==
+              ConfigKeyId::AutosaveJournal);
+static_assert(configKeyId(ConfigKeys::SHORTCUT_STOP_RECORDING) ==
+              ConfigKeyId::ShortcutStopRecording);
+static_assert(configKeyId(ConfigKeys::LOG_FILE_PATH) ==
+              ConfigKeyId::LogFilePath);
+
+const ConfigSnapshot::Value& valueAt(
+    const std::array<ConfigSnapshot::Value, CONFIG_KEY_COUNT>& values,
+    ConfigKeyId id)
+{
+    return values[static_cast<std::size_t>(id)];
+}
+
+} // namespace
+
+bool findConfigKeyId(std::string_view name, ConfigKeyId& id)
+{
+    for (std::size_t i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        if (name == CONFIG_KEY_TABLE[i].name)
+        {
+            id = static_cast<ConfigKeyId>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ConfigSnapshot::getBool(ConfigKeyId id, bool defaultValue) const noexcept
+{
+    const auto* value = std::get_if<bool>(&valueAt(m_values, id));
+    return value ? *value : defaultValue;
+}
+
+int ConfigSnapshot::getInt(ConfigKeyId id, int defaultValue) const noexcept
+{
+    const auto* value = std::get_if<int>(&valueAt(m_values, id));
+    return value ? *value : defaultValue;
+}
+
+double ConfigSnapshot::getDouble(ConfigKeyId id,
+                                 double defaultValue) const noexcept
+{
+    const auto* value = std::get_if<double>(&valueAt(m_values, id));
+    return value ? *value : defaultValue;
+}
+
+std::string_view ConfigSnapshot::getString(ConfigKeyId id,
+                                           std::string_view defaultValue) const
+    noexcept
+{
+    const auto* value = std::get_if<std::string>(&valueAt(m_values, id));
+    return value ? std::string_view(*value) : defaultValue;
+}
+
+bool ConfigSnapshot::hasValue(ConfigKeyId id) const noexcept
+{
+    return !std::holds_alternative<std::monostate>(valueAt(m_values, id));
+}
+
+void ConfigSnapshot::setValue(ConfigKeyId id, Value value)
+{
+    m_values[static_cast<std::size_t>(id)] = std::move(value);
+}
+
+} // namespace MouseRecorder::Core
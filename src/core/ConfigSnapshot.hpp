@@ -0,0 +1,230 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "IConfiguration.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace MouseRecorder::Core
+{
+
+/**
+ * @brief Integer identifiers for the scalar keys in ConfigKeys
+ *
+ * The order must match CONFIG_KEY_TABLE. Array-valued keys (such as
+ * RECENT_FILES) are not part of snapshots.
+ */
+enum class ConfigKeyId : std::size_t
+{
+    CaptureMouseEvents,
+    CaptureKeyboardEvents,
+    OptimizeMouseMovements,
+    MouseMovementThreshold,
+    MouseOptimizationTimeThreshold,
+    MouseOptimizationDouglasPeuckerEpsilon,
+    MouseOptimizationPreserveClicks,
+    MouseOptimizationPreserveFirstLast,
+    MouseOptimizationStrategy,
+    DefaultStorageFormat,
+    FilterStopRecordingShortcut,
+    AutosaveEnabled,
+    AutosaveIntervalMs,
+    AutosaveEventThreshold,
+    AutosaveJournal,
+    DefaultPlaybackSpeed,
+    LoopPlayback,
+    ShowPlaybackCursor,
+    RecordingCacheMb,
+    WindowWidth,
+    WindowHeight,
+    WindowX,
+    WindowY,
+    WindowMaximized,
+    Theme,
+    Language,
+    AutoMinimizeOnRecord,
+    ShortcutStartRecording,
+    ShortcutStopRecording,
+    ShortcutStartPlayback,
+    ShortcutStopPlayback,
+    LastSaveDirectory,
+    LastOpenDirectory,
+    LogLevel,
+    LogToFile,
+    LogFilePath,
+    LogAsync,
+    MetricsTextfileDirectory,
+    MetricsExportIntervalMs,
+    Count
+};
+
+/**
+ * @brief Value type stored for a snapshot key
+ */
+enum class ConfigValueType
+{
+    Bool,
+    Int,
+    Double,
+    String
+};
+
+/**
+ * @brief Name and type of a snapshot key
+ */
+struct ConfigKeyInfo
+{
+    const char* name;
+    ConfigValueType type;
+};
+
+constexpr std::size_t CONFIG_KEY_COUNT =
+    static_cast<std::size_t>(ConfigKeyId::Count);
+
+/**
+ * @brief Key names and types indexed by ConfigKeyId
+ */
+inline constexpr std::array<ConfigKeyInfo, CONFIG_KEY_COUNT> CONFIG_KEY_TABLE =
+    {{
+        {ConfigKeys::CAPTURE_MOUSE_EVENTS, ConfigValueType::Bool},
+        {ConfigKeys::CAPTURE_KEYBOARD_EVENTS, ConfigValueType::Bool},
+        {ConfigKeys::OPTIMIZE_MOUSE_MOVEMENTS, ConfigValueType::Bool},
+        {ConfigKeys::MOUSE_MOVEMENT_THRESHOLD, ConfigValueType::Int},
+        {ConfigKeys::MOUSE_OPTIMIZATION_TIME_THRESHOLD, ConfigValueType::Int},
+        {ConfigKeys::MOUSE_OPTIMIZATION_DOUGLAS_PEUCKER_EPSILON,
+         ConfigValueType::Double},
+        {ConfigKeys::MOUSE_OPTIMIZATION_PRESERVE_CLICKS, ConfigValueType::Bool},
+        {ConfigKeys::MOUSE_OPTIMIZATION_PRESERVE_FIRST_LAST,
+         ConfigValueType::Bool},
+        {ConfigKeys::MOUSE_OPTIMIZATION_STRATEGY, ConfigValueType::String},
+        {ConfigKeys::DEFAULT_STORAGE_FORMAT, ConfigValueType::String},
+        {ConfigKeys::FILTER_STOP_RECORDING_SHORTCUT, ConfigValueType::Bool},
+        {ConfigKeys::AUTOSAVE_ENABLED, ConfigValueType::Bool},
+        {ConfigKeys::AUTOSAVE_INTERVAL_MS, ConfigValueType::Int},
+        {ConfigKeys::AUTOSAVE_EVENT_THRESHOLD, ConfigValueType::Int},
+        {ConfigKeys::AUTOSAVE_JOURNAL, ConfigValueType::String},
+        {ConfigKeys::DEFAULT_PLAYBACK_SPEED, ConfigValueType::Double},
+        {ConfigKeys::LOOP_PLAYBACK, ConfigValueType::Bool},
+        {ConfigKeys::SHOW_PLAYBACK_CURSOR, ConfigValueType::Bool},
+        {ConfigKeys::RECORDING_CACHE_MB, ConfigValueType::Int},
+        {ConfigKeys::WINDOW_WIDTH, ConfigValueType::Int},
+        {ConfigKeys::WINDOW_HEIGHT, ConfigValueType::Int},
+        {ConfigKeys::WINDOW_X, ConfigValueType::Int},
+        {ConfigKeys::WINDOW_Y, ConfigValueType::Int},
+        {ConfigKeys::WINDOW_MAXIMIZED, ConfigValueType::Bool},
+        {ConfigKeys::THEME, ConfigValueType::String},
+        {ConfigKeys::LANGUAGE, ConfigValueType::String},
+        {ConfigKeys::AUTO_MINIMIZE_ON_RECORD, ConfigValueType::Bool},
+        {ConfigKeys::SHORTCUT_START_RECORDING, ConfigValueType::String},
+        {ConfigKeys::SHORTCUT_STOP_RECORDING, ConfigValueType::String},
+        {ConfigKeys::SHORTCUT_START_PLAYBACK, ConfigValueType::String},
+        {ConfigKeys::SHORTCUT_STOP_PLAYBACK, ConfigValueType::String},
+        {ConfigKeys::LAST_SAVE_DIRECTORY, ConfigValueType::String},
+        {ConfigKeys::LAST_OPEN_DIRECTORY, ConfigValueType::String},
+        {ConfigKeys::LOG_LEVEL, ConfigValueType::String},
+        {ConfigKeys::LOG_TO_FILE, ConfigValueType::Bool},
+        {ConfigKeys::LOG_FILE_PATH, ConfigValueType::String},
+        {ConfigKeys::LOG_ASYNC, ConfigValueType::Bool},
+        {ConfigKeys::METRICS_TEXTFILE_DIRECTORY, ConfigValueType::String},
+        {ConfigKeys::METRICS_EXPORT_INTERVAL_MS, ConfigValueType::Int},
+    }};
+
+/**
+ * @brief Resolve a ConfigKeys name to its id at compile time
+ *
+ * Fails to compile if the name is not a snapshot key, e.g.
+ * @code
+ * constexpr auto id = configKeyId(ConfigKeys::LOG_LEVEL);
+ * @endcode
+ */
+consteval ConfigKeyId configKeyId(std::string_view name)
+{
+    for (std::size_t i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        if (std::string_view(CONFIG_KEY_TABLE[i].name) == name)
+        {
+            return static_cast<ConfigKeyId>(i);
+        }
+    }
+    throw "Key is not part of configuration snapshots";
+}
+
+/**
+ * @brief Get the ConfigKeys name of a snapshot key
+ */
+constexpr const char* configKeyName(ConfigKeyId id)
+{
+    return CONFIG_KEY_TABLE[static_cast<std::size_t>(id)].name;
+}
+
+/**
+ * @brief Find the id of a key name at runtime
+ * @param name Configuration key
+ * @param id Output key id
+ * @return true if the key is part of configuration snapshots
+ */
+bool findConfigKeyId(std::string_view name, ConfigKeyId& id);
+
+/**
+ * @brief Immutable, typed view of the configuration at one point in time
+ *
+ * Configuration implementations build a new snapshot whenever a value
+ * changes and publish it atomically. Readers on hot paths (capture, replay)
+ * hold on to a snapshot and read values by ConfigKeyId without taking any
+ * lock or hashing key strings.
+ */
+class ConfigSnapshot
+{
+  public:
+    using Value = std::variant<std::monostate, bool, int, double, std::string>;
+
+    ConfigSnapshot() = default;
+
+    // Typed getters, return defaultValue if unset or of a different type
+    bool getBool(ConfigKeyId id, bool defaultValue = false) const noexcept;
+    int getInt(ConfigKeyId id, int defaultValue = 0) const noexcept;
+    double getDouble(ConfigKeyId id, double defaultValue = 0.0) const noexcept;
+    std::string_view getString(ConfigKeyId id,
+                               std::string_view defaultValue = {}) const
+        noexcept;
+
+    /**
+     * @brief Check if a key has a value in this snapshot
+     */
+    bool hasValue(ConfigKeyId id) const noexcept;
+
+    /**
+     * @brief Set a value while building a snapshot
+     *
+     * Only used by configuration implementations before publishing.
+     */
+    void setValue(ConfigKeyId id, Value value);
+
+    /**
+     * @brief Get the version of this snapshot
+     * @return number that increases with every published snapshot
+     */
+    std::uint64_t getVersion() const noexcept
+    {
+        return m_version;
+    }
+
+    void setVersion(std::uint64_t version) noexcept
+    {
+        m_version = version;
+    }
+
+  private:
+    std::array<Value, CONFIG_KEY_COUNT> m_values;
+    std::uint64_t m_version{0};
+};
+
+} // namespace MouseRecorder::Core
@@ -62,6 +62,8 @@ bool Configuration::loadFromFile(const std::string& filename)
             }
         }
 
+        publishSnapshot();
+
         spdlog::info("Configuration: Successfully loaded {} settings",
                      m_values.size());
         return true;
@@ -138,11 +140,16 @@ void Configuration::loadDefaults()
     m_values[ConfigKeys::MOUSE_OPTIMIZATION_STRATEGY] = std::string("combined");
     m_values[ConfigKeys::DEFAULT_STORAGE_FORMAT] = std::string("json");
     m_values[ConfigKeys::FILTER_STOP_RECORDING_SHORTCUT] = true;
+    m_values[ConfigKeys::AUTOSAVE_ENABLED] = true;
+    m_values[ConfigKeys::AUTOSAVE_INTERVAL_MS] = 30000;
+    m_values[ConfigKeys::AUTOSAVE_EVENT_THRESHOLD] = 5000;
+    m_values[ConfigKeys::AUTOSAVE_JOURNAL] = std::string("");
 
     // Playback settings
     m_values[ConfigKeys::DEFAULT_PLAYBACK_SPEED] = 1.0;
     m_values[ConfigKeys::LOOP_PLAYBACK] = false;
     m_values[ConfigKeys::SHOW_PLAYBACK_CURSOR] = true;
+    m_values[ConfigKeys::RECORDING_CACHE_MB] = 256;
 
     // UI settings
     m_values[ConfigKeys::WINDOW_WIDTH] = 800;
@@ -169,6 +176,11 @@ void Configuration::loadDefaults()
     m_values[ConfigKeys::LOG_LEVEL] = std::string("info");
     m_values[ConfigKeys::LOG_TO_FILE] = false;
     m_values[ConfigKeys::LOG_FILE_PATH] = std::string("mouserecorder.log");
+    m_values[ConfigKeys::LOG_ASYNC] = true;
+    m_values[ConfigKeys::METRICS_TEXTFILE_DIRECTORY] = std::string("");
+    m_values[ConfigKeys::METRICS_EXPORT_INTERVAL_MS] = 15000;
+
+    publishSnapshot();
 
     spdlog::debug("Configuration: Default values loaded");
 }
@@ -240,6 +252,7 @@ void Configuration::removeKey(const std::string& key)
     if (it != m_values.end())
     {
         m_values.erase(it);
+        publishSnapshot();
         spdlog::debug("Configuration: Removed key '{}'", key);
     }
 }
@@ -262,6 +275,7 @@ void Configuration::clear()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_values.clear();
+    publishSnapshot();
     spdlog::debug("Configuration: Cleared all values");
 }
 
@@ -274,18 +288,34 @@ size_t Configuration::registerChangeCallback(ConfigChangeCallback callback)
     return id;
 }
 
+size_t Configuration::registerBatchChangeCallback(
+    ConfigBatchChangeCallback callback)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t id = m_nextCallbackId++;
+    m_batchCallbacks[id] = std::move(callback);
+    spdlog::debug("Configuration: Registered batch change callback with ID {}",
+                  id);
+    return id;
+}
+
 void Configuration::unregisterChangeCallback(size_t callbackId)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    if (auto it = m_callbacks.find(callbackId); it != m_callbacks.end())
+    if (m_callbacks.erase(callbackId) > 0 ||
+        m_batchCallbacks.erase(callbackId) > 0)
     {
-        m_callbacks.erase(it);
         spdlog::debug("Configuration: Unregistered change callback with ID {}",
                       callbackId);
     }
 }
 
+std::shared_ptr<const ConfigSnapshot> Configuration::getSnapshot() const
+{
+    return m_snapshot.load(std::memory_order_acquire);
+}
+
 std::string Configuration::getLastError() const
 {
     std::lock_guard<std::mutex> lock(m_errorMutex);
@@ -307,6 +337,7 @@ void Configuration::setValue(const std::string& key, const T& value)
         }
 
         m_values[key] = value;
+        publishSnapshot();
     }
 
     std::string newValueStr = valueToString(ConfigValue{value});
@@ -315,6 +346,7 @@ void Configuration::setValue(const std::string& key, const T& value)
     if (oldValueStr != newValueStr)
     {
         notifyCallbacks(key, newValueStr);
+        notifyBatchCallbacks(ConfigChange{key, value});
         spdlog::debug("Configuration: Set '{}' = '{}'", key, newValueStr);
     }
 }
@@ -371,6 +403,37 @@ void Configuration::notifyCallbacks(const std::string& key,
     }
 }
 
+void Configuration::notifyBatchCallbacks(const ConfigChange& change)
+{
+    std::vector<ConfigBatchChangeCallback> callbacks;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        callbacks.reserve(m_batchCallbacks.size());
+        for (const auto& [id, callback] : m_batchCallbacks)
+        {
+            callbacks.push_back(callback);
+        }
+    }
+
+    // Values are held in memory, so every change is its own batch
+    const std::vector<ConfigChange> batch{change};
+    for (const auto& callback : callbacks)
+    {
+        try
+        {
+            callback(batch);
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error(
+                "Configuration: Batch callback exception for key '{}': {}",
+                change.key,
+                e.what());
+        }
+    }
+}
+
 std::string Configuration::valueToString(const ConfigValue& value) const
 {
     return std::visit(
@@ -410,6 +473,58 @@ std::string Configuration::valueToString(const ConfigValue& value) const
         value);
 }
 
+void Configuration::publishSnapshot()
+{
+    auto snapshot = std::make_shared<ConfigSnapshot>();
+
+    for (std::size_t i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        const auto& info = CONFIG_KEY_TABLE[i];
+        auto it = m_values.find(info.name);
+        if (it == m_values.end())
+        {
+            continue;
+        }
+
+        auto id = static_cast<ConfigKeyId>(i);
+        const ConfigValue& value = it->second;
+        switch (info.type)
+        {
+        case ConfigValueType::Bool:
+            if (const auto* v = std::get_if<bool>(&value))
+            {
+                snapshot->setValue(id, *v);
+            }
+            break;
+        case ConfigValueType::Int:
+            if (const auto* v = std::get_if<int>(&value))
+            {
+                snapshot->setValue(id, *v);
+            }
+            break;
+        case ConfigValueType::Double:
+            if (const auto* v = std::get_if<double>(&value))
+            {
+                snapshot->setValue(id, *v);
+            }
+            else if (const auto* n = std::get_if<int>(&value))
+            {
+                snapshot->setValue(id, static_cast<double>(*n));
+            }
+            break;
+        case ConfigValueType::String:
+            if (const auto* v = std::get_if<std::string>(&value))
+            {
+                snapshot->setValue(id, *v);
+            }
+            break;
+        }
+    }
+
+    snapshot->setVersion(++m_snapshotVersion);
+    m_snapshot.store(std::move(snapshot), std::memory_order_release);
+}
+
 void Configuration::setLastError(const std::string& error)
 {
     std::lock_guard<std::mutex> lock(m_errorMutex);
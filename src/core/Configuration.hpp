@@ -6,6 +6,8 @@
 #pragma once
 
 #include "IConfiguration.hpp"
+#include "ConfigSnapshot.hpp"
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <variant>
@@ -64,8 +66,12 @@ class Configuration : public IConfiguration
 
     // Change notifications
     size_t registerChangeCallback(ConfigChangeCallback callback) override;
+    size_t registerBatchChangeCallback(
+        ConfigBatchChangeCallback callback) override;
     void unregisterChangeCallback(size_t callbackId) override;
 
+    std::shared_ptr<const ConfigSnapshot> getSnapshot() const override;
+
     std::string getLastError() const override;
 
   private:
@@ -95,6 +101,12 @@ class Configuration : public IConfiguration
      */
     void notifyCallbacks(const std::string& key, const std::string& value);
 
+    /**
+     * @brief Notify batch callbacks about a single typed change
+     * @param change Changed key and its new value
+     */
+    void notifyBatchCallbacks(const ConfigChange& change);
+
     /**
      * @brief Convert ConfigValue to string representation
      * @param value Value to convert
@@ -102,6 +114,13 @@ class Configuration : public IConfiguration
      */
     std::string valueToString(const ConfigValue& value) const;
 
+    /**
+     * @brief Rebuild the typed snapshot from m_values and publish it
+     *
+     * Must be called with m_mutex held.
+     */
+    void publishSnapshot();
+
     /**
      * @brief Set last error message in thread-safe manner
      * @param error Error message
@@ -112,8 +131,14 @@ class Configuration : public IConfiguration
     mutable std::mutex m_mutex;
     std::map<std::string, ConfigValue> m_values;
 
+    // Published snapshot, replaced as a whole on every change. Not
+    // lock-free with libstdc++, which briefly spins on load and store
+    std::atomic<std::shared_ptr<const ConfigSnapshot>> m_snapshot;
+    std::uint64_t m_snapshotVersion{0};
+
     // Callback management
     std::map<size_t, ConfigChangeCallback> m_callbacks;
+    std::map<size_t, ConfigBatchChangeCallback> m_batchCallbacks;
     size_t m_nextCallbackId{1};
 
     // Error handling
@@ -4,6 +4,7 @@
 // https://opensource.org/licenses/MIT
 
 #include "Event.hpp"
+#include "Tracing.hpp"
 #include <sstream>
 #include <iomanip>
 
@@ -130,6 +131,7 @@ std::string Event::toString() const
 std::unique_ptr<Event> EventFactory::createMouseMoveEvent(const Point& position,
                                                           KeyModifier modifiers)
 {
+    MOUSERECORDER_TRACE_SCOPE("event", "createMouseMoveEvent");
     MouseEventData data;
     data.position = position;
     data.modifiers = modifiers;
@@ -139,6 +141,7 @@ std::unique_ptr<Event> EventFactory::createMouseMoveEvent(const Point& position,
 std::unique_ptr<Event> EventFactory::createMouseClickEvent(
     const Point& position, MouseButton button, KeyModifier modifiers)
 {
+    MOUSERECORDER_TRACE_SCOPE("event", "createMouseClickEvent");
     MouseEventData data;
     data.position = position;
     data.button = button;
@@ -149,6 +152,7 @@ std::unique_ptr<Event> EventFactory::createMouseClickEvent(
 std::unique_ptr<Event> EventFactory::createMouseDoubleClickEvent(
     const Point& position, MouseButton button, KeyModifier modifiers)
 {
+    MOUSERECORDER_TRACE_SCOPE("event", "createMouseDoubleClickEvent");
     MouseEventData data;
     data.position = position;
     data.button = button;
@@ -159,6 +163,7 @@ std::unique_ptr<Event> EventFactory::createMouseDoubleClickEvent(
 std::unique_ptr<Event> EventFactory::createMouseWheelEvent(
     const Point& position, int wheelDelta, KeyModifier modifiers)
 {
+    MOUSERECORDER_TRACE_SCOPE("event", "createMouseWheelEvent");
     MouseEventData data;
     data.position = position;
     data.wheelDelta = wheelDelta;
@@ -169,6 +174,7 @@ std::unique_ptr<Event> EventFactory::createMouseWheelEvent(
 std::unique_ptr<Event> EventFactory::createKeyPressEvent(
     uint32_t keyCode, const std::string& keyName, KeyModifier modifiers)
 {
+    MOUSERECORDER_TRACE_SCOPE("event", "createKeyPressEvent");
     KeyboardEventData data;
     data.keyCode = keyCode;
     data.keyName = keyName;
@@ -179,6 +185,7 @@ std::unique_ptr<Event> EventFactory::createKeyPressEvent(
 std::unique_ptr<Event> EventFactory::createKeyReleaseEvent(
     uint32_t keyCode, const std::string& keyName, KeyModifier modifiers)
 {
+    MOUSERECORDER_TRACE_SCOPE("event", "createKeyReleaseEvent");
     KeyboardEventData data;
     data.keyCode = keyCode;
     data.keyName = keyName;
@@ -8,17 +8,51 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <variant>
 
 namespace MouseRecorder::Core
 {
 
+class ConfigSnapshot;
+
 /**
  * @brief Configuration change callback type
  */
 using ConfigChangeCallback =
     std::function<void(const std::string& key, const std::string& value)>;
 
+/**
+ * @brief Typed value carried by change notifications
+ *
+ * std::monostate means the key was removed.
+ */
+using ConfigChangeValue = std::variant<std::monostate,
+                                       bool,
+                                       int,
+                                       double,
+                                       std::string,
+                                       std::vector<std::string>>;
+
+/**
+ * @brief A single key change in a notification batch
+ */
+struct ConfigChange
+{
+    std::string key;
+    ConfigChangeValue value;
+};
+
+/**
+ * @brief Batched configuration change callback type
+ *
+ * Changes are coalesced per key, so each key appears at most once with its
+ * latest value.
+ */
+using ConfigBatchChangeCallback =
+    std::function<void(const std::vector<ConfigChange>& changes)>;
+
 /**
  * @brief Interface for application configuration management
  *
@@ -102,17 +136,49 @@ class IConfiguration
 
     /**
      * @brief Register callback for configuration changes
+     *
+     * Callbacks run on the thread that delivers the change. That is the
+     * thread that made it, or for implementations that write changes
+     * behind the caller, like QtConfiguration, the thread that flushes
+     * them. QtConfiguration flushes on the thread that created it unless
+     * flushed explicitly elsewhere. Listeners that touch widgets and may
+     * see changes made on other threads should post to the GUI thread
+     * (e.g. QMetaObject::invokeMethod with Qt::QueuedConnection).
      * @param callback Function to call when configuration changes
      * @return callback ID for unregistering
      */
     virtual size_t registerChangeCallback(ConfigChangeCallback callback) = 0;
 
+    /**
+     * @brief Register callback for batched, typed configuration changes
+     *
+     * Called on the same threads as registerChangeCallback() callbacks.
+     * @param callback Function to call with each batch of changes
+     * @return callback ID for unregistering
+     */
+    virtual size_t registerBatchChangeCallback(
+        ConfigBatchChangeCallback callback) = 0;
+
     /**
      * @brief Unregister configuration change callback
-     * @param callbackId ID returned from registerChangeCallback
+     * @param callbackId ID returned from registerChangeCallback or
+     *                   registerBatchChangeCallback
      */
     virtual void unregisterChangeCallback(size_t callbackId) = 0;
 
+    /**
+     * @brief Get the current immutable configuration snapshot
+     *
+     * A new snapshot is published atomically on every change, so the
+     * returned snapshot never changes and can be read without locking.
+     * Fetching it is a short critical section rather than lock-free: the
+     * implementations keep it in std::atomic<std::shared_ptr>, which
+     * libstdc++ guards with a spin lock. Hot paths should fetch a snapshot
+     * once and keep it rather than call this per event.
+     * @return current snapshot, never null
+     */
+    virtual std::shared_ptr<const ConfigSnapshot> getSnapshot() const = 0;
+
     /**
      * @brief Get the last error message if any operation failed
      * @return error message or empty string if no error
@@ -147,11 +213,19 @@ constexpr const char* DEFAULT_STORAGE_FORMAT =
     "recording.default_storage_format";
 constexpr const char* FILTER_STOP_RECORDING_SHORTCUT =
     "recording.filter_stop_recording_shortcut";
+constexpr const char* AUTOSAVE_ENABLED = "recording.autosave_enabled";
+constexpr const char* AUTOSAVE_INTERVAL_MS = "recording.autosave_interval_ms";
+constexpr const char* AUTOSAVE_EVENT_THRESHOLD =
+    "recording.autosave_event_threshold";
+// Journal of the unsaved recording, empty if there is none
+constexpr const char* AUTOSAVE_JOURNAL = "recording.autosave_journal";
 
 // Playback settings
 constexpr const char* DEFAULT_PLAYBACK_SPEED = "playback.default_speed";
 constexpr const char* LOOP_PLAYBACK = "playback.loop_enabled";
 constexpr const char* SHOW_PLAYBACK_CURSOR = "playback.show_cursor";
+// Memory for recently loaded recordings, 0 disables the cache
+constexpr const char* RECORDING_CACHE_MB = "playback.recording_cache_mb";
 
 // UI settings
 constexpr const char* WINDOW_WIDTH = "ui.window_width";
@@ -178,6 +252,11 @@ constexpr const char* RECENT_FILES = "files.recent_files";
 constexpr const char* LOG_LEVEL = "system.log_level";
 constexpr const char* LOG_TO_FILE = "system.log_to_file";
 constexpr const char* LOG_FILE_PATH = "system.log_file_path";
+constexpr const char* LOG_ASYNC = "system.log_async";
+constexpr const char* METRICS_TEXTFILE_DIRECTORY =
+    "system.metrics_textfile_directory";
+constexpr const char* METRICS_EXPORT_INTERVAL_MS =
+    "system.metrics_export_interval_ms";
 } // namespace ConfigKeys
 
 } // namespace MouseRecorder::Core
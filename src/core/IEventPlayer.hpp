@@ -6,6 +6,7 @@
 #pragma once
 
 #include "Event.hpp"
+#include "RepeatedSegmentDetector.hpp"
 #include <vector>
 #include <memory>
 #include <functional>
@@ -47,6 +48,40 @@ class IEventPlayer
      */
     virtual bool loadEvents(std::vector<std::unique_ptr<Event>> events) = 0;
 
+    /**
+     * @brief Load a recording whose repeated segments are stored once
+     *
+     * Positions and the total event count are those of the expanded
+     * recording. Players that cannot expand the segments while playing
+     * load the expanded events.
+     * @param recording Stored events and their segments
+     * @return true if events loaded successfully
+     */
+    virtual bool loadLoopedEvents(LoopedRecording recording)
+    {
+        return loadEvents(recording.expand());
+    }
+
+    /**
+     * @brief Append events to the loaded ones, also during playback
+     *
+     * Used to start playing a recording while the rest of it is still
+     * being loaded.
+     * @param events Events following the loaded ones
+     * @return true if events were appended
+     */
+    virtual bool appendEvents(std::vector<std::unique_ptr<Event>> events) = 0;
+
+    /**
+     * @brief Announce whether more events will be appended
+     *
+     * While more events are pending, playback that catches up with the
+     * loaded events waits for appendEvents() instead of completing.
+     * loadEvents() clears the flag.
+     * @param pending true while events are still being loaded
+     */
+    virtual void setMoreEventsPending(bool pending) = 0;
+
     /**
      * @brief Start playing loaded events
      * @param callback Optional callback for playback progress updates
@@ -6,7 +6,11 @@
 #pragma once
 
 #include "Event.hpp"
+#include "RecordingStatistics.hpp"
 #include "version.hpp"
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <vector>
 #include <memory>
 #include <string>
@@ -21,7 +25,8 @@ enum class StorageFormat
 {
     Json,
     Xml,
-    Binary
+    Binary,
+    Columnar
 };
 
 /**
@@ -38,6 +43,90 @@ struct StorageMetadata
     size_t totalEvents{0};
     std::string platform;
     std::string screenResolution;
+
+    // Computed by the storage when saving; empty for files written before
+    // statistics were stored
+    std::optional<RecordingStatistics> statistics;
+};
+
+/**
+ * @brief Part of a recording to load, see IEventStorage::loadEventsRange()
+ */
+struct EventRange
+{
+    enum class Kind
+    {
+        // Milliseconds after the first event, both ends included
+        Time,
+        // Positions of the events in the file, last excluded
+        Index
+    };
+
+    Kind kind{Kind::Index};
+    uint64_t first{0};
+    uint64_t last{0};
+
+    /**
+     * @brief Events from fromMs to toMs after the start of the recording
+     */
+    static constexpr EventRange byTime(uint64_t fromMs, uint64_t toMs) noexcept
+    {
+        return {Kind::Time, fromMs, toMs};
+    }
+
+    /**
+     * @brief count events starting with the one at position firstEvent
+     */
+    static constexpr EventRange byIndex(uint64_t firstEvent,
+                                        uint64_t count) noexcept
+    {
+        return {Kind::Index,
+                firstEvent,
+                count > UINT64_MAX - firstEvent ? UINT64_MAX
+                                                : firstEvent + count};
+    }
+};
+
+class StorageProgress;
+class StorageTask;
+
+/**
+ * @brief Callbacks of an asynchronous save or load
+ *
+ * All callbacks run on the background thread doing the work.
+ */
+struct StorageTaskCallbacks
+{
+    /**
+     * @brief Run before saving, e.g. to optimize the events or fill in
+     * metadata that depends on them; ignored by loads
+     */
+    std::function<void(std::vector<std::unique_ptr<Event>>& events,
+                       StorageMetadata& metadata)>
+        prepare;
+
+    /**
+     * @brief Progress in work units, only done / total is meaningful
+     */
+    std::function<void(std::uint64_t done, std::uint64_t total)> progress;
+
+    /**
+     * @brief Loads: receives the metadata as soon as it has been read
+     */
+    std::function<void(const StorageMetadata& metadata)> metadata;
+
+    /**
+     * @brief Loads: receives the events in file order while they are decoded
+     *
+     * Formats that decode incrementally deliver several chunks, others one
+     * chunk at the end. When set, the task keeps no events for takeEvents().
+     */
+    std::function<void(std::vector<std::unique_ptr<Event>> events)> events;
+
+    /**
+     * @brief Called once when the operation has finished
+     */
+    std::function<void(bool success)> completion;
 };
 
 /**
@@ -74,6 +163,65 @@ class IEventStorage
                             std::vector<std::unique_ptr<Event>>& events,
                             StorageMetadata& metadata) = 0;
 
+    /**
+     * @brief Load part of the events of a file
+     *
+     * Recordings are in time order, so reading stops after the last event
+     * of the range. Binary files with a block index only read the blocks
+     * overlapping the range; other files are streamed and the events
+     * outside the range are dropped as they are decoded. Progress is
+     * reported, the events are not streamed to the progress sink.
+     * @param filename Path to the input file
+     * @param range Events to load
+     * @param events Output vector to store the events of the range
+     * @param metadata Output metadata of the whole file
+     * @return true if load was successful
+     */
+    virtual bool loadEventsRange(const std::string& filename,
+                                 const EventRange& range,
+                                 std::vector<std::unique_ptr<Event>>& events,
+                                 StorageMetadata& metadata) = 0;
+
+    /**
+     * @brief Save events on a background thread
+     *
+     * The storage must outlive the returned task and must not be used for
+     * anything else until the task has finished.
+     * @param events Events to save, owned by the task
+     * @param filename Path to the output file
+     * @param metadata Metadata to include
+     * @param callbacks Preparation, progress and completion callbacks
+     * @return handle to wait for or cancel the save
+     */
+    std::unique_ptr<StorageTask> saveEventsAsync(
+        std::vector<std::unique_ptr<Event>> events,
+        const std::string& filename,
+        const StorageMetadata& metadata = {},
+        StorageTaskCallbacks callbacks = {});
+
+    /**
+     * @brief Load events on a background thread
+     *
+     * The loaded events and metadata are taken from the task once it has
+     * finished, or streamed through the metadata and events callbacks
+     * while loading. The same lifetime rules as for saveEventsAsync()
+     * apply.
+     * @param filename Path to the input file
+     * @param callbacks Progress, streaming and completion callbacks
+     * @return handle to wait for or cancel the load
+     */
+    std::unique_ptr<StorageTask> loadEventsAsync(
+        const std::string& filename, StorageTaskCallbacks callbacks = {});
+
+    /**
+     * @brief Report progress of saveEvents() and loadEvents()
+     *
+     * Implementations report progress at points where they can also stop,
+     * and fail with a cancellation error once progress asks them to.
+     * @param progress Progress sink, nullptr to stop reporting
+     */
+    virtual void setProgress(StorageProgress* progress) = 0;
+
     /**
      * @brief Get supported file format
      * @return format supported by this implementation
@@ -125,6 +273,17 @@ class IEventStorage
      * @return true if compression is supported
      */
     virtual bool supportsCompression() const noexcept = 0;
+
+    /**
+     * @brief Flush saved files to disk before they replace the old file
+     *
+     * saveEvents() always writes a temporary file and renames it over the
+     * target, so a crash while saving never damages the previous file.
+     * Flushing additionally protects against power failures, at the cost
+     * of waiting for the disk. On by default; scratch files can skip it.
+     * @param sync true to flush saved files
+     */
+    virtual void setSyncOnSave(bool sync) = 0;
 };
 
 } // namespace MouseRecorder::Core
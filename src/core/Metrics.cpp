@@ -0,0 +1,484 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "Metrics.hpp"
+#include "SpdlogConfig.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace MouseRecorder::Core
+{
+
+namespace
+{
+
+std::string formatValue(double value)
+{
+    if (std::isnan(value))
+    {
+        return "NaN";
+    }
+    if (std::isinf(value))
+    {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+
+    // Shortest representation that round-trips, so 0.1 is written as 0.1
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+}
+
+void appendEscapedLabelValue(std::string& out, const std::string& value)
+{
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '\\':
+            out += "\\\\";
+            break;
+        case '"':
+            out += "\\\"";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        default:
+            out += c;
+        }
+    }
+}
+
+// Renders labels as {a="1",b="2"}, or an empty string without labels
+std::string renderLabels(const MetricLabels& labels)
+{
+    if (labels.empty())
+    {
+        return {};
+    }
+
+    std::string out = "{";
+    for (size_t i = 0; i < labels.size(); ++i)
+    {
+        if (i > 0)
+        {
+            out += ',';
+        }
+        out += labels[i].first;
+        out += "=\"";
+        appendEscapedLabelValue(out, labels[i].second);
+        out += '"';
+    }
+    out += '}';
+    return out;
+}
+
+// Adds one more label to an already rendered label set
+std::string withLabel(const std::string& labels,
+                      const std::string& name,
+                      const std::string& value)
+{
+    std::string extra = name + "=\"" + value + "\"";
+    if (labels.empty())
+    {
+        return "{" + extra + "}";
+    }
+    return labels.substr(0, labels.size() - 1) + "," + extra + "}";
+}
+
+} // namespace
+
+Histogram::Histogram(std::vector<double> bounds)
+    : m_bounds(std::move(bounds)),
+      m_buckets(
+          std::make_unique<std::atomic<std::uint64_t>[]>(m_bounds.size() + 1))
+{
+    if (!std::is_sorted(m_bounds.begin(), m_bounds.end()))
+    {
+        throw std::invalid_argument("Histogram bounds must be sorted");
+    }
+}
+
+void Histogram::observe(double value) noexcept
+{
+    // Prometheus buckets are inclusive: value <= bound
+    auto it = std::lower_bound(m_bounds.begin(), m_bounds.end(), value);
+    size_t index = static_cast<size_t>(it - m_bounds.begin());
+
+    m_buckets[index].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+std::vector<std::uint64_t> Histogram::bucketCounts() const
+{
+    std::vector<std::uint64_t> counts(m_bounds.size() + 1);
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        counts[i] = bucketCount(i);
+    }
+    return counts;
+}
+
+double Histogram::estimateQuantile(const std::vector<double>& bounds,
+                                   const std::vector<std::uint64_t>& counts,
+                                   double quantile)
+{
+    std::uint64_t total = 0;
+    for (std::uint64_t count : counts)
+    {
+        total += count;
+    }
+    if (total == 0 || counts.size() != bounds.size() + 1)
+    {
+        return std::nan("");
+    }
+
+    double rank = std::clamp(quantile, 0.0, 1.0) * static_cast<double>(total);
+    std::uint64_t cumulative = 0;
+    for (size_t i = 0; i < bounds.size(); ++i)
+    {
+        if (counts[i] > 0 &&
+            static_cast<double>(cumulative + counts[i]) >= rank)
+        {
+            double lower = i > 0 ? bounds[i - 1] : 0.0;
+            double fraction = (rank - static_cast<double>(cumulative)) /
+                              static_cast<double>(counts[i]);
+            return lower + (bounds[i] - lower) * fraction;
+        }
+        cumulative += counts[i];
+    }
+
+    return bounds.empty() ? std::nan("") : bounds.back();
+}
+
+const std::vector<double>& MetricsRegistry::latencyBuckets()
+{
+    static const std::vector<double> buckets = {
+        0.0001, 0.0005, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.5, 1.0};
+    return buckets;
+}
+
+const std::vector<double>& MetricsRegistry::durationBuckets()
+{
+    static const std::vector<double> buckets = {
+        0.001, 0.005, 0.01, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0};
+    return buckets;
+}
+
+MetricsRegistry& MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name,
+                                  const std::string& help,
+                                  const MetricLabels& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Family& family = familyLocked(name, help, MetricType::Counter);
+    auto& metric = family.counters[renderLabels(labels)];
+    if (!metric)
+    {
+        metric = std::make_unique<Counter>();
+    }
+    return *metric;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name,
+                              const std::string& help,
+                              const MetricLabels& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Family& family = familyLocked(name, help, MetricType::Gauge);
+    auto& metric = family.gauges[renderLabels(labels)];
+    if (!metric)
+    {
+        metric = std::make_unique<Gauge>();
+    }
+    return *metric;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name,
+                                      const std::string& help,
+                                      const std::vector<double>& bounds,
+                                      const MetricLabels& labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Family& family = familyLocked(name, help, MetricType::Histogram);
+    auto& metric = family.histograms[renderLabels(labels)];
+    if (!metric)
+    {
+        metric = std::make_unique<Histogram>(bounds);
+    }
+    return *metric;
+}
+
+const Counter* MetricsRegistry::findCounter(const std::string& name,
+                                            const MetricLabels& labels) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto family = m_families.find(name);
+    if (family == m_families.end())
+    {
+        return nullptr;
+    }
+    auto it = family->second.counters.find(renderLabels(labels));
+    return it != family->second.counters.end() ? it->second.get() : nullptr;
+}
+
+const Gauge* MetricsRegistry::findGauge(const std::string& name,
+                                        const MetricLabels& labels) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto family = m_families.find(name);
+    if (family == m_families.end())
+    {
+        return nullptr;
+    }
+    auto it = family->second.gauges.find(renderLabels(labels));
+    return it != family->second.gauges.end() ? it->second.get() : nullptr;
+}
+
+const Histogram* MetricsRegistry::findHistogram(
+    const std::string& name, const MetricLabels& labels) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto family = m_families.find(name);
+    if (family == m_families.end())
+    {
+        return nullptr;
+    }
+    auto it = family->second.histograms.find(renderLabels(labels));
+    return it != family->second.histograms.end() ? it->second.get() : nullptr;
+}
+
+std::string MetricsRegistry::toPrometheusText() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::string out;
+    for (const auto& [name, family] : m_families)
+    {
+        out += "# HELP " + name + " " + family.help + "\n";
+
+        switch (family.type)
+        {
+        case MetricType::Counter:
+            out += "# TYPE " + name + " counter\n";
+            for (const auto& [labels, counter] : family.counters)
+            {
+                out += name + labels + " " +
+                       std::to_string(counter->value()) + "\n";
+            }
+            break;
+
+        case MetricType::Gauge:
+            out += "# TYPE " + name + " gauge\n";
+            for (const auto& [labels, gauge] : family.gauges)
+            {
+                out += name + labels + " " + formatValue(gauge->value()) + "\n";
+            }
+            break;
+
+        case MetricType::Histogram:
+            out += "# TYPE " + name + " histogram\n";
+            for (const auto& [labels, histogram] : family.histograms)
+            {
+                // Buckets are read one by one while observations continue, so
+                // the cumulative counts may be off by in-flight updates
+                const auto& bounds = histogram->getBounds();
+                std::uint64_t cumulative = 0;
+                for (size_t i = 0; i <= bounds.size(); ++i)
+                {
+                    cumulative += histogram->bucketCount(i);
+                    std::string le = i < bounds.size()
+                                         ? formatValue(bounds[i])
+                                         : std::string("+Inf");
+                    out += name + "_bucket" + withLabel(labels, "le", le) +
+                           " " + std::to_string(cumulative) + "\n";
+                }
+                out += name + "_sum" + labels + " " +
+                       formatValue(histogram->sum()) + "\n";
+                out += name + "_count" + labels + " " +
+                       std::to_string(cumulative) + "\n";
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+bool MetricsRegistry::writeTextfile(const std::string& directory,
+                                    const std::string& filename)
+{
+    std::filesystem::path target = std::filesystem::path(directory) / filename;
+    // node-exporter only collects *.prom, so the temporary file is ignored
+    std::filesystem::path temp = target;
+    temp += ".tmp";
+
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            setLastError("Failed to open metrics file for writing: " +
+                         temp.string());
+            return false;
+        }
+
+        file << toPrometheusText();
+        file.close();
+
+        if (file.fail())
+        {
+            setLastError("Failed to write metrics file: " + temp.string());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp, target, ec);
+    if (ec)
+    {
+        setLastError("Failed to move metrics file into place: " +
+                     ec.message());
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+
+    return true;
+}
+
+std::string MetricsRegistry::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    return m_lastError;
+}
+
+MetricsRegistry::Family& MetricsRegistry::familyLocked(const std::string& name,
+                                                       const std::string& help,
+                                                       MetricType type)
+{
+    auto it = m_families.find(name);
+    if (it == m_families.end())
+    {
+        it = m_families.emplace(name, Family{type, help, {}, {}, {}}).first;
+    }
+    else if (it->second.type != type)
+    {
+        throw std::invalid_argument("Metric " + name +
+                                    " is already registered with another type");
+    }
+    return it->second;
+}
+
+void MetricsRegistry::setLastError(const std::string& error)
+{
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    m_lastError = error;
+    spdlog::error("MetricsRegistry: {}", error);
+}
+
+MetricsTextfileExporter::MetricsTextfileExporter(MetricsRegistry& registry)
+    : m_registry(registry)
+{
+}
+
+MetricsTextfileExporter::~MetricsTextfileExporter()
+{
+    stop();
+}
+
+bool MetricsTextfileExporter::start(const std::string& directory,
+                                    std::chrono::milliseconds interval)
+{
+    if (m_running.load())
+    {
+        setLastError("Metrics exporter is already running");
+        return false;
+    }
+
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec))
+    {
+        setLastError("Metrics textfile directory does not exist: " +
+                     directory);
+        return false;
+    }
+
+    m_directory = directory;
+    m_interval = interval.count() > 0 ? interval : DEFAULT_INTERVAL;
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stopRequested = false;
+    }
+
+    m_running.store(true);
+    m_thread = std::thread(&MetricsTextfileExporter::exportLoop, this);
+
+    spdlog::info("MetricsTextfileExporter: Writing metrics to {} every {} ms",
+                 m_directory,
+                 m_interval.count());
+    return true;
+}
+
+void MetricsTextfileExporter::stop()
+{
+    if (!m_running.load())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stopRequested = true;
+    }
+    m_stopCondition.notify_all();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+    m_running.store(false);
+}
+
+std::string MetricsTextfileExporter::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    return m_lastError;
+}
+
+void MetricsTextfileExporter::exportLoop()
+{
+    bool stopping = false;
+    while (!stopping)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_stopMutex);
+            stopping = m_stopCondition.wait_for(
+                lock, m_interval, [this]() { return m_stopRequested; });
+        }
+
+        // Also write once on the way out so the last values are not lost
+        if (!m_registry.writeTextfile(m_directory))
+        {
+            setLastError(m_registry.getLastError());
+        }
+    }
+}
+
+void MetricsTextfileExporter::setLastError(const std::string& error)
+{
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    m_lastError = error;
+}
+
+} // namespace MouseRecorder::Core
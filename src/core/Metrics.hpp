@@ -0,0 +1,347 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace MouseRecorder::Core
+{
+
+/**
+ * @brief Names of the metrics published by the application
+ */
+namespace MetricNames
+{
+constexpr const char* CAPTURE_EVENTS = "mouserecorder_capture_events_total";
+constexpr const char* CAPTURE_QUEUE_DEPTH = "mouserecorder_capture_queue_depth";
+constexpr const char* CAPTURE_DROPPED_EVENTS =
+    "mouserecorder_capture_dropped_events_total";
+constexpr const char* CAPTURE_FILTERED_EVENTS =
+    "mouserecorder_capture_filtered_events_total";
+constexpr const char* REPLAY_EVENTS = "mouserecorder_replay_events_total";
+constexpr const char* REPLAY_FAILED_EVENTS =
+    "mouserecorder_replay_failed_events_total";
+constexpr const char* REPLAY_LATENESS = "mouserecorder_replay_lateness_seconds";
+constexpr const char* STORAGE_BYTES = "mouserecorder_storage_bytes_total";
+constexpr const char* STORAGE_OPERATIONS =
+    "mouserecorder_storage_operations_total";
+constexpr const char* STORAGE_DURATION =
+    "mouserecorder_storage_duration_seconds";
+constexpr const char* RECORDING_CACHE_LOOKUPS =
+    "mouserecorder_recording_cache_lookups_total";
+constexpr const char* RECORDING_CACHE_BYTES =
+    "mouserecorder_recording_cache_bytes";
+} // namespace MetricNames
+
+/**
+ * @brief Label name/value pairs identifying one series of a metric
+ */
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Monotonically increasing counter
+ */
+class Counter
+{
+  public:
+    void increment(std::uint64_t amount = 1) noexcept
+    {
+        m_value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    std::uint64_t value() const noexcept
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<std::uint64_t> m_value{0};
+};
+
+/**
+ * @brief Value that can go up and down
+ */
+class Gauge
+{
+  public:
+    void set(double value) noexcept
+    {
+        m_value.store(value, std::memory_order_relaxed);
+    }
+
+    void add(double amount) noexcept
+    {
+        m_value.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    double value() const noexcept
+    {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<double> m_value{0.0};
+};
+
+/**
+ * @brief Histogram with fixed bucket upper bounds
+ *
+ * Observations only touch atomics, so they are safe from any thread and
+ * never block. Bounds are set at registration and cannot change.
+ */
+class Histogram
+{
+  public:
+    /**
+     * @param bounds Bucket upper bounds in increasing order, the +Inf bucket
+     * is implicit
+     */
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value) noexcept;
+
+    const std::vector<double>& getBounds() const noexcept
+    {
+        return m_bounds;
+    }
+
+    /**
+     * @brief Get the number of observations in one bucket (not cumulative)
+     * @param index Bucket index, getBounds().size() is the +Inf bucket
+     */
+    std::uint64_t bucketCount(std::size_t index) const noexcept
+    {
+        return m_buckets[index].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copy the per-bucket counts, including the +Inf bucket
+     */
+    std::vector<std::uint64_t> bucketCounts() const;
+
+    std::uint64_t count() const noexcept
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    double sum() const noexcept
+    {
+        return m_sum.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Estimate a quantile from per-bucket counts
+     *
+     * Interpolates linearly inside the bucket holding the quantile, like
+     * Prometheus' histogram_quantile(). Values in the +Inf bucket are
+     * reported as the largest bound.
+     * @param bounds Bucket upper bounds
+     * @param counts Per-bucket counts as returned by bucketCounts(), possibly
+     * the difference of two calls to look at a time window
+     * @param quantile Quantile in [0, 1]
+     * @return estimated value, or NaN if there are no observations
+     */
+    static double estimateQuantile(const std::vector<double>& bounds,
+                                   const std::vector<std::uint64_t>& counts,
+                                   double quantile);
+
+  private:
+    std::vector<double> m_bounds;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> m_buckets;
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<double> m_sum{0.0};
+};
+
+/**
+ * @brief Process-wide registry of counters, gauges and histograms
+ *
+ * Metrics are created on first lookup and live as long as the process, so
+ * hot paths should look a metric up once and keep the returned reference.
+ * Updating a metric is lock-free; only registration and export take the
+ * registry lock.
+ */
+class MetricsRegistry
+{
+  public:
+    /**
+     * @brief Bucket bounds in seconds for sub-second latencies
+     */
+    static const std::vector<double>& latencyBuckets();
+
+    /**
+     * @brief Bucket bounds in seconds for file operations
+     */
+    static const std::vector<double>& durationBuckets();
+
+    static MetricsRegistry& instance();
+
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief Get or create a counter
+     * @param name Metric name, e.g. "mouserecorder_capture_events_total"
+     * @param help Description written as # HELP
+     * @param labels Series labels
+     * @throws std::invalid_argument if name is registered with another type
+     */
+    Counter& counter(const std::string& name,
+                     const std::string& help,
+                     const MetricLabels& labels = {});
+
+    /**
+     * @brief Get or create a gauge
+     * @throws std::invalid_argument if name is registered with another type
+     */
+    Gauge& gauge(const std::string& name,
+                 const std::string& help,
+                 const MetricLabels& labels = {});
+
+    /**
+     * @brief Get or create a histogram
+     *
+     * The bounds of the first registration of a series are kept.
+     * @throws std::invalid_argument if name is registered with another type
+     */
+    Histogram& histogram(const std::string& name,
+                         const std::string& help,
+                         const std::vector<double>& bounds,
+                         const MetricLabels& labels = {});
+
+    /**
+     * @brief Look up an existing metric without creating it
+     * @return the metric, or nullptr if it was not registered
+     */
+    const Counter* findCounter(const std::string& name,
+                               const MetricLabels& labels = {}) const;
+    const Gauge* findGauge(const std::string& name,
+                           const MetricLabels& labels = {}) const;
+    const Histogram* findHistogram(const std::string& name,
+                                   const MetricLabels& labels = {}) const;
+
+    /**
+     * @brief Render all metrics in the Prometheus text exposition format
+     */
+    std::string toPrometheusText() const;
+
+    /**
+     * @brief Write all metrics as a node-exporter textfile
+     *
+     * The file is written next to its destination and renamed into place so
+     * the collector never reads a partial file.
+     * @param directory Textfile collector directory
+     * @param filename File name inside the directory, must end in .prom
+     * @return true if the file was written
+     */
+    bool writeTextfile(const std::string& directory,
+                       const std::string& filename = "mouserecorder.prom");
+
+    /**
+     * @brief Get the last error message
+     * @return error message or empty string if no error
+     */
+    std::string getLastError() const;
+
+  private:
+    enum class MetricType
+    {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    struct Family
+    {
+        MetricType type;
+        std::string help;
+        // Keyed by rendered label set, e.g. {format="json"}
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+
+    Family& familyLocked(const std::string& name,
+                         const std::string& help,
+                         MetricType type);
+
+    void setLastError(const std::string& error);
+
+  private:
+    std::map<std::string, Family> m_families;
+    mutable std::mutex m_mutex;
+
+    mutable std::mutex m_errorMutex;
+    std::string m_lastError;
+};
+
+/**
+ * @brief Periodically writes a MetricsRegistry to a textfile directory
+ */
+class MetricsTextfileExporter
+{
+  public:
+    static constexpr std::chrono::milliseconds DEFAULT_INTERVAL{15000};
+
+    explicit MetricsTextfileExporter(
+        MetricsRegistry& registry = MetricsRegistry::instance());
+    ~MetricsTextfileExporter();
+
+    MetricsTextfileExporter(const MetricsTextfileExporter&) = delete;
+    MetricsTextfileExporter& operator=(const MetricsTextfileExporter&) =
+        delete;
+
+    /**
+     * @brief Start exporting
+     * @param directory Textfile collector directory, must exist
+     * @param interval Time between exports
+     * @return true if the exporter was started
+     */
+    bool start(const std::string& directory,
+               std::chrono::milliseconds interval = DEFAULT_INTERVAL);
+
+    /**
+     * @brief Stop exporting after writing a final snapshot
+     */
+    void stop();
+
+    bool isRunning() const noexcept
+    {
+        return m_running.load();
+    }
+
+    std::string getLastError() const;
+
+  private:
+    void exportLoop();
+    void setLastError(const std::string& error);
+
+  private:
+    MetricsRegistry& m_registry;
+    std::string m_directory;
+    std::chrono::milliseconds m_interval{DEFAULT_INTERVAL};
+
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+    bool m_stopRequested{false};
+
+    mutable std::mutex m_errorMutex;
+    std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Core
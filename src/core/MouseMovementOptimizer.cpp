@@ -9,6 +9,7 @@
 #include <ranges>
 #include <set>
 #include "core/SpdlogConfig.hpp"
+#include "core/Tracing.hpp"
 
 namespace MouseRecorder::Core
 {
@@ -17,6 +18,8 @@ size_t MouseMovementOptimizer::optimizeEvents(
     std::vector<std::unique_ptr<Event>>& events,
     const OptimizationConfig& config)
 {
+    MOUSERECORDER_TRACE_SCOPE("optimizer", "optimizeEvents");
+
     if (!config.enabled || events.empty())
     {
         return 0;
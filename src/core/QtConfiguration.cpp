@@ -5,16 +5,84 @@
 
 #include "QtConfiguration.hpp"
 #include "application/MouseRecorderApp.hpp"
+#include <QAbstractEventDispatcher>
 #include <QStringList>
 #include <QDir>
 #include <QStandardPaths>
 #include "SpdlogConfig.hpp"
+#include <algorithm>
 #include <limits>
 #include <cmath>
+#include <set>
 
 namespace MouseRecorder::Core
 {
 
+namespace
+{
+
+// String form passed to per-key change callbacks
+std::string changeValueToString(const ConfigChange& change)
+{
+    if (change.key == "*")
+    {
+        return "cleared";
+    }
+
+    return std::visit(
+        [](const auto& v) -> std::string
+        {
+            using T = std::decay_t<decltype(v)>;
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                return v;
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                return v ? "true" : "false";
+            }
+            else if constexpr (std::is_same_v<T, int> ||
+                               std::is_same_v<T, double>)
+            {
+                return std::to_string(v);
+            }
+            else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+            {
+                std::string result = "[";
+                for (size_t i = 0; i < v.size(); ++i)
+                {
+                    if (i > 0)
+                        result += ",";
+                    result += v[i];
+                }
+                result += "]";
+                return result;
+            }
+            return "";
+        },
+        change.value);
+}
+
+// Snapshot value of a QSettings value of a key of the given type
+ConfigSnapshot::Value toSnapshotValue(ConfigValueType type,
+                                      const QVariant& value)
+{
+    switch (type)
+    {
+    case ConfigValueType::Bool:
+        return value.toBool();
+    case ConfigValueType::Int:
+        return value.toInt();
+    case ConfigValueType::Double:
+        return value.toDouble();
+    case ConfigValueType::String:
+        return value.toString().toStdString();
+    }
+    return std::monostate{};
+}
+
+} // namespace
+
 QtConfiguration::QtConfiguration()
 {
     spdlog::debug("QtConfiguration: Constructor");
@@ -25,6 +93,9 @@ QtConfiguration::QtConfiguration()
 
     m_settings = std::make_unique<QSettings>(organization, application);
     loadDefaults();
+
+    m_owner = std::make_unique<QObject>();
+    m_flushThread = std::thread(&QtConfiguration::flushLoop, this);
 }
 
 QtConfiguration::~QtConfiguration()
@@ -33,9 +104,27 @@ QtConfiguration::~QtConfiguration()
 
     spdlog::debug("QtConfiguration: Destructor");
 
-    // Sync and reset settings before destruction
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopFlushThread = true;
+        m_flushCondition.wakeAll();
+    }
+
+    if (m_flushThread.joinable())
+    {
+        m_flushThread.join();
+    }
+
+    // Drops a flush that was posted but has not run yet
+    m_owner.reset();
+
+    // Write and announce what is still pending, then sync and reset
+    // settings before destruction
     if (m_settings)
     {
+        flush();
+
+        QMutexLocker locker(&m_mutex);
         m_settings->sync();
         m_settings.reset();
     }
@@ -57,17 +146,40 @@ bool QtConfiguration::loadFromFile(const std::string& filename)
             return false;
         }
 
+        // Values from the file win over changes not yet written
+        applyPendingWritesLocked();
+
         // Copy all settings from file to our main settings
         const QStringList keys = fileSettings.allKeys();
         for (const QString& key : keys)
         {
             QVariant value = fileSettings.value(key);
             m_settings->setValue(key, value);
+            m_pendingNotifications.erase(fromQString(key));
+        }
+
+        // The remaining pending changes were just written, so report them
+        // now rather than with some later, unrelated flush
+        std::vector<ConfigChange> changes;
+        changes.reserve(m_pendingNotifications.size());
+        for (auto& [key, value] : m_pendingNotifications)
+        {
+            changes.push_back(ConfigChange{key, std::move(value)});
         }
+        m_pendingNotifications.clear();
 
         m_settings->sync();
+        bool synced = m_settings->status() == QSettings::NoError;
+        publishSnapshot();
+        locker.unlock();
 
-        if (m_settings->status() != QSettings::NoError)
+        // Call callbacks outside of mutex to avoid deadlock
+        if (!changes.empty())
+        {
+            notifyCallbacks(changes);
+        }
+
+        if (!synced)
         {
             setLastError("Failed to sync configuration settings");
             return false;
@@ -85,6 +197,9 @@ bool QtConfiguration::loadFromFile(const std::string& filename)
 
 bool QtConfiguration::saveToFile(const std::string& filename)
 {
+    // Saving is an explicit flush point for the write-behind layer
+    flush();
+
     QMutexLocker locker(&m_mutex);
     spdlog::info("QtConfiguration: Saving to file {}", filename);
 
@@ -138,6 +253,9 @@ void QtConfiguration::loadDefaults()
     QMutexLocker locker(&m_mutex);
     spdlog::debug("QtConfiguration: Loading default configuration");
 
+    // Defaults replace any changes not yet written
+    applyPendingWritesLocked();
+
     // Clear existing settings first if this is a reset
     // m_settings->clear();
 
@@ -147,41 +265,52 @@ void QtConfiguration::loadDefaults()
     m_settings->setValue(toQString(ConfigKeys::OPTIMIZE_MOUSE_MOVEMENTS), true);
     m_settings->setValue(toQString(ConfigKeys::MOUSE_MOVEMENT_THRESHOLD), 5);
 
+    // Autosave settings
+    m_settings->setValue(toQString(ConfigKeys::AUTOSAVE_ENABLED), true);
+    m_settings->setValue(toQString(ConfigKeys::AUTOSAVE_INTERVAL_MS), 30000);
+    m_settings->setValue(toQString(ConfigKeys::AUTOSAVE_EVENT_THRESHOLD),
+                         5000);
+
     // Playback settings
     m_settings->setValue(toQString(ConfigKeys::DEFAULT_PLAYBACK_SPEED), 1.0);
     m_settings->setValue(toQString(ConfigKeys::LOOP_PLAYBACK), false);
+    m_settings->setValue(toQString(ConfigKeys::RECORDING_CACHE_MB), 256);
 
     // Logging settings
     m_settings->setValue(toQString(ConfigKeys::LOG_LEVEL), toQString("info"));
     m_settings->setValue(toQString(ConfigKeys::LOG_TO_FILE), false);
     m_settings->setValue(toQString(ConfigKeys::LOG_FILE_PATH),
                          toQString("mouserecorder.log"));
+    m_settings->setValue(toQString(ConfigKeys::LOG_ASYNC), true);
+
+    // Metrics settings, an empty directory disables the textfile export
+    m_settings->setValue(toQString(ConfigKeys::METRICS_TEXTFILE_DIRECTORY),
+                         toQString(""));
+    m_settings->setValue(toQString(ConfigKeys::METRICS_EXPORT_INTERVAL_MS),
+                         15000);
 
     // UI settings
     m_settings->setValue(toQString(ConfigKeys::AUTO_MINIMIZE_ON_RECORD), true);
 
     m_settings->sync();
+    publishSnapshot();
 }
 
 void QtConfiguration::setString(const std::string& key,
                                 const std::string& value)
 {
-    QString oldValue;
-    bool changed = false;
-
-    // Critical section - hold mutex only for the actual setting operation
     {
         QMutexLocker locker(&m_mutex);
-        oldValue = m_settings->value(toQString(key)).toString();
-        m_settings->setValue(toQString(key), toQString(value));
-        changed = (oldValue != toQString(value));
+        QString qKey = toQString(key);
+        QString oldValue = valueLocked(qKey).toString();
+        if (oldValue != toQString(value) || !containsLocked(qKey))
+        {
+            stageChangeLocked(
+                key, PendingWrite{toQString(value)}, ConfigChangeValue{value});
+        }
     }
 
-    // Call callbacks outside of mutex to avoid deadlock
-    if (changed)
-    {
-        notifyCallbacks(key, value);
-    }
+    flushIfWriteThrough();
 }
 
 std::string QtConfiguration::getString(const std::string& key,
@@ -189,95 +318,81 @@ std::string QtConfiguration::getString(const std::string& key,
 {
     QMutexLocker locker(&m_mutex);
     return fromQString(
-        m_settings->value(toQString(key), toQString(defaultValue)).toString());
+        valueLocked(toQString(key), toQString(defaultValue)).toString());
 }
 
 void QtConfiguration::setInt(const std::string& key, int value)
 {
-    int oldValue;
-    bool changed = false;
-
-    // Critical section - hold mutex only for the actual setting operation
     {
         QMutexLocker locker(&m_mutex);
-        oldValue = m_settings->value(toQString(key)).toInt();
-        m_settings->setValue(toQString(key), value);
-        changed = (oldValue != value);
+        QString qKey = toQString(key);
+        int oldValue = valueLocked(qKey).toInt();
+        if (oldValue != value || !containsLocked(qKey))
+        {
+            stageChangeLocked(
+                key, PendingWrite{value}, ConfigChangeValue{value});
+        }
     }
 
-    // Call callbacks outside of mutex to avoid deadlock
-    if (changed)
-    {
-        notifyCallbacks(key, std::to_string(value));
-    }
+    flushIfWriteThrough();
 }
 
 int QtConfiguration::getInt(const std::string& key, int defaultValue) const
 {
     QMutexLocker locker(&m_mutex);
-    return m_settings->value(toQString(key), defaultValue).toInt();
+    return valueLocked(toQString(key), defaultValue).toInt();
 }
 
 void QtConfiguration::setDouble(const std::string& key, double value)
 {
-    double oldValue;
-    bool changed = false;
-
-    // Critical section - hold mutex only for the actual setting operation
     {
         QMutexLocker locker(&m_mutex);
-        oldValue = m_settings->value(toQString(key)).toDouble();
-        m_settings->setValue(toQString(key), value);
-        changed = (std::abs(oldValue - value) >
-                   std::numeric_limits<double>::epsilon());
+        QString qKey = toQString(key);
+        double oldValue = valueLocked(qKey).toDouble();
+        bool changed = (std::abs(oldValue - value) >
+                        std::numeric_limits<double>::epsilon());
+        if (changed || !containsLocked(qKey))
+        {
+            stageChangeLocked(
+                key, PendingWrite{value}, ConfigChangeValue{value});
+        }
     }
 
-    // Call callbacks outside of mutex to avoid deadlock
-    if (changed)
-    {
-        notifyCallbacks(key, std::to_string(value));
-    }
+    flushIfWriteThrough();
 }
 
 double QtConfiguration::getDouble(const std::string& key,
                                   double defaultValue) const
 {
     QMutexLocker locker(&m_mutex);
-    return m_settings->value(toQString(key), defaultValue).toDouble();
+    return valueLocked(toQString(key), defaultValue).toDouble();
 }
 
 void QtConfiguration::setBool(const std::string& key, bool value)
 {
-    bool oldValue;
-    bool changed = false;
-
-    // Critical section - hold mutex only for the actual setting operation
     {
         QMutexLocker locker(&m_mutex);
-        oldValue = m_settings->value(toQString(key)).toBool();
-        m_settings->setValue(toQString(key), value);
-        changed = (oldValue != value);
+        QString qKey = toQString(key);
+        bool oldValue = valueLocked(qKey).toBool();
+        if (oldValue != value || !containsLocked(qKey))
+        {
+            stageChangeLocked(
+                key, PendingWrite{value}, ConfigChangeValue{value});
+        }
     }
 
-    // Call callbacks outside of mutex to avoid deadlock
-    if (changed)
-    {
-        notifyCallbacks(key, value ? "true" : "false");
-    }
+    flushIfWriteThrough();
 }
 
 bool QtConfiguration::getBool(const std::string& key, bool defaultValue) const
 {
     QMutexLocker locker(&m_mutex);
-    return m_settings->value(toQString(key), defaultValue).toBool();
+    return valueLocked(toQString(key), defaultValue).toBool();
 }
 
 void QtConfiguration::setStringArray(const std::string& key,
                                      const std::vector<std::string>& value)
 {
-    std::string valueStr;
-
-    // Critical section - hold mutex only for the actual setting operation
     {
         QMutexLocker locker(&m_mutex);
 
@@ -287,21 +402,11 @@ void QtConfiguration::setStringArray(const std::string& key,
             qList.append(toQString(str));
         }
 
-        m_settings->setValue(toQString(key), qList);
-
         // For simplicity, always notify on array changes
-        valueStr = "[";
-        for (size_t i = 0; i < value.size(); ++i)
-        {
-            if (i > 0)
-                valueStr += ",";
-            valueStr += value[i];
-        }
-        valueStr += "]";
+        stageChangeLocked(key, PendingWrite{qList}, ConfigChangeValue{value});
     }
 
-    // Call callbacks outside of mutex to avoid deadlock
-    notifyCallbacks(key, valueStr);
+    flushIfWriteThrough();
 }
 
 std::vector<std::string> QtConfiguration::getStringArray(
@@ -316,7 +421,7 @@ std::vector<std::string> QtConfiguration::getStringArray(
     }
 
     QStringList qList =
-        m_settings->value(toQString(key), defaultQList).toStringList();
+        valueLocked(toQString(key), defaultQList).toStringList();
 
     std::vector<std::string> result;
     for (const QString& str : qList)
@@ -330,28 +435,22 @@ std::vector<std::string> QtConfiguration::getStringArray(
 bool QtConfiguration::hasKey(const std::string& key) const
 {
     QMutexLocker locker(&m_mutex);
-    return m_settings->contains(toQString(key));
+    return containsLocked(toQString(key));
 }
 
 void QtConfiguration::removeKey(const std::string& key)
 {
-    bool keyExisted = false;
-
-    // Critical section - hold mutex only for the actual removal operation
     {
         QMutexLocker locker(&m_mutex);
-        keyExisted = m_settings->contains(toQString(key));
-        if (keyExisted)
+        if (containsLocked(toQString(key)))
         {
-            m_settings->remove(toQString(key));
+            stageChangeLocked(key,
+                              PendingWrite{QVariant(), true},
+                              ConfigChangeValue{std::monostate{}});
         }
     }
 
-    // Call callbacks outside of mutex to avoid deadlock
-    if (keyExisted)
-    {
-        notifyCallbacks(key, "");
-    }
+    flushIfWriteThrough();
 }
 
 std::vector<std::string> QtConfiguration::getAllKeys() const
@@ -359,8 +458,21 @@ std::vector<std::string> QtConfiguration::getAllKeys() const
     QMutexLocker locker(&m_mutex);
     QStringList qKeys = m_settings->allKeys();
 
+    std::set<QString> keySet(qKeys.begin(), qKeys.end());
+    for (const auto& [key, write] : m_pendingWrites)
+    {
+        if (write.removed)
+        {
+            keySet.erase(key);
+        }
+        else
+        {
+            keySet.insert(key);
+        }
+    }
+
     std::vector<std::string> keys;
-    for (const QString& key : qKeys)
+    for (const QString& key : keySet)
     {
         keys.push_back(fromQString(key));
     }
@@ -373,11 +485,16 @@ void QtConfiguration::clear()
     // Critical section - hold mutex only for the actual clear operation
     {
         QMutexLocker locker(&m_mutex);
+        m_pendingWrites.clear();
+        m_pendingNotifications.clear();
+        m_firstPendingTime.reset();
+        m_flushDeadline.reset();
         m_settings->clear();
+        publishSnapshot();
     }
 
     // Call callbacks outside of mutex to avoid deadlock
-    notifyCallbacks("*", "cleared");
+    notifyCallbacks({ConfigChange{"*", std::monostate{}}});
 }
 
 size_t QtConfiguration::registerChangeCallback(ConfigChangeCallback callback)
@@ -388,10 +505,25 @@ size_t QtConfiguration::registerChangeCallback(ConfigChangeCallback callback)
     return id;
 }
 
+size_t QtConfiguration::registerBatchChangeCallback(
+    ConfigBatchChangeCallback callback)
+{
+    QMutexLocker locker(&m_mutex);
+    size_t id = m_nextCallbackId++;
+    m_batchCallbacks[id] = callback;
+    return id;
+}
+
 void QtConfiguration::unregisterChangeCallback(size_t callbackId)
 {
     QMutexLocker locker(&m_mutex);
     m_callbacks.erase(callbackId);
+    m_batchCallbacks.erase(callbackId);
+}
+
+std::shared_ptr<const ConfigSnapshot> QtConfiguration::getSnapshot() const
+{
+    return m_snapshot.load(std::memory_order_acquire);
 }
 
 std::string QtConfiguration::getLastError() const
@@ -400,6 +532,51 @@ std::string QtConfiguration::getLastError() const
     return m_lastError;
 }
 
+void QtConfiguration::flush()
+{
+    std::vector<ConfigChange> changes;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_flushQueued = false;
+
+        if (!m_pendingWrites.empty())
+        {
+            applyPendingWritesLocked();
+            m_settings->sync();
+
+            if (m_settings->status() != QSettings::NoError)
+            {
+                setLastError("Failed to sync configuration settings");
+            }
+        }
+
+        changes.reserve(m_pendingNotifications.size());
+        for (auto& [key, value] : m_pendingNotifications)
+        {
+            changes.push_back(ConfigChange{key, std::move(value)});
+        }
+        m_pendingNotifications.clear();
+    }
+
+    // Call callbacks outside of mutex to avoid deadlock
+    if (!changes.empty())
+    {
+        notifyCallbacks(changes);
+    }
+}
+
+void QtConfiguration::setWriteDelay(std::chrono::milliseconds delay)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_writeDelay = std::max(delay, std::chrono::milliseconds::zero());
+        m_flushCondition.wakeAll();
+    }
+
+    flushIfWriteThrough();
+}
+
 QString QtConfiguration::toQString(const std::string& str) const
 {
     return QString::fromStdString(str);
@@ -410,21 +587,131 @@ std::string QtConfiguration::fromQString(const QString& str) const
     return str.toStdString();
 }
 
-void QtConfiguration::notifyCallbacks(const std::string& key,
-                                      const std::string& value)
+QVariant QtConfiguration::valueLocked(const QString& key,
+                                      const QVariant& defaultValue) const
+{
+    if (auto it = m_pendingWrites.find(key); it != m_pendingWrites.end())
+    {
+        return it->second.removed ? defaultValue : it->second.value;
+    }
+
+    return m_settings->value(key, defaultValue);
+}
+
+bool QtConfiguration::containsLocked(const QString& key) const
+{
+    if (auto it = m_pendingWrites.find(key); it != m_pendingWrites.end())
+    {
+        return !it->second.removed;
+    }
+
+    return m_settings->contains(key);
+}
+
+void QtConfiguration::stageChangeLocked(const std::string& key,
+                                        PendingWrite write,
+                                        ConfigChangeValue value)
+{
+    m_pendingWrites[toQString(key)] = std::move(write);
+    m_pendingNotifications[key] = std::move(value);
+    publishSnapshotChange(key);
+
+    // Debounce, but bound how long a stream of changes can defer the write
+    auto now = std::chrono::steady_clock::now();
+    if (!m_firstPendingTime)
+    {
+        m_firstPendingTime = now;
+    }
+    m_flushDeadline =
+        std::min(now + m_writeDelay, *m_firstPendingTime + 4 * m_writeDelay);
+    m_flushCondition.wakeAll();
+}
+
+void QtConfiguration::applyPendingWritesLocked()
+{
+    for (const auto& [key, write] : m_pendingWrites)
+    {
+        if (write.removed)
+        {
+            m_settings->remove(key);
+        }
+        else
+        {
+            m_settings->setValue(key, write.value);
+        }
+    }
+
+    m_pendingWrites.clear();
+    m_firstPendingTime.reset();
+    m_flushDeadline.reset();
+}
+
+void QtConfiguration::flushIfWriteThrough()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_writeDelay.count() > 0)
+        {
+            return;
+        }
+    }
+
+    flush();
+}
+
+void QtConfiguration::flushLoop()
+{
+    QMutexLocker locker(&m_mutex);
+
+    while (!m_stopFlushThread)
+    {
+        if (!m_flushDeadline || m_flushQueued)
+        {
+            m_flushCondition.wait(&m_mutex);
+            continue;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now < *m_flushDeadline)
+        {
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                *m_flushDeadline - now);
+            m_flushCondition.wait(
+                &m_mutex, static_cast<unsigned long>(remaining.count()));
+            continue;
+        }
+
+        if (QAbstractEventDispatcher::instance(m_owner->thread()))
+        {
+            m_flushQueued = true;
+            QMetaObject::invokeMethod(
+                m_owner.get(), [this]() { flush(); }, Qt::QueuedConnection);
+            continue;
+        }
+
+        // Nothing would deliver a posted flush
+        locker.unlock();
+        flush();
+        locker.relock();
+    }
+}
+
+void QtConfiguration::notifyCallbacks(const std::vector<ConfigChange>& changes)
 {
     // Don't hold the main mutex while calling callbacks to avoid deadlocks
     std::map<size_t, ConfigChangeCallback> callbacks;
+    std::map<size_t, ConfigBatchChangeCallback> batchCallbacks;
     {
         QMutexLocker locker(&m_mutex);
         callbacks = m_callbacks;
+        batchCallbacks = m_batchCallbacks;
     }
 
-    for (const auto& [id, callback] : callbacks)
+    for (const auto& [id, callback] : batchCallbacks)
     {
         try
         {
-            callback(key, value);
+            callback(changes);
         }
         catch (const std::exception& e)
         {
@@ -433,6 +720,80 @@ void QtConfiguration::notifyCallbacks(const std::string& key,
                          e.what());
         }
     }
+
+    // Per-key callbacks get the string form, formatted only when needed
+    if (callbacks.empty())
+    {
+        return;
+    }
+
+    for (const auto& change : changes)
+    {
+        std::string value = changeValueToString(change);
+        for (const auto& [id, callback] : callbacks)
+        {
+            try
+            {
+                callback(change.key, value);
+            }
+            catch (const std::exception& e)
+            {
+                spdlog::warn(
+                    "QtConfiguration: Callback {} threw exception: {}",
+                    id,
+                    e.what());
+            }
+        }
+    }
+}
+
+void QtConfiguration::publishSnapshot()
+{
+    auto snapshot = std::make_shared<ConfigSnapshot>();
+
+    for (std::size_t i = 0; i < CONFIG_KEY_COUNT; ++i)
+    {
+        const auto& info = CONFIG_KEY_TABLE[i];
+        QString key = toQString(info.name);
+        if (containsLocked(key))
+        {
+            snapshot->setValue(static_cast<ConfigKeyId>(i),
+                               toSnapshotValue(info.type, valueLocked(key)));
+        }
+    }
+
+    snapshot->setVersion(++m_snapshotVersion);
+    m_snapshot.store(std::move(snapshot), std::memory_order_release);
+}
+
+void QtConfiguration::publishSnapshotChange(const std::string& key)
+{
+    // Keys without a ConfigKeyId are not part of snapshots
+    ConfigKeyId id;
+    if (!findConfigKeyId(key, id))
+    {
+        return;
+    }
+
+    auto previous = m_snapshot.load(std::memory_order_relaxed);
+    auto snapshot = previous ? std::make_shared<ConfigSnapshot>(*previous)
+                             : std::make_shared<ConfigSnapshot>();
+
+    QString qKey = toQString(key);
+    if (containsLocked(qKey))
+    {
+        snapshot->setValue(
+            id,
+            toSnapshotValue(CONFIG_KEY_TABLE[static_cast<std::size_t>(id)].type,
+                            valueLocked(qKey)));
+    }
+    else
+    {
+        snapshot->setValue(id, std::monostate{});
+    }
+
+    snapshot->setVersion(++m_snapshotVersion);
+    m_snapshot.store(std::move(snapshot), std::memory_order_release);
 }
 
 void QtConfiguration::setLastError(const std::string& error)
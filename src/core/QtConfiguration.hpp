@@ -6,11 +6,18 @@
 #pragma once
 
 #include "IConfiguration.hpp"
+#include "ConfigSnapshot.hpp"
+#include <QObject>
 #include <QSettings>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QWaitCondition>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <map>
+#include <optional>
+#include <thread>
 
 namespace MouseRecorder::Core
 {
@@ -20,10 +27,23 @@ namespace MouseRecorder::Core
  *
  * This class provides a thread-safe implementation of configuration storage
  * using Qt's QSettings for cross-platform persistence.
+ *
+ * Setters update an in-memory write-behind layer and return immediately.
+ * Changes are coalesced per key and written to QSettings by a background
+ * thread once no further change arrived for the write delay, or on flush(),
+ * saveToFile() and destruction. Change callbacks are delivered together with
+ * each write, one batch per flush, on the thread doing the flush. The
+ * background thread only waits for the write delay: it posts the debounced
+ * flush to the thread that created the configuration, so QSettings and the
+ * callbacks stay on that thread. Only when that thread has no event loop
+ * does the background thread flush itself. flush(), saveToFile(),
+ * loadFromFile() and a zero write delay flush on the caller's thread.
  */
 class QtConfiguration : public IConfiguration
 {
   public:
+    static constexpr std::chrono::milliseconds DEFAULT_WRITE_DELAY{500};
+
     QtConfiguration();
     ~QtConfiguration() override;
 
@@ -66,11 +86,38 @@ class QtConfiguration : public IConfiguration
 
     // Change notifications
     size_t registerChangeCallback(ConfigChangeCallback callback) override;
+    size_t registerBatchChangeCallback(
+        ConfigBatchChangeCallback callback) override;
     void unregisterChangeCallback(size_t callbackId) override;
 
+    std::shared_ptr<const ConfigSnapshot> getSnapshot() const override;
+
     std::string getLastError() const override;
 
+    /**
+     * @brief Write pending changes to QSettings and deliver notifications
+     */
+    void flush();
+
+    /**
+     * @brief Set how long changes are held before being written
+     *
+     * The write is postponed while changes keep arriving, but never by more
+     * than four times the delay after the first pending change.
+     * @param delay Debounce delay, zero writes through on every change
+     */
+    void setWriteDelay(std::chrono::milliseconds delay);
+
   private:
+    /**
+     * @brief Pending write for a single key
+     */
+    struct PendingWrite
+    {
+        QVariant value;
+        bool removed{false};
+    };
+
     /**
      * @brief Convert std::string to QString
      */
@@ -82,11 +129,74 @@ class QtConfiguration : public IConfiguration
     std::string fromQString(const QString& str) const;
 
     /**
-     * @brief Notify all registered callbacks about a change
+     * @brief Read a value through the write-behind layer
+     *
+     * Must be called with m_mutex held.
+     */
+    QVariant valueLocked(const QString& key,
+                         const QVariant& defaultValue = QVariant()) const;
+
+    /**
+     * @brief Check if a key exists through the write-behind layer
+     *
+     * Must be called with m_mutex held.
+     */
+    bool containsLocked(const QString& key) const;
+
+    /**
+     * @brief Record a change and schedule it to be written
+     *
+     * Must be called with m_mutex held.
      * @param key Changed key
-     * @param value New value as string
+     * @param write Pending write for QSettings
+     * @param value Typed value for change notifications
+     */
+    void stageChangeLocked(const std::string& key,
+                           PendingWrite write,
+                           ConfigChangeValue value);
+
+    /**
+     * @brief Apply pending writes to QSettings
+     *
+     * Must be called with m_mutex held. Does not sync to disk.
      */
-    void notifyCallbacks(const std::string& key, const std::string& value);
+    void applyPendingWritesLocked();
+
+    /**
+     * @brief Write pending changes if the write delay is zero
+     */
+    void flushIfWriteThrough();
+
+    /**
+     * @brief Background thread waiting for the debounce deadline
+     *
+     * Posts flush() to the owner thread once the deadline passed, or calls
+     * it directly if that thread runs no event loop.
+     */
+    void flushLoop();
+
+    /**
+     * @brief Deliver a batch of changes to all registered callbacks
+     * @param changes Coalesced changes
+     */
+    void notifyCallbacks(const std::vector<ConfigChange>& changes);
+
+    /**
+     * @brief Rebuild the typed snapshot and publish it
+     *
+     * Must be called with m_mutex held so snapshots are published in the
+     * same order as the changes they reflect.
+     */
+    void publishSnapshot();
+
+    /**
+     * @brief Publish a copy of the current snapshot with one key updated
+     *
+     * Must be called with m_mutex held. Keys that are not in
+     * CONFIG_KEY_TABLE leave the snapshot as it is.
+     * @param key Changed key
+     */
+    void publishSnapshotChange(const std::string& key);
 
     /**
      * @brief Set last error message in thread-safe manner
@@ -98,8 +208,31 @@ class QtConfiguration : public IConfiguration
     mutable QMutex m_mutex;
     std::unique_ptr<QSettings> m_settings;
 
+    // Write-behind state, guarded by m_mutex
+    std::map<QString, PendingWrite> m_pendingWrites;
+    std::map<std::string, ConfigChangeValue> m_pendingNotifications;
+    std::optional<std::chrono::steady_clock::time_point> m_firstPendingTime;
+    std::optional<std::chrono::steady_clock::time_point> m_flushDeadline;
+    std::chrono::milliseconds m_writeDelay{DEFAULT_WRITE_DELAY};
+
+    // Lives on the creating thread, debounced flushes are posted to it
+    std::unique_ptr<QObject> m_owner;
+
+    // Flush thread
+    std::thread m_flushThread;
+    QWaitCondition m_flushCondition;
+    bool m_stopFlushThread{false};
+    // A flush was posted to m_owner and has not run yet
+    bool m_flushQueued{false};
+
+    // Published snapshot, replaced as a whole on every change. Not
+    // lock-free with libstdc++, which briefly spins on load and store
+    std::atomic<std::shared_ptr<const ConfigSnapshot>> m_snapshot;
+    std::uint64_t m_snapshotVersion{0};
+
     // Callback management
     std::map<size_t, ConfigChangeCallback> m_callbacks;
+    std::map<size_t, ConfigBatchChangeCallback> m_batchCallbacks;
     size_t m_nextCallbackId{1};
 
     // Error handling
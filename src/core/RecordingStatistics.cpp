@@ -0,0 +1,111 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "RecordingStatistics.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace MouseRecorder::Core
+{
+
+RecordingStatistics RecordingStatistics::fromEvents(
+    const std::vector<std::unique_ptr<Event>>& events)
+{
+    RecordingStatistics statistics;
+    for (const auto& event : events)
+    {
+        if (event)
+        {
+            statistics.add(*event);
+        }
+    }
+    return statistics;
+}
+
+void RecordingStatistics::add(const Event& event)
+{
+    uint64_t timestamp = event.getTimestampMs();
+    if (getTotalEvents() == 0)
+    {
+        firstTimestampMs = timestamp;
+        lastTimestampMs = timestamp;
+    }
+    else
+    {
+        // Recordings are in timestamp order, but don't rely on it
+        firstTimestampMs = std::min(firstTimestampMs, timestamp);
+        lastTimestampMs = std::max(lastTimestampMs, timestamp);
+    }
+
+    ++eventCounts[static_cast<size_t>(event.getType())];
+    addActivity(timestamp);
+
+    if (const MouseEventData* mouse = event.getMouseData())
+    {
+        const Point& position = mouse->position;
+        if (!hasPointerBounds)
+        {
+            hasPointerBounds = true;
+            pointerMin = position;
+            pointerMax = position;
+        }
+        else
+        {
+            pointerMin.x = std::min(pointerMin.x, position.x);
+            pointerMin.y = std::min(pointerMin.y, position.y);
+            pointerMax.x = std::max(pointerMax.x, position.x);
+            pointerMax.y = std::max(pointerMax.y, position.y);
+        }
+    }
+
+    const KeyboardEventData* key = event.getKeyboardData();
+    if (key && event.getType() != EventType::KeyRelease)
+    {
+        keysUsed.insert(key->keyName.empty() ? std::to_string(key->keyCode)
+                                             : key->keyName);
+    }
+}
+
+void RecordingStatistics::addActivity(uint64_t timestampMs)
+{
+    if (getTotalEvents() == 1)
+    {
+        activityStartMs = timestampMs;
+    }
+
+    uint64_t offset =
+        timestampMs > activityStartMs ? timestampMs - activityStartMs : 0;
+    while (offset / activityBucketMs >= ACTIVITY_BUCKETS)
+    {
+        // Merge neighbouring buckets into the first half
+        for (size_t i = 0; i < ACTIVITY_BUCKETS / 2; ++i)
+        {
+            activity[i] = activity[2 * i] + activity[2 * i + 1];
+        }
+        std::fill(activity.begin() + ACTIVITY_BUCKETS / 2, activity.end(), 0);
+        activityBucketMs *= 2;
+    }
+    ++activity[offset / activityBucketMs];
+}
+
+size_t RecordingStatistics::getTotalEvents() const noexcept
+{
+    return std::accumulate(eventCounts.begin(), eventCounts.end(), size_t{0});
+}
+
+size_t RecordingStatistics::getMouseEvents() const noexcept
+{
+    return getCount(EventType::MouseMove) + getCount(EventType::MouseClick) +
+           getCount(EventType::MouseDoubleClick) +
+           getCount(EventType::MouseWheel);
+}
+
+size_t RecordingStatistics::getKeyboardEvents() const noexcept
+{
+    return getCount(EventType::KeyPress) + getCount(EventType::KeyRelease) +
+           getCount(EventType::KeyCombination);
+}
+
+} // namespace MouseRecorder::Core
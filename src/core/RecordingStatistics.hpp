@@ -0,0 +1,98 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "Event.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace MouseRecorder::Core
+{
+
+/**
+ * @brief Summary numbers of a recording
+ *
+ * Built up one event at a time, so it can follow a streaming load or a
+ * save without keeping the events around. Storages compute it while
+ * saving and store it with the metadata, so it can be read back without
+ * decoding the events.
+ */
+struct RecordingStatistics
+{
+    static constexpr size_t EVENT_TYPE_COUNT =
+        static_cast<size_t>(EventType::KeyCombination) + 1;
+
+    // Activity histogram size and the width its buckets start with
+    static constexpr size_t ACTIVITY_BUCKETS = 64;
+    static constexpr uint64_t MIN_ACTIVITY_BUCKET_MS = 10;
+
+    // Number of events of each EventType, indexed by the enum value
+    std::array<size_t, EVENT_TYPE_COUNT> eventCounts{};
+
+    // Timestamps of the first and last event, 0 for an empty recording
+    uint64_t firstTimestampMs{0};
+    uint64_t lastTimestampMs{0};
+
+    // Bounding box of the pointer positions of mouse events, only valid if
+    // hasPointerBounds is set
+    bool hasPointerBounds{false};
+    Point pointerMin;
+    Point pointerMax;
+
+    // Names of the keys pressed, key codes for keys without a name
+    std::set<std::string> keysUsed;
+
+    // Events per time bucket from activityStartMs, the timestamp of the
+    // first event added, on. Buckets double in width whenever the
+    // recording outgrows the histogram, so it covers the whole recording
+    // at a resolution of 1/64 to 1/128 of its length.
+    uint64_t activityStartMs{0};
+    uint64_t activityBucketMs{MIN_ACTIVITY_BUCKET_MS};
+    std::array<uint64_t, ACTIVITY_BUCKETS> activity{};
+
+    /**
+     * @brief Compute the statistics of a whole recording
+     */
+    static RecordingStatistics fromEvents(
+        const std::vector<std::unique_ptr<Event>>& events);
+
+    /**
+     * @brief Account for the next event of the recording
+     *
+     * Events are expected in timestamp order; earlier ones than the first
+     * event are counted in the first activity bucket.
+     */
+    void add(const Event& event);
+
+    size_t getCount(EventType type) const noexcept
+    {
+        return eventCounts[static_cast<size_t>(type)];
+    }
+
+    size_t getTotalEvents() const noexcept;
+    size_t getMouseEvents() const noexcept;
+    size_t getKeyboardEvents() const noexcept;
+
+    /**
+     * @brief Time between the first and the last event
+     */
+    uint64_t getDurationMs() const noexcept
+    {
+        return lastTimestampMs - firstTimestampMs;
+    }
+
+    bool operator==(const RecordingStatistics& other) const = default;
+
+  private:
+    void addActivity(uint64_t timestampMs);
+};
+
+} // namespace MouseRecorder::Core
@@ -0,0 +1,344 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "RepeatedSegmentDetector.hpp"
+#include "Tracing.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include "SpdlogConfig.hpp"
+
+namespace MouseRecorder::Core
+{
+
+namespace
+{
+
+uint64_t combine(uint64_t hash, uint64_t value)
+{
+    return hash ^ (value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2));
+}
+
+/**
+ * @brief Hash of everything but the timestamp of an event
+ */
+uint64_t fingerprint(const Event& event)
+{
+    uint64_t hash = static_cast<uint64_t>(event.getType());
+    if (const auto* mouse = event.getMouseData())
+    {
+        hash = combine(hash, static_cast<uint32_t>(mouse->position.x));
+        hash = combine(hash, static_cast<uint32_t>(mouse->position.y));
+        hash = combine(hash, static_cast<uint64_t>(mouse->button));
+        hash = combine(hash, static_cast<uint32_t>(mouse->wheelDelta));
+        hash = combine(hash, static_cast<uint64_t>(mouse->modifiers));
+    }
+    else if (const auto* key = event.getKeyboardData())
+    {
+        hash = combine(hash, key->keyCode);
+        hash = combine(hash, std::hash<std::string>{}(key->keyName));
+        hash = combine(hash, static_cast<uint64_t>(key->modifiers));
+        hash = combine(hash, key->isRepeated);
+    }
+    return hash;
+}
+
+bool haveSameContent(const Event& a, const Event& b)
+{
+    if (a.getType() != b.getType())
+    {
+        return false;
+    }
+    const auto* mouseA = a.getMouseData();
+    const auto* mouseB = b.getMouseData();
+    if (mouseA || mouseB)
+    {
+        return mouseA && mouseB && mouseA->position == mouseB->position &&
+               mouseA->button == mouseB->button &&
+               mouseA->wheelDelta == mouseB->wheelDelta &&
+               mouseA->modifiers == mouseB->modifiers;
+    }
+    const auto* keyA = a.getKeyboardData();
+    const auto* keyB = b.getKeyboardData();
+    return keyA && keyB && keyA->keyCode == keyB->keyCode &&
+           keyA->keyName == keyB->keyName &&
+           keyA->modifiers == keyB->modifiers &&
+           keyA->isRepeated == keyB->isRepeated;
+}
+
+/**
+ * @brief Events with their hashes and delays, compared while searching
+ */
+class EventSequence
+{
+  public:
+    EventSequence(const EventVector& events, uint64_t toleranceMs)
+        : m_events(events),
+          m_toleranceMs(toleranceMs)
+    {
+        m_fingerprints.reserve(events.size());
+        m_delaysMs.reserve(events.size());
+        uint64_t previousMs = events.empty() ? 0 : events[0]->getTimestampMs();
+        for (const auto& event : events)
+        {
+            uint64_t timestampMs = event->getTimestampMs();
+            m_fingerprints.push_back(fingerprint(*event));
+            m_delaysMs.push_back(
+                timestampMs > previousMs ? timestampMs - previousMs : 0);
+            previousMs = timestampMs;
+        }
+    }
+
+    /**
+     * @brief Check whether the event at b repeats the one at a
+     *
+     * The delay before the first event of a segment is not part of it.
+     */
+    bool matches(size_t a, size_t b, size_t segmentStart) const
+    {
+        if (m_fingerprints[a] != m_fingerprints[b])
+        {
+            return false;
+        }
+        if (a != segmentStart)
+        {
+            uint64_t delayA = m_delaysMs[a];
+            uint64_t delayB = m_delaysMs[b];
+            uint64_t difference =
+                delayA > delayB ? delayA - delayB : delayB - delayA;
+            if (difference > m_toleranceMs)
+            {
+                return false;
+            }
+        }
+        return haveSameContent(*m_events[a], *m_events[b]);
+    }
+
+  private:
+    const EventVector& m_events;
+    uint64_t m_toleranceMs;
+    std::vector<uint64_t> m_fingerprints;
+    std::vector<uint64_t> m_delaysMs;
+};
+
+uint64_t getAveragePeriodMs(const EventVector& events,
+                            size_t start,
+                            size_t length,
+                            size_t repeats)
+{
+    uint64_t firstMs = events[start]->getTimestampMs();
+    uint64_t lastMs = events[start + (repeats - 1) * length]->getTimestampMs();
+    return lastMs > firstMs ? (lastMs - firstMs) / (repeats - 1) : 0;
+}
+
+/**
+ * @brief Check whether replaying the first repetition every periodMs keeps
+ * the timestamps of the expanded recording in order
+ */
+bool fitsTiming(const EventVector& events,
+                size_t start,
+                size_t length,
+                size_t repeats,
+                uint64_t periodMs)
+{
+    uint64_t firstMs = events[start]->getTimestampMs();
+    uint64_t spanMs = events[start + length - 1]->getTimestampMs() - firstMs;
+    if (spanMs > periodMs)
+    {
+        return false;
+    }
+    size_t end = start + repeats * length;
+    return end >= events.size() ||
+           firstMs + (repeats - 1) * periodMs + spanMs <=
+               events[end]->getTimestampMs();
+}
+
+} // namespace
+
+SegmentIndex::SegmentIndex(std::vector<RepeatedSegment> segments)
+    : m_segments(std::move(segments))
+{
+    m_expandedStarts.reserve(m_segments.size());
+    for (const auto& segment : m_segments)
+    {
+        m_expandedStarts.push_back(segment.start + m_addedEvents);
+        m_addedEvents += (segment.repeatCount - 1) * segment.length;
+    }
+}
+
+bool SegmentIndex::isValid(const std::vector<RepeatedSegment>& segments,
+                           uint64_t storedCount) noexcept
+{
+    uint64_t end = 0;
+    for (const auto& segment : segments)
+    {
+        if (segment.length == 0 || segment.repeatCount < 2 ||
+            segment.start < end || segment.length > storedCount ||
+            segment.start > storedCount - segment.length)
+        {
+            return false;
+        }
+        end = segment.start + segment.length;
+    }
+    return true;
+}
+
+SegmentIndex::Location SegmentIndex::locate(uint64_t position) const noexcept
+{
+    // Last segment starting at or before position
+    auto next = std::upper_bound(
+        m_expandedStarts.begin(), m_expandedStarts.end(), position);
+    if (next == m_expandedStarts.begin())
+    {
+        return {position, 0};
+    }
+    size_t i = static_cast<size_t>(std::distance(m_expandedStarts.begin(),
+                                                 next)) -
+               1;
+    const RepeatedSegment& segment = m_segments[i];
+    uint64_t relative = position - m_expandedStarts[i];
+    uint64_t span = segment.length * segment.repeatCount;
+    if (relative < span)
+    {
+        return {segment.start + relative % segment.length,
+                relative / segment.length * segment.periodMs};
+    }
+    return {segment.start + segment.length + (relative - span), 0};
+}
+
+EventVector LoopedRecording::expand() const
+{
+    uint64_t count = getExpandedCount();
+    EventVector expanded;
+    expanded.reserve(count);
+    for (uint64_t position = 0; position < count; ++position)
+    {
+        auto location = index.locate(position);
+        const Event* event = events[location.event].get();
+        expanded.push_back(
+            event ? std::make_unique<Event>(
+                        event->getType(),
+                        event->getData(),
+                        event->getTimestamp() +
+                            std::chrono::milliseconds(location.offsetMs))
+                  : nullptr);
+    }
+    return expanded;
+}
+
+std::vector<RepeatedSegment> RepeatedSegmentDetector::findSegments(
+    const EventVector& events, const LoopDetectionConfig& config)
+{
+    MOUSERECORDER_TRACE_SCOPE("core", "RepeatedSegmentDetector::findSegments");
+    std::vector<RepeatedSegment> segments;
+    if (std::any_of(events.begin(),
+                    events.end(),
+                    [](const auto& event) { return !event; }))
+    {
+        spdlog::warn("RepeatedSegmentDetector: Recording has null events");
+        return segments;
+    }
+
+    EventSequence sequence(events, config.timingToleranceMs);
+    const size_t count = events.size();
+    size_t start = 0;
+    while (start + 1 < count)
+    {
+        // Length that saves the most events, the shortest one of those
+        size_t bestLength = 0;
+        size_t bestRepeats = 0;
+        size_t bestSaved = 0;
+        size_t maxLength = std::min(config.maxSegmentLength,
+                                    (count - start) / 2);
+        for (size_t length = 1; length <= maxLength; ++length)
+        {
+            // Events matching those one length earlier
+            size_t matched = 0;
+            while (start + length + matched < count &&
+                   sequence.matches(
+                       start + matched, start + length + matched, start))
+            {
+                ++matched;
+            }
+            size_t repeats = 1 + matched / length;
+            size_t saved = (repeats - 1) * length;
+            if (saved > bestSaved)
+            {
+                bestLength = length;
+                bestRepeats = repeats;
+                bestSaved = saved;
+            }
+        }
+
+        // Average period, so small timing differences don't add up. The
+        // copies replay the timing of the first repetition, so it must
+        // fit in a period and the last copy must end before the events
+        // after the segment; drop repetitions from the end until it does
+        uint64_t periodMs = 0;
+        for (; bestRepeats > 1; --bestRepeats)
+        {
+            periodMs = getAveragePeriodMs(events, start, bestLength,
+                                          bestRepeats);
+            if (fitsTiming(events, start, bestLength, bestRepeats,
+                           periodMs))
+            {
+                break;
+            }
+        }
+        bestSaved = (bestRepeats - 1) * bestLength;
+
+        // A first repetition slower than the others is left as it is and
+        // the search goes on from the events after its start
+        if (bestRepeats < 2 ||
+            bestSaved < std::max<size_t>(config.minSavedEvents, 1))
+        {
+            ++start;
+            continue;
+        }
+
+        segments.push_back({start, bestLength, bestRepeats, periodMs});
+        start += bestRepeats * bestLength;
+    }
+
+    spdlog::debug("RepeatedSegmentDetector: Found {} repeated segments in {} "
+                  "events",
+                  segments.size(),
+                  count);
+    return segments;
+}
+
+LoopedRecording RepeatedSegmentDetector::compress(
+    EventVector events, const LoopDetectionConfig& config)
+{
+    auto segments = findSegments(events, config);
+
+    // Keep the first repetition of each segment, indexing the kept events
+    LoopedRecording recording;
+    recording.events.reserve(events.size());
+    size_t next = 0;
+    for (auto& segment : segments)
+    {
+        uint64_t start = segment.start;
+        for (; next < start + segment.length; ++next)
+        {
+            recording.events.push_back(std::move(events[next]));
+        }
+        segment.start = recording.events.size() - segment.length;
+        next = start + segment.length * segment.repeatCount;
+    }
+    for (; next < events.size(); ++next)
+    {
+        recording.events.push_back(std::move(events[next]));
+    }
+    recording.index = SegmentIndex(std::move(segments));
+
+    spdlog::info("RepeatedSegmentDetector: Stored {} of {} events",
+                 recording.events.size(),
+                 events.size());
+    return recording;
+}
+
+} // namespace MouseRecorder::Core
@@ -0,0 +1,183 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "EventTypes.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MouseRecorder::Core
+{
+
+/**
+ * @brief Events that are repeated back to back
+ *
+ * Stands for repeatCount copies of the length events at start, each
+ * periodMs after the one before it.
+ */
+struct RepeatedSegment
+{
+    // Index of the first event of the segment
+    uint64_t start{0};
+    uint64_t length{0};
+    uint64_t repeatCount{0};
+
+    // Time from the start of one repetition to the start of the next
+    uint64_t periodMs{0};
+
+    bool operator==(const RepeatedSegment& other) const = default;
+};
+
+/**
+ * @brief Maps positions in a recording with its repeated segments expanded
+ * to the stored events
+ *
+ * Only the first repetition of each segment is stored. Playing the stored
+ * events through the index replays the recording without expanding it.
+ */
+class SegmentIndex
+{
+  public:
+    /**
+     * @brief Stored event at a position of the expanded recording
+     */
+    struct Location
+    {
+        uint64_t event{0};
+
+        // Time to add to the timestamp of the stored event
+        uint64_t offsetMs{0};
+    };
+
+    SegmentIndex() = default;
+
+    /**
+     * @param segments Segments indexing the stored events, see isValid()
+     */
+    explicit SegmentIndex(std::vector<RepeatedSegment> segments);
+
+    /**
+     * @brief Check whether segments can index storedCount events
+     *
+     * Segments must be in order, must not overlap, must repeat at least
+     * twice and must end before storedCount.
+     */
+    static bool isValid(const std::vector<RepeatedSegment>& segments,
+                        uint64_t storedCount) noexcept;
+
+    const std::vector<RepeatedSegment>& getSegments() const noexcept
+    {
+        return m_segments;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_segments.empty();
+    }
+
+    /**
+     * @brief Number of events once the segments are expanded
+     */
+    uint64_t getExpandedCount(uint64_t storedCount) const noexcept
+    {
+        return storedCount + m_addedEvents;
+    }
+
+    /**
+     * @brief Find the stored event played at a position
+     */
+    Location locate(uint64_t position) const noexcept;
+
+  private:
+    std::vector<RepeatedSegment> m_segments;
+
+    // Position of the first event of each segment once expanded
+    std::vector<uint64_t> m_expandedStarts;
+
+    // Events the repetitions add to the stored ones
+    uint64_t m_addedEvents{0};
+};
+
+/**
+ * @brief Recording with its repeated segments stored once
+ */
+struct LoopedRecording
+{
+    EventVector events;
+    SegmentIndex index;
+
+    /**
+     * @brief Number of events once expanded
+     */
+    uint64_t getExpandedCount() const noexcept
+    {
+        return index.getExpandedCount(events.size());
+    }
+
+    /**
+     * @brief Copies of the events with the segments expanded
+     */
+    EventVector expand() const;
+};
+
+/**
+ * @brief Configuration for finding repeated segments
+ */
+struct LoopDetectionConfig
+{
+    // Longest segment looked for; the search takes time proportional to
+    // it for each event
+    size_t maxSegmentLength{256};
+
+    // Largest difference between the delays of matching events of two
+    // repetitions
+    uint64_t timingToleranceMs{20};
+
+    // Events a segment must save to be worth a reference
+    size_t minSavedEvents{16};
+};
+
+/**
+ * @brief Finds events that are repeated back to back, as in recordings of
+ * repetitive tasks, and stores each repetition once
+ *
+ * Events match when they are equal apart from their timestamps and their
+ * delays to the events before them differ by at most the tolerance.
+ * Every event is hashed once; for each start position and segment length
+ * the hashes are compared with those one length further on, so the cost
+ * is proportional to the number of events times the longest segment.
+ * Segments are taken greedily from the front, each the one that saves
+ * the most events.
+ *
+ * Compressed recordings replay the timing of the first repetition of a
+ * segment for all of them, spaced by its average period. Repetitions are
+ * dropped from a segment until the first one fits in that period, so the
+ * expanded timestamps never go backwards.
+ */
+class RepeatedSegmentDetector
+{
+  public:
+    /**
+     * @brief Find the repeated segments of events
+     * @param events Events to search
+     * @param config Search configuration
+     * @return segments indexing events, in order
+     */
+    static std::vector<RepeatedSegment> findSegments(
+        const EventVector& events, const LoopDetectionConfig& config = {});
+
+    /**
+     * @brief Drop all but the first repetition of each repeated segment
+     * @param events Events to compress
+     * @param config Search configuration
+     * @return stored events and the segments indexing them
+     */
+    static LoopedRecording compress(EventVector events,
+                                    const LoopDetectionConfig& config = {});
+};
+
+} // namespace MouseRecorder::Core
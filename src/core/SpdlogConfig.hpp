@@ -11,8 +11,22 @@
  * This header provides a centralized way to include spdlog while suppressing
  * known warnings that occur on Windows due to Qt's uint typedef conflicting
  * with spdlog's bundled fmt library.
+ *
+ * It also sets the compile-time log level used by the SPDLOG_TRACE and
+ * SPDLOG_DEBUG macros. Per-event logging in capture and replay threads uses
+ * these macros, so release builds (NDEBUG) compile it out entirely, including
+ * argument evaluation. Define SPDLOG_ACTIVE_LEVEL before including this
+ * header (or on the compiler command line) to override.
  */
 
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
 // Suppress specific warnings on MSVC for spdlog/fmt conflicts
 #ifdef _MSC_VER
 #pragma warning(push)
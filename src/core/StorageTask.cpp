@@ -0,0 +1,289 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "StorageTask.hpp"
+#include "SpdlogConfig.hpp"
+#include "Tracing.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace MouseRecorder::Core
+{
+
+std::unique_ptr<StorageTask> IEventStorage::saveEventsAsync(
+    std::vector<std::unique_ptr<Event>> events,
+    const std::string& filename,
+    const StorageMetadata& metadata,
+    StorageTaskCallbacks callbacks)
+{
+    return StorageTask::startSave(
+        *this, std::move(events), filename, metadata, std::move(callbacks));
+}
+
+std::unique_ptr<StorageTask> IEventStorage::loadEventsAsync(
+    const std::string& filename, StorageTaskCallbacks callbacks)
+{
+    return StorageTask::startLoad(*this, filename, std::move(callbacks));
+}
+
+StorageTask::StorageTask(IEventStorage* storage,
+                         StorageTaskCallbacks callbacks)
+    : m_storage(storage), m_callbacks(std::move(callbacks))
+{
+}
+
+StorageTask::~StorageTask()
+{
+    cancel();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+std::unique_ptr<StorageTask> StorageTask::startSave(
+    IEventStorage& storage,
+    std::vector<std::unique_ptr<Event>> events,
+    const std::string& filename,
+    const StorageMetadata& metadata,
+    StorageTaskCallbacks callbacks)
+{
+    std::unique_ptr<StorageTask> task(
+        new StorageTask(&storage, std::move(callbacks)));
+    task->m_events = std::move(events);
+    task->m_metadata = metadata;
+
+    StorageTask* self = task.get();
+    task->start(
+        [self, filename](std::string& error)
+        {
+            if (self->m_callbacks.prepare)
+            {
+                MOUSERECORDER_TRACE_SCOPE("storage", "StorageTask::prepare");
+                self->m_callbacks.prepare(self->m_events, self->m_metadata);
+            }
+            if (self->isCancelled())
+            {
+                return false;
+            }
+            if (!self->m_storage->saveEvents(
+                    self->m_events, filename, self->m_metadata))
+            {
+                error = self->m_storage->getLastError();
+                return false;
+            }
+            return true;
+        });
+    return task;
+}
+
+std::unique_ptr<StorageTask> StorageTask::startLoad(
+    IEventStorage& storage,
+    const std::string& filename,
+    StorageTaskCallbacks callbacks)
+{
+    std::unique_ptr<StorageTask> task(
+        new StorageTask(&storage, std::move(callbacks)));
+
+    StorageTask* self = task.get();
+    task->start(
+        [self, filename](std::string& error)
+        {
+            if (!self->m_storage->loadEvents(
+                    filename, self->m_events, self->m_metadata))
+            {
+                error = self->m_storage->getLastError();
+                return false;
+            }
+
+            // Hand over whatever the storage did not stream itself
+            self->metadataLoaded(self->m_metadata);
+            if (!self->m_events.empty())
+            {
+                self->eventsLoaded(self->m_events);
+            }
+            return true;
+        });
+    return task;
+}
+
+std::unique_ptr<StorageTask> StorageTask::startLoad(
+    LoadFunction load, StorageTaskCallbacks callbacks)
+{
+    std::unique_ptr<StorageTask> task(
+        new StorageTask(nullptr, std::move(callbacks)));
+
+    StorageTask* self = task.get();
+    task->start(
+        [self, load = std::move(load)](std::string& error)
+        {
+            if (!load(self->m_events, self->m_metadata, error))
+            {
+                return false;
+            }
+
+            self->metadataLoaded(self->m_metadata);
+            if (!self->m_events.empty())
+            {
+                self->eventsLoaded(self->m_events);
+            }
+            return true;
+        });
+    return task;
+}
+
+void StorageTask::start(std::function<bool(std::string& error)> operation)
+{
+    m_thread = std::thread(
+        [this, operation = std::move(operation)]()
+        {
+            Tracer::instance().setThreadName("storage");
+
+            bool success = false;
+            std::string error;
+            if (m_storage)
+            {
+                m_storage->setProgress(this);
+            }
+            try
+            {
+                success = operation(error);
+                if (!success && isCancelled())
+                {
+                    error = CANCELLED_ERROR;
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+            if (m_storage)
+            {
+                m_storage->setProgress(nullptr);
+            }
+
+            if (!success)
+            {
+                spdlog::warn("StorageTask: Operation failed: {}", error);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_finished = true;
+                m_success = success;
+                m_error = std::move(error);
+            }
+            m_finishedCondition.notify_all();
+
+            if (m_callbacks.completion)
+            {
+                m_callbacks.completion(success);
+            }
+        });
+}
+
+void StorageTask::cancel() noexcept
+{
+    m_cancelled.store(true);
+}
+
+bool StorageTask::isFinished() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_finished;
+}
+
+bool StorageTask::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finishedCondition.wait(lock, [this]() { return m_finished; });
+    return m_success;
+}
+
+bool StorageTask::waitFor(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_finishedCondition.wait_for(
+        lock, timeout, [this]() { return m_finished; });
+}
+
+double StorageTask::getProgress() const noexcept
+{
+    std::uint64_t total = m_total.load();
+    if (total == 0)
+    {
+        return 0.0;
+    }
+    return static_cast<double>(std::min(m_done.load(), total)) / total;
+}
+
+bool StorageTask::succeeded() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_finished && m_success;
+}
+
+std::string StorageTask::getError() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_error;
+}
+
+std::vector<std::unique_ptr<Event>> StorageTask::takeEvents()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_finished)
+    {
+        return {};
+    }
+    return std::move(m_events);
+}
+
+StorageMetadata StorageTask::getMetadata() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_finished ? m_metadata : StorageMetadata{};
+}
+
+bool StorageTask::update(std::uint64_t done, std::uint64_t total)
+{
+    m_total.store(total);
+    m_done.store(done);
+    if (m_callbacks.progress)
+    {
+        m_callbacks.progress(done, total);
+    }
+    return !isCancelled();
+}
+
+void StorageTask::metadataLoaded(const StorageMetadata& metadata)
+{
+    if (m_metadataDelivered)
+    {
+        return;
+    }
+    m_metadataDelivered = true;
+    if (m_callbacks.metadata)
+    {
+        m_callbacks.metadata(metadata);
+    }
+}
+
+void StorageTask::eventsLoaded(std::vector<std::unique_ptr<Event>>& events)
+{
+    if (!m_callbacks.events)
+    {
+        return;
+    }
+
+    // Keep the capacity of events for the rest of the load
+    std::vector<std::unique_ptr<Event>> chunk(
+        std::make_move_iterator(events.begin()),
+        std::make_move_iterator(events.end()));
+    events.clear();
+    m_callbacks.events(std::move(chunk));
+}
+
+} // namespace MouseRecorder::Core
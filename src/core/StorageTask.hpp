@@ -0,0 +1,217 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "IEventStorage.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MouseRecorder::Core
+{
+
+/**
+ * @brief Receives progress from a running save or load
+ */
+class StorageProgress
+{
+  public:
+    /**
+     * @brief Error message of operations stopped through update()
+     */
+    static constexpr const char* CANCELLED_ERROR = "Operation cancelled";
+
+    virtual ~StorageProgress() = default;
+
+    /**
+     * @brief Report progress
+     * @param done Work units completed
+     * @param total Total work units
+     * @return false if the operation should stop
+     */
+    virtual bool update(std::uint64_t done, std::uint64_t total) = 0;
+
+    /**
+     * @brief Receive the metadata of a load as soon as it has been read
+     */
+    virtual void metadataLoaded(const StorageMetadata& metadata)
+    {
+        (void)metadata;
+    }
+
+    /**
+     * @brief Receive the events a load has decoded so far
+     *
+     * A sink that streams events moves them out of events; the storage
+     * keeps appending to the same vector.
+     */
+    virtual void eventsLoaded(std::vector<std::unique_ptr<Event>>& events)
+    {
+        (void)events;
+    }
+
+    /**
+     * @brief Report progress to an optional sink
+     * @return false if the operation should stop
+     */
+    static bool report(StorageProgress* progress,
+                       std::uint64_t done,
+                       std::uint64_t total)
+    {
+        return !progress || progress->update(done, total);
+    }
+};
+
+/**
+ * @brief Handle to a save or load running on a background thread
+ *
+ * Created by IEventStorage::saveEventsAsync() and loadEventsAsync().
+ * Cancellation is cooperative: the storage stops at its next progress
+ * report. Destroying the handle cancels the operation and waits for it.
+ */
+class StorageTask : public StorageProgress
+{
+  public:
+    /**
+     * @brief Reads a recording that no IEventStorage loads
+     *
+     * Returns false and sets error on failure.
+     */
+    using LoadFunction =
+        std::function<bool(std::vector<std::unique_ptr<Event>>& events,
+                           StorageMetadata& metadata,
+                           std::string& error)>;
+
+    /**
+     * @brief Start saving events
+     * @see IEventStorage::saveEventsAsync()
+     */
+    static std::unique_ptr<StorageTask> startSave(
+        IEventStorage& storage,
+        std::vector<std::unique_ptr<Event>> events,
+        const std::string& filename,
+        const StorageMetadata& metadata,
+        StorageTaskCallbacks callbacks);
+
+    /**
+     * @brief Start loading events
+     * @see IEventStorage::loadEventsAsync()
+     */
+    static std::unique_ptr<StorageTask> startLoad(
+        IEventStorage& storage,
+        const std::string& filename,
+        StorageTaskCallbacks callbacks);
+
+    /**
+     * @brief Start loading events with a function instead of a storage
+     *
+     * The function reports no progress, so it runs to its end even when
+     * the task is cancelled.
+     */
+    static std::unique_ptr<StorageTask> startLoad(
+        LoadFunction load, StorageTaskCallbacks callbacks);
+
+    ~StorageTask() override;
+
+    StorageTask(const StorageTask&) = delete;
+    StorageTask& operator=(const StorageTask&) = delete;
+
+    /**
+     * @brief Ask the operation to stop at its next progress report
+     */
+    void cancel() noexcept;
+
+    bool isCancelled() const noexcept
+    {
+        return m_cancelled.load();
+    }
+
+    bool isFinished() const;
+
+    /**
+     * @brief Wait until the operation has finished
+     * @return true if it succeeded
+     */
+    bool wait();
+
+    /**
+     * @brief Wait until the operation has finished or timeout expired
+     * @return true if it has finished
+     */
+    bool waitFor(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Get the fraction of work done so far, in [0, 1]
+     */
+    double getProgress() const noexcept;
+
+    /**
+     * @brief Check if the finished operation succeeded
+     */
+    bool succeeded() const;
+
+    /**
+     * @brief Get the error of a failed operation
+     */
+    std::string getError() const;
+
+    /**
+     * @brief Take the loaded events once a load has finished
+     *
+     * Empty if the events were streamed through StorageTaskCallbacks::events.
+     */
+    std::vector<std::unique_ptr<Event>> takeEvents();
+
+    /**
+     * @brief Get the loaded metadata once a load has finished
+     */
+    StorageMetadata getMetadata() const;
+
+    // StorageProgress interface
+    bool update(std::uint64_t done, std::uint64_t total) override;
+    void metadataLoaded(const StorageMetadata& metadata) override;
+    void eventsLoaded(std::vector<std::unique_ptr<Event>>& events) override;
+
+  private:
+    StorageTask(IEventStorage* storage, StorageTaskCallbacks callbacks);
+
+    /**
+     * @brief Run operation on the worker thread with progress reporting
+     *
+     * The operation sets its error when it fails.
+     */
+    void start(std::function<bool(std::string& error)> operation);
+
+  private:
+    // Null for loads done by a LoadFunction
+    IEventStorage* m_storage;
+    StorageTaskCallbacks m_callbacks;
+    std::thread m_thread;
+
+    std::atomic<bool> m_cancelled{false};
+    std::atomic<std::uint64_t> m_done{0};
+    std::atomic<std::uint64_t> m_total{0};
+    bool m_metadataDelivered{false};
+
+    // Owned by the worker until m_finished is set
+    std::vector<std::unique_ptr<Event>> m_events;
+    StorageMetadata m_metadata;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_finishedCondition;
+    bool m_finished{false};
+    bool m_success{false};
+    std::string m_error;
+};
+
+} // namespace MouseRecorder::Core
@@ -0,0 +1,314 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "Tracing.hpp"
+#include "SpdlogConfig.hpp"
+#include <cstdio>
+#include <fstream>
+
+namespace MouseRecorder::Core
+{
+
+namespace
+{
+
+void appendJsonString(std::string& out, const char* value)
+{
+    out += '"';
+    for (const char* c = value; c && *c; ++c)
+    {
+        switch (*c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        default:
+            if (static_cast<unsigned char>(*c) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                out += escaped;
+            }
+            else
+            {
+                out += *c;
+            }
+        }
+    }
+    out += '"';
+}
+
+// Trace-event timestamps are in microseconds
+void appendMicroseconds(std::string& out, uint64_t ns)
+{
+    char buffer[32];
+    std::snprintf(buffer,
+                  sizeof(buffer),
+                  "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out += buffer;
+}
+
+} // namespace
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() : m_epoch(std::chrono::steady_clock::now())
+{
+}
+
+void Tracer::setEnabled(bool enabled) noexcept
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const std::string& name)
+{
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    buffer.threadName = name;
+}
+
+uint64_t Tracer::nowNs() const noexcept
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_epoch)
+            .count());
+}
+
+void Tracer::recordSpan(const char* category,
+                        const char* name,
+                        uint64_t startNs,
+                        uint64_t endNs) noexcept
+{
+    ThreadBuffer* buffer = nullptr;
+    try
+    {
+        buffer = &threadBuffer();
+    }
+    catch (...)
+    {
+        // Out of memory for the ring buffer, drop the span
+        return;
+    }
+
+    // Single writer per buffer: fill the slot, then publish it via head
+    uint64_t index = buffer->head.load(std::memory_order_relaxed);
+    SpanRecord& record = buffer->records[index % EVENTS_PER_THREAD];
+    record.category.store(category, std::memory_order_relaxed);
+    record.name.store(name, std::memory_order_relaxed);
+    record.startNs.store(startNs, std::memory_order_relaxed);
+    record.endNs.store(endNs, std::memory_order_relaxed);
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::clear() noexcept
+{
+    m_clearedAtNs.store(nowNs(), std::memory_order_relaxed);
+    try
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        pruneRetiredBuffers(0);
+    }
+    catch (...)
+    {
+        // The spans are hidden anyway, their buffers go on the next prune
+    }
+}
+
+std::string Tracer::toChromeTraceJson() const
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::vector<std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        buffers = m_buffers;
+        for (const auto& buffer : buffers)
+        {
+            threadNames.push_back(buffer->threadName);
+        }
+    }
+
+    const uint64_t clearedAt = m_clearedAtNs.load(std::memory_order_relaxed);
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto beginEvent = [&]()
+    {
+        if (!first)
+        {
+            json += ",\n";
+        }
+        first = false;
+    };
+
+    for (size_t b = 0; b < buffers.size(); ++b)
+    {
+        const ThreadBuffer& buffer = *buffers[b];
+        const std::string tid = std::to_string(buffer.threadId);
+
+        if (!threadNames[b].empty())
+        {
+            beginEvent();
+            json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+            json += tid;
+            json += ",\"args\":{\"name\":";
+            appendJsonString(json, threadNames[b].c_str());
+            json += "}}";
+        }
+
+        // Spans being overwritten while we read may come out torn; that is
+        // acceptable for a diagnostics dump and keeps the writer lock-free
+        uint64_t head = buffer.head.load(std::memory_order_acquire);
+        uint64_t begin =
+            head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0;
+        for (uint64_t i = begin; i < head; ++i)
+        {
+            const SpanRecord& record = buffer.records[i % EVENTS_PER_THREAD];
+            const char* name = record.name.load(std::memory_order_relaxed);
+            uint64_t startNs = record.startNs.load(std::memory_order_relaxed);
+            uint64_t endNs = record.endNs.load(std::memory_order_relaxed);
+            if (!name || startNs < clearedAt || endNs < startNs)
+            {
+                continue;
+            }
+
+            beginEvent();
+            json += "{\"name\":";
+            appendJsonString(json, name);
+            json += ",\"cat\":";
+            appendJsonString(
+                json, record.category.load(std::memory_order_relaxed));
+            json += ",\"ph\":\"X\",\"ts\":";
+            appendMicroseconds(json, startNs);
+            json += ",\"dur\":";
+            appendMicroseconds(json, endNs - startNs);
+            json += ",\"pid\":1,\"tid\":";
+            json += tid;
+            json += "}";
+        }
+    }
+
+    json += "]}\n";
+    return json;
+}
+
+bool Tracer::writeChromeTrace(const std::string& filename)
+{
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        setLastError("Failed to open trace file for writing: " + filename);
+        return false;
+    }
+
+    file << toChromeTraceJson();
+    file.close();
+
+    if (file.fail())
+    {
+        setLastError("Failed to write trace file: " + filename);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        pruneRetiredBuffers(0);
+    }
+
+    spdlog::info("Tracer: Wrote trace to {}", filename);
+    return true;
+}
+
+std::string Tracer::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    return m_lastError;
+}
+
+size_t Tracer::getThreadBufferCount() const
+{
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    return m_buffers.size();
+}
+
+Tracer::ThreadBuffer& Tracer::threadBuffer()
+{
+    // Marks the buffer retired when the thread exits; the tracer keeps its
+    // own reference until the spans have been exported or cleared
+    struct Owner
+    {
+        std::shared_ptr<ThreadBuffer> buffer;
+
+        ~Owner()
+        {
+            if (buffer)
+            {
+                buffer->retired.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local Owner owner;
+    if (!owner.buffer)
+    {
+        auto newBuffer = std::make_shared<ThreadBuffer>();
+        newBuffer->records = std::make_unique<SpanRecord[]>(EVENTS_PER_THREAD);
+
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        pruneRetiredBuffers(MAX_RETIRED_BUFFERS);
+        newBuffer->threadId = m_nextThreadId++;
+        m_buffers.push_back(newBuffer);
+        owner.buffer = std::move(newBuffer);
+    }
+    return *owner.buffer;
+}
+
+void Tracer::pruneRetiredBuffers(size_t keep)
+{
+    size_t retired = 0;
+    for (const auto& buffer : m_buffers)
+    {
+        if (buffer->retired.load(std::memory_order_acquire))
+        {
+            ++retired;
+        }
+    }
+
+    // Buffers are in creation order, so the oldest retired ones go first
+    for (auto it = m_buffers.begin(); it != m_buffers.end() && retired > keep;)
+    {
+        if ((*it)->retired.load(std::memory_order_acquire))
+        {
+            it = m_buffers.erase(it);
+            --retired;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void Tracer::setLastError(const std::string& error)
+{
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    m_lastError = error;
+    spdlog::error("Tracer: {}", error);
+}
+
+} // namespace MouseRecorder::Core
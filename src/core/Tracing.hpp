@@ -0,0 +1,227 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace MouseRecorder::Core
+{
+
+/**
+ * @brief Low-overhead span tracer with Chrome trace-event export
+ *
+ * Each thread records completed spans into its own fixed-size ring buffer,
+ * so recording never takes a lock or allocates after the first span on a
+ * thread. When tracing is disabled a span costs one relaxed atomic load.
+ * The collected spans can be written as Chrome/Perfetto trace-event JSON
+ * (chrome://tracing, ui.perfetto.dev) at any time.
+ *
+ * Span names and categories must be string literals or otherwise outlive the
+ * tracer, since only the pointers are stored.
+ */
+class Tracer
+{
+  public:
+    /**
+     * @brief Number of spans kept per thread before the oldest are overwritten
+     */
+    static constexpr size_t EVENTS_PER_THREAD = 16384;
+
+    /**
+     * @brief Number of buffers of exited threads kept for export
+     *
+     * Buffers of exited threads are dropped by clear() and
+     * writeChromeTrace(), and the oldest beyond this number as new threads
+     * start recording.
+     */
+    static constexpr size_t MAX_RETIRED_BUFFERS = 16;
+
+    /**
+     * @brief Get the process-wide tracer
+     */
+    static Tracer& instance();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    /**
+     * @brief Enable or disable span recording
+     * @param enabled true to record spans
+     */
+    void setEnabled(bool enabled) noexcept;
+
+    /**
+     * @brief Check if span recording is enabled
+     */
+    bool isEnabled() const noexcept
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Name the calling thread in exported traces
+     * @param name Thread name, e.g. "capture" or "replay"
+     */
+    void setThreadName(const std::string& name);
+
+    /**
+     * @brief Get the tracer clock in nanoseconds
+     */
+    uint64_t nowNs() const noexcept;
+
+    /**
+     * @brief Record a completed span on the calling thread
+     * @param category Span category
+     * @param name Span name
+     * @param startNs Start time from nowNs()
+     * @param endNs End time from nowNs()
+     */
+    void recordSpan(const char* category,
+                    const char* name,
+                    uint64_t startNs,
+                    uint64_t endNs) noexcept;
+
+    /**
+     * @brief Drop all spans recorded so far
+     *
+     * Also frees the buffers of threads that have exited.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Build Chrome trace-event JSON from the recorded spans
+     * @return JSON document with a "traceEvents" array
+     */
+    std::string toChromeTraceJson() const;
+
+    /**
+     * @brief Write Chrome trace-event JSON to a file
+     *
+     * Spans of threads that have exited are dropped once written.
+     * @param filename Output file path
+     * @return true if the file was written
+     */
+    bool writeChromeTrace(const std::string& filename);
+
+    /**
+     * @brief Get the number of per-thread buffers currently allocated
+     */
+    size_t getThreadBufferCount() const;
+
+    /**
+     * @brief Get the last error message
+     * @return error message or empty string if no error
+     */
+    std::string getLastError() const;
+
+  private:
+    Tracer();
+
+    struct SpanRecord
+    {
+        std::atomic<const char*> category{nullptr};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> startNs{0};
+        std::atomic<uint64_t> endNs{0};
+    };
+
+    struct ThreadBuffer
+    {
+        uint32_t threadId{0};
+        std::string threadName; // Guarded by m_buffersMutex
+        std::unique_ptr<SpanRecord[]> records;
+        std::atomic<uint64_t> head{0};
+
+        // Set when the owning thread exits
+        std::atomic<bool> retired{false};
+    };
+
+    /**
+     * @brief Get or create the calling thread's ring buffer
+     */
+    ThreadBuffer& threadBuffer();
+
+    /**
+     * @brief Drop buffers of exited threads beyond keep, oldest first
+     *
+     * Requires m_buffersMutex.
+     */
+    void pruneRetiredBuffers(size_t keep);
+
+    void setLastError(const std::string& error);
+
+  private:
+    std::atomic<bool> m_enabled{false};
+    std::atomic<uint64_t> m_clearedAtNs{0};
+    const std::chrono::steady_clock::time_point m_epoch;
+
+    // Buffers stay alive after their thread exits so spans can be exported,
+    // until pruneRetiredBuffers() drops them
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+    mutable std::mutex m_buffersMutex;
+    uint32_t m_nextThreadId{1};
+
+    mutable std::mutex m_errorMutex;
+    std::string m_lastError;
+};
+
+/**
+ * @brief RAII span recorded from construction to destruction
+ */
+class TraceScope
+{
+  public:
+    TraceScope(const char* category, const char* name) noexcept
+        : m_category(category), m_name(name),
+          m_active(Tracer::instance().isEnabled())
+    {
+        if (m_active)
+        {
+            m_startNs = Tracer::instance().nowNs();
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_active)
+        {
+            auto& tracer = Tracer::instance();
+            tracer.recordSpan(m_category, m_name, m_startNs, tracer.nowNs());
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+  private:
+    const char* m_category;
+    const char* m_name;
+    bool m_active;
+    uint64_t m_startNs{0};
+};
+
+} // namespace MouseRecorder::Core
+
+#define MOUSERECORDER_TRACE_CONCAT_INNER(a, b) a##b
+#define MOUSERECORDER_TRACE_CONCAT(a, b) MOUSERECORDER_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Trace the enclosing scope, compiled out with
+ * MOUSERECORDER_DISABLE_TRACING
+ */
+#ifndef MOUSERECORDER_DISABLE_TRACING
+#define MOUSERECORDER_TRACE_SCOPE(category, name)                              \
+    ::MouseRecorder::Core::TraceScope MOUSERECORDER_TRACE_CONCAT(              \
+        traceScope_, __LINE__)(category, name)
+#else
+#define MOUSERECORDER_TRACE_SCOPE(category, name) ((void)0)
+#endif
@@ -308,6 +308,11 @@ json NlohmannJsonEventSerializer::metadataToJson(
     metadataJson["platform"] = metadata.platform;
     metadataJson["screen_resolution"] = metadata.screenResolution;
 
+    if (metadata.statistics)
+    {
+        metadataJson["statistics"] = statisticsToJson(*metadata.statistics);
+    }
+
     return metadataJson;
 }
 
@@ -336,10 +341,102 @@ StorageMetadata NlohmannJsonEventSerializer::jsonToMetadata(
     if (metadataJson.contains("screen_resolution"))
         metadata.screenResolution =
             metadataJson["screen_resolution"].get<std::string>();
+    if (metadataJson.contains("statistics") &&
+        metadataJson["statistics"].is_object())
+        metadata.statistics = jsonToStatistics(metadataJson["statistics"]);
 
     return metadata;
 }
 
+json NlohmannJsonEventSerializer::statisticsToJson(
+    const RecordingStatistics& statistics) const
+{
+    json statisticsJson;
+
+    // Counts are listed in EventType order
+    statisticsJson["event_counts"] = statistics.eventCounts;
+    statisticsJson["first_timestamp_ms"] = statistics.firstTimestampMs;
+    statisticsJson["last_timestamp_ms"] = statistics.lastTimestampMs;
+
+    if (statistics.hasPointerBounds)
+    {
+        statisticsJson["pointer_bounds"] = {
+            {"min_x", statistics.pointerMin.x},
+            {"min_y", statistics.pointerMin.y},
+            {"max_x", statistics.pointerMax.x},
+            {"max_y", statistics.pointerMax.y}};
+    }
+
+    statisticsJson["keys_used"] = statistics.keysUsed;
+    statisticsJson["activity_start_ms"] = statistics.activityStartMs;
+    statisticsJson["activity_bucket_ms"] = statistics.activityBucketMs;
+    statisticsJson["activity"] = statistics.activity;
+
+    return statisticsJson;
+}
+
+RecordingStatistics NlohmannJsonEventSerializer::jsonToStatistics(
+    const json& statisticsJson) const
+{
+    RecordingStatistics statistics;
+
+    if (statisticsJson.contains("event_counts"))
+    {
+        const json& eventCounts = statisticsJson["event_counts"];
+        for (size_t i = 0; i < eventCounts.size() &&
+                           i < statistics.eventCounts.size();
+             ++i)
+        {
+            statistics.eventCounts[i] = eventCounts[i].get<size_t>();
+        }
+    }
+    statistics.firstTimestampMs =
+        statisticsJson.value("first_timestamp_ms", uint64_t{0});
+    statistics.lastTimestampMs =
+        statisticsJson.value("last_timestamp_ms", uint64_t{0});
+
+    if (statisticsJson.contains("pointer_bounds"))
+    {
+        const json& bounds = statisticsJson["pointer_bounds"];
+        statistics.hasPointerBounds = true;
+        statistics.pointerMin = {bounds.value("min_x", 0),
+                                 bounds.value("min_y", 0)};
+        statistics.pointerMax = {bounds.value("max_x", 0),
+                                 bounds.value("max_y", 0)};
+    }
+
+    if (statisticsJson.contains("keys_used"))
+    {
+        for (const auto& key : statisticsJson["keys_used"])
+        {
+            statistics.keysUsed.insert(key.get<std::string>());
+        }
+    }
+
+    statistics.activityStartMs =
+        statisticsJson.value("activity_start_ms", uint64_t{0});
+    statistics.activityBucketMs =
+        statisticsJson.value("activity_bucket_ms",
+                             RecordingStatistics::MIN_ACTIVITY_BUCKET_MS);
+    if (statistics.activityBucketMs == 0)
+    {
+        statistics.activityBucketMs =
+            RecordingStatistics::MIN_ACTIVITY_BUCKET_MS;
+    }
+    if (statisticsJson.contains("activity"))
+    {
+        const json& activity = statisticsJson["activity"];
+        for (size_t i = 0;
+             i < activity.size() && i < statistics.activity.size();
+             ++i)
+        {
+            statistics.activity[i] = activity[i].get<uint64_t>();
+        }
+    }
+
+    return statistics;
+}
+
 json NlohmannJsonEventSerializer::mouseEventDataToJson(
     const MouseEventData& data) const
 {
@@ -83,6 +83,20 @@ class NlohmannJsonEventSerializer : public IEventSerializer
      */
     StorageMetadata jsonToMetadata(const json& json) const;
 
+    /**
+     * @brief Convert RecordingStatistics to JSON object
+     * @param statistics Statistics to convert
+     * @return JSON representation
+     */
+    json statisticsToJson(const RecordingStatistics& statistics) const;
+
+    /**
+     * @brief Convert JSON object to RecordingStatistics
+     * @param json JSON object to convert
+     * @return RecordingStatistics
+     */
+    RecordingStatistics jsonToStatistics(const json& json) const;
+
     /**
      * @brief Convert MouseEventData to JSON
      * @param data Mouse event data
@@ -452,6 +452,12 @@ void PugixmlEventSerializer::metadataToXml(const StorageMetadata& metadata,
     parent.append_attribute("platform") = metadata.platform.c_str();
     parent.append_attribute("screen_resolution") =
         metadata.screenResolution.c_str();
+
+    if (metadata.statistics)
+    {
+        auto statisticsNode = parent.append_child("Statistics");
+        statisticsToXml(*metadata.statistics, statisticsNode);
+    }
 }
 
 StorageMetadata PugixmlEventSerializer::xmlToMetadata(
@@ -470,9 +476,107 @@ StorageMetadata PugixmlEventSerializer::xmlToMetadata(
     metadata.platform = node.attribute("platform").as_string();
     metadata.screenResolution = node.attribute("screen_resolution").as_string();
 
+    if (auto statisticsNode = node.child("Statistics"))
+    {
+        metadata.statistics = xmlToStatistics(statisticsNode);
+    }
+
     return metadata;
 }
 
+void PugixmlEventSerializer::statisticsToXml(
+    const RecordingStatistics& statistics, pugi::xml_node& parent) const
+{
+    // Counts are listed in EventType order
+    std::ostringstream eventCounts;
+    for (size_t i = 0; i < statistics.eventCounts.size(); ++i)
+    {
+        eventCounts << (i > 0 ? " " : "") << statistics.eventCounts[i];
+    }
+    parent.append_attribute("event_counts") = eventCounts.str().c_str();
+    parent.append_attribute("first_timestamp_ms") =
+        statistics.firstTimestampMs;
+    parent.append_attribute("last_timestamp_ms") = statistics.lastTimestampMs;
+    parent.append_attribute("activity_start_ms") = statistics.activityStartMs;
+    parent.append_attribute("activity_bucket_ms") =
+        statistics.activityBucketMs;
+
+    std::ostringstream activity;
+    for (size_t i = 0; i < statistics.activity.size(); ++i)
+    {
+        activity << (i > 0 ? " " : "") << statistics.activity[i];
+    }
+    parent.append_attribute("activity") = activity.str().c_str();
+
+    if (statistics.hasPointerBounds)
+    {
+        auto pointerMin = parent.append_child("PointerMin");
+        pointerMin.append_attribute("x") = statistics.pointerMin.x;
+        pointerMin.append_attribute("y") = statistics.pointerMin.y;
+        auto pointerMax = parent.append_child("PointerMax");
+        pointerMax.append_attribute("x") = statistics.pointerMax.x;
+        pointerMax.append_attribute("y") = statistics.pointerMax.y;
+    }
+
+    for (const auto& key : statistics.keysUsed)
+    {
+        parent.append_child("Key").append_attribute("name") = key.c_str();
+    }
+}
+
+RecordingStatistics PugixmlEventSerializer::xmlToStatistics(
+    const pugi::xml_node& node) const
+{
+    RecordingStatistics statistics;
+
+    std::istringstream eventCounts(node.attribute("event_counts").as_string());
+    for (size_t& count : statistics.eventCounts)
+    {
+        if (!(eventCounts >> count))
+        {
+            count = 0;
+            break;
+        }
+    }
+    statistics.firstTimestampMs =
+        node.attribute("first_timestamp_ms").as_ullong();
+    statistics.lastTimestampMs =
+        node.attribute("last_timestamp_ms").as_ullong();
+    statistics.activityStartMs =
+        node.attribute("activity_start_ms").as_ullong();
+    statistics.activityBucketMs =
+        node.attribute("activity_bucket_ms")
+            .as_ullong(RecordingStatistics::MIN_ACTIVITY_BUCKET_MS);
+
+    std::istringstream activity(node.attribute("activity").as_string());
+    for (uint64_t& count : statistics.activity)
+    {
+        if (!(activity >> count))
+        {
+            count = 0;
+            break;
+        }
+    }
+
+    auto pointerMin = node.child("PointerMin");
+    auto pointerMax = node.child("PointerMax");
+    if (pointerMin && pointerMax)
+    {
+        statistics.hasPointerBounds = true;
+        statistics.pointerMin = {pointerMin.attribute("x").as_int(),
+                                 pointerMin.attribute("y").as_int()};
+        statistics.pointerMax = {pointerMax.attribute("x").as_int(),
+                                 pointerMax.attribute("y").as_int()};
+    }
+
+    for (auto key : node.children("Key"))
+    {
+        statistics.keysUsed.insert(key.attribute("name").as_string());
+    }
+
+    return statistics;
+}
+
 const char* PugixmlEventSerializer::mouseButtonToString(
     MouseButton button) const
 {
@@ -82,6 +82,21 @@ class PugixmlEventSerializer : public IEventSerializer
      */
     StorageMetadata xmlToMetadata(const pugi::xml_node& node) const;
 
+    /**
+     * @brief Convert RecordingStatistics to XML node
+     * @param statistics Statistics to convert
+     * @param parent Parent XML node
+     */
+    void statisticsToXml(const RecordingStatistics& statistics,
+                         pugi::xml_node& parent) const;
+
+    /**
+     * @brief Convert XML node to RecordingStatistics
+     * @param node XML node to convert
+     * @return RecordingStatistics
+     */
+    RecordingStatistics xmlToStatistics(const pugi::xml_node& node) const;
+
     /**
      * @brief Convert mouse button enum to string
      * @param button Mouse button enum
@@ -309,6 +309,11 @@ QJsonObject QtJsonEventSerializer::metadataToJson(
     metadataJson["screen_resolution"] =
         QString::fromStdString(metadata.screenResolution);
 
+    if (metadata.statistics)
+    {
+        metadataJson["statistics"] = statisticsToJson(*metadata.statistics);
+    }
+
     return metadataJson;
 }
 
@@ -331,9 +336,114 @@ StorageMetadata QtJsonEventSerializer::jsonToMetadata(
     metadata.screenResolution =
         json["screen_resolution"].toString().toStdString();
 
+    if (json["statistics"].isObject())
+    {
+        metadata.statistics = jsonToStatistics(json["statistics"].toObject());
+    }
+
     return metadata;
 }
 
+QJsonObject QtJsonEventSerializer::statisticsToJson(
+    const RecordingStatistics& statistics) const
+{
+    QJsonObject statisticsJson;
+
+    // Counts are listed in EventType order
+    QJsonArray eventCounts;
+    for (size_t count : statistics.eventCounts)
+    {
+        eventCounts.append(static_cast<qint64>(count));
+    }
+    statisticsJson["event_counts"] = eventCounts;
+    statisticsJson["first_timestamp_ms"] =
+        static_cast<qint64>(statistics.firstTimestampMs);
+    statisticsJson["last_timestamp_ms"] =
+        static_cast<qint64>(statistics.lastTimestampMs);
+
+    if (statistics.hasPointerBounds)
+    {
+        QJsonObject bounds;
+        bounds["min_x"] = statistics.pointerMin.x;
+        bounds["min_y"] = statistics.pointerMin.y;
+        bounds["max_x"] = statistics.pointerMax.x;
+        bounds["max_y"] = statistics.pointerMax.y;
+        statisticsJson["pointer_bounds"] = bounds;
+    }
+
+    QJsonArray keysUsed;
+    for (const auto& key : statistics.keysUsed)
+    {
+        keysUsed.append(QString::fromStdString(key));
+    }
+    statisticsJson["keys_used"] = keysUsed;
+
+    QJsonArray activity;
+    for (uint64_t count : statistics.activity)
+    {
+        activity.append(static_cast<qint64>(count));
+    }
+    statisticsJson["activity_start_ms"] =
+        static_cast<qint64>(statistics.activityStartMs);
+    statisticsJson["activity_bucket_ms"] =
+        static_cast<qint64>(statistics.activityBucketMs);
+    statisticsJson["activity"] = activity;
+
+    return statisticsJson;
+}
+
+RecordingStatistics QtJsonEventSerializer::jsonToStatistics(
+    const QJsonObject& json) const
+{
+    RecordingStatistics statistics;
+
+    const QJsonArray eventCounts = json["event_counts"].toArray();
+    for (int i = 0; i < eventCounts.size() &&
+                    i < static_cast<int>(statistics.eventCounts.size());
+         ++i)
+    {
+        statistics.eventCounts[i] = eventCounts[i].toVariant().toULongLong();
+    }
+    statistics.firstTimestampMs =
+        json["first_timestamp_ms"].toVariant().toULongLong();
+    statistics.lastTimestampMs =
+        json["last_timestamp_ms"].toVariant().toULongLong();
+
+    if (json["pointer_bounds"].isObject())
+    {
+        const QJsonObject bounds = json["pointer_bounds"].toObject();
+        statistics.hasPointerBounds = true;
+        statistics.pointerMin = {bounds["min_x"].toInt(),
+                                 bounds["min_y"].toInt()};
+        statistics.pointerMax = {bounds["max_x"].toInt(),
+                                 bounds["max_y"].toInt()};
+    }
+
+    for (const QJsonValue& key : json["keys_used"].toArray())
+    {
+        statistics.keysUsed.insert(key.toString().toStdString());
+    }
+
+    statistics.activityStartMs =
+        json["activity_start_ms"].toVariant().toULongLong();
+    statistics.activityBucketMs =
+        json["activity_bucket_ms"].toVariant().toULongLong();
+    if (statistics.activityBucketMs == 0)
+    {
+        statistics.activityBucketMs =
+            RecordingStatistics::MIN_ACTIVITY_BUCKET_MS;
+    }
+    const QJsonArray activity = json["activity"].toArray();
+    for (int i = 0; i < activity.size() &&
+                    i < static_cast<int>(statistics.activity.size());
+         ++i)
+    {
+        statistics.activity[i] = activity[i].toVariant().toULongLong();
+    }
+
+    return statistics;
+}
+
 QString QtJsonEventSerializer::eventTypeToString(EventType type) const
 {
     switch (type)
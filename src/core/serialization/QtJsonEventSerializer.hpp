@@ -82,6 +82,20 @@ class QtJsonEventSerializer : public IEventSerializer
      */
     StorageMetadata jsonToMetadata(const QJsonObject& json) const;
 
+    /**
+     * @brief Convert RecordingStatistics to QJsonObject
+     * @param statistics Statistics to convert
+     * @return QJsonObject representation
+     */
+    QJsonObject statisticsToJson(const RecordingStatistics& statistics) const;
+
+    /**
+     * @brief Convert QJsonObject to RecordingStatistics
+     * @param json QJsonObject to convert
+     * @return RecordingStatistics
+     */
+    RecordingStatistics jsonToStatistics(const QJsonObject& json) const;
+
     /**
      * @brief Convert EventType enum to string
      * @param type EventType enum value
@@ -354,6 +354,12 @@ QDomElement QtXmlEventSerializer::metadataToXml(
                     "screen_resolution",
                     QString::fromStdString(metadata.screenResolution));
 
+    if (metadata.statistics)
+    {
+        metadataElement.appendChild(
+            statisticsToXml(doc, *metadata.statistics));
+    }
+
     return metadataElement;
 }
 
@@ -376,9 +382,118 @@ StorageMetadata QtXmlEventSerializer::xmlToMetadata(
     metadata.screenResolution =
         element.attribute("screen_resolution").toStdString();
 
+    QDomElement statisticsElement = element.firstChildElement("statistics");
+    if (!statisticsElement.isNull())
+    {
+        metadata.statistics = xmlToStatistics(statisticsElement);
+    }
+
     return metadata;
 }
 
+QDomElement QtXmlEventSerializer::statisticsToXml(
+    QDomDocument& doc, const RecordingStatistics& statistics) const
+{
+    QDomElement statisticsElement = doc.createElement("statistics");
+
+    // Counts are listed in EventType order
+    QStringList eventCounts;
+    for (size_t count : statistics.eventCounts)
+    {
+        eventCounts << QString::number(count);
+    }
+    setXmlAttribute(statisticsElement, "event_counts", eventCounts.join(' '));
+    setXmlAttribute(statisticsElement,
+                    "first_timestamp_ms",
+                    static_cast<qint64>(statistics.firstTimestampMs));
+    setXmlAttribute(statisticsElement,
+                    "last_timestamp_ms",
+                    static_cast<qint64>(statistics.lastTimestampMs));
+    setXmlAttribute(statisticsElement,
+                    "activity_start_ms",
+                    static_cast<qint64>(statistics.activityStartMs));
+    setXmlAttribute(statisticsElement,
+                    "activity_bucket_ms",
+                    static_cast<qint64>(statistics.activityBucketMs));
+
+    QStringList activity;
+    for (uint64_t count : statistics.activity)
+    {
+        activity << QString::number(count);
+    }
+    setXmlAttribute(statisticsElement, "activity", activity.join(' '));
+
+    if (statistics.hasPointerBounds)
+    {
+        statisticsElement.appendChild(
+            pointToXml(doc, statistics.pointerMin, "pointer_min"));
+        statisticsElement.appendChild(
+            pointToXml(doc, statistics.pointerMax, "pointer_max"));
+    }
+
+    for (const auto& key : statistics.keysUsed)
+    {
+        QDomElement keyElement = doc.createElement("key");
+        setXmlAttribute(keyElement, "name", QString::fromStdString(key));
+        statisticsElement.appendChild(keyElement);
+    }
+
+    return statisticsElement;
+}
+
+RecordingStatistics QtXmlEventSerializer::xmlToStatistics(
+    const QDomElement& element) const
+{
+    RecordingStatistics statistics;
+
+    const QStringList eventCounts =
+        element.attribute("event_counts").split(' ', Qt::SkipEmptyParts);
+    for (int i = 0; i < eventCounts.size() &&
+                    i < static_cast<int>(statistics.eventCounts.size());
+         ++i)
+    {
+        statistics.eventCounts[i] = eventCounts[i].toULongLong();
+    }
+    statistics.firstTimestampMs =
+        getXmlAttribute<qint64>(element, "first_timestamp_ms", 0);
+    statistics.lastTimestampMs =
+        getXmlAttribute<qint64>(element, "last_timestamp_ms", 0);
+    statistics.activityStartMs =
+        getXmlAttribute<qint64>(element, "activity_start_ms", 0);
+    statistics.activityBucketMs = getXmlAttribute<qint64>(
+        element,
+        "activity_bucket_ms",
+        RecordingStatistics::MIN_ACTIVITY_BUCKET_MS);
+
+    const QStringList activity =
+        element.attribute("activity").split(' ', Qt::SkipEmptyParts);
+    for (int i = 0; i < activity.size() &&
+                    i < static_cast<int>(statistics.activity.size());
+         ++i)
+    {
+        statistics.activity[i] = activity[i].toULongLong();
+    }
+
+    QDomElement pointerMin = element.firstChildElement("pointer_min");
+    QDomElement pointerMax = element.firstChildElement("pointer_max");
+    if (!pointerMin.isNull() && !pointerMax.isNull())
+    {
+        statistics.hasPointerBounds = true;
+        statistics.pointerMin = xmlToPoint(pointerMin);
+        statistics.pointerMax = xmlToPoint(pointerMax);
+    }
+
+    for (QDomElement keyElement = element.firstChildElement("key");
+         !keyElement.isNull();
+         keyElement = keyElement.nextSiblingElement("key"))
+    {
+        statistics.keysUsed.insert(
+            keyElement.attribute("name").toStdString());
+    }
+
+    return statistics;
+}
+
 QString QtXmlEventSerializer::eventTypeToString(EventType type) const
 {
     switch (type)
@@ -84,6 +84,22 @@ class QtXmlEventSerializer : public IEventSerializer
      */
     StorageMetadata xmlToMetadata(const QDomElement& element) const;
 
+    /**
+     * @brief Convert RecordingStatistics to QDomElement
+     * @param doc Parent document (for creating elements)
+     * @param statistics Statistics to convert
+     * @return QDomElement representation
+     */
+    QDomElement statisticsToXml(QDomDocument& doc,
+                                const RecordingStatistics& statistics) const;
+
+    /**
+     * @brief Convert QDomElement to RecordingStatistics
+     * @param element QDomElement to convert
+     * @return RecordingStatistics
+     */
+    RecordingStatistics xmlToStatistics(const QDomElement& element) const;
+
     /**
      * @brief Convert EventType enum to string
      * @param type EventType enum value
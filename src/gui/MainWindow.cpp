@@ -8,10 +8,15 @@
 #include "RecordingWidget.hpp"
 #include "PlaybackWidget.hpp"
 #include "ConfigurationWidget.hpp"
+#include "PerformancePanel.hpp"
+#include "StorageTaskRunner.hpp"
 #include "../core/QtConfiguration.hpp"
 #include "../core/IEventStorage.hpp"
+#include "../core/StorageTask.hpp"
 #include "../core/MouseMovementOptimizer.hpp"
+#include "../core/Tracing.hpp"
 #include "../storage/EventStorageFactory.hpp"
+#include "../storage/RecordingJournal.hpp"
 #include "TestUtils.hpp"
 #include <QApplication>
 #include <QMessageBox>
@@ -33,16 +38,17 @@
 #include <QVBoxLayout>
 #include <QDialogButtonBox>
 #include <QDateTime>
+#include <QDockWidget>
+#include <QStandardPaths>
 #include <QSysInfo>
 #include <QScreen>
 #include <QGuiApplication>
 #include "core/SpdlogConfig.hpp"
+#include <algorithm>
 #include <filesystem>
 
 #ifdef __linux__
-#include <X11/Xlib.h>
-#include <X11/keysym.h>
-#include <X11/extensions/XTest.h>
+#include "platform/linux/LinuxGlobalShortcutListener.hpp"
 #endif
 
 namespace MouseRecorder::GUI
@@ -72,16 +78,28 @@ MainWindow::MainWindow(Application::MouseRecorderApp& app, QWidget* parent)
     updateUI();
     updateWindowTitle();
 
+    if (!TestUtils::isTestEnvironment())
+    {
+        QTimer::singleShot(0, this, &MainWindow::offerAutosaveRecovery);
+    }
+
     spdlog::info("MainWindow: Initialized");
 }
 
 MainWindow::~MainWindow()
 {
     // Stop global shortcut monitoring
-    if (m_globalShortcutTimer)
+#ifdef __linux__
+    if (m_shortcutConfigCallbackId)
+    {
+        m_app.getConfiguration().unregisterChangeCallback(
+            *m_shortcutConfigCallbackId);
+    }
+    if (m_globalShortcutListener)
     {
-        m_globalShortcutTimer->stop();
+        m_globalShortcutListener->stop();
     }
+#endif
 
     delete ui;
     spdlog::info("MainWindow: Destroyed");
@@ -91,6 +109,8 @@ void MainWindow::closeEvent(QCloseEvent* event)
 {
     spdlog::info("MainWindow: closeEvent triggered");
 
+    // Keep the journal only if the user chose to save and the save failed
+    bool keepAutosave = false;
     if (m_modified)
     {
         // In test environment, automatically discard changes to avoid hanging
@@ -111,6 +131,7 @@ void MainWindow::closeEvent(QCloseEvent* event)
             if (reply == QMessageBox::Save)
             {
                 onSaveFile();
+                keepAutosave = m_modified;
             }
             else if (reply == QMessageBox::Cancel)
             {
@@ -129,6 +150,11 @@ void MainWindow::closeEvent(QCloseEvent* event)
             spdlog::info("MainWindow: Stopping active recording before close");
             m_app.getEventRecorder().stopRecording();
         }
+        stopAutosave();
+        if (!keepAutosave)
+        {
+            discardAutosave();
+        }
 
         if (m_app.getEventPlayer().getState() != Core::PlaybackState::Stopped)
         {
@@ -171,6 +197,26 @@ void MainWindow::setupWidgets()
     ui->recordingLayout->addWidget(m_recordingWidget);
     ui->playbackLayout->addWidget(m_playbackWidget);
 
+    // Diagnostics panel, hidden until opened from the View menu
+    m_performancePanel = new PerformancePanel(this);
+    m_performancePanel->setRecordingMemoryProvider(
+        [this]()
+        {
+            // Approximation: event objects plus the pointer array, key names
+            // usually fit in the small string buffer
+            std::lock_guard<std::mutex> lock(m_eventsMutex);
+            return m_recordedEvents->capacity() *
+                       sizeof(std::unique_ptr<Core::Event>) +
+                   m_recordedEvents->size() * sizeof(Core::Event);
+        });
+
+    m_performanceDock = new QDockWidget("Performance", this);
+    m_performanceDock->setObjectName("performanceDock");
+    m_performanceDock->setWidget(m_performancePanel);
+    addDockWidget(Qt::RightDockWidgetArea, m_performanceDock);
+    m_performanceDock->hide();
+    ui->menuView->addAction(m_performanceDock->toggleViewAction());
+
     // Connect recording widget signals to actual recording functionality
     connect(m_recordingWidget,
             &RecordingWidget::recordingStarted,
@@ -230,6 +276,16 @@ void MainWindow::setupActions()
     connect(ui->actionAbout, &QAction::triggered, this, &MainWindow::onAbout);
     connect(
         ui->actionAboutQt, &QAction::triggered, this, &MainWindow::onAboutQt);
+    connect(ui->actionRecordTrace,
+            &QAction::toggled,
+            this,
+            &MainWindow::onRecordTraceToggled);
+    connect(ui->actionSaveTrace,
+            &QAction::triggered,
+            this,
+            &MainWindow::onSaveTrace);
+    ui->actionRecordTrace->setChecked(Core::Tracer::instance().isEnabled());
+    Core::Tracer::instance().setThreadName("gui");
 
     // Recording actions
     connect(ui->actionStartRecording,
@@ -301,104 +357,127 @@ void MainWindow::setupKeyboardShortcuts()
     spdlog::info("MainWindow: Global keyboard shortcuts initialized");
 }
 
-void MainWindow::setupGlobalShortcuts()
+namespace
 {
-    // Set up global shortcut monitoring timer
-    m_globalShortcutTimer = new QTimer(this);
-    connect(m_globalShortcutTimer,
-            &QTimer::timeout,
-            this,
-            &MainWindow::checkGlobalShortcuts);
-    m_globalShortcutTimer->start(
-        50); // Check every 50ms for responsive shortcuts
-
-    spdlog::info("MainWindow: Global shortcut monitoring started");
-}
+enum GlobalShortcutId
+{
+    StartRecordingShortcut,
+    StopRecordingShortcut
+};
+} // namespace
 
-void MainWindow::checkGlobalShortcuts()
+void MainWindow::setupGlobalShortcuts()
 {
 #ifdef __linux__
-    // Check for Ctrl+R (Start Recording) - XK_Control_L + XK_r
-    bool ctrlPressed = isKeyPressed(XK_Control_L) || isKeyPressed(XK_Control_R);
-    bool rPressed = isKeyPressed(XK_r);
-    bool shiftPressed = isKeyPressed(XK_Shift_L) || isKeyPressed(XK_Shift_R);
+    m_globalShortcutListener =
+        std::make_unique<Platform::Linux::LinuxGlobalShortcutListener>();
+    registerGlobalShortcuts();
 
-    // Ctrl+R (start recording)
-    if (ctrlPressed && rPressed && !shiftPressed)
-    {
-        if (!m_startRecordingKeyPressed)
+    // Activations arrive on the listener thread; hand them to the GUI thread
+    bool started = m_globalShortcutListener->start(
+        [this](int shortcutId)
         {
-            m_startRecordingKeyPressed = true;
+            QMetaObject::invokeMethod(
+                this,
+                [this, shortcutId]()
+                {
+                    onGlobalShortcutActivated(shortcutId);
+                },
+                Qt::QueuedConnection);
+        });
 
-            // Only start if not already recording and not playing back
-            if (!m_app.getEventRecorder().isRecording() &&
-                m_app.getEventPlayer().getState() !=
-                    Core::PlaybackState::Playing)
-            {
-                QTimer::singleShot(0, this, &MainWindow::onStartRecording);
-                spdlog::info(
-                    "MainWindow: Global shortcut triggered - Start Recording");
-            }
-        }
-    }
-    else
+    if (!started)
     {
-        m_startRecordingKeyPressed = false;
+        spdlog::warn("MainWindow: Global shortcuts unavailable: {}",
+                     m_globalShortcutListener->getLastError());
+        m_globalShortcutListener.reset();
+        return;
     }
 
-    // Ctrl+Shift+R (stop recording)
-    if (ctrlPressed && rPressed && shiftPressed)
-    {
-        if (!m_stopRecordingKeyPressed)
-        {
-            m_stopRecordingKeyPressed = true;
-
-            // Only stop if currently recording
-            if (m_app.getEventRecorder().isRecording())
+    // Follow shortcuts changed in the settings. Re-registering is posted so
+    // it happens on the GUI thread even for changes flushed elsewhere
+    m_shortcutConfigCallbackId =
+        m_app.getConfiguration().registerBatchChangeCallback(
+            [this](const std::vector<Core::ConfigChange>& changes)
             {
-                QTimer::singleShot(0, this, &MainWindow::onStopRecording);
-                spdlog::info(
-                    "MainWindow: Global shortcut triggered - Stop Recording");
-
-                // Also restore window if minimized to tray
-                if (!isVisible())
+                bool changed = std::any_of(
+                    changes.begin(),
+                    changes.end(),
+                    [](const Core::ConfigChange& change)
+                    {
+                        return change.key ==
+                                   Core::ConfigKeys::SHORTCUT_START_RECORDING ||
+                               change.key ==
+                                   Core::ConfigKeys::SHORTCUT_STOP_RECORDING ||
+                               change.key == "*";
+                    });
+                if (changed)
                 {
-                    QTimer::singleShot(100, this, &MainWindow::restoreFromTray);
+                    QMetaObject::invokeMethod(
+                        this,
+                        [this]() { registerGlobalShortcuts(); },
+                        Qt::QueuedConnection);
                 }
-            }
-        }
-    }
-    else
-    {
-        m_stopRecordingKeyPressed = false;
-    }
+            });
+
+    spdlog::info("MainWindow: Global shortcut monitoring started");
 #endif
 }
 
-bool MainWindow::isKeyPressed(int keyCode)
-{
 #ifdef __linux__
-    Display* display = XOpenDisplay(nullptr);
-    if (!display)
-        return false;
-
-    KeyCode kc = XKeysymToKeycode(display, keyCode);
-    if (kc == NoSymbol)
+void MainWindow::registerGlobalShortcuts()
+{
+    if (!m_globalShortcutListener)
     {
-        XCloseDisplay(display);
-        return false;
+        return;
     }
 
-    char keys[32];
-    XQueryKeymap(display, keys);
-    bool pressed = (keys[kc / 8] & (1 << (kc % 8))) != 0;
-
-    XCloseDisplay(display);
-    return pressed;
-#else
-    (void) keyCode; // Suppress unused parameter warning on non-Linux platforms
-    return false;
+    // Registering an id again replaces its sequence
+    const auto& config = m_app.getConfiguration();
+    m_globalShortcutListener->registerShortcut(
+        StartRecordingShortcut,
+        config.getString(Core::ConfigKeys::SHORTCUT_START_RECORDING, "Ctrl+R"));
+    m_globalShortcutListener->registerShortcut(
+        StopRecordingShortcut,
+        config.getString(Core::ConfigKeys::SHORTCUT_STOP_RECORDING,
+                         "Ctrl+Shift+R"));
+}
 #endif
+
+void MainWindow::onGlobalShortcutActivated(int shortcutId)
+{
+    switch (shortcutId)
+    {
+    case StartRecordingShortcut:
+        // Only start if not already recording and not playing back
+        if (!m_app.getEventRecorder().isRecording() &&
+            m_app.getEventPlayer().getState() != Core::PlaybackState::Playing)
+        {
+            spdlog::info(
+                "MainWindow: Global shortcut triggered - Start Recording");
+            onStartRecording();
+        }
+        break;
+
+    case StopRecordingShortcut:
+        // Only stop if currently recording
+        if (m_app.getEventRecorder().isRecording())
+        {
+            spdlog::info(
+                "MainWindow: Global shortcut triggered - Stop Recording");
+            onStopRecording();
+
+            // Also restore window if minimized to tray
+            if (!isVisible())
+            {
+                QTimer::singleShot(100, this, &MainWindow::restoreFromTray);
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
 }
 
 void MainWindow::setupStatusBar()
@@ -489,9 +568,12 @@ void MainWindow::onNewFile()
         }
     }
 
+    discardAutosave();
+
     // Clear current recording/playback
     std::lock_guard<std::mutex> lock(m_eventsMutex);
     m_recordedEvents->clear();
+    resetRecordingStatistics();
 
     if (m_recordingWidget)
     {
@@ -611,6 +693,43 @@ void MainWindow::onAboutQt()
     QMessageBox::aboutQt(this);
 }
 
+void MainWindow::onRecordTraceToggled(bool enabled)
+{
+    auto& tracer = Core::Tracer::instance();
+    if (enabled && !tracer.isEnabled())
+    {
+        // Start a fresh trace rather than appending to an old one
+        tracer.clear();
+    }
+    tracer.setEnabled(enabled);
+
+    ui->statusLabel->setText(enabled ? "Performance trace recording"
+                                     : "Performance trace stopped");
+}
+
+void MainWindow::onSaveTrace()
+{
+    QString filename = QFileDialog::getSaveFileName(
+        this,
+        "Save Performance Trace",
+        QDir::homePath() + "/mouserecorder_trace.json",
+        "Chrome Trace Files (*.json);;All Files (*)");
+    if (filename.isEmpty())
+    {
+        return;
+    }
+
+    auto& tracer = Core::Tracer::instance();
+    if (!tracer.writeChromeTrace(filename.toStdString()))
+    {
+        showErrorMessage("Save Performance Trace",
+                         QString::fromStdString(tracer.getLastError()));
+        return;
+    }
+
+    ui->statusLabel->setText("Performance trace saved: " + filename);
+}
+
 void MainWindow::onRecentFiles()
 {
     // This slot is called when the "Recent Files" menu item is clicked
@@ -652,8 +771,11 @@ void MainWindow::onClear()
 
     if (shouldClear)
     {
+        discardAutosave();
+
         std::lock_guard<std::mutex> lock(m_eventsMutex);
         m_recordedEvents->clear();
+        resetRecordingStatistics();
 
         if (m_recordingWidget)
         {
@@ -748,6 +870,7 @@ void MainWindow::onStartRecording()
     // Create event callback that stores events
     auto eventCallback = [this](std::unique_ptr<Core::Event> event)
     {
+        MOUSERECORDER_TRACE_SCOPE("gui", "recordCallback");
         {
             std::lock_guard<std::mutex> lock(m_eventsMutex);
             // Add event to the UI display (before moving to storage)
@@ -762,6 +885,10 @@ void MainWindow::onStartRecording()
                     Qt::QueuedConnection);
             }
 
+            if (m_autosave && event)
+            {
+                m_autosave->addEvent(*event);
+            }
             m_recordedEvents->push_back(std::move(event));
         }
 
@@ -775,9 +902,14 @@ void MainWindow::onStartRecording()
             Qt::QueuedConnection);
     };
 
+    // The new recording replaces the events of any previous journal
+    discardAutosave();
+    startAutosave();
+
     if (m_app.getEventRecorder().startRecording(eventCallback))
     {
         m_recordedEvents->clear();
+        resetRecordingStatistics();
         // Clear the recording widget display and update UI state
         if (m_recordingWidget)
         {
@@ -794,6 +926,8 @@ void MainWindow::onStartRecording()
     }
     else
     {
+        stopAutosave();
+        discardAutosave();
         spdlog::error("MainWindow: Failed to start recording: {}",
                       m_app.getEventRecorder().getLastError());
         QMessageBox::critical(
@@ -812,6 +946,7 @@ void MainWindow::onStopRecording()
         if (m_app.getEventRecorder().isRecording())
         {
             m_app.getEventRecorder().stopRecording();
+            stopAutosave();
             m_modified = true;
             updateWindowTitle();
 
@@ -892,6 +1027,11 @@ void MainWindow::onExportEvents()
             storage = Storage::EventStorageFactory::createStorage(
                 Core::StorageFormat::Binary);
         }
+        else if (selectedFilter.contains("Columnar"))
+        {
+            storage = Storage::EventStorageFactory::createStorage(
+                Core::StorageFormat::Columnar);
+        }
         else
         {
             // Fallback to file extension-based detection
@@ -903,74 +1043,27 @@ void MainWindow::onExportEvents()
             QMessageBox::critical(
                 this,
                 "Export Error",
-                "Unsupported file format. Please use .json, .xml, or .mre "
-                "extension.");
+                "Unsupported file format. Please use .json, .xml, .mre or "
+                ".mrc extension.");
             return;
         }
 
-        // Copy events for export (since saveEvents expects const reference)
-        Core::EventVector eventsToExport;
-        {
-            std::lock_guard<std::mutex> lock(m_eventsMutex);
-            for (const auto& event : *m_recordedEvents)
-            {
-                if (event)
-                {
-                    // Create a copy of the event for export
-                    // This is a simplification - in practice you might want to
-                    // implement a proper clone method for Event
-                    eventsToExport.emplace_back(
-                        std::make_unique<Core::Event>(*event));
-                }
-            }
-        }
-
-        // Apply mouse movement optimization if enabled
-        applyMouseMovementOptimization(eventsToExport);
-
-        // Create metadata for the export
-        Core::StorageMetadata metadata;
-        metadata.version = "0.0.1";
-        metadata.applicationName = "MouseRecorder";
-        metadata.createdBy = QString(qgetenv("USER")).toStdString();
-        metadata.description = "Mouse and keyboard event recording";
-        metadata.creationTimestamp =
-            static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
-        metadata.totalEvents = eventsToExport.size();
-        metadata.platform = QSysInfo::prettyProductName().toStdString();
-
-        // Get screen resolution using the modern Qt API
-        QScreen* primaryScreen = QGuiApplication::primaryScreen();
-        if (primaryScreen)
-        {
-            QRect screenGeometry = primaryScreen->geometry();
-            metadata.screenResolution = QString("%1x%2")
-                                            .arg(screenGeometry.width())
-                                            .arg(screenGeometry.height())
-                                            .toStdString();
-        }
-
-        // Calculate total duration from first to last event
-        if (!eventsToExport.empty() && eventsToExport.size() > 1)
-        {
-            uint64_t firstTimestamp = eventsToExport.front()->getTimestampMs();
-            uint64_t lastTimestamp = eventsToExport.back()->getTimestampMs();
-            metadata.totalDurationMs = lastTimestamp - firstTimestamp;
-        }
-
         std::string file_with_suffix(fileName.toStdString());
         if (std::filesystem::path(fileName.toStdString()).extension() !=
             storage->getFileExtension())
         {
             file_with_suffix += storage->getFileExtension();
         }
-        if (storage->saveEvents(eventsToExport, file_with_suffix, metadata))
+        size_t exportedEvents = 0;
+        std::string error;
+        if (saveEventsWithStorage(
+                *storage, file_with_suffix, exportedEvents, error))
         {
             QMessageBox::information(
                 this,
                 "Export Complete",
                 QString("Successfully exported %1 events to %2")
-                    .arg(eventsToExport.size())
+                    .arg(exportedEvents)
                     .arg(QFileInfo(file_with_suffix.c_str()).fileName()));
         }
         else
@@ -979,7 +1072,7 @@ void MainWindow::onExportEvents()
                 this,
                 "Export Error",
                 QString("Failed to export events: %1")
-                    .arg(QString::fromStdString(storage->getLastError())));
+                    .arg(QString::fromStdString(error)));
         }
     }
     catch (const std::exception& e)
@@ -1211,23 +1304,26 @@ void MainWindow::updateRecordingStatistics()
         return;
     }
 
+    MOUSERECORDER_TRACE_SCOPE("gui", "updateRecordingStatistics");
     std::lock_guard<std::mutex> lock(m_eventsMutex);
 
-    size_t totalEvents = m_recordedEvents->size();
-    size_t mouseEvents = 0;
-    size_t keyboardEvents = 0;
-
-    for (const auto& event : *m_recordedEvents)
+    // Only the events recorded since the last update are counted
+    if (m_statisticsEventCount > m_recordedEvents->size())
     {
-        if (event && event->isMouseEvent())
-        {
-            mouseEvents++;
-        }
-        else if (event && event->isKeyboardEvent())
+        resetRecordingStatistics();
+    }
+    for (size_t i = m_statisticsEventCount; i < m_recordedEvents->size(); ++i)
+    {
+        if ((*m_recordedEvents)[i])
         {
-            keyboardEvents++;
+            m_recordingStatistics.add(*(*m_recordedEvents)[i]);
         }
     }
+    m_statisticsEventCount = m_recordedEvents->size();
+
+    size_t totalEvents = m_recordedEvents->size();
+    size_t mouseEvents = m_recordingStatistics.getMouseEvents();
+    size_t keyboardEvents = m_recordingStatistics.getKeyboardEvents();
 
     spdlog::debug(
         "MainWindow: Updating statistics - Total: {}, Mouse: {}, Keyboard: {}",
@@ -1239,6 +1335,12 @@ void MainWindow::updateRecordingStatistics()
         totalEvents, mouseEvents, keyboardEvents);
 }
 
+void MainWindow::resetRecordingStatistics()
+{
+    m_recordingStatistics = {};
+    m_statisticsEventCount = 0;
+}
+
 void MainWindow::showErrorMessage(const QString& title, const QString& message)
 {
     if (!TestUtils::isTestEnvironment())
@@ -1414,28 +1516,79 @@ Core::MouseMovementOptimizer::OptimizationConfig MainWindow::
     return optimizationConfig;
 }
 
-size_t MainWindow::applyMouseMovementOptimization(
-    Core::EventVector& events) const
+bool MainWindow::saveEventsWithStorage(Core::IEventStorage& storage,
+                                       const std::string& filename,
+                                       size_t& savedEvents,
+                                       std::string& error)
 {
-    const auto& config = m_app.getConfiguration();
-    if (!config.getBool(Core::ConfigKeys::OPTIMIZE_MOUSE_MOVEMENTS, true))
+    Core::EventVector events;
     {
-        return 0; // No optimization if disabled
+        std::lock_guard<std::mutex> lock(m_eventsMutex);
+        events.reserve(m_recordedEvents->size());
+        for (const auto& event : *m_recordedEvents)
+        {
+            if (event)
+            {
+                events.emplace_back(std::make_unique<Core::Event>(*event));
+            }
+        }
     }
 
-    auto optimizationConfig = getOptimizationConfigFromSettings();
-
-    size_t removedCount = Core::MouseMovementOptimizer::optimizeEvents(
-        events, optimizationConfig);
+    Core::StorageMetadata metadata;
+    metadata.version = "0.0.1";
+    metadata.applicationName = "MouseRecorder";
+    metadata.createdBy = QString(qgetenv("USER")).toStdString();
+    metadata.description = "Mouse and keyboard event recording";
+    metadata.creationTimestamp =
+        static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
+    metadata.platform = QSysInfo::prettyProductName().toStdString();
 
-    if (removedCount > 0)
+    // Get screen resolution using the modern Qt API
+    QScreen* primaryScreen = QGuiApplication::primaryScreen();
+    if (primaryScreen)
     {
-        spdlog::info("MainWindow: Mouse movement optimization removed {} "
-                     "redundant events",
-                     removedCount);
+        QRect screenGeometry = primaryScreen->geometry();
+        metadata.screenResolution = QString("%1x%2")
+                                        .arg(screenGeometry.width())
+                                        .arg(screenGeometry.height())
+                                        .toStdString();
     }
 
-    return removedCount;
+    // Read the settings here; optimization runs on the storage thread
+    auto optimizationConfig = getOptimizationConfigFromSettings();
+
+    Core::StorageTaskCallbacks callbacks;
+    callbacks.prepare = [optimizationConfig](Core::EventVector& toSave,
+                                             Core::StorageMetadata& meta)
+    {
+        size_t removedCount = Core::MouseMovementOptimizer::optimizeEvents(
+            toSave, optimizationConfig);
+        if (removedCount > 0)
+        {
+            spdlog::info("MainWindow: Mouse movement optimization removed {} "
+                         "redundant events",
+                         removedCount);
+        }
+
+        // Calculate total duration from first to last event
+        meta.totalEvents = toSave.size();
+        if (toSave.size() > 1)
+        {
+            meta.totalDurationMs = toSave.back()->getTimestampMs() -
+                                   toSave.front()->getTimestampMs();
+        }
+    };
+
+    StorageTaskRunner runner("Saving events...", this);
+    auto task = storage.saveEventsAsync(std::move(events),
+                                        filename,
+                                        metadata,
+                                        runner.callbacks(std::move(callbacks)));
+    bool success = runner.run(*task);
+
+    savedEvents = task->getMetadata().totalEvents;
+    error = task->getError();
+    return success;
 }
 
 void MainWindow::onTrayIconActivated(QSystemTrayIcon::ActivationReason reason)
@@ -1632,53 +1785,6 @@ bool MainWindow::saveEventsToFile(const QString& filename)
             return false;
         }
 
-        // Create a copy of events for saving
-        Core::EventVector eventsToSave;
-        {
-            std::lock_guard<std::mutex> lock(m_eventsMutex);
-            for (const auto& event : *m_recordedEvents)
-            {
-                if (event)
-                {
-                    eventsToSave.emplace_back(
-                        std::make_unique<Core::Event>(*event));
-                }
-            }
-        }
-
-        // Apply mouse movement optimization if enabled
-        applyMouseMovementOptimization(eventsToSave);
-
-        // Create metadata for the save
-        Core::StorageMetadata metadata;
-        metadata.version = "0.0.1";
-        metadata.applicationName = "MouseRecorder";
-        metadata.createdBy = QString(qgetenv("USER")).toStdString();
-        metadata.description = "Mouse and keyboard event recording";
-        metadata.creationTimestamp =
-            static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
-        metadata.totalEvents = eventsToSave.size();
-        metadata.platform = QSysInfo::prettyProductName().toStdString();
-
-        // Get screen resolution using the modern Qt API
-        QScreen* primaryScreen = QGuiApplication::primaryScreen();
-        if (primaryScreen)
-        {
-            QRect screenGeometry = primaryScreen->geometry();
-            metadata.screenResolution = QString("%1x%2")
-                                            .arg(screenGeometry.width())
-                                            .arg(screenGeometry.height())
-                                            .toStdString();
-        }
-
-        // Calculate total duration from first to last event
-        if (!eventsToSave.empty() && eventsToSave.size() > 1)
-        {
-            uint64_t firstTimestamp = eventsToSave.front()->getTimestampMs();
-            uint64_t lastTimestamp = eventsToSave.back()->getTimestampMs();
-            metadata.totalDurationMs = lastTimestamp - firstTimestamp;
-        }
-
         // Ensure the file has the correct extension
         std::string fileWithExtension = filename.toStdString();
         if (std::filesystem::path(filename.toStdString()).extension() !=
@@ -1687,18 +1793,22 @@ bool MainWindow::saveEventsToFile(const QString& filename)
             fileWithExtension += storage->getFileExtension();
         }
 
-        if (storage->saveEvents(eventsToSave, fileWithExtension, metadata))
+        size_t savedEvents = 0;
+        std::string error;
+        if (saveEventsWithStorage(
+                *storage, fileWithExtension, savedEvents, error))
         {
             spdlog::info("MainWindow: Saved {} events to {}",
-                         eventsToSave.size(),
+                         savedEvents,
                          fileWithExtension);
+            discardAutosave();
             return true;
         }
         else
         {
             spdlog::error("MainWindow: Failed to save events to {}: {}",
                           fileWithExtension,
-                          storage->getLastError());
+                          error);
             return false;
         }
     }
@@ -1711,4 +1821,185 @@ bool MainWindow::saveEventsToFile(const QString& filename)
     }
 }
 
+void MainWindow::startAutosave()
+{
+    auto& config = const_cast<Core::IConfiguration&>(m_app.getConfiguration());
+    if (!config.getBool(Core::ConfigKeys::AUTOSAVE_ENABLED, true))
+    {
+        return;
+    }
+
+    std::string journalPath;
+    if (!m_currentFile.isEmpty())
+    {
+        journalPath = Storage::RecordingJournal::getJournalPath(
+            m_currentFile.toStdString());
+    }
+    else
+    {
+        QDir dataDir(
+            QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+        dataDir.mkpath(".");
+        journalPath = dataDir
+                          .absoluteFilePath(
+                              QString("unsaved-recording") +
+                              Storage::RecordingJournal::FILE_EXTENSION)
+                          .toStdString();
+    }
+
+    Storage::AutosaveOptions options;
+    options.interval = std::chrono::milliseconds(std::max(
+        config.getInt(Core::ConfigKeys::AUTOSAVE_INTERVAL_MS, 30000), 100));
+    options.eventThreshold = static_cast<size_t>(std::max(
+        config.getInt(Core::ConfigKeys::AUTOSAVE_EVENT_THRESHOLD, 5000), 1));
+
+    Core::StorageMetadata metadata;
+    metadata.version = "0.0.1";
+    metadata.applicationName = "MouseRecorder";
+    metadata.createdBy = QString(qgetenv("USER")).toStdString();
+    metadata.description = "Mouse and keyboard event recording";
+    metadata.creationTimestamp =
+        static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
+    metadata.platform = QSysInfo::prettyProductName().toStdString();
+
+    auto autosave = std::make_unique<Storage::AutosaveService>(options);
+    if (!autosave->start(
+            journalPath, m_currentFile.toStdString(), metadata))
+    {
+        // Recording works without it, only crash recovery is lost
+        spdlog::warn("MainWindow: Autosave disabled for this recording: {}",
+                     autosave->getLastError());
+        return;
+    }
+
+    config.setString(Core::ConfigKeys::AUTOSAVE_JOURNAL, journalPath);
+    std::lock_guard<std::mutex> lock(m_eventsMutex);
+    m_autosave = std::move(autosave);
+}
+
+void MainWindow::stopAutosave()
+{
+    if (m_autosave && !m_autosave->stop())
+    {
+        spdlog::warn("MainWindow: Autosave journal is incomplete: {}",
+                     m_autosave->getLastError());
+    }
+}
+
+void MainWindow::discardAutosave()
+{
+    std::unique_ptr<Storage::AutosaveService> autosave;
+    {
+        std::lock_guard<std::mutex> lock(m_eventsMutex);
+        if (m_autosave && m_autosave->isRunning())
+        {
+            // Still needed for the events recorded from now on
+            return;
+        }
+        autosave = std::move(m_autosave);
+    }
+
+    auto& config = const_cast<Core::IConfiguration&>(m_app.getConfiguration());
+    std::string journalPath =
+        config.getString(Core::ConfigKeys::AUTOSAVE_JOURNAL, "");
+    if (journalPath.empty() && autosave)
+    {
+        journalPath = autosave->getJournalPath();
+    }
+    if (journalPath.empty())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(journalPath, ec);
+    if (ec)
+    {
+        spdlog::warn("MainWindow: Failed to remove autosave journal {}: {}",
+                     journalPath,
+                     ec.message());
+    }
+    config.setString(Core::ConfigKeys::AUTOSAVE_JOURNAL, "");
+}
+
+void MainWindow::offerAutosaveRecovery()
+{
+    const auto& config = m_app.getConfiguration();
+    std::string journalPath =
+        config.getString(Core::ConfigKeys::AUTOSAVE_JOURNAL, "");
+    if (journalPath.empty())
+    {
+        return;
+    }
+
+    Storage::RecordingJournalContents contents;
+    std::string error;
+    if (!std::filesystem::exists(journalPath) ||
+        !Storage::RecordingJournal::read(journalPath, contents, error))
+    {
+        spdlog::warn("MainWindow: Cannot recover autosave journal {}: {}",
+                     journalPath,
+                     error.empty() ? "file not found" : error);
+        discardAutosave();
+        return;
+    }
+    if (contents.events.empty())
+    {
+        discardAutosave();
+        return;
+    }
+
+    QString target = QString::fromStdString(contents.targetPath);
+    QString message =
+        QString("MouseRecorder did not exit normally while recording. "
+                "Recover the %1 events autosaved from %2?")
+            .arg(contents.events.size())
+            .arg(target.isEmpty() ? "an unsaved recording"
+                                  : QFileInfo(target).fileName());
+    if (contents.truncated)
+    {
+        message += "\n\nThe events recorded in the last moments before "
+                   "the crash could not be recovered.";
+    }
+
+    QMessageBox::StandardButton reply =
+        QMessageBox::question(this,
+                              "Recover Recording",
+                              message,
+                              QMessageBox::Yes | QMessageBox::No,
+                              QMessageBox::Yes);
+    if (reply != QMessageBox::Yes)
+    {
+        discardAutosave();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_eventsMutex);
+        *m_recordedEvents = std::move(contents.events);
+        resetRecordingStatistics();
+
+        if (m_recordingWidget)
+        {
+            m_recordingWidget->clearEvents();
+            for (const auto& event : *m_recordedEvents)
+            {
+                m_recordingWidget->addEvent(event.get());
+            }
+        }
+    }
+
+    // The journal stays until the recovered events are saved
+    m_currentFile = target;
+    m_modified = true;
+    updateWindowTitle();
+    updateUI();
+    updateRecordingStatistics();
+    ui->statusLabel->setText(
+        QString("Recovered %1 events").arg(m_recordedEvents->size()));
+    spdlog::info("MainWindow: Recovered {} events from {}",
+                 m_recordedEvents->size(),
+                 journalPath);
+}
+
 } // namespace MouseRecorder::GUI
@@ -11,7 +11,10 @@
 #include "application/MouseRecorderApp.hpp"
 #include "core/EventTypes.hpp"
 #include "core/MouseMovementOptimizer.hpp"
+#include "core/RecordingStatistics.hpp"
+#include "storage/AutosaveService.hpp"
 #include <mutex>
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 class QTabWidget;
@@ -20,6 +23,7 @@ class QMenu;
 class QAction;
 class QShortcut;
 class QTimer;
+class QDockWidget;
 QT_END_NAMESPACE
 
 namespace Ui
@@ -31,8 +35,16 @@ namespace MouseRecorder::GUI
 {
 class RecordingWidget;
 class PlaybackWidget;
+class PerformancePanel;
 } // namespace MouseRecorder::GUI
 
+#ifdef __linux__
+namespace MouseRecorder::Platform::Linux
+{
+class LinuxGlobalShortcutListener;
+} // namespace MouseRecorder::Platform::Linux
+#endif
+
 namespace MouseRecorder::GUI
 {
 
@@ -65,6 +77,8 @@ class MainWindow : public QMainWindow
     void onExit();
     void onAbout();
     void onAboutQt();
+    void onRecordTraceToggled(bool enabled);
+    void onSaveTrace();
 
     void onStartRecording();
     void onStopRecording();
@@ -101,18 +115,49 @@ class MainWindow : public QMainWindow
     void updateUI();
     void updateWindowTitle();
     void updateRecordingStatistics();
+    void resetRecordingStatistics();
     void updateRecentFilesMenu();
     void addToRecentFiles(const QString& filename);
     void loadRecentFiles();
     void saveRecentFiles();
     bool saveEventsToFile(const QString& filename);
 
+    /**
+     * @brief Start journaling the recording about to start
+     *
+     * The journal goes next to the current file, or to the application
+     * data directory if the recording has not been saved yet, and its path
+     * is kept in the configuration until the recording is saved.
+     */
+    void startAutosave();
+    void stopAutosave();
+
+    /**
+     * @brief Remove the journal once its events are saved or discarded
+     */
+    void discardAutosave();
+
+    /**
+     * @brief Offer to restore the recording of a journal left by a crash
+     */
+    void offerAutosaveRecovery();
+
     bool shouldAutoMinimize() const;
 
     // Helper method for mouse movement optimization
     Core::MouseMovementOptimizer::OptimizationConfig
     getOptimizationConfigFromSettings() const;
-    size_t applyMouseMovementOptimization(Core::EventVector& events) const;
+
+    /**
+     * @brief Save a copy of the recorded events on a storage thread
+     *
+     * Optimizes the copy there when enabled and shows a cancellable
+     * progress dialog while waiting.
+     */
+    bool saveEventsWithStorage(Core::IEventStorage& storage,
+                               const std::string& filename,
+                               size_t& savedEvents,
+                               std::string& error);
 
     // Helper methods to suppress message boxes in test environments
     void showErrorMessage(const QString& title, const QString& message);
@@ -131,6 +176,8 @@ class MainWindow : public QMainWindow
     // Custom widgets
     RecordingWidget* m_recordingWidget{nullptr};
     PlaybackWidget* m_playbackWidget{nullptr};
+    QDockWidget* m_performanceDock{nullptr};
+    PerformancePanel* m_performancePanel{nullptr};
 
     // Event storage for recording session
     // Using unique_ptr to avoid Qt MOC registration issues with non-copyable
@@ -138,6 +185,14 @@ class MainWindow : public QMainWindow
     std::unique_ptr<Core::EventVector> m_recordedEvents;
     mutable std::mutex m_eventsMutex;
 
+    // Statistics of the first m_statisticsEventCount recorded events,
+    // updated incrementally as events arrive; guarded by m_eventsMutex
+    Core::RecordingStatistics m_recordingStatistics;
+    size_t m_statisticsEventCount{0};
+
+    // Journal of the current recording; set under m_eventsMutex
+    std::unique_ptr<Storage::AutosaveService> m_autosave;
+
     // System tray components
     QSystemTrayIcon* m_trayIcon{nullptr};
     QMenu* m_trayMenu{nullptr};
@@ -152,14 +207,14 @@ class MainWindow : public QMainWindow
     QShortcut* m_stopPlaybackShortcut{nullptr};
 
     // Global shortcut monitoring
-    QTimer* m_globalShortcutTimer{nullptr};
+#ifdef __linux__
+    std::unique_ptr<Platform::Linux::LinuxGlobalShortcutListener>
+        m_globalShortcutListener;
+    std::optional<size_t> m_shortcutConfigCallbackId;
+    void registerGlobalShortcuts();
+#endif
     void setupGlobalShortcuts();
-    void checkGlobalShortcuts();
-    bool isKeyPressed(int keyCode);
-
-    // Shortcut states to prevent repeating
-    bool m_startRecordingKeyPressed{false};
-    bool m_stopRecordingKeyPressed{false};
+    void onGlobalShortcutActivated(int shortcutId);
 };
 
 } // namespace MouseRecorder::GUI
@@ -0,0 +1,193 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "PerformancePanel.hpp"
+#include "ui_PerformancePanel.h"
+#include "../core/Metrics.hpp"
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+
+namespace MouseRecorder::GUI
+{
+
+PerformancePanel::PerformancePanel(QWidget* parent)
+    : QWidget(parent),
+      ui(new Ui::PerformancePanel),
+      m_refreshTimer(new QTimer(this)),
+      m_frameProbeTimer(new QTimer(this))
+{
+    ui->setupUi(this);
+
+    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    connect(
+        m_refreshTimer, &QTimer::timeout, this, &PerformancePanel::refresh);
+
+    m_frameProbeTimer->setInterval(FRAME_PROBE_INTERVAL_MS);
+    connect(m_frameProbeTimer,
+            &QTimer::timeout,
+            this,
+            &PerformancePanel::onFrameProbe);
+}
+
+PerformancePanel::~PerformancePanel()
+{
+    delete ui;
+}
+
+void PerformancePanel::setRecordingMemoryProvider(
+    RecordingMemoryProvider provider)
+{
+    m_recordingMemoryProvider = std::move(provider);
+}
+
+void PerformancePanel::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+
+    // Start from fresh baselines so the first values cover only visible time
+    resolveMetrics();
+    m_lastCaptureEvents = m_captureEvents ? m_captureEvents->value() : 0;
+    m_lastLatenessCounts =
+        m_replayLateness ? m_replayLateness->bucketCounts()
+                         : std::vector<std::uint64_t>();
+    m_sampleTimer.start();
+    m_frameTimer.start();
+    m_maxFrameTimeMs = 0;
+
+    m_refreshTimer->start();
+    m_frameProbeTimer->start();
+}
+
+void PerformancePanel::hideEvent(QHideEvent* event)
+{
+    m_refreshTimer->stop();
+    m_frameProbeTimer->stop();
+
+    QWidget::hideEvent(event);
+}
+
+void PerformancePanel::refresh()
+{
+    resolveMetrics();
+
+    double elapsedSeconds = m_sampleTimer.restart() / 1000.0;
+
+    // Capture
+    if (m_captureEvents && elapsedSeconds > 0)
+    {
+        std::uint64_t events = m_captureEvents->value();
+        double rate = (events - m_lastCaptureEvents) / elapsedSeconds;
+        m_lastCaptureEvents = events;
+        ui->captureRateValue->setText(
+            QString("%1 events/s").arg(rate, 0, 'f', 1));
+    }
+    if (m_captureQueueDepth)
+    {
+        ui->queueDepthValue->setText(
+            QString::number(static_cast<qint64>(m_captureQueueDepth->value())));
+    }
+    std::uint64_t dropped = 0;
+    for (const Core::Counter* counter : {m_droppedOverflow, m_droppedExpired})
+    {
+        dropped += counter ? counter->value() : 0;
+    }
+    ui->droppedEventsValue->setText(QString::number(dropped));
+
+    // Replay lateness over the last refresh interval
+    if (m_replayLateness)
+    {
+        std::vector<std::uint64_t> counts = m_replayLateness->bucketCounts();
+        std::vector<std::uint64_t> window(counts.size(), 0);
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            std::uint64_t last =
+                i < m_lastLatenessCounts.size() ? m_lastLatenessCounts[i] : 0;
+            window[i] = counts[i] - last;
+        }
+        m_lastLatenessCounts = std::move(counts);
+
+        const auto& bounds = m_replayLateness->getBounds();
+        ui->latencyP50Value->setText(formatMilliseconds(
+            Core::Histogram::estimateQuantile(bounds, window, 0.50)));
+        ui->latencyP95Value->setText(formatMilliseconds(
+            Core::Histogram::estimateQuantile(bounds, window, 0.95)));
+        ui->latencyP99Value->setText(formatMilliseconds(
+            Core::Histogram::estimateQuantile(bounds, window, 0.99)));
+    }
+
+    // Recording memory
+    if (m_recordingMemoryProvider)
+    {
+        ui->recordingMemoryValue->setText(
+            formatBytes(m_recordingMemoryProvider()));
+    }
+
+    // GUI frame time
+    ui->frameTimeValue->setText(QString("%1 ms").arg(m_maxFrameTimeMs));
+    m_maxFrameTimeMs = 0;
+}
+
+void PerformancePanel::onFrameProbe()
+{
+    // A blocked event loop shows up as a long gap between probe ticks
+    m_maxFrameTimeMs = std::max(m_maxFrameTimeMs, m_frameTimer.restart());
+}
+
+void PerformancePanel::resolveMetrics()
+{
+    auto& registry = Core::MetricsRegistry::instance();
+    if (!m_captureEvents)
+    {
+        m_captureEvents =
+            registry.findCounter(Core::MetricNames::CAPTURE_EVENTS);
+    }
+    if (!m_captureQueueDepth)
+    {
+        m_captureQueueDepth =
+            registry.findGauge(Core::MetricNames::CAPTURE_QUEUE_DEPTH);
+    }
+    if (!m_droppedOverflow)
+    {
+        m_droppedOverflow =
+            registry.findCounter(Core::MetricNames::CAPTURE_DROPPED_EVENTS,
+                                 {{"reason", "buffer_overflow"}});
+    }
+    if (!m_droppedExpired)
+    {
+        m_droppedExpired =
+            registry.findCounter(Core::MetricNames::CAPTURE_DROPPED_EVENTS,
+                                 {{"reason", "buffer_expired"}});
+    }
+    if (!m_replayLateness)
+    {
+        m_replayLateness =
+            registry.findHistogram(Core::MetricNames::REPLAY_LATENESS);
+    }
+}
+
+QString PerformancePanel::formatMilliseconds(double seconds)
+{
+    if (std::isnan(seconds))
+    {
+        return "-";
+    }
+    return QString("%1 ms").arg(seconds * 1000.0, 0, 'f', 2);
+}
+
+QString PerformancePanel::formatBytes(std::size_t bytes)
+{
+    if (bytes < 1024)
+    {
+        return QString("%1 B").arg(bytes);
+    }
+    if (bytes < 1024 * 1024)
+    {
+        return QString("%1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+    }
+    return QString("%1 MiB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+}
+
+} // namespace MouseRecorder::GUI
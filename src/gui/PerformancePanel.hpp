@@ -0,0 +1,98 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <QWidget>
+#include <QElapsedTimer>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class QTimer;
+
+namespace Ui
+{
+class PerformancePanel;
+}
+
+namespace MouseRecorder::Core
+{
+class Counter;
+class Gauge;
+class Histogram;
+} // namespace MouseRecorder::Core
+
+namespace MouseRecorder::GUI
+{
+
+/**
+ * @brief Live diagnostics read from the metrics registry
+ *
+ * Shows capture rate, queue depth and drops, replay lateness percentiles,
+ * memory held by the current recording and GUI frame time. Values are
+ * sampled at a low fixed rate and only while the panel is visible, so the
+ * panel itself doesn't add to the load it reports.
+ */
+class PerformancePanel : public QWidget
+{
+    Q_OBJECT
+
+  public:
+    static constexpr int REFRESH_INTERVAL_MS = 1000;
+    static constexpr int FRAME_PROBE_INTERVAL_MS = 16;
+
+    /**
+     * @brief Returns the bytes held by the current recording
+     */
+    using RecordingMemoryProvider = std::function<std::size_t()>;
+
+    explicit PerformancePanel(QWidget* parent = nullptr);
+    ~PerformancePanel();
+
+    void setRecordingMemoryProvider(RecordingMemoryProvider provider);
+
+  protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+  private slots:
+    void refresh();
+    void onFrameProbe();
+
+  private:
+    /**
+     * @brief Look up metrics that were not registered yet
+     */
+    void resolveMetrics();
+
+    static QString formatMilliseconds(double seconds);
+    static QString formatBytes(std::size_t bytes);
+
+  private:
+    Ui::PerformancePanel* ui;
+    QTimer* m_refreshTimer;
+    QTimer* m_frameProbeTimer;
+    RecordingMemoryProvider m_recordingMemoryProvider;
+
+    // Metrics, owned by the registry
+    const Core::Counter* m_captureEvents{nullptr};
+    const Core::Gauge* m_captureQueueDepth{nullptr};
+    const Core::Counter* m_droppedOverflow{nullptr};
+    const Core::Counter* m_droppedExpired{nullptr};
+    const Core::Histogram* m_replayLateness{nullptr};
+
+    // Values at the previous refresh, to report rates and windowed
+    // percentiles rather than totals since startup
+    QElapsedTimer m_sampleTimer;
+    std::uint64_t m_lastCaptureEvents{0};
+    std::vector<std::uint64_t> m_lastLatenessCounts;
+
+    // Longest gap between frame probes since the last refresh
+    QElapsedTimer m_frameTimer;
+    qint64 m_maxFrameTimeMs{0};
+};
+
+} // namespace MouseRecorder::GUI
@@ -7,6 +7,7 @@
 #include "ui_PlaybackWidget.h"
 #include "application/MouseRecorderApp.hpp"
 #include "core/IConfiguration.hpp"
+#include "core/StorageTask.hpp"
 #include "storage/EventStorageFactory.hpp"
 #include "TestUtils.hpp"
 #include <QFileDialog>
@@ -16,8 +17,10 @@
 #include <QDateTime>
 #include <QTimer>
 #include <QMessageBox>
-#include <QProgressDialog>
 #include <QApplication>
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include "core/SpdlogConfig.hpp"
 
 namespace MouseRecorder::GUI
@@ -28,7 +31,7 @@ PlaybackWidget::PlaybackWidget(Application::MouseRecorderApp& app,
     : QWidget(parent),
       ui(new Ui::PlaybackWidget),
       m_app(app),
-      m_loadedEvents(std::make_unique<Core::EventVector>())
+      m_loadedEvents(std::make_shared<Core::EventVector>())
 {
     ui->setupUi(this);
     setupUI();
@@ -44,12 +47,18 @@ PlaybackWidget::~PlaybackWidget()
         m_updateTimer->deleteLater();
         m_updateTimer = nullptr;
     }
+    if (m_followTimer)
+    {
+        m_followTimer->stop();
+    }
 
     // Disconnect all signals to prevent callbacks during destruction
     disconnect();
 
-    // Clear any loaded events to free memory
-    m_loadedEvents->clear();
+    // Stop a load still in progress and free the loaded events
+    cancelLoading();
+    m_loadingEvents.reset();
+    m_loadedEvents.reset();
 
     delete ui;
 }
@@ -65,6 +74,10 @@ void PlaybackWidget::setupUI()
             &QPushButton::clicked,
             this,
             &PlaybackWidget::onReloadFile);
+    connect(ui->followCheckBox,
+            &QCheckBox::toggled,
+            this,
+            &PlaybackWidget::onFollowToggled);
     connect(
         ui->playButton, &QPushButton::clicked, this, &PlaybackWidget::onPlay);
     connect(
@@ -102,6 +115,14 @@ void PlaybackWidget::setupUI()
             this,
             &PlaybackWidget::updatePlaybackProgress);
 
+    // Poll a followed recording for events appended to it
+    m_followTimer = new QTimer(this);
+    m_followTimer->setInterval(1000);
+    connect(m_followTimer,
+            &QTimer::timeout,
+            this,
+            &PlaybackWidget::onFollowTimer);
+
     updateUI();
     loadConfigurationSettings();
     updateSpeed();
@@ -175,9 +196,9 @@ void PlaybackWidget::onBrowseFile()
             this,
             "Open Recording File",
             "",
-            "All Supported (*.json *.mre *.xml);;JSON Files (*.json);;Binary "
-            "Files "
-            "(*.mre);;XML Files (*.xml)");
+            "All Supported (*.json *.mre *.xml *.autosave);;JSON Files "
+            "(*.json);;Binary Files (*.mre);;XML Files (*.xml);;Recordings "
+            "in Progress (*.autosave)");
     }
 
     if (!fileName.isEmpty())
@@ -188,10 +209,82 @@ void PlaybackWidget::onBrowseFile()
 
 void PlaybackWidget::onReloadFile()
 {
-    if (!m_currentFile.isEmpty())
+    if (m_currentFile.isEmpty())
+    {
+        return;
+    }
+
+    // A journal that is still growing only needs its new events; anything
+    // else is loaded again, from the cache if it did not change
+    if (!m_loading && m_journalTail && appendNewEvents())
+    {
+        return;
+    }
+    loadFile(m_currentFile);
+}
+
+void PlaybackWidget::onFollowToggled(bool enabled)
+{
+    if (enabled && m_journalTail)
+    {
+        spdlog::info("PlaybackWidget: Following '{}'",
+                     m_currentFile.toStdString());
+        m_followTimer->start();
+    }
+    else
+    {
+        m_followTimer->stop();
+    }
+}
+
+void PlaybackWidget::onFollowTimer()
+{
+    if (m_loading || !m_journalTail)
+    {
+        return;
+    }
+
+    if (!appendNewEvents())
+    {
+        spdlog::warn("PlaybackWidget: Stopped following '{}'",
+                     m_currentFile.toStdString());
+        stopFollowing();
+    }
+}
+
+bool PlaybackWidget::appendNewEvents()
+{
+    // Journals are removed rather than finished once the recording is
+    // saved, so they are followed until reading them fails
+    Storage::RecordingJournalContents contents;
+    std::string error;
+    if (!Storage::RecordingJournal::readAppended(
+            m_currentFile.toStdString(), *m_journalTail, contents, error))
     {
-        loadFile(m_currentFile);
+        spdlog::warn("PlaybackWidget: Cannot read new events of '{}': {}",
+                     m_currentFile.toStdString(),
+                     error);
+        return false;
     }
+
+    if (!contents.events.empty())
+    {
+        spdlog::debug("PlaybackWidget: {} new events in '{}'",
+                      contents.events.size(),
+                      m_currentFile.toStdString());
+        onEventsLoaded(m_loadGeneration, std::move(contents.events));
+    }
+    return true;
+}
+
+void PlaybackWidget::stopFollowing()
+{
+    m_followTimer->stop();
+    m_journalTail.reset();
+    ui->followCheckBox->blockSignals(true);
+    ui->followCheckBox->setChecked(false);
+    ui->followCheckBox->blockSignals(false);
+    ui->followCheckBox->setEnabled(false);
 }
 
 void PlaybackWidget::onPlay()
@@ -232,13 +325,32 @@ void PlaybackWidget::onPlay()
             eventsCopy.push_back(std::move(eventCopy));
         }
 
-        if (!player.loadEvents(std::move(eventsCopy)))
+        // Looped recordings are expanded by the player as it plays
+        bool loaded = false;
+        if (m_loadedSegments.empty())
+        {
+            loaded = player.loadEvents(std::move(eventsCopy));
+        }
+        else
+        {
+            loaded = player.loadLoopedEvents(
+                {std::move(eventsCopy), m_loadedSegments});
+        }
+        if (!loaded)
         {
             showErrorMessage("Playback Error",
                              QString::fromStdString(player.getLastError()));
             return;
         }
 
+        // Play the head of a recording that is still loading; the rest is
+        // appended as it arrives
+        if (m_loading)
+        {
+            player.setMoreEventsPending(true);
+            m_streamingToPlayer = true;
+        }
+
         // Set up playback callback
         auto callback =
             [this](Core::PlaybackState state, size_t current, size_t total)
@@ -282,6 +394,7 @@ void PlaybackWidget::onStop()
     try
     {
         auto& player = m_app.getEventPlayer();
+        m_streamingToPlayer = false;
         player.stopPlayback();
 
         ui->playButton->setEnabled(true);
@@ -291,7 +404,7 @@ void PlaybackWidget::onStop()
         // Reset time labels to initial state
         if (!m_loadedEvents->empty())
         {
-            updateTimeLabels(0, m_loadedEvents->size());
+            updateTimeLabels(0, getPlayedEventCount());
         }
 
         // Stop update timer
@@ -403,198 +516,502 @@ void PlaybackWidget::onLoopCountChanged(int count)
 void PlaybackWidget::loadFile(const QString& fileName)
 {
     spdlog::info("PlaybackWidget: Loading file '{}'", fileName.toStdString());
+    cancelLoading();
+    stopFollowing();
+
     m_currentFile = fileName;
     ui->filePathLineEdit->setText(fileName);
+    m_fileLoaded = false;
+    m_loadingEvents = std::make_shared<Core::EventVector>();
+    m_loadedEvents = m_loadingEvents;
+    m_loadedSegments = {};
+    m_expectedEvents = 0;
+    m_expectedDurationMs = 0;
+    ui->eventsPreviewTableWidget->setRowCount(0);
 
     QFileInfo fileInfo(fileName);
+    ui->fileFormatValue->setText(fileInfo.suffix().toUpper());
+    ui->createdValue->setText(
+        fileInfo.birthTime().toString("yyyy-MM-dd hh:mm:ss"));
 
-    // Show progress dialog for large files (but not in test environment)
-    std::unique_ptr<QProgressDialog> progress;
-    if (!TestUtils::isTestEnvironment())
+    if (fileName.endsWith(Storage::RecordingJournal::FILE_EXTENSION))
     {
-        progress = std::make_unique<QProgressDialog>(
-            "Loading events...", "Cancel", 0, 0, nullptr);
-        progress->setWindowModality(Qt::WindowModal);
-        progress->setMinimumDuration(500); // Show after 500ms
-        progress->show();
-        QApplication::processEvents(); // Allow the progress dialog to show
+        loadJournal(fileName);
+        return;
     }
 
     try
     {
+        // Recently loaded recordings come from the cache unless the file
+        // changed on disk since
+        m_loadStamp = Storage::FileStamp::of(fileName.toStdString());
+        m_loadMetadata = {};
+        if (m_loadStamp)
+        {
+            if (auto cached = m_app.getRecordingCache().find(*m_loadStamp))
+            {
+                showCachedRecording(*cached);
+                return;
+            }
+        }
+
         // Load events using storage factory
-        auto storage = Storage::EventStorageFactory::createStorageFromFilename(
+        m_loadStorage = Storage::EventStorageFactory::createStorageFromFilename(
             fileName.toStdString());
 
-        if (!storage)
+        if (!m_loadStorage)
         {
-            if (progress)
-            {
-                progress->close();
-                QApplication::processEvents();
-            }
             if (!TestUtils::isTestEnvironment())
             {
                 showErrorMessage("Error", "Unsupported file format");
             }
-            m_fileLoaded = false;
-            m_loadedEvents->clear();
+            updateUI();
             return;
         }
 
-        Core::EventVector events;
-        Core::StorageMetadata metadata;
+        // Decode on a storage thread. Metadata and events are handed over
+        // as soon as they are decoded, so the head of a large recording can
+        // be inspected and played while the rest is still loading.
+        uint64_t generation = ++m_loadGeneration;
+        m_loading = true;
+        if (Storage::EventStorageFactory::getFormatFromExtension(
+                fileInfo.suffix().toStdString()) ==
+                Core::StorageFormat::Binary &&
+            Storage::BinaryEventStorage().isLoopedFile(fileName.toStdString()))
+        {
+            loadLoopedFile(fileName, generation);
+        }
+        else
+        {
+            m_loadTask = m_loadStorage->loadEventsAsync(
+                fileName.toStdString(), makeLoadCallbacks(generation));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        cancelLoading();
+        showErrorMessage("Error",
+                         QString("Failed to load file: %1").arg(e.what()));
+    }
+
+    ui->browseFileButton->setEnabled(true);
+    ui->reloadFileButton->setEnabled(false);
+    updateUI();
+}
 
-        if (!storage->loadEvents(fileName.toStdString(), events, metadata))
+Core::StorageTaskCallbacks PlaybackWidget::makeLoadCallbacks(
+    uint64_t generation)
+{
+    Core::StorageTaskCallbacks callbacks;
+    callbacks.metadata =
+        [this, generation](const Core::StorageMetadata& metadata)
+    {
+        QMetaObject::invokeMethod(
+            this,
+            [this, generation, metadata]()
+            { onMetadataLoaded(generation, metadata); },
+            Qt::QueuedConnection);
+    };
+    callbacks.events = [this, generation](Core::EventVector events)
+    {
+        // Queued functors must be copyable
+        auto chunk = std::make_shared<Core::EventVector>(std::move(events));
+        QMetaObject::invokeMethod(
+            this,
+            [this, generation, chunk]()
+            { onEventsLoaded(generation, std::move(*chunk)); },
+            Qt::QueuedConnection);
+    };
+    callbacks.completion = [this, generation](bool success)
+    {
+        QMetaObject::invokeMethod(
+            this,
+            [this, generation, success]()
+            { onLoadFinished(generation, success); },
+            Qt::QueuedConnection);
+    };
+    return callbacks;
+}
+
+void PlaybackWidget::cancelLoading()
+{
+    // Drop callbacks of the old load that are still queued
+    ++m_loadGeneration;
+
+    // The task must go before the storage it runs on
+    m_loadTask.reset();
+    m_loadStorage.reset();
+    m_loading = false;
+
+    if (m_streamingToPlayer)
+    {
+        m_app.getEventPlayer().setMoreEventsPending(false);
+        m_streamingToPlayer = false;
+    }
+}
+
+void PlaybackWidget::onMetadataLoaded(uint64_t generation,
+                                      const Core::StorageMetadata& metadata)
+{
+    if (generation != m_loadGeneration)
+    {
+        return;
+    }
+
+    m_loadMetadata = metadata;
+    m_expectedEvents = metadata.totalEvents;
+    m_expectedDurationMs = metadata.totalDurationMs;
+    if (metadata.statistics)
+    {
+        // Counted from the stored events rather than taken on trust
+        m_expectedEvents = metadata.statistics->getTotalEvents();
+        m_expectedDurationMs = metadata.statistics->getDurationMs();
+    }
+    updateLoadedEventsInfo();
+}
+
+void PlaybackWidget::onEventsLoaded(uint64_t generation,
+                                    Core::EventVector events)
+{
+    if (generation != m_loadGeneration || events.empty())
+    {
+        return;
+    }
+
+    // Events of a recording that is shared with the cache do not change
+    if (!m_loadingEvents)
+    {
+        return;
+    }
+
+    // Keep feeding a playback that started before the load finished
+    if (m_streamingToPlayer)
+    {
+        Core::EventVector eventsCopy;
+        eventsCopy.reserve(events.size());
+        for (const auto& event : events)
         {
-            if (progress)
-            {
-                progress->close();
-                QApplication::processEvents();
-            }
-            showErrorMessage("Error",
-                             QString::fromStdString(storage->getLastError()));
-            m_fileLoaded = false;
-            m_loadedEvents->clear();
-            return;
+            eventsCopy.push_back(std::make_unique<Core::Event>(*event));
         }
+        m_app.getEventPlayer().appendEvents(std::move(eventsCopy));
+    }
 
-        *m_loadedEvents = std::move(events);
+    bool firstEvents = m_loadingEvents->empty();
+    m_loadingEvents->insert(m_loadingEvents->end(),
+                            std::make_move_iterator(events.begin()),
+                            std::make_move_iterator(events.end()));
+    updateLoadedEventsInfo();
 
-        // Update UI with actual data
-        ui->fileFormatValue->setText(fileInfo.suffix().toUpper());
-        ui->totalEventsValue->setText(QString::number(m_loadedEvents->size()));
+    if (firstEvents)
+    {
+        spdlog::info("PlaybackWidget: First {} events of {} available",
+                     m_loadedEvents->size(),
+                     m_currentFile.toStdString());
 
-        // Calculate duration
-        if (!m_loadedEvents->empty())
+        // The head of the recording can be played right away
+        m_fileLoaded = true;
+        if (m_app.getEventPlayer().getState() != Core::PlaybackState::Playing)
         {
-            uint64_t startTime = m_loadedEvents->front()->getTimestampMs();
-            uint64_t endTime = m_loadedEvents->back()->getTimestampMs();
-            uint64_t durationMs = endTime - startTime;
-
-            int seconds = static_cast<int>(durationMs / 1000);
-            int minutes = seconds / 60;
-            int hours = minutes / 60;
-
-            ui->durationValue->setText(
-                QString("%1:%2:%3")
-                    .arg(hours, 2, 10, QChar('0'))
-                    .arg(minutes % 60, 2, 10, QChar('0'))
-                    .arg(seconds % 60, 2, 10, QChar('0')));
-
-            // Set progress slider range
-            ui->progressSlider->setRange(
-                0, static_cast<int>(m_loadedEvents->size() - 1));
-
-            // Initialize time labels
-            updateTimeLabels(0, m_loadedEvents->size());
+            updateUI();
         }
-        else
+    }
+}
+
+void PlaybackWidget::onLoadFinished(uint64_t generation, bool success)
+{
+    if (generation != m_loadGeneration)
+    {
+        return;
+    }
+
+    std::string error = m_loadTask ? m_loadTask->getError() : std::string();
+    m_loadTask.reset();
+    m_loadStorage.reset();
+    m_loading = false;
+
+    if (m_streamingToPlayer)
+    {
+        m_app.getEventPlayer().setMoreEventsPending(false);
+        m_streamingToPlayer = false;
+        if (!success)
         {
-            ui->durationValue->setText("00:00:00");
-            ui->progressSlider->setRange(0, 0);
+            onStop();
         }
+    }
 
-        ui->createdValue->setText(
-            fileInfo.birthTime().toString("yyyy-MM-dd hh:mm:ss"));
+    if (!success)
+    {
+        showErrorMessage("Error", QString::fromStdString(error));
+        m_fileLoaded = false;
+        m_loadingEvents = std::make_shared<Core::EventVector>();
+        m_loadedEvents = m_loadingEvents;
+        m_loadedSegments = {};
+        ui->eventsPreviewTableWidget->setRowCount(0);
+        updateUI();
+        return;
+    }
 
-        // Update events preview table
-        ui->eventsPreviewTableWidget->setRowCount(
-            std::min(static_cast<int>(m_loadedEvents->size()),
-                     100) // Show max 100 events
-        );
+    ui->followCheckBox->setEnabled(m_journalTail.has_value());
+
+    // Recordings that cannot grow any more are shared with the cache for
+    // the next load of the same file and no longer change
+    if (m_loadStamp && !m_journalTail)
+    {
+        m_loadingEvents.reset();
+        m_app.getRecordingCache().insert(
+            *m_loadStamp, m_loadedEvents, m_loadMetadata);
+    }
+    m_loadStamp.reset();
+
+    m_fileLoaded = true;
+    updateLoadedEventsInfo();
+    ui->reloadFileButton->setEnabled(true);
+    if (m_app.getEventPlayer().getState() != Core::PlaybackState::Playing)
+    {
+        updateUI();
+    }
+
+    spdlog::info("PlaybackWidget: Loaded {} events from {}",
+                 m_loadedEvents->size(),
+                 m_currentFile.toStdString());
+
+    // Emit signal to notify that file was loaded
+    emit fileLoaded(m_currentFile);
+}
+
+void PlaybackWidget::showCachedRecording(
+    const Storage::CachedRecording& recording)
+{
+    spdlog::info("PlaybackWidget: Using cached events of '{}'",
+                 m_currentFile.toStdString());
+
+    // Share the cached events like a load that finished right away; the
+    // recording is cached already
+    m_loadStamp.reset();
+    m_loadingEvents.reset();
+    m_loadedEvents = recording.events;
+    m_loadedSegments = {};
+    uint64_t generation = ++m_loadGeneration;
+    m_loading = true;
+    onMetadataLoaded(generation, recording.metadata);
+    m_fileLoaded = true;
+    onLoadFinished(generation, true);
+}
 
-        for (int i = 0; i < ui->eventsPreviewTableWidget->rowCount(); ++i)
+void PlaybackWidget::loadJournal(const QString& fileName)
+{
+    // The journal of a recording in progress; it is read in place on a
+    // storage thread, and reloading or following it picks up the blocks
+    // appended since
+    m_loadStamp.reset();
+
+    auto position = std::make_shared<Storage::RecordingJournal::ReadPosition>();
+    uint64_t generation = ++m_loadGeneration;
+    Core::StorageTaskCallbacks callbacks = makeLoadCallbacks(generation);
+    callbacks.completion = [this, generation, position](bool success)
+    {
+        QMetaObject::invokeMethod(
+            this,
+            [this, generation, position, success]()
+            {
+                if (success && generation == m_loadGeneration)
+                {
+                    m_journalTail = *position;
+                }
+                onLoadFinished(generation, success);
+            },
+            Qt::QueuedConnection);
+    };
+
+    m_loading = true;
+    m_loadTask = Core::StorageTask::startLoad(
+        [path = fileName.toStdString(), position](
+            Core::EventVector& events,
+            Core::StorageMetadata& metadata,
+            std::string& error)
         {
-            const auto& event = (*m_loadedEvents)[static_cast<size_t>(i)];
-            ui->eventsPreviewTableWidget->setItem(
-                i, 0, new QTableWidgetItem(QString::number(i)));
-
-            // Format timestamp
-            uint64_t timestamp = event->getTimestampMs();
-            uint64_t relativeTime =
-                timestamp - m_loadedEvents->front()->getTimestampMs();
-            int seconds = static_cast<int>(relativeTime / 1000);
-            int milliseconds = static_cast<int>(relativeTime % 1000);
-
-            ui->eventsPreviewTableWidget->setItem(
-                i,
-                1,
-                new QTableWidgetItem(QString("%1.%2s").arg(seconds).arg(
-                    milliseconds, 3, 10, QChar('0'))));
-
-            // Event type
-            QString typeString;
-            switch (event->getType())
+            Storage::RecordingJournalContents contents;
+            if (!Storage::RecordingJournal::readAppended(
+                    path, *position, contents, error))
             {
-            case Core::EventType::MouseMove:
-                typeString = "Mouse Move";
-                break;
-            case Core::EventType::MouseClick:
-                typeString = "Mouse Click";
-                break;
-            case Core::EventType::MouseDoubleClick:
-                typeString = "Mouse Double Click";
-                break;
-            case Core::EventType::MouseWheel:
-                typeString = "Mouse Wheel";
-                break;
-            case Core::EventType::KeyPress:
-                typeString = "Key Press";
-                break;
-            case Core::EventType::KeyRelease:
-                typeString = "Key Release";
-                break;
-            case Core::EventType::KeyCombination:
-                typeString = "Key Combination";
-                break;
+                return false;
             }
+            events = std::move(contents.events);
+            metadata = contents.metadata;
+            return true;
+        },
+        std::move(callbacks));
 
-            ui->eventsPreviewTableWidget->setItem(
-                i, 2, new QTableWidgetItem(typeString));
+    ui->reloadFileButton->setEnabled(false);
+    updateUI();
+}
 
-            // Event details (simplified)
-            QString details = QString::fromStdString(event->toString());
-            if (details.length() > 50)
+void PlaybackWidget::loadLoopedFile(const QString& fileName,
+                                    uint64_t generation)
+{
+    // Only the stored events are loaded; the cache would lose the segments
+    m_loadStamp.reset();
+
+    // The segments come with the events, so they are never shown or played
+    // without them
+    auto segments = std::make_shared<Core::SegmentIndex>();
+    Core::StorageTaskCallbacks callbacks = makeLoadCallbacks(generation);
+    callbacks.events = [this, generation, segments](Core::EventVector events)
+    {
+        auto chunk = std::make_shared<Core::EventVector>(std::move(events));
+        QMetaObject::invokeMethod(
+            this,
+            [this, generation, segments, chunk]()
+            {
+                if (generation == m_loadGeneration)
+                {
+                    m_loadedSegments = *segments;
+                }
+                onEventsLoaded(generation, std::move(*chunk));
+            },
+            Qt::QueuedConnection);
+    };
+
+    m_loadTask = Core::StorageTask::startLoad(
+        [path = fileName.toStdString(), segments](
+            Core::EventVector& events,
+            Core::StorageMetadata& metadata,
+            std::string& error)
+        {
+            Storage::BinaryEventStorage storage;
+            Core::LoopedRecording recording;
+            if (!storage.loadLoopedEvents(path, recording, metadata))
             {
-                details = details.left(47) + "...";
+                error = storage.getLastError();
+                return false;
             }
-            ui->eventsPreviewTableWidget->setItem(
-                i, 3, new QTableWidgetItem(details));
-        }
+            events = std::move(recording.events);
+            *segments = std::move(recording.index);
+            return true;
+        },
+        std::move(callbacks));
+}
 
-        m_fileLoaded = true;
-        spdlog::info("PlaybackWidget: Loaded {} events from {}",
-                     m_loadedEvents->size(),
-                     m_currentFile.toStdString());
+void PlaybackWidget::updateLoadedEventsInfo()
+{
+    size_t loadedCount = getPlayedEventCount();
 
-        // Close progress dialog before emitting signal
-        if (progress)
-        {
-            progress->close();
-            QApplication::processEvents();
-        }
+    // While loading, show how far the load got
+    if (m_loading && m_expectedEvents > loadedCount)
+    {
+        ui->totalEventsValue->setText(
+            QString("%1 / %2").arg(loadedCount).arg(m_expectedEvents));
+    }
+    else
+    {
+        ui->totalEventsValue->setText(QString::number(loadedCount));
+    }
 
-        // Emit signal to notify that file was loaded
-        emit fileLoaded(m_currentFile);
+    // Calculate duration, from the metadata until all events are there
+    uint64_t durationMs = 0;
+    if (m_loading && m_expectedDurationMs > 0)
+    {
+        durationMs = m_expectedDurationMs;
     }
-    catch (const std::exception& e)
+    else if (!m_loadedEvents->empty())
     {
-        if (progress)
+        durationMs = getPlayedTimestampMs(loadedCount - 1) -
+                     getPlayedTimestampMs(0);
+    }
+
+    int seconds = static_cast<int>(durationMs / 1000);
+    int minutes = seconds / 60;
+    int hours = minutes / 60;
+
+    ui->durationValue->setText(QString("%1:%2:%3")
+                                   .arg(hours, 2, 10, QChar('0'))
+                                   .arg(minutes % 60, 2, 10, QChar('0'))
+                                   .arg(seconds % 60, 2, 10, QChar('0')));
+
+    if (m_loadedEvents->empty())
+    {
+        ui->progressSlider->setRange(0, 0);
+        return;
+    }
+
+    // Set progress slider range
+    ui->progressSlider->setRange(0, static_cast<int>(loadedCount - 1));
+
+    // Initialize time labels unless a playback is updating them
+    if (m_app.getEventPlayer().getState() != Core::PlaybackState::Playing)
+    {
+        updateTimeLabels(0, loadedCount);
+    }
+
+    updateEventsPreview();
+}
+
+void PlaybackWidget::updateEventsPreview()
+{
+    // Show max 100 events; rows already filled stay as they are
+    int firstRow = ui->eventsPreviewTableWidget->rowCount();
+    ui->eventsPreviewTableWidget->setRowCount(
+        static_cast<int>(std::min<size_t>(getPlayedEventCount(), 100)));
+
+    for (int i = firstRow; i < ui->eventsPreviewTableWidget->rowCount(); ++i)
+    {
+        const size_t position = static_cast<size_t>(i);
+        const auto& event =
+            (*m_loadedEvents)[m_loadedSegments.locate(position).event];
+        ui->eventsPreviewTableWidget->setItem(
+            i, 0, new QTableWidgetItem(QString::number(i)));
+
+        // Format timestamp
+        uint64_t relativeTime =
+            getPlayedTimestampMs(position) - getPlayedTimestampMs(0);
+        int seconds = static_cast<int>(relativeTime / 1000);
+        int milliseconds = static_cast<int>(relativeTime % 1000);
+
+        ui->eventsPreviewTableWidget->setItem(
+            i,
+            1,
+            new QTableWidgetItem(QString("%1.%2s").arg(seconds).arg(
+                milliseconds, 3, 10, QChar('0'))));
+
+        // Event type
+        QString typeString;
+        switch (event->getType())
         {
-            progress->close();
-            QApplication::processEvents();
+        case Core::EventType::MouseMove:
+            typeString = "Mouse Move";
+            break;
+        case Core::EventType::MouseClick:
+            typeString = "Mouse Click";
+            break;
+        case Core::EventType::MouseDoubleClick:
+            typeString = "Mouse Double Click";
+            break;
+        case Core::EventType::MouseWheel:
+            typeString = "Mouse Wheel";
+            break;
+        case Core::EventType::KeyPress:
+            typeString = "Key Press";
+            break;
+        case Core::EventType::KeyRelease:
+            typeString = "Key Release";
+            break;
+        case Core::EventType::KeyCombination:
+            typeString = "Key Combination";
+            break;
         }
-        showErrorMessage("Error",
-                         QString("Failed to load file: %1").arg(e.what()));
-        m_fileLoaded = false;
-        m_loadedEvents->clear();
-    }
 
-    // Re-enable UI
-    ui->browseFileButton->setEnabled(true);
-    ui->reloadFileButton->setEnabled(m_fileLoaded);
-    updateUI();
+        ui->eventsPreviewTableWidget->setItem(
+            i, 2, new QTableWidgetItem(typeString));
+
+        // Event details (simplified)
+        QString details = QString::fromStdString(event->toString());
+        if (details.length() > 50)
+        {
+            details = details.left(47) + "...";
+        }
+        ui->eventsPreviewTableWidget->setItem(
+            i, 3, new QTableWidgetItem(details));
+    }
 }
 
 void PlaybackWidget::updateUI()
@@ -647,8 +1064,8 @@ void PlaybackWidget::updatePlaybackProgress()
                 // Update time labels to show total duration
                 if (!m_loadedEvents->empty())
                 {
-                    updateTimeLabels(m_loadedEvents->size(),
-                                     m_loadedEvents->size());
+                    updateTimeLabels(getPlayedEventCount(),
+                                     getPlayedEventCount());
                 }
                 emit playbackStopped();
                 spdlog::info("PlaybackWidget: Playback completed");
@@ -707,25 +1124,25 @@ void PlaybackWidget::updateTimeLabels(size_t currentEvent, size_t totalEvents)
     }
 
     // Calculate current time based on event timestamps
-    auto firstEventTime = (*m_loadedEvents)[0]->getTimestamp();
+    uint64_t firstEventTimeMs = getPlayedTimestampMs(0);
     auto totalDuration = std::chrono::milliseconds(0);
     auto currentDuration = std::chrono::milliseconds(0);
 
+    // The player may still hold the events of a previously loaded file
+    totalEvents = std::min(totalEvents, getPlayedEventCount());
+    currentEvent = std::min(currentEvent, totalEvents);
+
     if (totalEvents > 0)
     {
         // Calculate total duration (time from first to last event)
-        auto lastEventTime = (*m_loadedEvents)[totalEvents - 1]->getTimestamp();
-        totalDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            lastEventTime - firstEventTime);
+        totalDuration = std::chrono::milliseconds(
+            getPlayedTimestampMs(totalEvents - 1) - firstEventTimeMs);
 
         // Calculate current duration based on current event position
         if (currentEvent > 0 && currentEvent <= totalEvents)
         {
-            auto currentEventTime =
-                (*m_loadedEvents)[currentEvent - 1]->getTimestamp();
-            currentDuration =
-                std::chrono::duration_cast<std::chrono::milliseconds>(
-                    currentEventTime - firstEventTime);
+            currentDuration = std::chrono::milliseconds(
+                getPlayedTimestampMs(currentEvent - 1) - firstEventTimeMs);
         }
     }
 
@@ -733,6 +1150,19 @@ void PlaybackWidget::updateTimeLabels(size_t currentEvent, size_t totalEvents)
     ui->totalTimeLabel->setText(formatTime(totalDuration));
 }
 
+size_t PlaybackWidget::getPlayedEventCount() const
+{
+    return static_cast<size_t>(
+        m_loadedSegments.getExpandedCount(m_loadedEvents->size()));
+}
+
+uint64_t PlaybackWidget::getPlayedTimestampMs(size_t position) const
+{
+    auto location = m_loadedSegments.locate(position);
+    return (*m_loadedEvents)[location.event]->getTimestampMs() +
+           location.offsetMs;
+}
+
 QString PlaybackWidget::formatTime(std::chrono::milliseconds duration)
 {
     auto totalSeconds = duration.count() / 1000;
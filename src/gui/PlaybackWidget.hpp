@@ -8,6 +8,13 @@
 #include <QWidget>
 #include "core/IEventPlayer.hpp"
 #include "core/EventTypes.hpp"
+#include "core/RepeatedSegmentDetector.hpp"
+#include "storage/BinaryEventStorage.hpp"
+#include "storage/RecordingCache.hpp"
+#include "storage/RecordingJournal.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
 
 namespace Ui
 {
@@ -19,6 +26,13 @@ namespace MouseRecorder::Application
 class MouseRecorderApp;
 }
 
+namespace MouseRecorder::Core
+{
+class IEventStorage;
+class StorageTask;
+struct StorageMetadata;
+} // namespace MouseRecorder::Core
+
 namespace MouseRecorder::GUI
 {
 
@@ -34,7 +48,13 @@ class PlaybackWidget : public QWidget
                             QWidget* parent = nullptr);
     ~PlaybackWidget();
 
-    // Public method for testing
+    /**
+     * @brief Start loading a recording in the background
+     *
+     * Metadata and events show up as they are decoded; playback can start
+     * once the first events are there. fileLoaded() is emitted when the
+     * whole file has been loaded. Public for testing.
+     */
     void loadFile(const QString& fileName);
 
   signals:
@@ -46,6 +66,8 @@ class PlaybackWidget : public QWidget
   private slots:
     void onBrowseFile();
     void onReloadFile();
+    void onFollowToggled(bool enabled);
+    void onFollowTimer();
     void onPlay();
     void onStop();
     void onSpeedChanged(int value);
@@ -69,6 +91,30 @@ class PlaybackWidget : public QWidget
                             size_t total);
     void onEventPlayed(const Core::Event& event);
 
+    // Progressive loading, called on the GUI thread for the load with the
+    // given generation
+    void onMetadataLoaded(uint64_t generation,
+                          const Core::StorageMetadata& metadata);
+    void onEventsLoaded(uint64_t generation, Core::EventVector events);
+    void onLoadFinished(uint64_t generation, bool success);
+    Core::StorageTaskCallbacks makeLoadCallbacks(uint64_t generation);
+    void showCachedRecording(const Storage::CachedRecording& recording);
+    void loadJournal(const QString& fileName);
+    void loadLoopedFile(const QString& fileName, uint64_t generation);
+
+    // Following a journal that is still being written; appendNewEvents()
+    // returns false if the file needs a full load instead
+    bool appendNewEvents();
+    void stopFollowing();
+    void cancelLoading();
+    void updateLoadedEventsInfo();
+    void updateEventsPreview();
+
+    // Events of the loaded recording as they are played, with its repeated
+    // segments expanded
+    size_t getPlayedEventCount() const;
+    uint64_t getPlayedTimestampMs(size_t position) const;
+
     // Helper methods for time display
     void updateTimeLabels(size_t currentEvent, size_t totalEvents);
     QString formatTime(std::chrono::milliseconds duration);
@@ -82,10 +128,36 @@ class PlaybackWidget : public QWidget
     Application::MouseRecorderApp& m_app;
     QString m_currentFile;
     bool m_fileLoaded{false};
-    // Using unique_ptr to avoid Qt MOC registration issues with non-copyable
-    // types
-    std::unique_ptr<Core::EventVector> m_loadedEvents;
+    // Shared with the recording cache once the load finished; until then
+    // m_loadingEvents is the same vector, the only one that may change it
+    std::shared_ptr<const Core::EventVector> m_loadedEvents;
+    std::shared_ptr<Core::EventVector> m_loadingEvents;
+
+    // Repeated segments of a looped recording, whose m_loadedEvents are
+    // the stored events only; the player expands them as it plays
+    Core::SegmentIndex m_loadedSegments;
+
+    // Load in progress; the task runs on m_loadStorage
+    std::unique_ptr<Core::IEventStorage> m_loadStorage;
+    std::unique_ptr<Core::StorageTask> m_loadTask;
+    uint64_t m_loadGeneration{0};
+    bool m_loading{false};
+    size_t m_expectedEvents{0};
+    uint64_t m_expectedDurationMs{0};
+
+    // File as it was when the load started and its metadata, for caching
+    // the loaded recording
+    std::optional<Storage::FileStamp> m_loadStamp;
+    Core::StorageMetadata m_loadMetadata;
+
+    // Whether loaded events are appended to a running playback
+    bool m_streamingToPlayer{false};
     QTimer* m_updateTimer{nullptr};
+
+    // Where the next incremental reload continues in the loaded autosave
+    // journal; empty for files that cannot grow
+    std::optional<Storage::RecordingJournal::ReadPosition> m_journalTail;
+    QTimer* m_followTimer{nullptr};
 };
 
 } // namespace MouseRecorder::GUI
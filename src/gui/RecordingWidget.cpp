@@ -7,12 +7,13 @@
 #include "ui_RecordingWidget.h"
 #include "../application/MouseRecorderApp.hpp"
 #include "../core/IConfiguration.hpp"
+#include "../core/Tracing.hpp"
 #include <QTimer>
 #include <QTableWidget>
 #include <QTableWidgetItem>
 #include <QHeaderView>
 #include <QDateTime>
-#include <spdlog/spdlog.h>
+#include "../core/SpdlogConfig.hpp"
 
 namespace MouseRecorder::GUI
 {
@@ -208,6 +209,7 @@ void RecordingWidget::addEvent(const Core::Event* event)
     if (!event)
         return;
 
+    MOUSERECORDER_TRACE_SCOPE("gui", "addEvent");
     int row = ui->eventsTableWidget->rowCount();
     ui->eventsTableWidget->insertRow(row);
 
@@ -0,0 +1,98 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "StorageTaskRunner.hpp"
+#include "TestUtils.hpp"
+#include <QMetaObject>
+#include <QProgressDialog>
+#include <QWidget>
+#include <algorithm>
+
+namespace MouseRecorder::GUI
+{
+
+namespace
+{
+
+// Resolution of the progress dialog
+constexpr int PROGRESS_STEPS = 1000;
+
+// Quick operations finish before the dialog would flash up
+constexpr int DIALOG_DELAY_MS = 500;
+
+} // namespace
+
+StorageTaskRunner::StorageTaskRunner(const QString& label, QWidget* parent)
+    : m_label(label), m_parent(parent)
+{
+}
+
+Core::StorageTaskCallbacks StorageTaskRunner::callbacks(
+    Core::StorageTaskCallbacks callbacks)
+{
+    // Called on the storage thread; queued calls to a destroyed runner are
+    // dropped by Qt
+    callbacks.progress =
+        [this, next = std::move(callbacks.progress)](std::uint64_t done,
+                                                     std::uint64_t total)
+    {
+        if (next)
+        {
+            next(done, total);
+        }
+        QMetaObject::invokeMethod(
+            this,
+            [this, done, total]() { onProgress(done, total); },
+            Qt::QueuedConnection);
+    };
+    callbacks.completion = [this, next = std::move(callbacks.completion)](
+                               bool success)
+    {
+        if (next)
+        {
+            next(success);
+        }
+        QMetaObject::invokeMethod(
+            this, [this]() { m_loop.quit(); }, Qt::QueuedConnection);
+    };
+    return callbacks;
+}
+
+bool StorageTaskRunner::run(Core::StorageTask& task)
+{
+    if (!TestUtils::isTestEnvironment())
+    {
+        m_dialog = new QProgressDialog(
+            m_label, "Cancel", 0, PROGRESS_STEPS, m_parent.data());
+        m_dialog->setWindowModality(Qt::WindowModal);
+        m_dialog->setMinimumDuration(DIALOG_DELAY_MS);
+        m_dialog->setAutoClose(false);
+        m_dialog->setAutoReset(false);
+        connect(m_dialog,
+                &QProgressDialog::canceled,
+                this,
+                [&task]() { task.cancel(); });
+    }
+
+    // The completion callback quits the loop; it may already have run
+    if (!task.isFinished())
+    {
+        m_loop.exec();
+    }
+
+    delete m_dialog;
+    return task.wait();
+}
+
+void StorageTaskRunner::onProgress(std::uint64_t done, std::uint64_t total)
+{
+    if (m_dialog && total > 0)
+    {
+        m_dialog->setValue(
+            static_cast<int>(PROGRESS_STEPS * std::min(done, total) / total));
+    }
+}
+
+} // namespace MouseRecorder::GUI
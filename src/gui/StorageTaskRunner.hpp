@@ -0,0 +1,65 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "core/StorageTask.hpp"
+#include <QEventLoop>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+class QProgressDialog;
+class QWidget;
+
+namespace MouseRecorder::GUI
+{
+
+/**
+ * @brief Waits for an asynchronous save or load without freezing the GUI
+ *
+ * run() spins a local event loop until the task has finished, so callers
+ * keep their straight-line flow while the window keeps repainting. Tasks
+ * taking longer than a moment show a window-modal progress dialog whose
+ * Cancel button cancels the task.
+ */
+class StorageTaskRunner : public QObject
+{
+    Q_OBJECT
+
+  public:
+    /**
+     * @param label Progress dialog text, e.g. "Saving events..."
+     * @param parent Window the progress dialog is modal to
+     */
+    StorageTaskRunner(const QString& label, QWidget* parent);
+
+    /**
+     * @brief Add progress and completion reporting to callbacks
+     *
+     * Pass the result to saveEventsAsync() or loadEventsAsync() and the
+     * returned task to run().
+     * @param callbacks Callbacks to extend, e.g. with a prepare step
+     */
+    Core::StorageTaskCallbacks callbacks(
+        Core::StorageTaskCallbacks callbacks = {});
+
+    /**
+     * @brief Process GUI events until task has finished
+     * @return true if the task succeeded
+     */
+    bool run(Core::StorageTask& task);
+
+  private:
+    void onProgress(std::uint64_t done, std::uint64_t total);
+
+  private:
+    QString m_label;
+    QPointer<QWidget> m_parent;
+    QEventLoop m_loop;
+    QPointer<QProgressDialog> m_dialog;
+};
+
+} // namespace MouseRecorder::GUI
@@ -12,6 +12,7 @@
 #include <QIcon>
 #include "version.hpp"
 #include "core/SpdlogConfig.hpp"
+#include "core/Tracing.hpp"
 
 #include "application/MouseRecorderApp.hpp"
 #include "gui/MainWindow.hpp"
@@ -55,8 +56,20 @@ int main(int argc, char* argv[])
         "info");
     parser.addOption(logLevelOption);
 
+    QCommandLineOption traceOption(
+        QStringList() << "trace",
+        "Record a performance trace and write it as Chrome trace JSON on exit",
+        "trace_file");
+    parser.addOption(traceOption);
+
     parser.process(app);
 
+    QString traceFile = parser.value(traceOption);
+    if (!traceFile.isEmpty())
+    {
+        MouseRecorder::Core::Tracer::instance().setEnabled(true);
+    }
+
     // Get configuration file path
     QString configFile = parser.value(configOption);
     if (configFile.isEmpty())
@@ -126,6 +139,12 @@ int main(int argc, char* argv[])
     // Run the application
     int result = app.exec();
 
+    if (!traceFile.isEmpty())
+    {
+        MouseRecorder::Core::Tracer::instance().writeChromeTrace(
+            traceFile.toStdString());
+    }
+
     spdlog::info("MouseRecorder application exiting with code {}", result);
     return result;
 }
@@ -5,6 +5,7 @@
 
 #include "LinuxEventCapture.hpp"
 #include "core/Event.hpp"
+#include "core/Tracing.hpp"
 #include "application/MouseRecorderApp.hpp"
 #include <X11/extensions/XTest.h>
 #include <X11/XKBlib.h>
@@ -16,8 +17,26 @@
 namespace MouseRecorder::Platform::Linux
 {
 
-LinuxEventCapture::LinuxEventCapture(const Core::IConfiguration& config)
-    : m_config(config)
+LinuxEventCapture::LinuxEventCapture(const Core::IConfiguration& config,
+                                     Core::IClock& clock)
+    : m_config(config), m_clock(clock),
+      m_eventsMetric(Core::MetricsRegistry::instance().counter(
+          Core::MetricNames::CAPTURE_EVENTS,
+          "Events delivered by the capture thread")),
+      m_queueDepthMetric(Core::MetricsRegistry::instance().gauge(
+          Core::MetricNames::CAPTURE_QUEUE_DEPTH,
+          "X events pending when the capture thread last polled")),
+      m_droppedOverflowMetric(Core::MetricsRegistry::instance().counter(
+          Core::MetricNames::CAPTURE_DROPPED_EVENTS,
+          "Captured events dropped before delivery",
+          {{"reason", "buffer_overflow"}})),
+      m_droppedExpiredMetric(Core::MetricsRegistry::instance().counter(
+          Core::MetricNames::CAPTURE_DROPPED_EVENTS,
+          "Captured events dropped before delivery",
+          {{"reason", "buffer_expired"}})),
+      m_filteredMetric(Core::MetricsRegistry::instance().counter(
+          Core::MetricNames::CAPTURE_FILTERED_EVENTS,
+          "Modifier events removed as part of the stop recording shortcut"))
 {
     spdlog::debug("LinuxEventCapture: Constructor");
 }
@@ -79,6 +98,7 @@ bool LinuxEventCapture::startRecording(EventCallback callback)
 
     // Reset state
     m_hasLastMousePosition.store(false);
+    m_configSnapshot = m_config.getSnapshot();
 
     // Start event thread
     m_eventThread =
@@ -233,22 +253,31 @@ bool LinuxEventCapture::setupEventMasks()
 void LinuxEventCapture::eventLoop()
 {
     spdlog::debug("LinuxEventCapture: Event loop started");
+    Core::Tracer::instance().setThreadName("capture");
 
     while (!m_shouldStop.load())
     {
-        if (XPending(m_display) > 0)
+        int pending = XPending(m_display);
+        m_queueDepthMetric.set(pending);
+        if (pending > 0)
         {
-            XEvent event;
-            XNextEvent(m_display, &event);
+            // Pick up configuration changes once per batch, not per event
+            m_configSnapshot = m_config.getSnapshot();
 
-            if (XGetEventData(m_display, &event.xcookie))
+            while (pending-- > 0)
             {
-                if (event.xcookie.type == GenericEvent &&
-                    event.xcookie.extension == m_xiOpcode)
+                XEvent event;
+                XNextEvent(m_display, &event);
+
+                if (XGetEventData(m_display, &event.xcookie))
                 {
-                    processRawEvent(&event);
+                    if (event.xcookie.type == GenericEvent &&
+                        event.xcookie.extension == m_xiOpcode)
+                    {
+                        processRawEvent(&event);
+                    }
+                    XFreeEventData(m_display, &event.xcookie);
                 }
-                XFreeEventData(m_display, &event.xcookie);
             }
         }
         else
@@ -263,6 +292,7 @@ void LinuxEventCapture::eventLoop()
 
 void LinuxEventCapture::processRawEvent(XEvent* event)
 {
+    MOUSERECORDER_TRACE_SCOPE("capture", "processRawEvent");
     XIRawEvent* data = static_cast<XIRawEvent*>(event->xcookie.data);
 
     switch (data->evtype)
@@ -296,7 +326,7 @@ void LinuxEventCapture::processRawMouseEvent(XIRawEvent* data)
         if (shouldRecordMouseMovement(currentPos))
         {
             auto event = Core::EventFactory::createMouseMoveEvent(currentPos);
-            m_eventCallback(std::move(event));
+            emitEvent(std::move(event));
             m_lastMousePosition = currentPos;
             m_hasLastMousePosition.store(true);
         }
@@ -331,7 +361,7 @@ void LinuxEventCapture::processRawMouseEvent(XIRawEvent* data)
                 (data->detail == 4 || data->detail == 6) ? 120 : -120;
             auto event = Core::EventFactory::createMouseWheelEvent(currentPos,
                                                                    wheelDelta);
-            m_eventCallback(std::move(event));
+            emitEvent(std::move(event));
             return;
         }
         default:
@@ -340,7 +370,7 @@ void LinuxEventCapture::processRawMouseEvent(XIRawEvent* data)
 
         auto event =
             Core::EventFactory::createMouseClickEvent(currentPos, button);
-        m_eventCallback(std::move(event));
+        emitEvent(std::move(event));
         break;
     }
 
@@ -364,8 +394,8 @@ void LinuxEventCapture::processRawKeyEvent(XIRawEvent* data)
         // Check if this completes a stop recording shortcut
         if (isStopRecordingShortcut(data->detail))
         {
-            spdlog::debug("LinuxEventCapture: Detected stop recording "
-                          "shortcut, filtering recent modifiers");
+            SPDLOG_DEBUG("LinuxEventCapture: Detected stop recording "
+                         "shortcut, filtering recent modifiers");
             // Filter out recent modifier events that are part of this shortcut
             filterRecentModifierEvents();
             // Don't record this final key either
@@ -378,8 +408,8 @@ void LinuxEventCapture::processRawKeyEvent(XIRawEvent* data)
         // If this is a modifier key and filtering is enabled, buffer it briefly
         // in case it's part of a stop shortcut
         if (isModifierKey(data->detail) &&
-            m_config.getBool(Core::ConfigKeys::FILTER_STOP_RECORDING_SHORTCUT,
-                             true))
+            m_configSnapshot->getBool(
+                Core::ConfigKeyId::FilterStopRecordingShortcut, true))
         {
             bufferEvent(std::move(event));
         }
@@ -387,7 +417,7 @@ void LinuxEventCapture::processRawKeyEvent(XIRawEvent* data)
         {
             // Flush any buffered events first, then send this one
             flushEventBuffer();
-            m_eventCallback(std::move(event));
+            emitEvent(std::move(event));
         }
         break;
     }
@@ -400,12 +430,18 @@ void LinuxEventCapture::processRawKeyEvent(XIRawEvent* data)
         flushEventBuffer(); // Flush any pending events first
         auto event =
             Core::EventFactory::createKeyReleaseEvent(data->detail, keyName);
-        m_eventCallback(std::move(event));
+        emitEvent(std::move(event));
         break;
     }
     }
 }
 
+void LinuxEventCapture::emitEvent(std::unique_ptr<Core::Event> event)
+{
+    m_eventsMetric.increment();
+    m_eventCallback(std::move(event));
+}
+
 std::string LinuxEventCapture::getKeyName(KeyCode keycode)
 {
     if (!m_display)
@@ -485,8 +521,8 @@ void LinuxEventCapture::setLastError(const std::string& error)
 bool LinuxEventCapture::isStopRecordingShortcut(KeyCode keycode)
 {
     // If shortcut filtering is disabled, never filter
-    if (!m_config.getBool(Core::ConfigKeys::FILTER_STOP_RECORDING_SHORTCUT,
-                          true))
+    if (!m_configSnapshot->getBool(
+            Core::ConfigKeyId::FilterStopRecordingShortcut, true))
     {
         return false;
     }
@@ -500,15 +536,15 @@ bool LinuxEventCapture::isStopRecordingShortcut(KeyCode keycode)
     }
 
     // Only check against the stop recording shortcut
-    auto stopRecording = m_config.getString(
-        Core::ConfigKeys::SHORTCUT_STOP_RECORDING, "Ctrl+Shift+R");
+    auto stopRecording = m_configSnapshot->getString(
+        Core::ConfigKeyId::ShortcutStopRecording, "Ctrl+Shift+R");
 
     bool isStopShortcut = (currentSequence == stopRecording);
 
     if (isStopShortcut)
     {
-        spdlog::debug("LinuxEventCapture: Detected stop recording shortcut: {}",
-                      currentSequence);
+        SPDLOG_DEBUG("LinuxEventCapture: Detected stop recording shortcut: {}",
+                     currentSequence);
     }
 
     return isStopShortcut;
@@ -664,7 +700,7 @@ void LinuxEventCapture::bufferEvent(std::unique_ptr<Core::Event> event)
     // Add event to buffer with current timestamp
     BufferedEvent bufferedEvent;
     bufferedEvent.event = std::move(event);
-    bufferedEvent.timestamp = std::chrono::steady_clock::now();
+    bufferedEvent.timestamp = m_clock.now();
 
     m_eventBuffer.push_back(std::move(bufferedEvent));
 
@@ -672,18 +708,21 @@ void LinuxEventCapture::bufferEvent(std::unique_ptr<Core::Event> event)
     if (m_eventBuffer.size() > MAX_BUFFER_SIZE)
     {
         m_eventBuffer.erase(m_eventBuffer.begin());
+        m_droppedOverflowMetric.increment();
     }
 
     // Remove events older than timeout
-    auto now = std::chrono::steady_clock::now();
-    m_eventBuffer.erase(std::remove_if(m_eventBuffer.begin(),
-                                       m_eventBuffer.end(),
-                                       [now](const BufferedEvent& buffered)
-                                       {
-                                           return (now - buffered.timestamp) >
-                                                  BUFFER_TIMEOUT;
-                                       }),
-                        m_eventBuffer.end());
+    auto now = m_clock.now();
+    auto expired = std::remove_if(m_eventBuffer.begin(),
+                                  m_eventBuffer.end(),
+                                  [now](const BufferedEvent& buffered)
+                                  {
+                                      return (now - buffered.timestamp) >
+                                             BUFFER_TIMEOUT;
+                                  });
+    m_droppedExpiredMetric.increment(
+        static_cast<std::uint64_t>(m_eventBuffer.end() - expired));
+    m_eventBuffer.erase(expired, m_eventBuffer.end());
 }
 
 void LinuxEventCapture::flushEventBuffer()
@@ -695,7 +734,7 @@ void LinuxEventCapture::flushEventBuffer()
     {
         if (bufferedEvent.event && m_eventCallback)
         {
-            m_eventCallback(std::move(bufferedEvent.event));
+            emitEvent(std::move(bufferedEvent.event));
         }
     }
 
@@ -707,8 +746,9 @@ void LinuxEventCapture::filterRecentModifierEvents()
     std::lock_guard<std::mutex> lock(m_bufferMutex);
 
     // Remove recent modifier key events from buffer
-    auto now = std::chrono::steady_clock::now();
+    auto now = m_clock.now();
 
+    size_t sizeBefore = m_eventBuffer.size();
     m_eventBuffer.erase(
         std::remove_if(m_eventBuffer.begin(),
                        m_eventBuffer.end(),
@@ -738,8 +778,9 @@ void LinuxEventCapture::filterRecentModifierEvents()
                            return isModifierKey(keyData->keyCode);
                        }),
         m_eventBuffer.end());
+    m_filteredMetric.increment(sizeBefore - m_eventBuffer.size());
 
-    spdlog::debug(
+    SPDLOG_DEBUG(
         "LinuxEventCapture: Filtered recent modifier events from buffer");
 }
 
@@ -5,8 +5,11 @@
 
 #pragma once
 
+#include "core/Clock.hpp"
 #include "core/IEventRecorder.hpp"
 #include "core/IConfiguration.hpp"
+#include "core/ConfigSnapshot.hpp"
+#include "core/Metrics.hpp"
 #include <X11/Xlib.h>
 #include <X11/extensions/XInput2.h>
 #include <memory>
@@ -29,7 +32,13 @@ namespace MouseRecorder::Platform::Linux
 class LinuxEventCapture : public Core::IEventRecorder
 {
   public:
-    explicit LinuxEventCapture(const Core::IConfiguration& config);
+    /**
+     * @param config Configuration to read capture settings from
+     * @param clock Clock used to age out buffered events
+     */
+    explicit LinuxEventCapture(
+        const Core::IConfiguration& config,
+        Core::IClock& clock = Core::SystemClock::instance());
     ~LinuxEventCapture() override;
 
     // IEventRecorder interface
@@ -83,6 +92,12 @@ class LinuxEventCapture : public Core::IEventRecorder
      */
     void processRawKeyEvent(XIRawEvent* data);
 
+    /**
+     * @brief Count an event and hand it to the recording callback
+     * @param event Captured event
+     */
+    void emitEvent(std::unique_ptr<Core::Event> event);
+
     /**
      * @brief Convert X11 keycode to key name
      * @param keycode X11 keycode
@@ -151,6 +166,10 @@ class LinuxEventCapture : public Core::IEventRecorder
   private:
     // Configuration reference
     const Core::IConfiguration& m_config;
+    Core::IClock& m_clock;
+
+    // Configuration snapshot read by the event thread, refreshed per batch
+    std::shared_ptr<const Core::ConfigSnapshot> m_configSnapshot;
 
     // X11 resources
     Display* m_display{nullptr};
@@ -188,6 +207,13 @@ class LinuxEventCapture : public Core::IEventRecorder
     static constexpr size_t MAX_BUFFER_SIZE = 10;
     static constexpr std::chrono::milliseconds BUFFER_TIMEOUT{500};
 
+    // Metrics, looked up once since they are updated per event
+    Core::Counter& m_eventsMetric;
+    Core::Gauge& m_queueDepthMetric;
+    Core::Counter& m_droppedOverflowMetric;
+    Core::Counter& m_droppedExpiredMetric;
+    Core::Counter& m_filteredMetric;
+
     // Callback and error handling
     EventCallback m_eventCallback;
     mutable std::mutex m_errorMutex;
@@ -5,6 +5,7 @@
 
 #include "LinuxEventReplay.hpp"
 #include "core/Event.hpp"
+#include "core/Tracing.hpp"
 #include "application/MouseRecorderApp.hpp"
 #include <X11/extensions/XTest.h>
 #include <X11/XKBlib.h>
@@ -12,6 +13,7 @@
 #include "core/SpdlogConfig.hpp"
 #include <algorithm>
 #include <csignal>
+#include <iterator>
 #include <atomic>
 #include <string>
 
@@ -40,7 +42,17 @@ static void emergencyCleanupHandler(int signal)
     std::exit(signal);
 }
 
-LinuxEventReplay::LinuxEventReplay()
+LinuxEventReplay::LinuxEventReplay(Core::IClock& clock)
+    : m_clock(clock),
+      m_eventsMetric(Core::MetricsRegistry::instance().counter(
+          Core::MetricNames::REPLAY_EVENTS, "Events replayed")),
+      m_failedEventsMetric(Core::MetricsRegistry::instance().counter(
+          Core::MetricNames::REPLAY_FAILED_EVENTS,
+          "Events that failed to replay")),
+      m_latenessMetric(Core::MetricsRegistry::instance().histogram(
+          Core::MetricNames::REPLAY_LATENESS,
+          "How late events were injected relative to their schedule",
+          Core::MetricsRegistry::latencyBuckets()))
 {
     spdlog::debug("LinuxEventReplay: Constructor");
     // Install signal handlers for emergency cleanup
@@ -57,6 +69,7 @@ LinuxEventReplay::~LinuxEventReplay()
     if (m_state.load() != Core::PlaybackState::Stopped)
     {
         m_shouldStop.store(true);
+        wakePlaybackThread();
         m_state.store(Core::PlaybackState::Stopped);
 
         if (m_playbackThread && m_playbackThread->joinable())
@@ -94,7 +107,15 @@ LinuxEventReplay::~LinuxEventReplay()
 bool LinuxEventReplay::loadEvents(
     std::vector<std::unique_ptr<Core::Event>> events)
 {
-    spdlog::info("LinuxEventReplay: Loading {} events", events.size());
+    return loadLoopedEvents(Core::LoopedRecording{std::move(events), {}});
+}
+
+bool LinuxEventReplay::loadLoopedEvents(Core::LoopedRecording recording)
+{
+    spdlog::info("LinuxEventReplay: Loading {} events with {} repeated "
+                 "segments",
+                 recording.events.size(),
+                 recording.index.getSegments().size());
 
     // Enhanced state checking with timeout for safety
     auto currentState = m_state.load();
@@ -119,9 +140,15 @@ bool LinuxEventReplay::loadEvents(
         m_playbackThread.reset();
     }
 
-    m_events = std::move(events);
+    size_t eventCount = recording.getExpandedCount();
+    {
+        std::lock_guard<std::mutex> lock(m_eventsMutex);
+        m_events = std::move(recording.events);
+        m_segments = std::move(recording.index);
+        m_moreEventsPending = false;
+    }
     m_currentPosition.store(0);
-    m_totalEvents.store(m_events.size()); // Store thread-safe total count
+    m_totalEvents.store(eventCount); // Store thread-safe total count
 
     // Reset state to Stopped when loading new events
     setState(Core::PlaybackState::Stopped);
@@ -134,10 +161,40 @@ bool LinuxEventReplay::loadEvents(
     }
 
     spdlog::info("LinuxEventReplay: {} events loaded successfully",
-                 m_events.size());
+                 eventCount);
     return true;
 }
 
+bool LinuxEventReplay::appendEvents(
+    std::vector<std::unique_ptr<Core::Event>> events)
+{
+    size_t eventCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_eventsMutex);
+        m_events.insert(m_events.end(),
+                        std::make_move_iterator(events.begin()),
+                        std::make_move_iterator(events.end()));
+        eventCount = m_segments.getExpandedCount(m_events.size());
+    }
+    m_totalEvents.store(eventCount);
+    m_eventsAppended.notify_all();
+
+    SPDLOG_DEBUG("LinuxEventReplay: Appended {} events, {} loaded",
+                 events.size(),
+                 eventCount);
+    return true;
+}
+
+void LinuxEventReplay::setMoreEventsPending(bool pending)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_eventsMutex);
+        m_moreEventsPending = pending;
+    }
+    m_eventsAppended.notify_all();
+    spdlog::debug("LinuxEventReplay: More events pending set to {}", pending);
+}
+
 bool LinuxEventReplay::startPlayback(PlaybackCallback callback)
 {
     spdlog::info("LinuxEventReplay: Starting playback");
@@ -153,7 +210,7 @@ bool LinuxEventReplay::startPlayback(PlaybackCallback callback)
         return false;
     }
 
-    if (m_events.empty())
+    if (m_totalEvents.load() == 0)
     {
         setLastError("No events loaded for playback");
         return false;
@@ -215,6 +272,7 @@ void LinuxEventReplay::stopPlayback()
 
     // Signal the playback thread to stop
     m_shouldStop.store(true);
+    wakePlaybackThread();
 
     // Set state to stopping to prevent race conditions
     setState(Core::PlaybackState::Stopped);
@@ -484,59 +542,47 @@ void LinuxEventReplay::cleanupX11()
 void LinuxEventReplay::playbackLoop()
 {
     spdlog::debug("LinuxEventReplay: Playback loop started");
+    Core::Tracer::instance().setThreadName("replay");
 
     try
     {
-        // Get first event time for potential future timing calculations
-        [[maybe_unused]] auto startTime = std::chrono::steady_clock::now();
-        [[maybe_unused]] uint64_t firstEventTime = 0;
-
-        if (!m_events.empty())
-        {
-            firstEventTime = m_events[0]->getTimestampMs();
-        }
+        // Events are due at the time the pass started plus their offset from
+        // the pass's first event, so lateness includes execution time and
+        // drift rather than only oversleep. Re-anchored when the speed changes
+        std::optional<Core::IClock::TimePoint> scheduleStart;
+        uint64_t scheduleStartMs = 0;
+        double scheduleSpeed = m_playbackSpeed.load();
 
         // Reset loop iteration counter
         m_currentLoopIteration.store(0);
 
+        // Events that failed to execute, reported once per run instead of
+        // per event so a misbehaving replay doesn't slow itself down
+        size_t failedEvents = 0;
+
         do
         {
+            scheduleStart.reset();
+
             // Increment loop iteration for finite loops
             if (m_loopEnabled.load() && m_loopCount.load() > 0)
             {
                 m_currentLoopIteration.fetch_add(1);
-                spdlog::debug("LinuxEventReplay: Starting loop iteration {}/{}",
-                              m_currentLoopIteration.load(),
-                              m_loopCount.load());
+                SPDLOG_DEBUG("LinuxEventReplay: Starting loop iteration {}/{}",
+                             m_currentLoopIteration.load(),
+                             m_loopCount.load());
             }
-            for (size_t i = m_currentPosition.load();
-                 i < m_events.size() && !m_shouldStop.load();
+            for (size_t i = m_currentPosition.load(); !m_shouldStop.load();
                  ++i)
             {
-                // Safety check: ensure we're not accessing invalid memory
-                if (i >= m_events.size())
+                const Core::Event* event = nullptr;
+                uint64_t nextEventTime = 0;
+                std::optional<uint64_t> currentEventTime;
+                if (!waitForEvent(i, event, nextEventTime, currentEventTime))
                 {
-                    spdlog::error(
-                        "LinuxEventReplay: Index {} out of bounds (size: {})",
-                        i,
-                        m_events.size());
                     break;
                 }
 
-                if (m_shouldStop.load())
-                {
-                    break;
-                }
-
-                // Additional safety check after potential wait
-                if (i >= m_events.size())
-                {
-                    spdlog::warn(
-                        "LinuxEventReplay: Event index invalid after wait");
-                    break;
-                }
-
-                const auto& event = m_events[i];
                 if (!event)
                 {
                     spdlog::error("LinuxEventReplay: Null event at position {}",
@@ -544,19 +590,38 @@ void LinuxEventReplay::playbackLoop()
                     continue;
                 }
 
-                // Calculate delay
-                if (i > 0 && i - 1 < m_events.size())
+                // Keep the pace reached so far, only later events use a new
+                // speed
+                double speed = m_playbackSpeed.load();
+                if (scheduleStart && speed != scheduleSpeed &&
+                    currentEventTime && *currentEventTime >= scheduleStartMs)
                 {
-                    uint64_t currentEventTime =
-                        m_events[i - 1]->getTimestampMs();
-                    uint64_t nextEventTime = event->getTimestampMs();
-                    auto delay =
-                        calculateDelay(currentEventTime, nextEventTime);
+                    *scheduleStart += calculateDelay(
+                        scheduleStartMs, *currentEventTime, scheduleSpeed);
+                    scheduleStartMs = *currentEventTime;
+                }
+                scheduleSpeed = speed;
 
-                    if (delay.count() > 0)
+                if (!scheduleStart || nextEventTime < scheduleStartMs)
+                {
+                    scheduleStart = m_clock.now();
+                    scheduleStartMs = nextEventTime;
+                }
+                else
+                {
+                    auto deadline =
+                        *scheduleStart +
+                        calculateDelay(scheduleStartMs, nextEventTime, speed);
+                    auto wait = deadline - m_clock.now();
+                    if (wait.count() > 0)
                     {
-                        std::this_thread::sleep_for(delay);
+                        MOUSERECORDER_TRACE_SCOPE("replay", "waitForEvent");
+                        m_clock.sleepFor(wait);
                     }
+
+                    std::chrono::duration<double> lateness =
+                        m_clock.now() - deadline;
+                    m_latenessMetric.observe(std::max(lateness.count(), 0.0));
                 }
 
                 // Execute event callback
@@ -577,12 +642,26 @@ void LinuxEventReplay::playbackLoop()
                 // Execute the event with error handling
                 try
                 {
-                    if (!executeEvent(*event))
+                    if (executeEvent(*event))
                     {
-                        spdlog::warn(
-                            "LinuxEventReplay: Failed to execute event at "
-                            "position {}",
-                            i);
+                        m_eventsMetric.increment();
+                    }
+                    else
+                    {
+                        m_failedEventsMetric.increment();
+                        if (failedEvents++ == 0)
+                        {
+                            spdlog::warn(
+                                "LinuxEventReplay: Failed to execute event at "
+                                "position {}",
+                                i);
+                        }
+                        else
+                        {
+                            SPDLOG_DEBUG("LinuxEventReplay: Failed to execute "
+                                         "event at position {}",
+                                         i);
+                        }
                         // Continue with next event rather than stopping
                     }
                 }
@@ -626,12 +705,12 @@ void LinuxEventReplay::playbackLoop()
                 if (loopCount == 0) // Infinite loop
                 {
                     shouldContinueLoop = true;
-                    spdlog::debug("LinuxEventReplay: Continuing infinite loop");
+                    SPDLOG_DEBUG("LinuxEventReplay: Continuing infinite loop");
                 }
                 else if (currentIteration < loopCount) // Finite loop
                 {
                     shouldContinueLoop = true;
-                    spdlog::debug(
+                    SPDLOG_DEBUG(
                         "LinuxEventReplay: Continuing loop iteration {}/{}",
                         currentIteration,
                         loopCount);
@@ -656,6 +735,12 @@ void LinuxEventReplay::playbackLoop()
 
         } while (m_loopEnabled.load() && !m_shouldStop.load());
 
+        if (failedEvents > 0)
+        {
+            spdlog::warn("LinuxEventReplay: {} events failed to execute",
+                         failedEvents);
+        }
+
         if (!m_shouldStop.load())
         {
             // Clean up input state immediately when playback completes normally
@@ -687,8 +772,68 @@ void LinuxEventReplay::playbackLoop()
     spdlog::debug("LinuxEventReplay: Playback loop ended");
 }
 
+bool LinuxEventReplay::waitForEvent(
+    size_t index,
+    const Core::Event*& event,
+    uint64_t& timestampMs,
+    std::optional<uint64_t>& previousTimestampMs)
+{
+    std::unique_lock<std::mutex> lock(m_eventsMutex);
+    auto loaded = [this]()
+    { return m_segments.getExpandedCount(m_events.size()); };
+    if (index >= loaded() && m_moreEventsPending)
+    {
+        MOUSERECORDER_TRACE_SCOPE("replay", "waitForLoad");
+        spdlog::debug("LinuxEventReplay: Waiting for event {} to be loaded",
+                      index);
+        m_eventsAppended.wait(lock,
+                              [this, index, &loaded]()
+                              {
+                                  return index < loaded() ||
+                                         !m_moreEventsPending ||
+                                         m_shouldStop.load();
+                              });
+    }
+
+    if (index >= loaded() || m_shouldStop.load())
+    {
+        return false;
+    }
+
+    // Events stay in place when m_events grows, only their owners move
+    auto location = m_segments.locate(index);
+    event = m_events[location.event].get();
+    if (!event)
+    {
+        return true;
+    }
+    timestampMs = event->getTimestampMs() + location.offsetMs;
+
+    previousTimestampMs.reset();
+    if (index > 0)
+    {
+        auto previous = m_segments.locate(index - 1);
+        if (const auto* previousEvent = m_events[previous.event].get())
+        {
+            previousTimestampMs =
+                previousEvent->getTimestampMs() + previous.offsetMs;
+        }
+    }
+    return true;
+}
+
+void LinuxEventReplay::wakePlaybackThread()
+{
+    // Lock so the wakeup can't slip in between a check and the wait
+    {
+        std::lock_guard<std::mutex> lock(m_eventsMutex);
+    }
+    m_eventsAppended.notify_all();
+}
+
 bool LinuxEventReplay::executeEvent(const Core::Event& event)
 {
+    MOUSERECORDER_TRACE_SCOPE("replay", "executeEvent");
     switch (event.getType())
     {
     case Core::EventType::MouseMove:
@@ -918,7 +1063,7 @@ KeyCode LinuxEventReplay::getKeycodeFromName(const std::string& keyName)
 }
 
 std::chrono::milliseconds LinuxEventReplay::calculateDelay(
-    uint64_t currentEventTime, uint64_t nextEventTime)
+    uint64_t currentEventTime, uint64_t nextEventTime, double speed)
 {
     if (nextEventTime <= currentEventTime)
     {
@@ -926,7 +1071,6 @@ std::chrono::milliseconds LinuxEventReplay::calculateDelay(
     }
 
     uint64_t originalDelay = nextEventTime - currentEventTime;
-    double speed = m_playbackSpeed.load();
 
     if (speed <= 0.0)
     {
@@ -5,9 +5,12 @@
 
 #pragma once
 
+#include "core/Clock.hpp"
 #include "core/IEventPlayer.hpp"
+#include "core/Metrics.hpp"
 #include <X11/Xlib.h>
 #include <memory>
+#include <optional>
 #include <thread>
 #include <atomic>
 #include <mutex>
@@ -27,11 +30,19 @@ namespace MouseRecorder::Platform::Linux
 class LinuxEventReplay : public Core::IEventPlayer
 {
   public:
-    LinuxEventReplay();
+    /**
+     * @param clock Clock used to wait between events and measure lateness
+     */
+    explicit LinuxEventReplay(
+        Core::IClock& clock = Core::SystemClock::instance());
     ~LinuxEventReplay() override;
 
     // IEventPlayer interface
     bool loadEvents(std::vector<std::unique_ptr<Core::Event>> events) override;
+    bool loadLoopedEvents(Core::LoopedRecording recording) override;
+    bool appendEvents(
+        std::vector<std::unique_ptr<Core::Event>> events) override;
+    void setMoreEventsPending(bool pending) override;
     bool startPlayback(PlaybackCallback callback = nullptr) override;
     void stopPlayback() override;
     Core::PlaybackState getState() const noexcept override;
@@ -64,6 +75,29 @@ class LinuxEventReplay : public Core::IEventPlayer
      */
     void playbackLoop();
 
+    /**
+     * @brief Wait until the event at index has been loaded
+     *
+     * Repeated segments are expanded on the way: index counts their
+     * repetitions, and the stored event of a later repetition is played
+     * with its timestamp shifted.
+     * @param index Position of the event
+     * @param event Output event at index
+     * @param timestampMs Output time the event is played at
+     * @param previousTimestampMs Output time the event before it is
+     * played at, nothing for the first one
+     * @return false if playback should end instead
+     */
+    bool waitForEvent(size_t index,
+                      const Core::Event*& event,
+                      uint64_t& timestampMs,
+                      std::optional<uint64_t>& previousTimestampMs);
+
+    /**
+     * @brief Wake a playback thread waiting for events to be loaded
+     */
+    void wakePlaybackThread();
+
     /**
      * @brief Execute a single event
      * @param event Event to execute
@@ -96,10 +130,12 @@ class LinuxEventReplay : public Core::IEventPlayer
      * @brief Calculate delay until next event
      * @param currentEventTime Current event timestamp
      * @param nextEventTime Next event timestamp
+     * @param speed Playback speed, treated as 1.0 when not positive
      * @return delay in milliseconds
      */
-    std::chrono::milliseconds calculateDelay(uint64_t currentEventTime,
-                                             uint64_t nextEventTime);
+    static std::chrono::milliseconds calculateDelay(uint64_t currentEventTime,
+                                                    uint64_t nextEventTime,
+                                                    double speed);
 
     /**
      * @brief Set playback state and notify callbacks
@@ -124,8 +160,15 @@ class LinuxEventReplay : public Core::IEventPlayer
     Display* m_display{nullptr};
     Window m_rootWindow{0};
 
-    // Events and playback control
+    // Events and playback control; m_events grows during playback of
+    // recordings that are still being loaded
+    std::mutex m_eventsMutex;
+    std::condition_variable m_eventsAppended;
     std::vector<std::unique_ptr<Core::Event>> m_events;
+
+    // Repeated segments of m_events, expanded while playing
+    Core::SegmentIndex m_segments;
+    bool m_moreEventsPending{false};
     std::atomic<size_t> m_currentPosition{0};
     std::atomic<size_t> m_totalEvents{0}; // Thread-safe total events count
     std::atomic<Core::PlaybackState> m_state{Core::PlaybackState::Stopped};
@@ -146,6 +189,13 @@ class LinuxEventReplay : public Core::IEventPlayer
     std::set<KeyCode> m_pressedKeys;
     std::set<unsigned int> m_pressedButtons;
 
+    Core::IClock& m_clock;
+
+    // Metrics, looked up once since they are updated per event
+    Core::Counter& m_eventsMetric;
+    Core::Counter& m_failedEventsMetric;
+    Core::Histogram& m_latenessMetric;
+
     // Callbacks
     PlaybackCallback m_playbackCallback;
     EventCallback m_eventCallback;
@@ -0,0 +1,539 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "LinuxGlobalShortcutListener.hpp"
+#include <X11/XKBlib.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XInput2.h>
+#include "core/SpdlogConfig.hpp"
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace MouseRecorder::Platform::Linux
+{
+
+namespace
+{
+
+std::string toLower(std::string value)
+{
+    std::transform(value.begin(),
+                   value.end(),
+                   value.begin(),
+                   [](unsigned char c)
+                   {
+                       return static_cast<char>(std::tolower(c));
+                   });
+    return value;
+}
+
+std::string trim(const std::string& value)
+{
+    auto begin = value.find_first_not_of(" \t");
+    if (begin == std::string::npos)
+    {
+        return "";
+    }
+    auto end = value.find_last_not_of(" \t");
+    return value.substr(begin, end - begin + 1);
+}
+
+// Qt key names whose X11 keysym name differs
+std::string qtKeyNameToKeysymName(const std::string& qtName)
+{
+    static const std::map<std::string, std::string> names = {
+        {"space", "space"},
+        {"esc", "Escape"},
+        {"escape", "Escape"},
+        {"del", "Delete"},
+        {"delete", "Delete"},
+        {"ins", "Insert"},
+        {"insert", "Insert"},
+        {"pgup", "Prior"},
+        {"pgdown", "Next"},
+        {"backspace", "BackSpace"},
+        {"return", "Return"},
+        {"enter", "Return"},
+        {"tab", "Tab"},
+        {"home", "Home"},
+        {"end", "End"},
+        {"left", "Left"},
+        {"right", "Right"},
+        {"up", "Up"},
+        {"down", "Down"},
+        {"pause", "Pause"},
+        {"print", "Print"}};
+
+    if (qtName.length() == 1)
+    {
+        // Letters and digits use their lowercase character as keysym name
+        return toLower(qtName);
+    }
+
+    auto it = names.find(toLower(qtName));
+    return it != names.end() ? it->second : qtName;
+}
+
+unsigned int modifierFromName(const std::string& name)
+{
+    std::string modifier = toLower(name);
+    if (modifier == "ctrl" || modifier == "control")
+    {
+        return LinuxGlobalShortcutListener::CtrlModifier;
+    }
+    if (modifier == "shift")
+    {
+        return LinuxGlobalShortcutListener::ShiftModifier;
+    }
+    if (modifier == "alt")
+    {
+        return LinuxGlobalShortcutListener::AltModifier;
+    }
+    if (modifier == "meta" || modifier == "super" || modifier == "win")
+    {
+        return LinuxGlobalShortcutListener::MetaModifier;
+    }
+    return LinuxGlobalShortcutListener::NoModifier;
+}
+
+} // namespace
+
+LinuxGlobalShortcutListener::LinuxGlobalShortcutListener()
+{
+    spdlog::debug("LinuxGlobalShortcutListener: Constructor");
+}
+
+LinuxGlobalShortcutListener::~LinuxGlobalShortcutListener()
+{
+    stop();
+}
+
+bool LinuxGlobalShortcutListener::registerShortcut(int shortcutId,
+                                                   const std::string& sequence)
+{
+    KeySequence parsed;
+    if (!parseKeySequence(sequence, parsed) ||
+        XStringToKeysym(parsed.keyName.c_str()) == NoSymbol)
+    {
+        setLastError("Invalid shortcut sequence: " + sequence);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_shortcutsMutex);
+        m_shortcuts[shortcutId] = RegisteredShortcut{parsed, 0};
+    }
+
+    // Let the listener thread resolve the keycode on its own connection
+    if (m_running.load() && m_wakeupPipe[1] >= 0)
+    {
+        const char wake = 'r';
+        [[maybe_unused]] auto written = write(m_wakeupPipe[1], &wake, 1);
+    }
+
+    spdlog::debug("LinuxGlobalShortcutListener: Registered shortcut {} as {}",
+                  shortcutId,
+                  sequence);
+    return true;
+}
+
+void LinuxGlobalShortcutListener::unregisterShortcut(int shortcutId)
+{
+    std::lock_guard<std::mutex> lock(m_shortcutsMutex);
+    m_shortcuts.erase(shortcutId);
+}
+
+bool LinuxGlobalShortcutListener::start(ActivationCallback callback)
+{
+    if (m_running.load())
+    {
+        setLastError("Shortcut listener is already running");
+        return false;
+    }
+
+    // A listener that stopped on an error still holds its thread
+    stop();
+
+    if (!callback)
+    {
+        setLastError("Activation callback is required");
+        return false;
+    }
+
+    if (!initializeX11())
+    {
+        cleanupX11();
+        return false;
+    }
+
+    resolveKeycodes();
+
+    m_callback = std::move(callback);
+    m_pressedModifiers.clear();
+    m_activeShortcuts.clear();
+    m_shouldStop.store(false);
+    m_running.store(true);
+
+    m_listenerThread = std::make_unique<std::thread>(
+        &LinuxGlobalShortcutListener::eventLoop, this);
+
+    spdlog::info("LinuxGlobalShortcutListener: Listening for global shortcuts");
+    return true;
+}
+
+void LinuxGlobalShortcutListener::stop()
+{
+    if (!m_listenerThread)
+    {
+        return;
+    }
+
+    m_shouldStop.store(true);
+
+    if (m_wakeupPipe[1] >= 0)
+    {
+        const char wake = 'q';
+        [[maybe_unused]] auto written = write(m_wakeupPipe[1], &wake, 1);
+    }
+
+    if (m_listenerThread && m_listenerThread->joinable())
+    {
+        m_listenerThread->join();
+        m_listenerThread.reset();
+    }
+
+    m_running.store(false);
+    m_callback = nullptr;
+    cleanupX11();
+
+    spdlog::debug("LinuxGlobalShortcutListener: Stopped");
+}
+
+bool LinuxGlobalShortcutListener::isRunning() const noexcept
+{
+    return m_running.load();
+}
+
+std::string LinuxGlobalShortcutListener::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    return m_lastError;
+}
+
+bool LinuxGlobalShortcutListener::parseKeySequence(const std::string& sequence,
+                                                   KeySequence& result)
+{
+    result = KeySequence{};
+
+    if (sequence.empty() || sequence.back() == '+')
+    {
+        return false;
+    }
+
+    std::vector<std::string> tokens;
+    std::stringstream stream(sequence);
+    std::string token;
+    while (std::getline(stream, token, '+'))
+    {
+        tokens.push_back(trim(token));
+    }
+
+    if (tokens.empty() || tokens.back().empty() ||
+        modifierFromName(tokens.back()) != NoModifier)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i + 1 < tokens.size(); ++i)
+    {
+        unsigned int modifier = modifierFromName(tokens[i]);
+        if (modifier == NoModifier)
+        {
+            return false;
+        }
+        result.modifiers |= modifier;
+    }
+
+    result.keyName = qtKeyNameToKeysymName(tokens.back());
+    return true;
+}
+
+bool LinuxGlobalShortcutListener::initializeX11()
+{
+    m_display = XOpenDisplay(nullptr);
+    if (!m_display)
+    {
+        setLastError("Failed to open X11 display");
+        return false;
+    }
+
+    m_rootWindow = DefaultRootWindow(m_display);
+
+    int event, error;
+    if (!XQueryExtension(
+            m_display, "XInputExtension", &m_xiOpcode, &event, &error))
+    {
+        setLastError("XInput extension not available");
+        return false;
+    }
+
+    // Before XI 2.1 the server withholds raw events while any client,
+    // including our own menus, holds a keyboard grab
+    int major = 2, minor = 2;
+    if (XIQueryVersion(m_display, &major, &minor) == BadRequest)
+    {
+        setLastError(
+            "XInput2 not available. Server supports only version < 2.0");
+        return false;
+    }
+    if (major == 2 && minor < 1)
+    {
+        spdlog::warn("LinuxGlobalShortcutListener: XInput2 version {}.{}, "
+                     "shortcuts do not work while a keyboard grab is active",
+                     major,
+                     minor);
+    }
+
+    XIEventMask evmask;
+    unsigned char mask[XIMaskLen(XI_LASTEVENT)] = {0};
+    XISetMask(mask, XI_RawKeyPress);
+    XISetMask(mask, XI_RawKeyRelease);
+
+    evmask.deviceid = XIAllMasterDevices;
+    evmask.mask_len = sizeof(mask);
+    evmask.mask = mask;
+
+    if (XISelectEvents(m_display, m_rootWindow, &evmask, 1) != Success)
+    {
+        setLastError("Failed to select XInput2 key events");
+        return false;
+    }
+    XFlush(m_display);
+
+    if (pipe(m_wakeupPipe) != 0)
+    {
+        setLastError("Failed to create listener wakeup pipe");
+        return false;
+    }
+    fcntl(m_wakeupPipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(m_wakeupPipe[1], F_SETFL, O_NONBLOCK);
+
+    return true;
+}
+
+void LinuxGlobalShortcutListener::cleanupX11()
+{
+    if (m_display)
+    {
+        XCloseDisplay(m_display);
+        m_display = nullptr;
+    }
+
+    for (int& fd : m_wakeupPipe)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+void LinuxGlobalShortcutListener::resolveKeycodes()
+{
+    std::lock_guard<std::mutex> lock(m_shortcutsMutex);
+
+    for (auto& [id, shortcut] : m_shortcuts)
+    {
+        KeySym keysym = XStringToKeysym(shortcut.sequence.keyName.c_str());
+        shortcut.keycode =
+            keysym != NoSymbol ? XKeysymToKeycode(m_display, keysym) : 0;
+
+        if (shortcut.keycode == 0)
+        {
+            spdlog::warn("LinuxGlobalShortcutListener: No keycode for key '{}' "
+                         "(shortcut {})",
+                         shortcut.sequence.keyName,
+                         id);
+        }
+    }
+}
+
+void LinuxGlobalShortcutListener::eventLoop()
+{
+    spdlog::debug("LinuxGlobalShortcutListener: Event loop started");
+
+    pollfd fds[2];
+    fds[0].fd = ConnectionNumber(m_display);
+    fds[0].events = POLLIN;
+    fds[1].fd = m_wakeupPipe[0];
+    fds[1].events = POLLIN;
+
+    while (!m_shouldStop.load())
+    {
+        // Drain anything Xlib already buffered before blocking
+        while (XPending(m_display) > 0)
+        {
+            XEvent event;
+            XNextEvent(m_display, &event);
+
+            if (XGetEventData(m_display, &event.xcookie))
+            {
+                if (event.xcookie.type == GenericEvent &&
+                    event.xcookie.extension == m_xiOpcode)
+                {
+                    auto* data = static_cast<XIRawEvent*>(event.xcookie.data);
+                    processKey(static_cast<KeyCode>(data->detail),
+                               data->evtype == XI_RawKeyPress,
+                               (data->flags & XIKeyRepeat) != 0);
+                }
+                XFreeEventData(m_display, &event.xcookie);
+            }
+        }
+
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (waitForInput(fds, 2) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            setLastError("Shortcut listener poll failed: " +
+                         std::string(std::strerror(errno)));
+            m_running.store(false);
+            break;
+        }
+
+        if (fds[1].revents & POLLIN)
+        {
+            char buffer[16];
+            while (read(m_wakeupPipe[0], buffer, sizeof(buffer)) > 0)
+            {
+            }
+            // Shortcuts may have changed while we were waiting
+            resolveKeycodes();
+        }
+    }
+
+    spdlog::debug("LinuxGlobalShortcutListener: Event loop ended");
+}
+
+int LinuxGlobalShortcutListener::waitForInput(pollfd* fds, unsigned long count)
+{
+    return poll(fds, static_cast<nfds_t>(count), -1);
+}
+
+void LinuxGlobalShortcutListener::processKey(KeyCode keycode,
+                                             bool pressed,
+                                             bool repeated)
+{
+    if (unsigned int modifier = modifierForKeycode(keycode);
+        modifier != NoModifier)
+    {
+        if (pressed)
+        {
+            m_pressedModifiers.insert(keycode);
+        }
+        else
+        {
+            m_pressedModifiers.erase(keycode);
+        }
+        return;
+    }
+
+    std::vector<int> activated;
+    {
+        std::lock_guard<std::mutex> lock(m_shortcutsMutex);
+
+        if (!pressed)
+        {
+            for (const auto& [id, shortcut] : m_shortcuts)
+            {
+                if (shortcut.keycode == keycode)
+                {
+                    m_activeShortcuts.erase(id);
+                }
+            }
+            return;
+        }
+
+        if (repeated)
+        {
+            return;
+        }
+
+        unsigned int modifiers = NoModifier;
+        for (KeyCode pressedModifier : m_pressedModifiers)
+        {
+            modifiers |= modifierForKeycode(pressedModifier);
+        }
+
+        for (const auto& [id, shortcut] : m_shortcuts)
+        {
+            if (shortcut.keycode == keycode &&
+                shortcut.sequence.modifiers == modifiers &&
+                m_activeShortcuts.insert(id).second)
+            {
+                activated.push_back(id);
+            }
+        }
+    }
+
+    // Invoke callbacks outside the lock so they may re-register shortcuts
+    for (int id : activated)
+    {
+        try
+        {
+            m_callback(id);
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error(
+                "LinuxGlobalShortcutListener: Exception in callback: {}",
+                e.what());
+        }
+    }
+}
+
+unsigned int LinuxGlobalShortcutListener::modifierForKeycode(
+    KeyCode keycode) const
+{
+    switch (XkbKeycodeToKeysym(m_display, keycode, 0, 0))
+    {
+    case XK_Control_L:
+    case XK_Control_R:
+        return CtrlModifier;
+    case XK_Shift_L:
+    case XK_Shift_R:
+        return ShiftModifier;
+    case XK_Alt_L:
+    case XK_Alt_R:
+        return AltModifier;
+    case XK_Meta_L:
+    case XK_Meta_R:
+    case XK_Super_L:
+    case XK_Super_R:
+        return MetaModifier;
+    default:
+        return NoModifier;
+    }
+}
+
+void LinuxGlobalShortcutListener::setLastError(const std::string& error)
+{
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    m_lastError = error;
+    spdlog::error("LinuxGlobalShortcutListener: {}", error);
+}
+
+} // namespace MouseRecorder::Platform::Linux
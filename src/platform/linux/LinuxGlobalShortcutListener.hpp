@@ -0,0 +1,205 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <X11/Xlib.h>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <set>
+#include <string>
+
+struct pollfd;
+
+namespace MouseRecorder::Platform::Linux
+{
+
+/**
+ * @brief Event-driven global shortcut listener using X11 XInput2
+ *
+ * Keeps a single long-lived X11 connection and listens for raw key events on
+ * the root window. Raw events are delivered regardless of which client has
+ * focus and do not steal the key from other applications, so registered
+ * shortcuts behave like the previous keymap polling but without opening a
+ * new connection per check. The listener thread blocks on the connection's
+ * file descriptor and only wakes up when the server has input for it.
+ */
+class LinuxGlobalShortcutListener
+{
+  public:
+    /**
+     * @brief Modifier flags used in parsed key sequences
+     */
+    enum Modifier : unsigned int
+    {
+        NoModifier = 0,
+        CtrlModifier = 1 << 0,
+        ShiftModifier = 1 << 1,
+        AltModifier = 1 << 2,
+        MetaModifier = 1 << 3
+    };
+
+    /**
+     * @brief Key sequence broken down into modifiers and main key name
+     */
+    struct KeySequence
+    {
+        unsigned int modifiers{NoModifier};
+        std::string keyName; // X11 keysym name, e.g. "r" or "F5"
+    };
+
+    /**
+     * @brief Called from the listener thread when a shortcut is activated
+     * @param shortcutId Identifier passed to registerShortcut
+     */
+    using ActivationCallback = std::function<void(int shortcutId)>;
+
+    LinuxGlobalShortcutListener();
+    virtual ~LinuxGlobalShortcutListener();
+
+    LinuxGlobalShortcutListener(const LinuxGlobalShortcutListener&) = delete;
+    LinuxGlobalShortcutListener& operator=(const LinuxGlobalShortcutListener&) =
+        delete;
+
+    /**
+     * @brief Register or replace a shortcut
+     * @param shortcutId Caller-defined identifier reported on activation
+     * @param sequence Qt-style key sequence string (e.g., "Ctrl+Shift+R")
+     * @return true if the sequence could be parsed
+     */
+    bool registerShortcut(int shortcutId, const std::string& sequence);
+
+    /**
+     * @brief Remove a previously registered shortcut
+     * @param shortcutId Identifier passed to registerShortcut
+     */
+    void unregisterShortcut(int shortcutId);
+
+    /**
+     * @brief Open the X11 connection and start the listener thread
+     * @param callback Function to call when a shortcut is activated
+     * @return true if the listener is running
+     */
+    bool start(ActivationCallback callback);
+
+    /**
+     * @brief Stop the listener thread and close the X11 connection
+     */
+    void stop();
+
+    /**
+     * @brief Check if the listener thread is running
+     *
+     * Turns false when the listener stops on an error; getLastError() then
+     * tells why.
+     * @return true if running
+     */
+    bool isRunning() const noexcept;
+
+    /**
+     * @brief Get the last error message
+     * @return error message or empty string if no error
+     */
+    std::string getLastError() const;
+
+    /**
+     * @brief Parse a Qt-style key sequence string
+     * @param sequence Sequence such as "Ctrl+Shift+R"
+     * @param result Output parsed sequence
+     * @return true if the sequence has a main key and only known modifiers
+     */
+    static bool parseKeySequence(const std::string& sequence,
+                                 KeySequence& result);
+
+  protected:
+    /**
+     * @brief Wait for input on the X11 connection or the wakeup pipe
+     *
+     * Wraps poll(2), so tests can make it fail. Derived classes must stop
+     * the listener in their destructor.
+     * @return number of ready descriptors, or -1 with errno set
+     */
+    virtual int waitForInput(pollfd* fds, unsigned long count);
+
+  private:
+    struct RegisteredShortcut
+    {
+        KeySequence sequence;
+        KeyCode keycode{0};
+    };
+
+    /**
+     * @brief Initialize X11 connection and XInput2 raw key selection
+     * @return true if initialization successful
+     */
+    bool initializeX11();
+
+    /**
+     * @brief Cleanup X11 resources and the wakeup pipe
+     */
+    void cleanupX11();
+
+    /**
+     * @brief Resolve keycodes for all registered shortcuts
+     */
+    void resolveKeycodes();
+
+    /**
+     * @brief Listener loop running in separate thread
+     */
+    void eventLoop();
+
+    /**
+     * @brief Handle a raw key press or release
+     * @param keycode X11 keycode
+     * @param pressed true for press, false for release
+     * @param repeated true if the press is an auto-repeat
+     */
+    void processKey(KeyCode keycode, bool pressed, bool repeated);
+
+    /**
+     * @brief Get modifier flag for a keycode
+     * @param keycode X11 keycode
+     * @return modifier flag or NoModifier if the key is not a modifier
+     */
+    unsigned int modifierForKeycode(KeyCode keycode) const;
+
+    /**
+     * @brief Set last error message in thread-safe manner
+     * @param error error message
+     */
+    void setLastError(const std::string& error);
+
+  private:
+    // X11 resources
+    Display* m_display{nullptr};
+    Window m_rootWindow{0};
+    int m_xiOpcode{0};
+    int m_wakeupPipe[2]{-1, -1};
+
+    // Threading
+    std::unique_ptr<std::thread> m_listenerThread;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_shouldStop{false};
+
+    // Registered shortcuts, keyed by caller id
+    std::map<int, RegisteredShortcut> m_shortcuts;
+    mutable std::mutex m_shortcutsMutex;
+
+    // Key state, only touched by the listener thread
+    std::set<KeyCode> m_pressedModifiers;
+    std::set<int> m_activeShortcuts;
+
+    // Callback and error handling
+    ActivationCallback m_callback;
+    mutable std::mutex m_errorMutex;
+    std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Platform::Linux
@@ -10,6 +10,7 @@
 #include <chrono>
 #include <thread>
 #include <cstdlib>
+#include <iterator>
 
 namespace MouseRecorder::Platform::Windows
 {
@@ -64,6 +65,8 @@ bool WindowsEventReplay::loadEvents(
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         m_events = std::move(events);
+        m_moreEventsPending = false;
+        m_totalEvents.store(m_events.size());
         m_currentPosition.store(0);
         m_state.store(Core::PlaybackState::Stopped);
 
@@ -78,6 +81,37 @@ bool WindowsEventReplay::loadEvents(
     }
 }
 
+bool WindowsEventReplay::appendEvents(
+    std::vector<std::unique_ptr<Core::Event>> events)
+{
+    try
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_events.insert(m_events.end(),
+                            std::make_move_iterator(events.begin()),
+                            std::make_move_iterator(events.end()));
+            m_totalEvents.store(m_events.size());
+        }
+        m_cv.notify_all();
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        setLastError("Failed to append events: " + std::string(e.what()));
+        return false;
+    }
+}
+
+void WindowsEventReplay::setMoreEventsPending(bool pending)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_moreEventsPending = pending;
+    }
+    m_cv.notify_all();
+}
+
 bool WindowsEventReplay::startPlayback(PlaybackCallback callback)
 {
     if (m_state.load() == Core::PlaybackState::Playing)
@@ -86,7 +120,7 @@ bool WindowsEventReplay::startPlayback(PlaybackCallback callback)
         return false;
     }
 
-    if (m_events.empty())
+    if (m_totalEvents.load() == 0)
     {
         setLastError("No events loaded for playback");
         return false;
@@ -104,7 +138,7 @@ bool WindowsEventReplay::startPlayback(PlaybackCallback callback)
             &WindowsEventReplay::playbackThreadFunc, this);
 
         spdlog::info("WindowsEventReplay: Starting playback of {} events",
-                     m_events.size());
+                     m_totalEvents.load());
         return true;
     }
     catch (const std::exception& e)
@@ -125,6 +159,10 @@ void WindowsEventReplay::stopPlayback()
     spdlog::info("WindowsEventReplay: Stopping playback");
 
     m_shouldStop.store(true);
+    {
+        // Don't let the wakeup slip in between a check and the wait
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
     m_cv.notify_all();
 
     if (m_playbackThread && m_playbackThread->joinable())
@@ -179,7 +217,7 @@ size_t WindowsEventReplay::getCurrentPosition() const noexcept
 
 size_t WindowsEventReplay::getTotalEvents() const noexcept
 {
-    return m_events.size();
+    return m_totalEvents.load();
 }
 
 bool WindowsEventReplay::seekToPosition(size_t position)
@@ -190,7 +228,7 @@ bool WindowsEventReplay::seekToPosition(size_t position)
         return false;
     }
 
-    if (position >= m_events.size())
+    if (position >= m_totalEvents.load())
     {
         setLastError("Seek position out of range");
         return false;
@@ -238,7 +276,7 @@ void WindowsEventReplay::playbackThreadFunc()
                 spdlog::debug(
                     "WindowsEventReplay: Starting loop {} with {} events",
                     currentLoop,
-                    m_events.size());
+                    m_totalEvents.load());
             }
 
             // In CI environments, add a timeout to prevent hanging
@@ -264,17 +302,21 @@ void WindowsEventReplay::playbackThreadFunc()
                 m_isCI ? 50 : SIZE_MAX; // Very low limit in CI to prevent hangs
 
             for (size_t i = m_currentPosition.load();
-                 i < m_events.size() && !m_shouldStop.load() &&
-                 eventCount < maxEventsInCI;
+                 !m_shouldStop.load() && eventCount < maxEventsInCI;
                  ++i, ++eventCount)
             {
-                const auto& event = m_events[i];
+                const Core::Event* event = nullptr;
+                const Core::Event* previous = nullptr;
+                if (!waitForEvent(i, event, previous))
+                {
+                    break;
+                }
 
                 // Calculate timing delay
-                if (i > 0 && m_playbackSpeed.load() > 0.0 && !m_isCI)
+                if (previous && m_playbackSpeed.load() > 0.0 && !m_isCI)
                 {
                     auto currentTime = event->getTimestamp();
-                    auto previousTime = m_events[i - 1]->getTimestamp();
+                    auto previousTime = previous->getTimestamp();
                     auto delay = currentTime - previousTime;
 
                     // Apply speed scaling
@@ -321,15 +363,16 @@ void WindowsEventReplay::playbackThreadFunc()
                 // Log progress in CI environment
                 if (m_isCI && i % 5 == 0)
                 {
-                    spdlog::debug("WindowsEventReplay: Processed event {}/{}",
-                                  i + 1,
-                                  m_events.size());
+                    SPDLOG_DEBUG("WindowsEventReplay: Processed event {}/{}",
+                                 i + 1,
+                                 m_totalEvents.load());
                 }
 
                 // Call progress callback
                 if (m_playbackCallback)
                 {
-                    m_playbackCallback(m_state.load(), i, m_events.size());
+                    m_playbackCallback(
+                        m_state.load(), i, m_totalEvents.load());
                 }
 
                 // Call event callback
@@ -406,8 +449,9 @@ void WindowsEventReplay::playbackThreadFunc()
         // Final callback
         if (m_playbackCallback)
         {
-            m_playbackCallback(
-                m_state.load(), m_currentPosition.load(), m_events.size());
+            m_playbackCallback(m_state.load(),
+                               m_currentPosition.load(),
+                               m_totalEvents.load());
         }
 
         spdlog::debug("WindowsEventReplay: Playback thread completed");
@@ -419,6 +463,29 @@ void WindowsEventReplay::playbackThreadFunc()
     }
 }
 
+bool WindowsEventReplay::waitForEvent(size_t index,
+                                      const Core::Event*& event,
+                                      const Core::Event*& previous)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock,
+              [this, index]()
+              {
+                  return index < m_events.size() || !m_moreEventsPending ||
+                         m_shouldStop.load();
+              });
+
+    if (index >= m_events.size() || m_shouldStop.load())
+    {
+        return false;
+    }
+
+    // Events stay in place when m_events grows, only their owners move
+    event = m_events[index].get();
+    previous = index > 0 ? m_events[index - 1].get() : nullptr;
+    return event != nullptr;
+}
+
 bool WindowsEventReplay::injectEvent(const Core::Event& event)
 {
     try
@@ -459,8 +526,8 @@ bool WindowsEventReplay::injectEvent(const Core::Event& event)
             // In CI environments, if SendInput fails, just log and continue
             if (!result && m_isCI)
             {
-                spdlog::debug("WindowsEventReplay: SendInput failed in CI "
-                              "environment, continuing");
+                SPDLOG_DEBUG("WindowsEventReplay: SendInput failed in CI "
+                             "environment, continuing");
                 result = true; // Pretend it succeeded to avoid hanging tests
             }
             break;
@@ -528,8 +595,8 @@ bool WindowsEventReplay::injectEvent(const Core::Event& event)
             // In CI environments, if SendInput fails, just log and continue
             if (!result && m_isCI)
             {
-                spdlog::debug("WindowsEventReplay: SendInput failed in CI "
-                              "environment, continuing");
+                SPDLOG_DEBUG("WindowsEventReplay: SendInput failed in CI "
+                             "environment, continuing");
                 result = true; // Pretend it succeeded to avoid hanging tests
             }
             break;
@@ -595,8 +662,8 @@ bool WindowsEventReplay::injectEvent(const Core::Event& event)
             // In CI environments, if SendInput fails, just log and continue
             if (!result && m_isCI)
             {
-                spdlog::debug("WindowsEventReplay: SendInput failed in CI "
-                              "environment, continuing");
+                SPDLOG_DEBUG("WindowsEventReplay: SendInput failed in CI "
+                             "environment, continuing");
                 result = true; // Pretend it succeeded to avoid hanging tests
             }
             break;
@@ -631,8 +698,8 @@ bool WindowsEventReplay::injectEvent(const Core::Event& event)
             // In CI environments, if SendInput fails, just log and continue
             if (!result && m_isCI)
             {
-                spdlog::debug("WindowsEventReplay: SendInput failed in CI "
-                              "environment, continuing");
+                SPDLOG_DEBUG("WindowsEventReplay: SendInput failed in CI "
+                             "environment, continuing");
                 result = true; // Pretend it succeeded to avoid hanging tests
             }
             break;
@@ -655,8 +722,8 @@ bool WindowsEventReplay::injectEvent(const Core::Event& event)
             // In CI environments, if SendInput fails, just log and continue
             if (!result && m_isCI)
             {
-                spdlog::debug("WindowsEventReplay: SendInput failed in CI "
-                              "environment, continuing");
+                SPDLOG_DEBUG("WindowsEventReplay: SendInput failed in CI "
+                             "environment, continuing");
                 result = true; // Pretend it succeeded to avoid hanging tests
             }
             break;
@@ -683,8 +750,8 @@ bool WindowsEventReplay::injectEvent(const Core::Event& event)
             // In CI environments, if SendInput fails, just log and continue
             if (!result && m_isCI)
             {
-                spdlog::debug("WindowsEventReplay: SendInput failed in CI "
-                              "environment, continuing");
+                SPDLOG_DEBUG("WindowsEventReplay: SendInput failed in CI "
+                             "environment, continuing");
                 result = true; // Pretend it succeeded to avoid hanging tests
             }
             break;
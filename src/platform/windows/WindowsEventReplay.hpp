@@ -31,6 +31,9 @@ class WindowsEventReplay : public Core::IEventPlayer
 
     // IEventPlayer interface
     bool loadEvents(std::vector<std::unique_ptr<Core::Event>> events) override;
+    bool appendEvents(
+        std::vector<std::unique_ptr<Core::Event>> events) override;
+    void setMoreEventsPending(bool pending) override;
     bool startPlayback(PlaybackCallback callback = nullptr) override;
     void stopPlayback() override;
     Core::PlaybackState getState() const noexcept override;
@@ -57,6 +60,17 @@ class WindowsEventReplay : public Core::IEventPlayer
      */
     void playbackThreadFunc();
 
+    /**
+     * @brief Wait until the event at index has been loaded
+     * @param index Position of the event
+     * @param event Output event at index
+     * @param previous Output event before it, nullptr for the first one
+     * @return false if playback should end instead
+     */
+    bool waitForEvent(size_t index,
+                      const Core::Event*& event,
+                      const Core::Event*& previous);
+
     /**
      * @brief Inject a single event using SendInput
      */
@@ -68,7 +82,9 @@ class WindowsEventReplay : public Core::IEventPlayer
     std::atomic<bool> m_loopPlayback;
     std::atomic<int> m_loopCount;
     std::atomic<size_t> m_currentPosition;
-    std::vector<std::unique_ptr<Core::Event>> m_events;
+    std::atomic<size_t> m_totalEvents{0};
+    std::vector<std::unique_ptr<Core::Event>> m_events; // Guarded by m_mutex
+    bool m_moreEventsPending{false};
 
     // Threading
     std::unique_ptr<std::thread> m_playbackThread;
@@ -0,0 +1,196 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "AutosaveService.hpp"
+#include "core/Event.hpp"
+#include "core/SpdlogConfig.hpp"
+#include <algorithm>
+
+namespace MouseRecorder::Storage
+{
+
+AutosaveService::AutosaveService(AutosaveOptions options)
+    : m_options(options)
+{
+    m_options.eventThreshold = std::max<size_t>(m_options.eventThreshold, 1);
+}
+
+AutosaveService::~AutosaveService()
+{
+    stop();
+}
+
+bool AutosaveService::start(const std::string& journalPath,
+                            const std::string& targetPath,
+                            const Core::StorageMetadata& metadata)
+{
+    if (isRunning())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastError = "Autosave is already running";
+        return false;
+    }
+
+    if (!m_journal.create(journalPath, targetPath, metadata))
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastError = m_journal.getLastError();
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.clear();
+        m_pendingEvents = 0;
+        m_queuedEvents = 0;
+        m_savedEvents = 0;
+        m_flushRequested = false;
+        m_stopping = false;
+        m_failed = false;
+        m_lastError.clear();
+        m_running = true;
+    }
+    m_thread = std::thread([this]() { run(); });
+
+    spdlog::info("AutosaveService: Autosaving to {} every {} ms or {} events",
+                 journalPath,
+                 m_options.interval.count(),
+                 m_options.eventThreshold);
+    return true;
+}
+
+void AutosaveService::addEvent(const Core::Event& event)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_running || m_stopping || m_failed)
+    {
+        return;
+    }
+
+    m_encoder.serializeEvent(event, m_pending);
+    ++m_pendingEvents;
+    ++m_queuedEvents;
+    if (m_pendingEvents == m_options.eventThreshold)
+    {
+        m_wake.notify_one();
+    }
+}
+
+bool AutosaveService::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_running)
+    {
+        return !m_failed;
+    }
+
+    const size_t target = m_queuedEvents;
+    m_flushRequested = true;
+    m_wake.notify_one();
+    m_written.wait(lock,
+                   [this, target]()
+                   { return m_failed || m_savedEvents >= target; });
+    return !m_failed;
+}
+
+bool AutosaveService::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running)
+        {
+            return !m_failed;
+        }
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+    m_journal.close();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+    spdlog::info("AutosaveService: Stopped after saving {} events to {}",
+                 m_savedEvents,
+                 m_journal.getPath());
+    return !m_failed;
+}
+
+bool AutosaveService::isRunning() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+size_t AutosaveService::getSavedEventCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_savedEvents;
+}
+
+std::string AutosaveService::getJournalPath() const
+{
+    return m_journal.getPath();
+}
+
+std::string AutosaveService::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastError;
+}
+
+void AutosaveService::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wake.wait_for(lock,
+                        m_options.interval,
+                        [this]()
+                        {
+                            return m_stopping || m_flushRequested ||
+                                   m_pendingEvents >= m_options.eventThreshold;
+                        });
+        writePending(lock);
+        if (m_stopping || m_failed)
+        {
+            return;
+        }
+    }
+}
+
+void AutosaveService::writePending(std::unique_lock<std::mutex>& lock)
+{
+    m_flushRequested = false;
+    if (m_pendingEvents == 0)
+    {
+        m_written.notify_all();
+        return;
+    }
+
+    // Capture goes on into a fresh buffer while this one is written
+    std::vector<uint8_t> block;
+    block.swap(m_pending);
+    const uint32_t count = m_pendingEvents;
+    m_pendingEvents = 0;
+
+    lock.unlock();
+    bool appended = m_journal.append(block, count, m_options.sync);
+    lock.lock();
+
+    if (appended)
+    {
+        m_savedEvents += count;
+    }
+    else
+    {
+        // Later blocks would leave a gap in the journal; keep what it has
+        m_failed = true;
+        m_lastError = m_journal.getLastError();
+        spdlog::error("AutosaveService: Autosave stopped: {}", m_lastError);
+    }
+    m_written.notify_all();
+}
+
+} // namespace MouseRecorder::Storage
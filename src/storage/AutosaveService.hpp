@@ -0,0 +1,136 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "BinaryEventStorage.hpp"
+#include "RecordingJournal.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief When AutosaveService writes captured events
+ */
+struct AutosaveOptions
+{
+    // Longest time captured events wait before they are written
+    std::chrono::milliseconds interval{30000};
+
+    // Number of waiting events that are written without waiting for the
+    // interval to pass
+    size_t eventThreshold{5000};
+
+    // Flush every append to disk, see Core::IEventStorage::setSyncOnSave()
+    bool sync{true};
+};
+
+/**
+ * @brief Keeps a recording in progress in a recovery journal
+ *
+ * addEvent() only serializes the event into memory, so it is cheap enough
+ * for the capture callback. A background thread appends the waiting
+ * events to a RecordingJournal every interval or eventThreshold events.
+ * Each append writes just the events captured since the last one, so
+ * autosaving costs the same an hour into a session as at its start.
+ *
+ * The journal is kept when the service stops; it is up to the owner to
+ * remove it once the recording has been saved.
+ */
+class AutosaveService
+{
+  public:
+    explicit AutosaveService(AutosaveOptions options = {});
+    ~AutosaveService();
+
+    AutosaveService(const AutosaveService&) = delete;
+    AutosaveService& operator=(const AutosaveService&) = delete;
+
+    /**
+     * @brief Create the journal and start autosaving
+     * @param journalPath Path to the journal
+     * @param targetPath Recording the journal belongs to, may be empty
+     * @param metadata Metadata of the recording
+     * @return true if the journal was created
+     */
+    bool start(const std::string& journalPath,
+               const std::string& targetPath,
+               const Core::StorageMetadata& metadata = {});
+
+    /**
+     * @brief Queue a captured event for the next append
+     *
+     * Thread safe. Ignored if the service is not running.
+     */
+    void addEvent(const Core::Event& event);
+
+    /**
+     * @brief Append all queued events now and wait for it
+     * @return true if all events added so far are in the journal
+     */
+    bool flush();
+
+    /**
+     * @brief Append the queued events and close the journal
+     * @return true if all events added are in the journal
+     */
+    bool stop();
+
+    bool isRunning() const;
+
+    /**
+     * @brief Get the number of events written to the journal
+     */
+    size_t getSavedEventCount() const;
+
+    /**
+     * @brief Get the path of the current or last journal
+     */
+    std::string getJournalPath() const;
+
+    /**
+     * @brief Get the last error message if any operation failed
+     */
+    std::string getLastError() const;
+
+  private:
+    void run();
+
+    /**
+     * @brief Append the queued events with m_mutex held by lock
+     */
+    void writePending(std::unique_lock<std::mutex>& lock);
+
+    AutosaveOptions m_options;
+
+    // Only its const serialization methods are used, from any thread
+    const BinaryEventStorage m_encoder;
+
+    // Used by the worker thread while it runs
+    RecordingJournal m_journal;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_written;
+    std::vector<uint8_t> m_pending;
+    uint32_t m_pendingEvents{0};
+    size_t m_queuedEvents{0};
+    size_t m_savedEvents{0};
+    bool m_flushRequested{false};
+    bool m_stopping{false};
+    bool m_running{false};
+    bool m_failed{false};
+    std::string m_lastError;
+    std::thread m_thread;
+};
+
+} // namespace MouseRecorder::Storage
@@ -4,14 +4,106 @@
 // https://opensource.org/licenses/MIT
 
 #include "BinaryEventStorage.hpp"
+#include "Crc32c.hpp"
 #include "core/Event.hpp"
 #include <fstream>
 #include "core/SpdlogConfig.hpp"
+#include "core/Tracing.hpp"
+#include "EventRangeFilter.hpp"
+#include "StorageFileIO.hpp"
+#include "StorageMetrics.hpp"
+#include "core/StorageTask.hpp"
+#include <algorithm>
+#include <bit>
 #include <cstring>
+#include <filesystem>
+#include <type_traits>
 
 namespace MouseRecorder::Storage
 {
 
+namespace
+{
+
+// Bytes read from the file at a time while loading
+constexpr size_t READ_BLOCK_SIZE = 1 << 20;
+
+// Refill the read window when fewer bytes than this are left
+constexpr size_t MIN_LOOKAHEAD = 4096;
+
+/**
+ * @brief Sliding read window over a file
+ *
+ * Lets loadEvents() decode events while the rest of the file is still on
+ * disk, so the first events are available right away.
+ */
+class BlockReader
+{
+  public:
+    explicit BlockReader(std::ifstream& file) : m_file(file)
+    {
+    }
+
+    /**
+     * @brief Drop the bytes before offset and append the next block
+     * @return false at the end of the file
+     */
+    bool refill(std::vector<uint8_t>& buffer, size_t& offset)
+    {
+        if (!m_file.is_open() || !m_file.good())
+        {
+            return false;
+        }
+
+        buffer.erase(buffer.begin(),
+                     buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+        offset = 0;
+
+        size_t size = buffer.size();
+        buffer.resize(size + READ_BLOCK_SIZE);
+        m_file.read(reinterpret_cast<char*>(buffer.data() + size),
+                    READ_BLOCK_SIZE);
+        buffer.resize(size + static_cast<size_t>(m_file.gcount()));
+        return m_file.gcount() > 0;
+    }
+
+    /**
+     * @brief Refill until bytes are available after offset or the file ends
+     */
+    void ensure(std::vector<uint8_t>& buffer, size_t& offset, size_t bytes)
+    {
+        while (buffer.size() - offset < bytes && refill(buffer, offset))
+        {
+        }
+    }
+
+  private:
+    std::ifstream& m_file;
+};
+
+/**
+ * @brief Statistics of a looped recording as it is played
+ */
+Core::RecordingStatistics expandedStatistics(
+    const Core::LoopedRecording& recording)
+{
+    Core::RecordingStatistics statistics;
+    const uint64_t count = recording.getExpandedCount();
+    for (uint64_t position = 0; position < count; ++position)
+    {
+        auto location = recording.index.locate(position);
+        const Core::Event& event = *recording.events[location.event];
+        statistics.add(Core::Event(
+            event.getType(),
+            event.getData(),
+            event.getTimestamp() +
+                std::chrono::milliseconds(location.offsetMs)));
+    }
+    return statistics;
+}
+
+} // namespace
+
 BinaryEventStorage::BinaryEventStorage()
 {
     spdlog::debug("BinaryEventStorage: Constructor");
@@ -22,35 +114,41 @@ bool BinaryEventStorage::saveEvents(
     const std::string& filename,
     const Core::StorageMetadata& metadata)
 {
+    MOUSERECORDER_TRACE_SCOPE("storage", "BinaryEventStorage::saveEvents");
+    auto startTime = std::chrono::steady_clock::now();
     spdlog::info(
         "BinaryEventStorage: Saving {} events to {}", events.size(), filename);
 
     try
     {
         std::vector<uint8_t> buffer;
-
-        // Write header
-        writeBinary(buffer, MAGIC_NUMBER);
-        writeBinary(buffer, FORMAT_VERSION);
-
-        // Serialize metadata
-        std::vector<uint8_t> metadataBuffer;
-        serializeMetadata(metadata, metadataBuffer);
-        writeBinary(buffer, static_cast<uint32_t>(metadataBuffer.size()));
-        buffer.insert(
-            buffer.end(), metadataBuffer.begin(), metadataBuffer.end());
-
-        // Write event count
-        writeBinary(buffer, static_cast<uint32_t>(events.size()));
-
-        // Serialize events
-        for (const auto& event : events)
+        serializeHeader(metadata, events.size(), buffer);
+        const size_t headerSize = buffer.size();
+
+        // Serialize events, collecting their statistics and block index on
+        // the way
+        Core::RecordingStatistics statistics;
+        BlockIndex index;
+        for (size_t i = 0; i < events.size(); ++i)
         {
-            if (event)
+            if (i % PROGRESS_INTERVAL == 0 &&
+                !Core::StorageProgress::report(m_progress, i, events.size()))
+            {
+                setLastError(Core::StorageProgress::CANCELLED_ERROR);
+                return false;
+            }
+            if (events[i])
             {
-                serializeEvent(*event, buffer);
+                index.add(*events[i], buffer.size());
+                serializeEvent(*events[i], buffer);
+                statistics.add(*events[i]);
             }
         }
+        index.headerChecksum = crc32c(0, buffer.data(), headerSize);
+        index.addBytes(
+            buffer.data() + headerSize, buffer.size() - headerSize, headerSize);
+        serializeBlockIndexFooter(index, buffer);
+        serializeStatisticsFooter(statistics, buffer);
 
         // Apply compression if enabled
         std::vector<uint8_t> finalData;
@@ -63,24 +161,23 @@ bool BinaryEventStorage::saveEvents(
             finalData = std::move(buffer);
         }
 
-        // Write to file
-        std::ofstream file(filename, std::ios::binary);
-        if (!file.is_open())
+        // Write to file; progress was reported per event already
+        std::string error;
+        if (!writeFileWithProgress(
+                filename,
+                std::string_view(
+                    reinterpret_cast<const char*>(finalData.data()),
+                    finalData.size()),
+                nullptr,
+                m_syncOnSave,
+                error))
         {
-            setLastError("Failed to open file for writing: " + filename);
-            return false;
-        }
-
-        file.write(reinterpret_cast<const char*>(finalData.data()),
-                   finalData.size());
-        file.close();
-
-        if (file.fail())
-        {
-            setLastError("Failed to write binary data to file");
+            setLastError(error);
             return false;
         }
 
+        Core::StorageProgress::report(m_progress, events.size(), events.size());
+        recordStorageOperation("binary", "save", finalData.size(), startTime);
         spdlog::info(
             "BinaryEventStorage: Successfully saved {} events ({} bytes)",
             events.size(),
@@ -99,6 +196,8 @@ bool BinaryEventStorage::loadEvents(
     std::vector<std::unique_ptr<Core::Event>>& events,
     Core::StorageMetadata& metadata)
 {
+    MOUSERECORDER_TRACE_SCOPE("storage", "BinaryEventStorage::loadEvents");
+    auto startTime = std::chrono::steady_clock::now();
     spdlog::info("BinaryEventStorage: Loading events from {}", filename);
 
     try
@@ -110,84 +209,1076 @@ bool BinaryEventStorage::loadEvents(
             return false;
         }
 
-        // Read entire file
         file.seekg(0, std::ios::end);
         size_t fileSize = file.tellg();
         file.seekg(0, std::ios::beg);
 
-        std::vector<uint8_t> fileData(fileSize);
-        file.read(reinterpret_cast<char*>(fileData.data()), fileSize);
-        file.close();
-
-        // Decompress if needed
+        // Compressed files are decoded as a whole, plain ones block by
+        // block; the version is all that is read of them up front
         std::vector<uint8_t> buffer;
         if (m_compressionEnabled)
         {
+            std::vector<uint8_t> fileData(fileSize);
+            file.read(reinterpret_cast<char*>(fileData.data()), fileSize);
+            file.close();
             buffer = decompressData(fileData);
         }
         else
         {
-            buffer = std::move(fileData);
+            buffer.resize(2 * sizeof(uint32_t));
+            file.read(reinterpret_cast<char*>(buffer.data()),
+                      static_cast<std::streamsize>(buffer.size()));
+        }
+
+        // Files with a loop table are small and expanded as a whole
+        if (isLoopedData(buffer))
+        {
+            file.close();
+            Core::LoopedRecording recording;
+            if ((!m_compressionEnabled && !readFileData(filename, buffer)) ||
+                !parseLoopedData(std::move(buffer), recording, metadata))
+            {
+                return false;
+            }
+            if (m_progress)
+            {
+                m_progress->metadataLoaded(metadata);
+            }
+            events = recording.expand();
+            Core::StorageProgress::report(
+                m_progress, events.size(), events.size());
+            recordStorageOperation("binary", "load", fileSize, startTime);
+            return true;
+        }
+        if (!m_compressionEnabled)
+        {
+            buffer.clear();
+        }
+
+        // Files with an index are checked one block at a time, each right
+        // before its events are decoded
+        if (!m_compressionEnabled)
+        {
+            auto index = readBlockIndexFooter(file);
+            if (index)
+            {
+                file.close();
+                if (!loadIndexedRange(filename,
+                                      *index,
+                                      Core::EventRange::byIndex(0, UINT64_MAX),
+                                      events,
+                                      metadata,
+                                      true))
+                {
+                    return false;
+                }
+                recordStorageOperation("binary", "load", fileSize, startTime);
+                return true;
+            }
+        }
+
+        std::optional<Core::RecordingStatistics> statistics;
+        if (m_compressionEnabled)
+        {
+            statistics = readStatisticsFooter(buffer);
+        }
+        else
+        {
+            // The footer goes out with the metadata, before any event
+            statistics = readStatisticsFooter(file);
+            file.clear();
+            file.seekg(0, std::ios::beg);
         }
 
         size_t offset = 0;
+        uint64_t eventCount = 0;
+        if (!readHeader(file, buffer, offset, metadata, eventCount))
+        {
+            return false;
+        }
+        metadata.statistics = statistics;
+        if (m_progress)
+        {
+            m_progress->metadataLoaded(metadata);
+        }
 
-        // Read and validate header
-        uint32_t magic = readBinary<uint32_t>(buffer, offset);
-        if (magic != MAGIC_NUMBER)
+        // Read events; a progress sink may take them in chunks, so only
+        // reserve what one chunk needs then
+        const bool finished = eventCount != UNKNOWN_EVENT_COUNT;
+        events.clear();
+        if (finished)
+        {
+            events.reserve(m_progress ? std::min<uint64_t>(eventCount,
+                                                           PROGRESS_INTERVAL)
+                                      : eventCount);
+        }
+
+        uint64_t i = 0;
+        for (; i < eventCount; ++i)
+        {
+            if (i % PROGRESS_INTERVAL == 0)
+            {
+                if (m_progress && i > 0)
+                {
+                    m_progress->eventsLoaded(events);
+                }
+                if (!Core::StorageProgress::report(
+                        m_progress, i, finished ? eventCount : 0))
+                {
+                    events.clear();
+                    setLastError(Core::StorageProgress::CANCELLED_ERROR);
+                    return false;
+                }
+            }
+
+            // Nothing after an event that can't be read lines up, whether
+            // the file ended or the data is damaged
+            auto event = readEvent(file, buffer, offset);
+            if (!event)
+            {
+                if (finished)
+                {
+                    spdlog::warn("BinaryEventStorage: Failed to deserialize "
+                                 "event {} of {}, stopping",
+                                 i,
+                                 eventCount);
+                }
+                break;
+            }
+            events.push_back(std::move(event));
+        }
+        if (!finished)
+        {
+            spdlog::warn("BinaryEventStorage: {} was not finished, read {} "
+                         "events",
+                         filename,
+                         i);
+        }
+
+        Core::StorageProgress::report(m_progress, i, i);
+        recordStorageOperation("binary", "load", fileSize, startTime);
+        // i counts the decoded events, events may have been streamed out
+        spdlog::info("BinaryEventStorage: Successfully loaded {} events", i);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        setLastError("Binary deserialization error: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool BinaryEventStorage::loadEventsRange(
+    const std::string& filename,
+    const Core::EventRange& range,
+    std::vector<std::unique_ptr<Core::Event>>& events,
+    Core::StorageMetadata& metadata)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "BinaryEventStorage::loadEventsRange");
+
+    std::optional<BlockIndex> index;
+    if (!m_compressionEnabled)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (file.is_open())
+        {
+            index = readBlockIndexFooter(file);
+        }
+    }
+    if (index)
+    {
+        return loadIndexedRange(filename, *index, range, events, metadata);
+    }
+
+    // Compressed files and files written before the index was added
+    if (!loadEventsRangeStreaming(
+            *this, m_progress, filename, range, events, metadata))
+    {
+        return false;
+    }
+    m_lastError.clear();
+    spdlog::info("BinaryEventStorage: Loaded {} events of a range from {}",
+                 events.size(),
+                 filename);
+    return true;
+}
+
+bool BinaryEventStorage::loadIndexedRange(
+    const std::string& filename,
+    const BlockIndex& index,
+    const Core::EventRange& range,
+    std::vector<std::unique_ptr<Core::Event>>& events,
+    Core::StorageMetadata& metadata,
+    bool streamEvents)
+{
+    events.clear();
+
+    try
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            setLastError("Failed to open file for reading: " + filename);
+            return false;
+        }
+        auto statistics = readStatisticsFooter(file);
+        if (!verifyHeader(file, index))
+        {
+            return false;
+        }
+        file.clear();
+        file.seekg(0, std::ios::beg);
+
+        std::vector<uint8_t> buffer;
+        size_t offset = 0;
+        uint64_t eventCount = 0;
+        if (!readHeader(file, buffer, offset, metadata, eventCount))
+        {
+            return false;
+        }
+        metadata.statistics = statistics;
+        if (m_progress)
+        {
+            m_progress->metadataLoaded(metadata);
+        }
+
+        const uint64_t perBlock = index.eventsPerBlock;
+        const size_t blockCount = index.blocks.size();
+        if (!index.covers(eventCount))
+        {
+            setLastError("Corrupted file: block index does not match the "
+                         "event count");
+            return false;
+        }
+
+        std::vector<bool> selected = selectBlocks(index, eventCount, range);
+        uint64_t total = 0;
+        for (size_t block = 0; block < blockCount; ++block)
+        {
+            if (selected[block])
+            {
+                total += std::min<uint64_t>(perBlock,
+                                            eventCount - block * perBlock);
+            }
+        }
+
+        // Read the selected blocks one at a time, checking each before
+        // decoding it
+        uint64_t decoded = 0;
+        size_t blocksRead = 0;
+        for (size_t block = 0; block < blockCount; ++block)
+        {
+            if (!selected[block])
+            {
+                continue;
+            }
+
+            uint64_t begin = index.blocks[block].offset;
+            uint64_t end = block + 1 < blockCount
+                               ? index.blocks[block + 1].offset
+                               : index.endOffset;
+            buffer.resize(end - begin);
+            file.clear();
+            file.seekg(static_cast<std::streamoff>(begin));
+            file.read(reinterpret_cast<char*>(buffer.data()),
+                      static_cast<std::streamsize>(buffer.size()));
+            if (!file)
+            {
+                events.clear();
+                setLastError("Failed to read file: " + filename);
+                return false;
+            }
+            if (!index.verify(block, buffer))
+            {
+                events.clear();
+                setLastError("Corrupted file: checksum mismatch in block " +
+                             std::to_string(block));
+                return false;
+            }
+
+            offset = 0;
+            uint64_t last =
+                std::min<uint64_t>((block + 1) * perBlock, eventCount);
+            for (uint64_t i = block * perBlock; i < last; ++i, ++decoded)
+            {
+                if (decoded % PROGRESS_INTERVAL == 0)
+                {
+                    // Only events of verified blocks reach the sink
+                    if (streamEvents && m_progress && decoded > 0)
+                    {
+                        m_progress->eventsLoaded(events);
+                    }
+                    if (!Core::StorageProgress::report(
+                            m_progress, decoded, total))
+                    {
+                        events.clear();
+                        setLastError(Core::StorageProgress::CANCELLED_ERROR);
+                        return false;
+                    }
+                }
+
+                auto event = deserializeEvent(buffer, offset);
+                if (!event)
+                {
+                    events.clear();
+                    setLastError("Corrupted file: failed to decode event " +
+                                 std::to_string(i));
+                    return false;
+                }
+                if (isInRange(index, range, i, event->getTimestampMs()))
+                {
+                    events.push_back(std::move(event));
+                }
+            }
+            if (offset != buffer.size())
+            {
+                events.clear();
+                setLastError("Corrupted file: block index does not match the "
+                             "events");
+                return false;
+            }
+            ++blocksRead;
+        }
+
+        Core::StorageProgress::report(m_progress, total, total);
+        spdlog::info("BinaryEventStorage: Loaded {} events of a range from {} "
+                     "reading {} of {} blocks",
+                     events.size(),
+                     filename,
+                     blocksRead,
+                     blockCount);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        events.clear();
+        setLastError("Binary deserialization error: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool BinaryEventStorage::saveLoopedEvents(
+    const Core::LoopedRecording& recording,
+    const std::string& filename,
+    const Core::StorageMetadata& metadata)
+{
+    if (recording.index.empty())
+    {
+        return saveEvents(recording.events, filename, metadata);
+    }
+
+    MOUSERECORDER_TRACE_SCOPE("storage",
+                              "BinaryEventStorage::saveLoopedEvents");
+    auto startTime = std::chrono::steady_clock::now();
+    const auto& events = recording.events;
+    const auto& segments = recording.index.getSegments();
+    spdlog::info("BinaryEventStorage: Saving {} events with {} repeated "
+                 "segments to {}",
+                 events.size(),
+                 segments.size(),
+                 filename);
+
+    // Segments index the stored events, so none may be left out
+    if (std::any_of(events.begin(),
+                    events.end(),
+                    [](const auto& event) { return !event; }) ||
+        !Core::SegmentIndex::isValid(segments, events.size()))
+    {
+        setLastError("Invalid repeated segments");
+        return false;
+    }
+
+    try
+    {
+        std::vector<uint8_t> buffer;
+        serializeHeader(metadata, events.size(), buffer);
+        std::vector<uint8_t> version;
+        writeBinary(version, LOOPED_FORMAT_VERSION);
+        std::copy(version.begin(),
+                  version.end(),
+                  buffer.begin() + sizeof(MAGIC_NUMBER));
+        const size_t headerSize = buffer.size();
+
+        // The block index checks the stored events, the statistics count
+        // the expanded ones as they are played
+        BlockIndex index;
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            if (i % PROGRESS_INTERVAL == 0 &&
+                !Core::StorageProgress::report(m_progress, i, events.size()))
+            {
+                setLastError(Core::StorageProgress::CANCELLED_ERROR);
+                return false;
+            }
+            index.add(*events[i], buffer.size());
+            serializeEvent(*events[i], buffer);
+        }
+        index.headerChecksum = crc32c(0, buffer.data(), headerSize);
+        index.addBytes(
+            buffer.data() + headerSize, buffer.size() - headerSize, headerSize);
+        serializeBlockIndexFooter(index, buffer);
+        serializeStatisticsFooter(expandedStatistics(recording), buffer);
+
+        const size_t footerStart = buffer.size();
+        for (const auto& segment : segments)
+        {
+            writeBinary(buffer, segment.start);
+            writeBinary(buffer, segment.length);
+            writeBinary(buffer, segment.repeatCount);
+            writeBinary(buffer, segment.periodMs);
+        }
+        writeBinary(buffer, static_cast<uint32_t>(buffer.size() - footerStart));
+        writeBinary(buffer, LOOP_TABLE_MAGIC);
+
+        std::vector<uint8_t> finalData =
+            m_compressionEnabled ? compressData(buffer) : std::move(buffer);
+        std::string error;
+        if (!writeFileWithProgress(
+                filename,
+                std::string_view(
+                    reinterpret_cast<const char*>(finalData.data()),
+                    finalData.size()),
+                nullptr,
+                m_syncOnSave,
+                error))
+        {
+            setLastError(error);
+            return false;
+        }
+
+        Core::StorageProgress::report(m_progress, events.size(), events.size());
+        recordStorageOperation("binary", "save", finalData.size(), startTime);
+        spdlog::info("BinaryEventStorage: Successfully saved {} of {} events "
+                     "({} bytes)",
+                     events.size(),
+                     recording.getExpandedCount(),
+                     finalData.size());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        setLastError("Binary serialization error: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool BinaryEventStorage::loadLoopedEvents(const std::string& filename,
+                                          Core::LoopedRecording& recording,
+                                          Core::StorageMetadata& metadata)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage",
+                              "BinaryEventStorage::loadLoopedEvents");
+    recording = {};
+
+    std::vector<uint8_t> data;
+    if (!readFileData(filename, data))
+    {
+        return false;
+    }
+    if (!isLoopedData(data))
+    {
+        data.clear();
+        return loadEvents(filename, recording.events, metadata);
+    }
+    return parseLoopedData(std::move(data), recording, metadata);
+}
+
+bool BinaryEventStorage::isLoopedFile(const std::string& filename)
+{
+    // Compressed files start with their compression flag
+    std::vector<uint8_t> data;
+    if (m_compressionEnabled)
+    {
+        return readFileData(filename, data) && isLoopedData(data);
+    }
+
+    std::ifstream file(filename, std::ios::binary);
+    data.resize(2 * sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(data.data()),
+              static_cast<std::streamsize>(data.size()));
+    return file && isLoopedData(data);
+}
+
+bool BinaryEventStorage::readFileData(const std::string& filename,
+                                      std::vector<uint8_t>& data)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        setLastError("Failed to open file for reading: " + filename);
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(data.data()),
+              static_cast<std::streamsize>(data.size()));
+    if (!file)
+    {
+        setLastError("Failed to read file: " + filename);
+        return false;
+    }
+    if (m_compressionEnabled)
+    {
+        data = decompressData(data);
+    }
+    return true;
+}
+
+bool BinaryEventStorage::isLoopedData(const std::vector<uint8_t>& data) const
+{
+    if (data.size() < 2 * sizeof(uint32_t))
+    {
+        return false;
+    }
+    size_t offset = 0;
+    uint32_t magic = readBinary<uint32_t>(data, offset);
+    return magic == MAGIC_NUMBER &&
+           readBinary<uint32_t>(data, offset) == LOOPED_FORMAT_VERSION;
+}
+
+bool BinaryEventStorage::parseLoopedData(std::vector<uint8_t> data,
+                                         Core::LoopedRecording& recording,
+                                         Core::StorageMetadata& metadata)
+{
+    try
+    {
+        // All of the data is in memory already
+        std::ifstream closed;
+        size_t offset = 0;
+        uint64_t eventCount = 0;
+        if (!readHeader(closed, data, offset, metadata, eventCount))
+        {
+            return false;
+        }
+
+        constexpr size_t TRAILER_SIZE = 2 * sizeof(uint32_t);
+        constexpr size_t SEGMENT_SIZE = 4 * sizeof(uint64_t);
+        size_t trailer = data.size() - TRAILER_SIZE;
+        uint32_t footerSize = 0;
+        if (data.size() < offset + TRAILER_SIZE ||
+            (footerSize = readBinary<uint32_t>(data, trailer),
+             readBinary<uint32_t>(data, trailer) != LOOP_TABLE_MAGIC) ||
+            footerSize % SEGMENT_SIZE != 0 ||
+            footerSize > data.size() - TRAILER_SIZE - offset)
+        {
+            setLastError("Corrupted file: invalid loop table");
+            return false;
+        }
+        const size_t footerStart = data.size() - TRAILER_SIZE - footerSize;
+
+        // The block index and statistics footers, if the file has them,
+        // end where the loop table starts
+        size_t eventsEnd = footerStart;
+        auto readTrailerAt =
+            [this, &data, &eventsEnd, offset](uint32_t& size, uint32_t& magic)
+        {
+            if (eventsEnd - offset < TRAILER_SIZE)
+            {
+                return false;
+            }
+            size_t trailerOffset = eventsEnd - TRAILER_SIZE;
+            size = readBinary<uint32_t>(data, trailerOffset);
+            magic = readBinary<uint32_t>(data, trailerOffset);
+            return size <= eventsEnd - TRAILER_SIZE - offset;
+        };
+        uint32_t size = 0;
+        uint32_t magic = 0;
+        if (readTrailerAt(size, magic) && magic == STATISTICS_MAGIC)
+        {
+            std::vector<uint8_t> footer(
+                data.begin() +
+                    static_cast<std::ptrdiff_t>(eventsEnd - TRAILER_SIZE - size),
+                data.begin() + static_cast<std::ptrdiff_t>(eventsEnd));
+            metadata.statistics = readStatisticsFooter(footer);
+            eventsEnd -= TRAILER_SIZE + size;
+        }
+        if (readTrailerAt(size, magic) && magic == CHECKSUM_BLOCK_INDEX_MAGIC)
+        {
+            eventsEnd -= TRAILER_SIZE + size;
+            auto index = parseBlockIndexFooter(
+                std::vector<uint8_t>(
+                    data.begin() + static_cast<std::ptrdiff_t>(eventsEnd),
+                    data.begin() +
+                        static_cast<std::ptrdiff_t>(eventsEnd + size)),
+                eventsEnd);
+            if (!index || !verifyLoopedData(data, *index, offset))
+            {
+                return false;
+            }
+        }
+
+        std::vector<Core::RepeatedSegment> segments(footerSize / SEGMENT_SIZE);
+        size_t footerOffset = footerStart;
+        for (auto& segment : segments)
+        {
+            segment.start = readBinary<uint64_t>(data, footerOffset);
+            segment.length = readBinary<uint64_t>(data, footerOffset);
+            segment.repeatCount = readBinary<uint64_t>(data, footerOffset);
+            segment.periodMs = readBinary<uint64_t>(data, footerOffset);
+        }
+
+        // Every event takes a byte at least
+        if (eventCount > eventsEnd - offset ||
+            !Core::SegmentIndex::isValid(segments, eventCount))
+        {
+            setLastError("Corrupted file: invalid loop table");
+            return false;
+        }
+
+        recording.events.reserve(eventCount);
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            auto event = deserializeEvent(data, offset);
+            if (!event || offset > eventsEnd)
+            {
+                recording.events.clear();
+                setLastError("Corrupted file: failed to decode event " +
+                             std::to_string(i));
+                return false;
+            }
+            recording.events.push_back(std::move(event));
+        }
+        recording.index = Core::SegmentIndex(std::move(segments));
+
+        spdlog::info("BinaryEventStorage: Loaded {} events with {} repeated "
+                     "segments, {} once expanded",
+                     eventCount,
+                     recording.index.getSegments().size(),
+                     recording.getExpandedCount());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        recording.events.clear();
+        setLastError("Binary deserialization error: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool BinaryEventStorage::verifyLoopedData(const std::vector<uint8_t>& data,
+                                          const BlockIndex& index,
+                                          size_t eventsStart)
+{
+    if (index.blocks.empty() ? index.endOffset != eventsStart
+                             : index.blocks.front().offset != eventsStart)
+    {
+        setLastError("Corrupted file: block index does not match the events");
+        return false;
+    }
+    if (crc32c(0, data.data(), eventsStart) != index.headerChecksum)
+    {
+        setLastError("Corrupted file: metadata checksum mismatch");
+        return false;
+    }
+    for (size_t block = 0; block < index.blocks.size(); ++block)
+    {
+        uint64_t start = index.blocks[block].offset;
+        uint64_t end = block + 1 < index.blocks.size()
+                           ? index.blocks[block + 1].offset
+                           : index.endOffset;
+        if (crc32c(0, data.data() + start, end - start) !=
+            index.blocks[block].checksum)
+        {
+            setLastError("Corrupted file: checksum mismatch in block " +
+                         std::to_string(block));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BinaryEventStorage::hasBlockIndex(const std::string& filename) const
+{
+    std::ifstream file(filename, std::ios::binary);
+    std::vector<uint8_t> header(2 * sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(header.data()),
+              static_cast<std::streamsize>(header.size()));
+    if (!file)
+    {
+        return false;
+    }
+    size_t offset = 0;
+    uint32_t magic = readBinary<uint32_t>(header, offset);
+    uint32_t version = readBinary<uint32_t>(header, offset);
+    return magic == MAGIC_NUMBER && isSupportedVersion(version) &&
+           readBlockIndexFooter(file).has_value();
+}
+
+bool BinaryEventStorage::splice(const std::vector<SpliceSegment>& segments,
+                                const std::string& filename,
+                                uint64_t gapMs,
+                                Core::StorageMetadata& metadata)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "BinaryEventStorage::splice");
+    auto startTime = std::chrono::steady_clock::now();
+    spdlog::info("BinaryEventStorage: Splicing {} segments into {}",
+                 segments.size(),
+                 filename);
+
+    const std::string tempPath = makeTempPath(filename);
+    auto fail = [this, &tempPath](const std::string& error)
+    {
+        std::error_code ignored;
+        std::filesystem::remove(tempPath, ignored);
+        setLastError(error);
+        return false;
+    };
+
+    try
+    {
+        std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+        if (!output.is_open())
+        {
+            return fail("Failed to open file for writing: " + tempPath);
+        }
+
+        // The totals are only known at the end; the header is written
+        // again then, with the same size
+        std::vector<uint8_t> header;
+        metadata.totalEvents = 0;
+        metadata.totalDurationMs = 0;
+        metadata.statistics.reset();
+        serializeHeader(metadata, UNKNOWN_EVENT_COUNT, header);
+        output.write(reinterpret_cast<const char*>(header.data()),
+                     static_cast<std::streamsize>(header.size()));
+
+        uint64_t outputOffset = header.size();
+        BlockIndex outputIndex;
+        std::optional<uint64_t> firstTimestampMs;
+        uint64_t lastTimestampMs = 0;
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+            if (!Core::StorageProgress::report(m_progress, i, segments.size()))
+            {
+                return fail(Core::StorageProgress::CANCELLED_ERROR);
+            }
+            if (!spliceSegment(segments[i],
+                               gapMs,
+                               output,
+                               outputOffset,
+                               outputIndex,
+                               firstTimestampMs,
+                               lastTimestampMs))
+            {
+                return fail(m_lastError);
+            }
+        }
+
+        metadata.totalEvents = outputIndex.eventCount;
+        metadata.totalDurationMs =
+            firstTimestampMs && lastTimestampMs > *firstTimestampMs
+                ? lastTimestampMs - *firstTimestampMs
+                : 0;
+        header.clear();
+        serializeHeader(metadata, outputIndex.eventCount, header);
+        outputIndex.headerChecksum = crc32c(0, header.data(), header.size());
+
+        std::vector<uint8_t> footer;
+        serializeBlockIndexFooter(outputIndex, footer);
+        output.write(reinterpret_cast<const char*>(footer.data()),
+                     static_cast<std::streamsize>(footer.size()));
+        output.seekp(0);
+        output.write(reinterpret_cast<const char*>(header.data()),
+                     static_cast<std::streamsize>(header.size()));
+        output.close();
+        if (!output)
+        {
+            return fail("Failed to write file: " + tempPath);
+        }
+
+        std::string error;
+        if (!replaceFile(tempPath, filename, m_syncOnSave, error))
+        {
+            setLastError(error);
+            return false;
+        }
+
+        Core::StorageProgress::report(
+            m_progress, segments.size(), segments.size());
+        recordStorageOperation(
+            "binary", "splice", outputOffset + footer.size(), startTime);
+        spdlog::info("BinaryEventStorage: Spliced {} events into {}",
+                     outputIndex.eventCount,
+                     filename);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        return fail("Binary splice error: " + std::string(e.what()));
+    }
+}
+
+bool BinaryEventStorage::spliceSegment(
+    const SpliceSegment& segment,
+    uint64_t gapMs,
+    std::ofstream& output,
+    uint64_t& outputOffset,
+    BlockIndex& outputIndex,
+    std::optional<uint64_t>& firstTimestampMs,
+    uint64_t& lastTimestampMs)
+{
+    std::ifstream file(segment.filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        setLastError("Failed to open file for reading: " + segment.filename);
+        return false;
+    }
+    auto index = readBlockIndexFooter(file);
+    if (!index)
+    {
+        setLastError("File has no block index: " + segment.filename);
+        return false;
+    }
+    file.clear();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<uint8_t> buffer;
+    size_t offset = 0;
+    Core::StorageMetadata metadata;
+    uint64_t eventCount = 0;
+    if (!readHeader(file, buffer, offset, metadata, eventCount))
+    {
+        return false;
+    }
+    if (!index->covers(eventCount))
+    {
+        setLastError("Corrupted file: block index does not match the event "
+                     "count");
+        return false;
+    }
+
+    // Rebased segments are shifted by the same amount throughout, decided
+    // by their first event
+    std::optional<uint64_t> shift;
+    if (!segment.rebase)
+    {
+        shift = 0;
+    }
+
+    const uint64_t perBlock = index->eventsPerBlock;
+    const size_t blockCount = index->blocks.size();
+    std::vector<bool> selected =
+        selectBlocks(*index, eventCount, segment.range);
+    std::vector<uint8_t> kept;
+    std::vector<uint8_t> encoded;
+    for (size_t block = 0; block < blockCount; ++block)
+    {
+        if (!selected[block])
+        {
+            continue;
+        }
+
+        uint64_t begin = index->blocks[block].offset;
+        uint64_t end = block + 1 < blockCount ? index->blocks[block + 1].offset
+                                              : index->endOffset;
+        buffer.resize(end - begin);
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(begin));
+        file.read(reinterpret_cast<char*>(buffer.data()),
+                  static_cast<std::streamsize>(buffer.size()));
+        if (!file)
         {
-            setLastError("Invalid file format: magic number mismatch");
+            setLastError("Failed to read file: " + segment.filename);
             return false;
         }
-
-        uint32_t version = readBinary<uint32_t>(buffer, offset);
-        if (version != FORMAT_VERSION)
+        if (!index->verify(block, buffer))
         {
-            setLastError("Unsupported file version: " +
-                         std::to_string(version));
+            setLastError("Corrupted file: checksum mismatch in block " +
+                         std::to_string(block) + " of " + segment.filename);
             return false;
         }
 
-        // Read metadata
-        uint32_t metadataSize = readBinary<uint32_t>(buffer, offset);
-        if (offset + metadataSize > buffer.size())
+        kept.clear();
+        size_t position = 0;
+        uint64_t last = std::min<uint64_t>((block + 1) * perBlock, eventCount);
+        for (uint64_t i = block * perBlock; i < last; ++i)
+        {
+            size_t size = getSerializedEventSize(buffer, position);
+            if (size == 0)
+            {
+                setLastError("Corrupted file: failed to read event " +
+                             std::to_string(i) + " of " + segment.filename);
+                return false;
+            }
+
+            size_t timestampOffset = position + sizeof(uint8_t);
+            uint64_t timestamp = readBinary<uint64_t>(buffer, timestampOffset);
+            if (isInRange(*index, segment.range, i, timestamp))
+            {
+                if (!shift)
+                {
+                    shift = firstTimestampMs
+                                ? lastTimestampMs + gapMs - timestamp
+                                : 0;
+                }
+                timestamp += *shift;
+                encoded.clear();
+                writeBinary(encoded, timestamp);
+                std::copy(encoded.begin(),
+                          encoded.end(),
+                          buffer.begin() + static_cast<std::ptrdiff_t>(
+                                               position + sizeof(uint8_t)));
+
+                outputIndex.add(timestamp, outputOffset + kept.size());
+                kept.insert(kept.end(),
+                            buffer.begin() +
+                                static_cast<std::ptrdiff_t>(position),
+                            buffer.begin() +
+                                static_cast<std::ptrdiff_t>(position + size));
+                if (!firstTimestampMs)
+                {
+                    firstTimestampMs = timestamp;
+                }
+                lastTimestampMs = timestamp;
+            }
+            position += size;
+        }
+        if (position != buffer.size())
         {
-            setLastError("Corrupted file: metadata size exceeds file size");
+            setLastError("Corrupted file: block index does not match the "
+                         "events of " +
+                         segment.filename);
             return false;
         }
 
-        metadata = deserializeMetadata(buffer, offset);
+        outputIndex.addBytes(kept.data(), kept.size(), outputOffset);
+        output.write(reinterpret_cast<const char*>(kept.data()),
+                     static_cast<std::streamsize>(kept.size()));
+        outputOffset += kept.size();
+    }
+    return true;
+}
 
-        // Read event count
-        uint32_t eventCount = readBinary<uint32_t>(buffer, offset);
+size_t BinaryEventStorage::getSerializedEventSize(
+    const std::vector<uint8_t>& buffer, size_t offset) const
+{
+    // Type and timestamp
+    constexpr size_t EVENT_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint64_t);
+    if (offset + EVENT_HEADER_SIZE > buffer.size())
+    {
+        return 0;
+    }
 
-        // Read events
-        events.clear();
-        events.reserve(eventCount);
+    size_t size = 0;
+    switch (static_cast<Core::EventType>(buffer[offset]))
+    {
+    case Core::EventType::MouseMove:
+    case Core::EventType::MouseClick:
+    case Core::EventType::MouseDoubleClick:
+    case Core::EventType::MouseWheel:
+        // Position, button, wheel delta and modifiers
+        size = EVENT_HEADER_SIZE + 4 * sizeof(uint32_t) + sizeof(uint8_t);
+        break;
 
-        for (uint32_t i = 0; i < eventCount; ++i)
+    case Core::EventType::KeyPress:
+    case Core::EventType::KeyRelease:
+    case Core::EventType::KeyCombination: {
+        // Key code, key name, modifiers and repeat flag
+        size_t nameOffset = offset + EVENT_HEADER_SIZE + sizeof(uint32_t);
+        if (nameOffset + sizeof(uint32_t) > buffer.size())
         {
-            auto event = deserializeEvent(buffer, offset);
-            if (event)
-            {
-                events.push_back(std::move(event));
-            }
-            else
-            {
-                spdlog::warn(
-                    "BinaryEventStorage: Failed to deserialize event {}", i);
-            }
+            return 0;
         }
+        uint32_t nameLength = readBinary<uint32_t>(buffer, nameOffset);
+        size = EVENT_HEADER_SIZE + 3 * sizeof(uint32_t) + nameLength +
+               sizeof(uint8_t);
+        break;
+    }
 
-        spdlog::info("BinaryEventStorage: Successfully loaded {} events",
-                     events.size());
-        return true;
+    default:
+        return 0;
     }
-    catch (const std::exception& e)
+
+    return offset + size <= buffer.size() ? size : 0;
+}
+
+bool BinaryEventStorage::isSupportedVersion(uint32_t version) noexcept
+{
+    return version == FORMAT_VERSION || version == LEGACY_FORMAT_VERSION ||
+           version == LOOPED_FORMAT_VERSION;
+}
+
+bool BinaryEventStorage::readHeader(std::ifstream& file,
+                                    std::vector<uint8_t>& buffer,
+                                    size_t& offset,
+                                    Core::StorageMetadata& metadata,
+                                    uint64_t& eventCount)
+{
+    BlockReader reader(file);
+
+    // Read and validate header
+    reader.ensure(buffer, offset, METADATA_OFFSET);
+    uint32_t magic = readBinary<uint32_t>(buffer, offset);
+    if (magic != MAGIC_NUMBER)
     {
-        setLastError("Binary deserialization error: " + std::string(e.what()));
+        setLastError("Invalid file format: magic number mismatch");
+        return false;
+    }
+
+    uint32_t version = readBinary<uint32_t>(buffer, offset);
+    if (!isSupportedVersion(version))
+    {
+        setLastError("Unsupported file version: " + std::to_string(version));
+        return false;
+    }
+
+    const bool legacy = version == LEGACY_FORMAT_VERSION;
+    uint64_t metadataSize = 0;
+    if (legacy)
+    {
+        metadataSize = readBinary<uint32_t>(buffer, offset);
+    }
+    else
+    {
+        eventCount = readBinary<uint64_t>(buffer, offset);
+        metadataSize = readBinary<uint64_t>(buffer, offset);
+    }
+
+    // Read metadata
+    reader.ensure(buffer, offset, metadataSize + sizeof(uint32_t));
+    if (metadataSize > buffer.size() - offset)
+    {
+        setLastError("Corrupted file: metadata size exceeds file size");
+        return false;
+    }
+    const size_t metadataEnd = offset + metadataSize;
+    metadata = deserializeMetadata(buffer, offset);
+    if (legacy)
+    {
+        eventCount = readBinary<uint32_t>(buffer, offset);
+    }
+    else if (offset > metadataEnd)
+    {
+        setLastError("Corrupted file: metadata exceeds its size");
         return false;
     }
+    else
+    {
+        // Room for metadata fields added later
+        offset = metadataEnd;
+    }
+    return true;
+}
+
+std::unique_ptr<Core::Event> BinaryEventStorage::readEvent(
+    std::ifstream& file, std::vector<uint8_t>& buffer, size_t& offset) const
+{
+    BlockReader reader(file);
+    if (buffer.size() - offset < MIN_LOOKAHEAD)
+    {
+        reader.refill(buffer, offset);
+    }
+
+    // Retry events that straddle the end of the read window
+    size_t eventOffset = offset;
+    auto event = deserializeEvent(buffer, offset);
+    while (!event && reader.refill(buffer, eventOffset))
+    {
+        offset = eventOffset;
+        event = deserializeEvent(buffer, offset);
+    }
+    return event;
 }
 
 Core::StorageFormat BinaryEventStorage::getSupportedFormat() const noexcept
@@ -216,11 +1307,18 @@ bool BinaryEventStorage::validateFile(const std::string& filename) const
         }
 
         // Read and validate header only
-        uint32_t magic, version;
-        file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
-        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        std::vector<uint8_t> header(2 * sizeof(uint32_t));
+        file.read(reinterpret_cast<char*>(header.data()),
+                  static_cast<std::streamsize>(header.size()));
+        if (!file)
+        {
+            return false;
+        }
 
-        return magic == MAGIC_NUMBER && version == FORMAT_VERSION;
+        size_t offset = 0;
+        uint32_t magic = readBinary<uint32_t>(header, offset);
+        uint32_t version = readBinary<uint32_t>(header, offset);
+        return magic == MAGIC_NUMBER && isSupportedVersion(version);
     }
     catch (const std::exception&)
     {
@@ -239,28 +1337,56 @@ bool BinaryEventStorage::getFileMetadata(const std::string& filename,
             return false;
         }
 
-        std::vector<uint8_t> buffer;
-
-        // Read header
-        uint32_t magic, version;
-        file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
-        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        // Read only the header and metadata, not a whole read block
+        auto read = [&file](std::vector<uint8_t>& buffer, uint64_t size)
+        {
+            buffer.resize(size);
+            file.read(reinterpret_cast<char*>(buffer.data()),
+                      static_cast<std::streamsize>(size));
+            return static_cast<bool>(file);
+        };
 
-        if (magic != MAGIC_NUMBER || version != FORMAT_VERSION)
+        std::vector<uint8_t> buffer;
+        size_t offset = 0;
+        if (!read(buffer, 2 * sizeof(uint32_t)))
+        {
+            return false;
+        }
+        uint32_t magic = readBinary<uint32_t>(buffer, offset);
+        uint32_t version = readBinary<uint32_t>(buffer, offset);
+        if (magic != MAGIC_NUMBER || !isSupportedVersion(version))
         {
             return false;
         }
 
-        // Read metadata size
-        uint32_t metadataSize;
-        file.read(reinterpret_cast<char*>(&metadataSize), sizeof(metadataSize));
+        // The event count follows the metadata in legacy files
+        const bool legacy = version == LEGACY_FORMAT_VERSION;
+        if (!read(buffer,
+                  legacy ? sizeof(uint32_t) : 2 * sizeof(uint64_t)))
+        {
+            return false;
+        }
+        offset = legacy ? 0 : sizeof(uint64_t);
+        uint64_t metadataSize = legacy ? readBinary<uint32_t>(buffer, offset)
+                                       : readBinary<uint64_t>(buffer, offset);
 
-        // Read metadata
-        buffer.resize(metadataSize);
-        file.read(reinterpret_cast<char*>(buffer.data()), metadataSize);
+        file.seekg(0, std::ios::end);
+        std::streamoff end = file.tellg();
+        std::streamoff start =
+            legacy ? 3 * sizeof(uint32_t) : METADATA_OFFSET;
+        if (metadataSize > static_cast<uint64_t>(end - start))
+        {
+            return false;
+        }
+        file.seekg(start);
+        if (!read(buffer, metadataSize))
+        {
+            return false;
+        }
 
-        size_t offset = 0;
+        offset = 0;
         metadata = deserializeMetadata(buffer, offset);
+        metadata.statistics = readStatisticsFooter(file);
 
         return true;
     }
@@ -270,6 +1396,11 @@ bool BinaryEventStorage::getFileMetadata(const std::string& filename,
     }
 }
 
+void BinaryEventStorage::setProgress(Core::StorageProgress* progress)
+{
+    m_progress = progress;
+}
+
 std::string BinaryEventStorage::getLastError() const
 {
     return m_lastError;
@@ -287,6 +1418,11 @@ bool BinaryEventStorage::supportsCompression() const noexcept
     return true;
 }
 
+void BinaryEventStorage::setSyncOnSave(bool sync)
+{
+    m_syncOnSave = sync;
+}
+
 void BinaryEventStorage::serializeEvent(const Core::Event& event,
                                         std::vector<uint8_t>& buffer) const
 {
@@ -380,6 +1516,27 @@ std::unique_ptr<Core::Event> BinaryEventStorage::deserializeEvent(
     }
 }
 
+void BinaryEventStorage::serializeHeader(const Core::StorageMetadata& metadata,
+                                         uint64_t eventCount,
+                                         std::vector<uint8_t>& buffer) const
+{
+    writeBinary(buffer, MAGIC_NUMBER);
+    writeBinary(buffer, FORMAT_VERSION);
+    writeBinary(buffer, eventCount);
+
+    // The size goes before the metadata, which is serialized in place
+    size_t sizeOffset = buffer.size();
+    writeBinary(buffer, uint64_t{0});
+    serializeMetadata(metadata, buffer);
+    uint64_t metadataSize = buffer.size() - sizeOffset - sizeof(uint64_t);
+
+    std::vector<uint8_t> size;
+    writeBinary(size, metadataSize);
+    std::copy(size.begin(),
+              size.end(),
+              buffer.begin() + static_cast<std::ptrdiff_t>(sizeOffset));
+}
+
 void BinaryEventStorage::serializeMetadata(
     const Core::StorageMetadata& metadata, std::vector<uint8_t>& buffer) const
 {
@@ -389,7 +1546,7 @@ void BinaryEventStorage::serializeMetadata(
     writeString(buffer, metadata.description);
     writeBinary(buffer, metadata.creationTimestamp);
     writeBinary(buffer, metadata.totalDurationMs);
-    writeBinary(buffer, metadata.totalEvents);
+    writeBinary(buffer, static_cast<uint64_t>(metadata.totalEvents));
     writeString(buffer, metadata.platform);
     writeString(buffer, metadata.screenResolution);
 }
@@ -405,34 +1562,424 @@ Core::StorageMetadata BinaryEventStorage::deserializeMetadata(
     metadata.description = readString(buffer, offset);
     metadata.creationTimestamp = readBinary<uint64_t>(buffer, offset);
     metadata.totalDurationMs = readBinary<uint64_t>(buffer, offset);
-    metadata.totalEvents = readBinary<size_t>(buffer, offset);
+    metadata.totalEvents =
+        static_cast<size_t>(readBinary<uint64_t>(buffer, offset));
     metadata.platform = readString(buffer, offset);
     metadata.screenResolution = readString(buffer, offset);
 
     return metadata;
 }
 
-template <typename T>
-void BinaryEventStorage::writeBinary(std::vector<uint8_t>& buffer,
-                                     const T& value) const
+void BinaryEventStorage::serializeStatistics(
+    const Core::RecordingStatistics& statistics,
+    std::vector<uint8_t>& buffer) const
+{
+    writeBinary(buffer, static_cast<uint32_t>(statistics.eventCounts.size()));
+    for (size_t count : statistics.eventCounts)
+    {
+        writeBinary(buffer, static_cast<uint64_t>(count));
+    }
+    writeBinary(buffer, statistics.firstTimestampMs);
+    writeBinary(buffer, statistics.lastTimestampMs);
+
+    writeBinary(buffer, static_cast<uint8_t>(statistics.hasPointerBounds));
+    writeBinary(buffer, static_cast<int32_t>(statistics.pointerMin.x));
+    writeBinary(buffer, static_cast<int32_t>(statistics.pointerMin.y));
+    writeBinary(buffer, static_cast<int32_t>(statistics.pointerMax.x));
+    writeBinary(buffer, static_cast<int32_t>(statistics.pointerMax.y));
+
+    writeBinary(buffer, static_cast<uint32_t>(statistics.keysUsed.size()));
+    for (const auto& key : statistics.keysUsed)
+    {
+        writeString(buffer, key);
+    }
+
+    writeBinary(buffer, statistics.activityStartMs);
+    writeBinary(buffer, statistics.activityBucketMs);
+    writeBinary(buffer, static_cast<uint32_t>(statistics.activity.size()));
+    for (uint64_t count : statistics.activity)
+    {
+        writeBinary(buffer, count);
+    }
+}
+
+Core::RecordingStatistics BinaryEventStorage::deserializeStatistics(
+    const std::vector<uint8_t>& buffer, size_t& offset) const
+{
+    Core::RecordingStatistics statistics;
+
+    // Event types added later are left out
+    uint32_t typeCount = readBinary<uint32_t>(buffer, offset);
+    for (uint32_t i = 0; i < typeCount; ++i)
+    {
+        uint64_t count = readBinary<uint64_t>(buffer, offset);
+        if (i < statistics.eventCounts.size())
+        {
+            statistics.eventCounts[i] = static_cast<size_t>(count);
+        }
+    }
+    statistics.firstTimestampMs = readBinary<uint64_t>(buffer, offset);
+    statistics.lastTimestampMs = readBinary<uint64_t>(buffer, offset);
+
+    statistics.hasPointerBounds = readBinary<uint8_t>(buffer, offset) != 0;
+    statistics.pointerMin.x = readBinary<int32_t>(buffer, offset);
+    statistics.pointerMin.y = readBinary<int32_t>(buffer, offset);
+    statistics.pointerMax.x = readBinary<int32_t>(buffer, offset);
+    statistics.pointerMax.y = readBinary<int32_t>(buffer, offset);
+
+    uint32_t keyCount = readBinary<uint32_t>(buffer, offset);
+    for (uint32_t i = 0; i < keyCount; ++i)
+    {
+        statistics.keysUsed.insert(readString(buffer, offset));
+    }
+
+    statistics.activityStartMs = readBinary<uint64_t>(buffer, offset);
+    statistics.activityBucketMs = readBinary<uint64_t>(buffer, offset);
+    if (statistics.activityBucketMs == 0)
+    {
+        throw std::runtime_error("Invalid activity bucket width");
+    }
+    uint32_t bucketCount = readBinary<uint32_t>(buffer, offset);
+    if (bucketCount != statistics.activity.size())
+    {
+        throw std::runtime_error("Unexpected activity histogram size");
+    }
+    for (uint64_t& count : statistics.activity)
+    {
+        count = readBinary<uint64_t>(buffer, offset);
+    }
+
+    return statistics;
+}
+
+void BinaryEventStorage::serializeStatisticsFooter(
+    const Core::RecordingStatistics& statistics,
+    std::vector<uint8_t>& buffer) const
+{
+    size_t start = buffer.size();
+    serializeStatistics(statistics, buffer);
+    writeBinary(buffer, static_cast<uint32_t>(buffer.size() - start));
+    writeBinary(buffer, STATISTICS_MAGIC);
+}
+
+std::optional<Core::RecordingStatistics> BinaryEventStorage::
+    readStatisticsFooter(const std::vector<uint8_t>& data) const
+{
+    constexpr size_t TRAILER_SIZE = 2 * sizeof(uint32_t);
+    if (data.size() < TRAILER_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    size_t offset = data.size() - TRAILER_SIZE;
+    uint32_t size = readBinary<uint32_t>(data, offset);
+    uint32_t magic = readBinary<uint32_t>(data, offset);
+    if (magic != STATISTICS_MAGIC || size > data.size() - TRAILER_SIZE)
+    {
+        return std::nullopt;
+    }
+
+    try
+    {
+        offset = data.size() - TRAILER_SIZE - size;
+        auto statistics = deserializeStatistics(data, offset);
+        if (offset != data.size() - TRAILER_SIZE)
+        {
+            return std::nullopt;
+        }
+        return statistics;
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+}
+
+std::optional<Core::RecordingStatistics> BinaryEventStorage::
+    readStatisticsFooter(std::istream& file) const
+{
+    constexpr size_t TRAILER_SIZE = 2 * sizeof(uint32_t);
+    file.clear();
+    file.seekg(0, std::ios::end);
+    std::streamoff end = file.tellg();
+
+    // In files with a loop table the statistics precede it
+    uint32_t size = 0;
+    uint32_t magic = 0;
+    if (!readTrailer(file, end, size, magic))
+    {
+        return std::nullopt;
+    }
+    if (magic == LOOP_TABLE_MAGIC)
+    {
+        end -= static_cast<std::streamoff>(TRAILER_SIZE + size);
+        if (!readTrailer(file, end, size, magic))
+        {
+            return std::nullopt;
+        }
+    }
+    if (magic != STATISTICS_MAGIC)
+    {
+        return std::nullopt;
+    }
+
+    // Read the statistics with their trailer and parse them from memory
+    std::vector<uint8_t> footer(size + TRAILER_SIZE);
+    file.seekg(end - static_cast<std::streamoff>(footer.size()));
+    file.read(reinterpret_cast<char*>(footer.data()),
+              static_cast<std::streamsize>(footer.size()));
+    if (!file)
+    {
+        return std::nullopt;
+    }
+    return readStatisticsFooter(footer);
+}
+
+void BinaryEventStorage::BlockIndex::add(const Core::Event& event,
+                                         uint64_t offset)
+{
+    add(event.getTimestampMs(), offset);
+}
+
+void BinaryEventStorage::BlockIndex::add(uint64_t timestamp, uint64_t offset)
+{
+    if (eventCount % eventsPerBlock == 0)
+    {
+        if (blocks.empty())
+        {
+            startTimestampMs = timestamp;
+        }
+        blocks.push_back({offset, timestamp, timestamp});
+    }
+    else
+    {
+        auto& block = blocks.back();
+        block.minTimestampMs = std::min(block.minTimestampMs, timestamp);
+        block.maxTimestampMs = std::max(block.maxTimestampMs, timestamp);
+    }
+    ++eventCount;
+}
+
+void BinaryEventStorage::BlockIndex::addBytes(const uint8_t* data,
+                                              size_t size,
+                                              uint64_t offset)
+{
+    // Start with the last block beginning at or before offset
+    auto next = std::upper_bound(blocks.begin(),
+                                 blocks.end(),
+                                 offset,
+                                 [](uint64_t value, const Block& block)
+                                 { return value < block.offset; });
+    while (size > 0 && next != blocks.begin())
+    {
+        Block& block = *std::prev(next);
+        uint64_t end = next != blocks.end() ? next->offset : UINT64_MAX;
+        size_t count = static_cast<size_t>(
+            std::min<uint64_t>(size, end - offset));
+        block.checksum = crc32c(block.checksum, data, count);
+        data += count;
+        size -= count;
+        offset += count;
+        ++next;
+    }
+}
+
+bool BinaryEventStorage::BlockIndex::verify(
+    size_t block, const std::vector<uint8_t>& data) const
+{
+    return crc32c(0, data.data(), data.size()) == blocks[block].checksum;
+}
+
+void BinaryEventStorage::serializeBlockIndexFooter(
+    const BlockIndex& index, std::vector<uint8_t>& buffer) const
 {
-    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
-    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    size_t start = buffer.size();
+    writeBinary(buffer, index.eventsPerBlock);
+    writeBinary(buffer, index.startTimestampMs);
+    writeBinary(buffer, index.headerChecksum);
+    writeBinary(buffer, static_cast<uint32_t>(index.blocks.size()));
+    for (const auto& block : index.blocks)
+    {
+        writeBinary(buffer, block.offset);
+        writeBinary(buffer, block.minTimestampMs);
+        writeBinary(buffer, block.maxTimestampMs);
+        writeBinary(buffer, block.checksum);
+    }
+    writeBinary(buffer, static_cast<uint32_t>(buffer.size() - start));
+    writeBinary(buffer, CHECKSUM_BLOCK_INDEX_MAGIC);
+}
+
+bool BinaryEventStorage::readTrailer(std::istream& file,
+                                     std::streamoff end,
+                                     uint32_t& size,
+                                     uint32_t& magic) const
+{
+    constexpr std::streamoff TRAILER_SIZE = 2 * sizeof(uint32_t);
+    if (end < TRAILER_SIZE)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> trailer(TRAILER_SIZE);
+    file.clear();
+    file.seekg(end - TRAILER_SIZE);
+    file.read(reinterpret_cast<char*>(trailer.data()), TRAILER_SIZE);
+    if (!file)
+    {
+        return false;
+    }
+    size_t offset = 0;
+    size = readBinary<uint32_t>(trailer, offset);
+    magic = readBinary<uint32_t>(trailer, offset);
+    return size <= end - TRAILER_SIZE;
+}
+
+bool BinaryEventStorage::verifyHeader(std::istream& file,
+                                      const BlockIndex& index)
+{
+    uint64_t size =
+        index.blocks.empty() ? index.endOffset : index.blocks.front().offset;
+    std::vector<uint8_t> header(size);
+    file.clear();
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(header.data()),
+              static_cast<std::streamsize>(header.size()));
+    if (!file ||
+        crc32c(0, header.data(), header.size()) != index.headerChecksum)
+    {
+        setLastError("Corrupted file: metadata checksum mismatch");
+        return false;
+    }
+    return true;
+}
+
+std::optional<BinaryEventStorage::BlockIndex> BinaryEventStorage::
+    readBlockIndexFooter(std::istream& file) const
+{
+    constexpr std::streamoff TRAILER_SIZE = 2 * sizeof(uint32_t);
+    file.clear();
+    file.seekg(0, std::ios::end);
+    std::streamoff end = file.tellg();
+
+    // The index ends where the statistics footer starts, if there is one
+    uint32_t trailer[2];
+    if (!readTrailer(file, end, trailer[0], trailer[1]))
+    {
+        return std::nullopt;
+    }
+    if (trailer[1] == STATISTICS_MAGIC)
+    {
+        end -= TRAILER_SIZE + trailer[0];
+        if (!readTrailer(file, end, trailer[0], trailer[1]))
+        {
+            return std::nullopt;
+        }
+    }
+    if (trailer[1] != CHECKSUM_BLOCK_INDEX_MAGIC)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<uint8_t> footer(trailer[0]);
+    file.seekg(end - TRAILER_SIZE - trailer[0]);
+    file.read(reinterpret_cast<char*>(footer.data()),
+              static_cast<std::streamsize>(footer.size()));
+    if (!file)
+    {
+        return std::nullopt;
+    }
+    return parseBlockIndexFooter(
+        footer, static_cast<uint64_t>(end - TRAILER_SIZE - trailer[0]));
+}
+
+std::optional<BinaryEventStorage::BlockIndex> BinaryEventStorage::
+    parseBlockIndexFooter(const std::vector<uint8_t>& footer,
+                          uint64_t endOffset) const
+{
+    try
+    {
+        BlockIndex index;
+        index.endOffset = endOffset;
+        size_t offset = 0;
+        index.eventsPerBlock = readBinary<uint32_t>(footer, offset);
+        index.startTimestampMs = readBinary<uint64_t>(footer, offset);
+        index.headerChecksum = readBinary<uint32_t>(footer, offset);
+        uint32_t blockCount = readBinary<uint32_t>(footer, offset);
+        const size_t blockSize = 3 * sizeof(uint64_t) + sizeof(uint32_t);
+        if (index.eventsPerBlock == 0 ||
+            (footer.size() - offset) / blockSize != blockCount)
+        {
+            return std::nullopt;
+        }
+
+        // Blocks must be in file order for their byte spans to make sense
+        index.blocks.resize(blockCount);
+        uint64_t previous = 0;
+        for (auto& block : index.blocks)
+        {
+            block.offset = readBinary<uint64_t>(footer, offset);
+            block.minTimestampMs = readBinary<uint64_t>(footer, offset);
+            block.maxTimestampMs = readBinary<uint64_t>(footer, offset);
+            block.checksum = readBinary<uint32_t>(footer, offset);
+            if (block.offset >= index.endOffset || block.offset < previous)
+            {
+                return std::nullopt;
+            }
+            previous = block.offset + 1;
+        }
+        return index;
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+}
+
+std::vector<bool> BinaryEventStorage::selectBlocks(
+    const BlockIndex& index,
+    uint64_t eventCount,
+    const Core::EventRange& range)
+{
+    const uint64_t perBlock = index.eventsPerBlock;
+    std::vector<bool> selected(index.blocks.size());
+    for (size_t block = 0; block < selected.size(); ++block)
+    {
+        uint64_t first = block * perBlock;
+        if (range.kind == Core::EventRange::Kind::Index)
+        {
+            uint64_t end = std::min<uint64_t>(first + perBlock, eventCount);
+            selected[block] = range.first < end && first < range.last;
+        }
+        else
+        {
+            const auto& entry = index.blocks[block];
+            selected[block] =
+                elapsedMs(index, entry.maxTimestampMs) >= range.first &&
+                elapsedMs(index, entry.minTimestampMs) <= range.last;
+        }
+    }
+    return selected;
 }
 
-template <typename T>
-T BinaryEventStorage::readBinary(const std::vector<uint8_t>& buffer,
-                                 size_t& offset) const
+bool BinaryEventStorage::isInRange(const BlockIndex& index,
+                                   const Core::EventRange& range,
+                                   uint64_t position,
+                                   uint64_t timestampMs)
 {
-    if (offset + sizeof(T) > buffer.size())
+    if (range.kind == Core::EventRange::Kind::Index)
     {
-        throw std::runtime_error("Buffer underrun while reading binary data");
+        return position >= range.first && position < range.last;
     }
+    uint64_t elapsed = elapsedMs(index, timestampMs);
+    return elapsed >= range.first && elapsed <= range.last;
+}
 
-    T value;
-    std::memcpy(&value, buffer.data() + offset, sizeof(T));
-    offset += sizeof(T);
-    return value;
+uint64_t BinaryEventStorage::elapsedMs(const BlockIndex& index,
+                                       uint64_t timestampMs)
+{
+    return timestampMs > index.startTimestampMs
+               ? timestampMs - index.startTimestampMs
+               : 0;
 }
 
 void BinaryEventStorage::writeString(std::vector<uint8_t>& buffer,
@@ -545,6 +2092,11 @@ std::vector<uint8_t> BinaryEventStorage::decompressData(
 void BinaryEventStorage::setLastError(const std::string& error)
 {
     m_lastError = error;
+    if (error == Core::StorageProgress::CANCELLED_ERROR)
+    {
+        spdlog::info("BinaryEventStorage: {}", error);
+        return;
+    }
     spdlog::error("BinaryEventStorage: {}", error);
 }
 
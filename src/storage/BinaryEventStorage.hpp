@@ -6,7 +6,16 @@
 #pragma once
 
 #include "core/IEventStorage.hpp"
+#include "core/RepeatedSegmentDetector.hpp"
+#include <bit>
 #include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace MouseRecorder::Storage
 {
@@ -17,12 +26,32 @@ namespace MouseRecorder::Storage
  * This class handles saving and loading events in a custom binary format
  * for optimal performance and minimal file size.
  *
- * Binary Format:
- * - Header: Magic number (4 bytes) + Version (4 bytes) + Metadata size (4
- * bytes)
+ * Binary Format, all values little-endian:
+ * - Header: Magic number (4 bytes) + Version (4 bytes) + Event count (8
+ * bytes) + Metadata size (8 bytes)
  * - Metadata: Serialized metadata structure
- * - Event count (4 bytes)
  * - Events: Array of serialized events
+ * - Block index footer (optional): Serialized BlockIndex + its size (4
+ * bytes) + CHECKSUM_BLOCK_INDEX_MAGIC (4 bytes)
+ * - Statistics footer (optional): Serialized statistics + their size (4
+ * bytes) + STATISTICS_MAGIC (4 bytes)
+ *
+ * The event count sits at a fixed offset, so a streaming writer can put
+ * UNKNOWN_EVENT_COUNT there first and fill it in once it is done. Files
+ * of LEGACY_FORMAT_VERSION have a 4 byte metadata size, then the metadata,
+ * then a 4 byte event count, and are still loaded.
+ *
+ * The block index holds a CRC32C of the header and metadata and one of the
+ * events of each block. Files with such an index are loaded block by
+ * block, checking each block right before its events are decoded.
+ *
+ * Files of LOOPED_FORMAT_VERSION store only the first repetition of
+ * repeated segments, see saveLoopedEvents(). Their block index and
+ * statistics footers are followed by a loop table footer: per segment its
+ * start, length, repeat count and period (8 bytes each), then the footer
+ * size (4 bytes) and LOOP_TABLE_MAGIC (4 bytes). The index covers the
+ * stored events, the statistics the expanded ones. loadEvents() expands
+ * them.
  */
 class BinaryEventStorage : public Core::IEventStorage
 {
@@ -39,20 +68,167 @@ class BinaryEventStorage : public Core::IEventStorage
                     std::vector<std::unique_ptr<Core::Event>>& events,
                     Core::StorageMetadata& metadata) override;
 
+    bool loadEventsRange(const std::string& filename,
+                         const Core::EventRange& range,
+                         std::vector<std::unique_ptr<Core::Event>>& events,
+                         Core::StorageMetadata& metadata) override;
+
     Core::StorageFormat getSupportedFormat() const noexcept override;
     std::string getFileExtension() const noexcept override;
     std::string getFormatDescription() const noexcept override;
     bool validateFile(const std::string& filename) const override;
     bool getFileMetadata(const std::string& filename,
                          Core::StorageMetadata& metadata) const override;
+    void setProgress(Core::StorageProgress* progress) override;
     std::string getLastError() const override;
     void setCompressionLevel(int level) override;
     bool supportsCompression() const noexcept override;
+    void setSyncOnSave(bool sync) override;
 
-  private:
     static constexpr uint32_t MAGIC_NUMBER =
         0x4D525245; // "MRRE" - MouseRecorder Recording Events
-    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    // Files with 32-bit counts and sizes, loaded but no longer written
+    static constexpr uint32_t LEGACY_FORMAT_VERSION = 1;
+
+    // Files with a loop table. Their event count is that of the stored
+    // events, so readers that don't know the table must reject them
+    // rather than play the stored events only.
+    static constexpr uint32_t LOOPED_FORMAT_VERSION = 3;
+
+    // Offset of the metadata, after the fixed size part of the header
+    static constexpr uint64_t METADATA_OFFSET =
+        2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+    // Event count of a file its writer never finished. Its events run to
+    // the end of the file, which has no footers.
+    static constexpr uint64_t UNKNOWN_EVENT_COUNT = UINT64_MAX;
+
+    // Ends the statistics footer that follows the events. Readers that
+    // don't know the footer stop after the last event and never see it.
+    static constexpr uint32_t STATISTICS_MAGIC = 0x5453524D; // "MRST"
+
+    // Ends the block index footer that precedes the statistics footer
+    static constexpr uint32_t CHECKSUM_BLOCK_INDEX_MAGIC =
+        0x4349524D; // "MRIC"
+
+    // Ends the loop table footer of LOOPED_FORMAT_VERSION files
+    static constexpr uint32_t LOOP_TABLE_MAGIC = 0x504C524D; // "MRLP"
+
+    // Events per block of the block index
+    static constexpr uint32_t INDEX_BLOCK_EVENTS = 4096;
+
+    /**
+     * @brief Where every INDEX_BLOCK_EVENTS events start and when they
+     * happened
+     *
+     * Lets loadEventsRange() seek to the blocks overlapping a range
+     * instead of decoding the events before it.
+     */
+    struct BlockIndex
+    {
+        struct Block
+        {
+            // Offset of the first event of the block in the file
+            uint64_t offset{0};
+            uint64_t minTimestampMs{0};
+            uint64_t maxTimestampMs{0};
+
+            // CRC32C of the serialized events of the block
+            uint32_t checksum{0};
+        };
+
+        uint32_t eventsPerBlock{INDEX_BLOCK_EVENTS};
+
+        // CRC32C of the header and metadata preceding the first event
+        uint32_t headerChecksum{0};
+
+        // Timestamp of the first event of the recording
+        uint64_t startTimestampMs{0};
+        std::vector<Block> blocks;
+
+        // Events added so far, not stored
+        uint64_t eventCount{0};
+
+        // Offset following the last event, set when the index is read
+        uint64_t endOffset{0};
+
+        /**
+         * @brief Account for the next event, serialized at offset
+         */
+        void add(const Core::Event& event, uint64_t offset);
+        void add(uint64_t timestampMs, uint64_t offset);
+
+        /**
+         * @brief Add serialized events to the checksums of their blocks
+         *
+         * The events must have been add()ed already.
+         * @param data Serialized events, possibly spanning blocks
+         * @param size Number of bytes
+         * @param offset Offset of data in the file
+         */
+        void addBytes(const uint8_t* data, size_t size, uint64_t offset);
+
+        /**
+         * @brief Check the serialized events of a block against its
+         * checksum
+         * @return true if they match
+         */
+        bool verify(size_t block, const std::vector<uint8_t>& data) const;
+
+        /**
+         * @brief Check whether the blocks hold eventCount events
+         */
+        bool covers(uint64_t eventCount) const noexcept
+        {
+            return eventCount != UNKNOWN_EVENT_COUNT &&
+                   (eventCount + eventsPerBlock - 1) / eventsPerBlock ==
+                       blocks.size();
+        }
+    };
+
+    /**
+     * @brief Events of a file copied by splice()
+     */
+    struct SpliceSegment
+    {
+        std::string filename;
+        Core::EventRange range;
+
+        // Shift the timestamps so the segment starts gapMs after the last
+        // event of the segments before it
+        bool rebase{false};
+    };
+
+    /**
+     * @brief Write binary data to buffer (little-endian)
+     *
+     * Also used by the other files of the storage layer, so all of them
+     * are independent of the byte order of the host.
+     */
+    template <typename T>
+    void writeBinary(std::vector<uint8_t>& buffer, const T& value) const;
+
+    /**
+     * @brief Read binary data from buffer (little-endian)
+     * @throws std::runtime_error if the buffer ends before the value
+     */
+    template <typename T>
+    T readBinary(const std::vector<uint8_t>& buffer, size_t& offset) const;
+
+    /**
+     * @brief Write string to buffer (length-prefixed)
+     */
+    void writeString(std::vector<uint8_t>& buffer,
+                     const std::string& str) const;
+
+    /**
+     * @brief Read string from buffer (length-prefixed)
+     * @throws std::runtime_error if the buffer ends before the string
+     */
+    std::string readString(const std::vector<uint8_t>& buffer,
+                           size_t& offset) const;
 
     /**
      * @brief Serialize an event to binary buffer
@@ -71,8 +247,20 @@ class BinaryEventStorage : public Core::IEventStorage
     std::unique_ptr<Core::Event> deserializeEvent(
         const std::vector<uint8_t>& buffer, size_t& offset) const;
 
+    /**
+     * @brief Serialize the header and metadata that precede the events
+     * @param metadata Metadata to serialize
+     * @param eventCount Number of events, or UNKNOWN_EVENT_COUNT
+     * @param buffer Output buffer
+     */
+    void serializeHeader(const Core::StorageMetadata& metadata,
+                         uint64_t eventCount,
+                         std::vector<uint8_t>& buffer) const;
+
     /**
      * @brief Serialize metadata to binary buffer
+     *
+     * The size only depends on the string fields.
      * @param metadata Metadata to serialize
      * @param buffer Output buffer
      */
@@ -89,28 +277,284 @@ class BinaryEventStorage : public Core::IEventStorage
         const std::vector<uint8_t>& buffer, size_t& offset) const;
 
     /**
-     * @brief Write binary data to buffer (little-endian)
+     * @brief Serialize statistics to binary buffer
+     * @param statistics Statistics to serialize
+     * @param buffer Output buffer
      */
-    template <typename T>
-    void writeBinary(std::vector<uint8_t>& buffer, const T& value) const;
+    void serializeStatistics(const Core::RecordingStatistics& statistics,
+                             std::vector<uint8_t>& buffer) const;
 
     /**
-     * @brief Read binary data from buffer (little-endian)
+     * @brief Deserialize statistics from binary buffer
+     * @param buffer Input buffer
+     * @param offset Current offset in buffer (will be updated)
+     * @return RecordingStatistics
      */
-    template <typename T>
-    T readBinary(const std::vector<uint8_t>& buffer, size_t& offset) const;
+    Core::RecordingStatistics deserializeStatistics(
+        const std::vector<uint8_t>& buffer, size_t& offset) const;
 
     /**
-     * @brief Write string to buffer (length-prefixed)
+     * @brief Append the statistics footer written after the events
+     *
+     * The statistics are followed by their size and STATISTICS_MAGIC, so
+     * they can be found from the end of the file.
+     * @param statistics Statistics to serialize
+     * @param buffer Output buffer
      */
-    void writeString(std::vector<uint8_t>& buffer,
-                     const std::string& str) const;
+    void serializeStatisticsFooter(const Core::RecordingStatistics& statistics,
+                                   std::vector<uint8_t>& buffer) const;
 
     /**
-     * @brief Read string from buffer (length-prefixed)
+     * @brief Append the block index footer written after the events
+     *
+     * Goes before the statistics footer.
+     * @param index Index of the serialized events
+     * @param buffer Output buffer
      */
-    std::string readString(const std::vector<uint8_t>& buffer,
-                           size_t& offset) const;
+    void serializeBlockIndexFooter(const BlockIndex& index,
+                                   std::vector<uint8_t>& buffer) const;
+
+    /**
+     * @brief Save a recording with its repeated segments stored once
+     *
+     * Files of recordings without segments are written by saveEvents().
+     * The block index of the file only checks the stored events; ranges
+     * of it are loaded by expanding it, and it cannot be spliced or
+     * followed.
+     * @param recording Stored events and their segments, see
+     * Core::RepeatedSegmentDetector::compress()
+     * @param filename Path to the output file
+     * @param metadata Metadata to write
+     * @return true if the file was written
+     */
+    bool saveLoopedEvents(const Core::LoopedRecording& recording,
+                          const std::string& filename,
+                          const Core::StorageMetadata& metadata = {});
+
+    /**
+     * @brief Load a recording without expanding its repeated segments
+     *
+     * For a player that expands them while playing; files without a loop
+     * table are loaded as they are, with an empty segment index.
+     * @param filename Path to the input file
+     * @param recording Output stored events and segments
+     * @param metadata Output metadata
+     * @return true if the file was loaded
+     */
+    bool loadLoopedEvents(const std::string& filename,
+                          Core::LoopedRecording& recording,
+                          Core::StorageMetadata& metadata);
+
+    /**
+     * @brief Check whether a file is of LOOPED_FORMAT_VERSION
+     *
+     * Only the header of uncompressed files is read.
+     */
+    bool isLoopedFile(const std::string& filename);
+
+    /**
+     * @brief Check whether splice() can copy events of a file
+     * @return true if the file is uncompressed and has a block index
+     */
+    bool hasBlockIndex(const std::string& filename) const;
+
+    /**
+     * @brief Write ranges of indexed files to a new file without decoding
+     * their events
+     *
+     * Only the blocks overlapping the ranges are read, and the serialized
+     * events are copied as they are; rebased segments have the timestamp
+     * of each event patched on the way. The file gets a new block index
+     * but no statistics footer, which would take decoding the events.
+     * @param segments Files and ranges to copy, in output order
+     * @param filename Path to the output file
+     * @param gapMs Time between rebased segments
+     * @param metadata Metadata to write; totalEvents and totalDurationMs
+     * are set to those of the output
+     * @return true if the file was written
+     */
+    bool splice(const std::vector<SpliceSegment>& segments,
+                const std::string& filename,
+                uint64_t gapMs,
+                Core::StorageMetadata& metadata);
+
+    /**
+     * @brief Get the size of a serialized event without decoding it
+     * @param buffer Buffer holding the event
+     * @param offset Offset of the event in buffer
+     * @return size or 0 if the buffer ends inside the event or its type is
+     * unknown
+     */
+    size_t getSerializedEventSize(const std::vector<uint8_t>& buffer,
+                                  size_t offset) const;
+
+  private:
+    // Events serialized or deserialized between progress reports
+    static constexpr uint32_t PROGRESS_INTERVAL = 4096;
+
+    /**
+     * @brief Check whether files of version can be loaded
+     */
+    static bool isSupportedVersion(uint32_t version) noexcept;
+
+    /**
+     * @brief Read the header and metadata up to the first event
+     * @param file File being read, or a closed file if buffer holds all
+     * of the data
+     * @param buffer Read window, see readEvent()
+     * @param offset Offset of the first event in buffer on return
+     * @param metadata Output metadata, without the statistics
+     * @param eventCount Output number of events, or UNKNOWN_EVENT_COUNT
+     * @return true if the header is valid
+     */
+    bool readHeader(std::ifstream& file,
+                    std::vector<uint8_t>& buffer,
+                    size_t& offset,
+                    Core::StorageMetadata& metadata,
+                    uint64_t& eventCount);
+
+    /**
+     * @brief Read a whole file, decompressing it if compression is enabled
+     */
+    bool readFileData(const std::string& filename,
+                      std::vector<uint8_t>& data);
+
+    /**
+     * @brief Check whether file data has a loop table
+     */
+    bool isLoopedData(const std::vector<uint8_t>& data) const;
+
+    /**
+     * @brief Decode the file data of a LOOPED_FORMAT_VERSION file
+     * @return true if its events and loop table are valid
+     */
+    bool parseLoopedData(std::vector<uint8_t> data,
+                         Core::LoopedRecording& recording,
+                         Core::StorageMetadata& metadata);
+
+    /**
+     * @brief Check the header, metadata and events of a looped file
+     * against its block index
+     * @param data File data
+     * @param index Block index read from data
+     * @param eventsStart Offset of the first event
+     * @return false if they do not match
+     */
+    bool verifyLoopedData(const std::vector<uint8_t>& data,
+                          const BlockIndex& index,
+                          size_t eventsStart);
+
+    /**
+     * @brief Decode the next event, reading more of the file as needed
+     * @return event or nullptr if it could not be decoded
+     */
+    std::unique_ptr<Core::Event> readEvent(std::ifstream& file,
+                                           std::vector<uint8_t>& buffer,
+                                           size_t& offset) const;
+
+    /**
+     * @brief Check the header and metadata of file against the checksum of
+     * index
+     *
+     * Leaves the read position of file undefined.
+     * @return false if they do not match
+     */
+    bool verifyHeader(std::istream& file, const BlockIndex& index);
+
+    /**
+     * @brief Read the block index footer of an uncompressed file
+     *
+     * Leaves the read position of file undefined.
+     * @param file Uncompressed file
+     * @return index or nothing if the file has no valid index
+     */
+    std::optional<BlockIndex> readBlockIndexFooter(std::istream& file) const;
+
+    /**
+     * @brief Decode a block index footer
+     * @param footer Serialized index, without its trailer
+     * @param endOffset Offset of the footer, where the events end
+     * @return index or nothing if the footer is not a valid index
+     */
+    std::optional<BlockIndex> parseBlockIndexFooter(
+        const std::vector<uint8_t>& footer, uint64_t endOffset) const;
+
+    /**
+     * @brief Read the size and magic number ending a footer
+     * @param end Offset the footer ends at
+     * @return false if there is no room for the trailer or its size
+     */
+    bool readTrailer(std::istream& file,
+                     std::streamoff end,
+                     uint32_t& size,
+                     uint32_t& magic) const;
+
+    /**
+     * @brief Select the blocks of an index holding events of a range
+     */
+    static std::vector<bool> selectBlocks(const BlockIndex& index,
+                                          uint64_t eventCount,
+                                          const Core::EventRange& range);
+
+    /**
+     * @brief Check whether the event at position with timestampMs is part
+     * of range
+     */
+    static bool isInRange(const BlockIndex& index,
+                          const Core::EventRange& range,
+                          uint64_t position,
+                          uint64_t timestampMs);
+
+    /**
+     * @brief Get the time of timestampMs after the start of an index
+     */
+    static uint64_t elapsedMs(const BlockIndex& index, uint64_t timestampMs);
+
+    /**
+     * @brief Copy the events of one segment for splice()
+     * @param lastTimestampMs Timestamp of the last event written so far,
+     * updated
+     */
+    bool spliceSegment(const SpliceSegment& segment,
+                       uint64_t gapMs,
+                       std::ofstream& output,
+                       uint64_t& outputOffset,
+                       BlockIndex& outputIndex,
+                       std::optional<uint64_t>& firstTimestampMs,
+                       uint64_t& lastTimestampMs);
+
+    /**
+     * @brief Load a range by decoding only the blocks overlapping it
+     *
+     * Each block is read as a whole and checked against its checksum
+     * before it is decoded. With streamEvents the decoded events are
+     * handed to the progress sink as they come, like loadEvents() does.
+     */
+    bool loadIndexedRange(const std::string& filename,
+                          const BlockIndex& index,
+                          const Core::EventRange& range,
+                          std::vector<std::unique_ptr<Core::Event>>& events,
+                          Core::StorageMetadata& metadata,
+                          bool streamEvents = false);
+
+    /**
+     * @brief Read the statistics footer at the end of file data
+     * @param data File content
+     * @return statistics or nothing if the data has no footer
+     */
+    std::optional<Core::RecordingStatistics> readStatisticsFooter(
+        const std::vector<uint8_t>& data) const;
+
+    /**
+     * @brief Read the statistics footer at the end of a file, or before
+     * its loop table
+     *
+     * Leaves the read position of file undefined.
+     * @param file Uncompressed file
+     * @return statistics or nothing if the file has no footer
+     */
+    std::optional<Core::RecordingStatistics> readStatisticsFooter(
+        std::istream& file) const;
 
     /**
      * @brief Compress data using simple RLE compression
@@ -136,6 +580,42 @@ class BinaryEventStorage : public Core::IEventStorage
   private:
     mutable std::string m_lastError;
     bool m_compressionEnabled{false};
+    Core::StorageProgress* m_progress{nullptr};
+    bool m_syncOnSave{true};
 };
 
+template <typename T>
+void BinaryEventStorage::writeBinary(std::vector<uint8_t>& buffer,
+                                     const T& value) const
+{
+    static_assert(std::is_integral_v<T>, "Only integers are serialized");
+    T encoded = value;
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        encoded = std::byteswap(encoded);
+    }
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&encoded);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T BinaryEventStorage::readBinary(const std::vector<uint8_t>& buffer,
+                                 size_t& offset) const
+{
+    if (offset + sizeof(T) > buffer.size())
+    {
+        throw std::runtime_error("Buffer underrun while reading binary data");
+    }
+
+    static_assert(std::is_integral_v<T>, "Only integers are serialized");
+    T value;
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        value = std::byteswap(value);
+    }
+    offset += sizeof(T);
+    return value;
+}
+
 } // namespace MouseRecorder::Storage
@@ -0,0 +1,946 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "ColumnarEventStorage.hpp"
+#include "EventRangeFilter.hpp"
+#include "StorageFileIO.hpp"
+#include "StorageMetrics.hpp"
+#include "core/Event.hpp"
+#include "core/SpdlogConfig.hpp"
+#include "core/StorageTask.hpp"
+#include "core/Tracing.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace MouseRecorder::Storage
+{
+
+namespace
+{
+
+using ColumnEncoding = ColumnarEventStorage::ColumnEncoding;
+
+constexpr EventColumn LAST_COLUMN = EventColumn::Repeated;
+constexpr ColumnEncoding LAST_ENCODING = ColumnEncoding::Dictionary;
+
+// Size of a column directory entry
+constexpr uint64_t DIRECTORY_ENTRY_SIZE =
+    2 * sizeof(uint32_t) + 3 * sizeof(uint64_t);
+
+// More columns than any version writes means a corrupted directory
+constexpr uint32_t MAX_COLUMNS = 64;
+
+/**
+ * @brief Columns with one value per event, per mouse event and per
+ * keyboard event
+ */
+enum class ColumnGroup
+{
+    Event,
+    Mouse,
+    Keyboard
+};
+
+ColumnGroup groupOf(EventColumn column)
+{
+    switch (column)
+    {
+    case EventColumn::X:
+    case EventColumn::Y:
+    case EventColumn::Button:
+    case EventColumn::WheelDelta:
+        return ColumnGroup::Mouse;
+    case EventColumn::KeyCode:
+    case EventColumn::KeyName:
+    case EventColumn::Repeated:
+        return ColumnGroup::Keyboard;
+    default:
+        return ColumnGroup::Event;
+    }
+}
+
+/**
+ * @brief Check whether events of type carry mouse data, as in
+ * BinaryEventStorage::serializeEvent()
+ */
+bool isMouseType(Core::EventType type)
+{
+    return type == Core::EventType::MouseMove ||
+           type == Core::EventType::MouseClick ||
+           type == Core::EventType::MouseDoubleClick ||
+           type == Core::EventType::MouseWheel;
+}
+
+template <typename T>
+void appendLittleEndian(std::vector<uint8_t>& buffer, T value)
+{
+    static_assert(std::is_unsigned_v<T>, "Only unsigned values are written");
+    for (size_t i = 0; i < sizeof(T); ++i)
+    {
+        buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void appendVarint(std::vector<uint8_t>& buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t zigzag(uint64_t value)
+{
+    return (value << 1) ^ (static_cast<int64_t>(value) < 0 ? UINT64_MAX : 0);
+}
+
+uint64_t unzigzag(uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+/**
+ * @brief Reads little-endian values and varints from a buffer
+ */
+class ByteReader
+{
+  public:
+    explicit ByteReader(const std::vector<uint8_t>& buffer) : m_buffer(buffer)
+    {
+    }
+
+    template <typename T>
+    T read()
+    {
+        require(sizeof(T));
+        T value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            value |= static_cast<T>(m_buffer[m_offset++]) << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t readVarint()
+    {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7)
+        {
+            require(1);
+            uint8_t byte = m_buffer[m_offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw std::runtime_error("Varint is too long");
+    }
+
+    std::string readString()
+    {
+        uint64_t size = readVarint();
+        require(size);
+        std::string value(
+            reinterpret_cast<const char*>(m_buffer.data() + m_offset), size);
+        m_offset += size;
+        return value;
+    }
+
+    size_t remaining() const noexcept
+    {
+        return m_buffer.size() - m_offset;
+    }
+
+  private:
+    void require(uint64_t bytes) const
+    {
+        if (bytes > remaining())
+        {
+            throw std::runtime_error("Unexpected end of data");
+        }
+    }
+
+    const std::vector<uint8_t>& m_buffer;
+    size_t m_offset{0};
+};
+
+/**
+ * @brief Read size bytes at the current position of a file of fileSize
+ * bytes
+ */
+std::vector<uint8_t> readBytes(std::istream& file,
+                               uint64_t fileSize,
+                               uint64_t size)
+{
+    std::streamoff position = file.tellg();
+    if (position < 0 || size > fileSize - static_cast<uint64_t>(position))
+    {
+        throw std::runtime_error("File ends early");
+    }
+    std::vector<uint8_t> buffer(size);
+    file.read(reinterpret_cast<char*>(buffer.data()),
+              static_cast<std::streamsize>(size));
+    if (!file)
+    {
+        throw std::runtime_error("Failed to read file");
+    }
+    return buffer;
+}
+
+} // namespace
+
+ColumnarEventStorage::Encoder::Encoder()
+{
+    // Columns in the order of EventColumn, which add() relies on
+    m_columns = {
+        {EventColumn::Type, ColumnEncoding::RunLength},
+        {EventColumn::Timestamp, ColumnEncoding::Delta},
+        {EventColumn::X, ColumnEncoding::Delta},
+        {EventColumn::Y, ColumnEncoding::Delta},
+        {EventColumn::Button, ColumnEncoding::RunLength},
+        {EventColumn::WheelDelta, ColumnEncoding::Delta},
+        {EventColumn::KeyCode, ColumnEncoding::Plain},
+        {EventColumn::KeyName, ColumnEncoding::Dictionary},
+        {EventColumn::Modifiers, ColumnEncoding::RunLength},
+        {EventColumn::Repeated, ColumnEncoding::RunLength},
+    };
+}
+
+void ColumnarEventStorage::Encoder::add(const Core::Event& event)
+{
+    ++m_eventCount;
+    add(EventColumn::Type, static_cast<uint64_t>(event.getType()));
+    add(EventColumn::Timestamp, event.getTimestampMs());
+
+    // Signed values are stored as their two's complement, which the delta
+    // encoding turns back into small numbers
+    if (isMouseType(event.getType()))
+    {
+        static const Core::MouseEventData none;
+        const auto* data = event.getMouseData();
+        const auto& mouse = data ? *data : none;
+        add(EventColumn::X, static_cast<uint64_t>(mouse.position.x));
+        add(EventColumn::Y, static_cast<uint64_t>(mouse.position.y));
+        add(EventColumn::Button, static_cast<uint64_t>(mouse.button));
+        add(EventColumn::WheelDelta, static_cast<uint64_t>(mouse.wheelDelta));
+        add(EventColumn::Modifiers, static_cast<uint64_t>(mouse.modifiers));
+    }
+    else
+    {
+        static const Core::KeyboardEventData none;
+        const auto* data = event.getKeyboardData();
+        const auto& key = data ? *data : none;
+        add(EventColumn::KeyCode, key.keyCode);
+        add(EventColumn::KeyName, key.keyName);
+        add(EventColumn::Repeated, static_cast<uint64_t>(key.isRepeated));
+        add(EventColumn::Modifiers, static_cast<uint64_t>(key.modifiers));
+    }
+}
+
+void ColumnarEventStorage::Encoder::add(EventColumn id, uint64_t value)
+{
+    Column& column = m_columns[static_cast<size_t>(id)];
+    ++column.valueCount;
+    switch (column.encoding)
+    {
+    case ColumnEncoding::Plain:
+        appendVarint(column.data, value);
+        break;
+    case ColumnEncoding::Delta:
+        appendVarint(column.data, zigzag(value - column.previous));
+        column.previous = value;
+        break;
+    case ColumnEncoding::RunLength:
+        if (column.runLength > 0 && value == column.previous)
+        {
+            ++column.runLength;
+            break;
+        }
+        if (column.runLength > 0)
+        {
+            appendVarint(column.data, column.previous);
+            appendVarint(column.data, column.runLength);
+        }
+        column.previous = value;
+        column.runLength = 1;
+        break;
+    case ColumnEncoding::Dictionary:
+        throw std::logic_error("Dictionary columns hold strings");
+    }
+}
+
+void ColumnarEventStorage::Encoder::add(EventColumn id,
+                                        const std::string& value)
+{
+    Column& column = m_columns[static_cast<size_t>(id)];
+    auto [it, inserted] =
+        column.indices.try_emplace(value, column.dictionary.size());
+    if (inserted)
+    {
+        column.dictionary.push_back(value);
+    }
+    ++column.valueCount;
+    appendVarint(column.data, it->second);
+}
+
+void ColumnarEventStorage::Encoder::serialize(const Column& column,
+                                              std::vector<uint8_t>& buffer)
+{
+    if (column.encoding == ColumnEncoding::Dictionary)
+    {
+        appendVarint(buffer, column.dictionary.size());
+        for (const auto& value : column.dictionary)
+        {
+            appendVarint(buffer, value.size());
+            buffer.insert(buffer.end(), value.begin(), value.end());
+        }
+    }
+    buffer.insert(buffer.end(), column.data.begin(), column.data.end());
+    if (column.encoding == ColumnEncoding::RunLength && column.runLength > 0)
+    {
+        appendVarint(buffer, column.previous);
+        appendVarint(buffer, column.runLength);
+    }
+}
+
+void ColumnarEventStorage::Encoder::serialize(
+    const Core::StorageMetadata& metadata, std::vector<uint8_t>& buffer) const
+{
+    appendLittleEndian(buffer, MAGIC_NUMBER);
+    appendLittleEndian(buffer, FORMAT_VERSION);
+    appendLittleEndian(buffer, m_eventCount);
+
+    std::vector<uint8_t> section;
+    m_codec.serializeMetadata(metadata, section);
+    appendLittleEndian(buffer, static_cast<uint64_t>(section.size()));
+    buffer.insert(buffer.end(), section.begin(), section.end());
+
+    section.clear();
+    if (metadata.statistics)
+    {
+        m_codec.serializeStatistics(*metadata.statistics, section);
+    }
+    appendLittleEndian(buffer, static_cast<uint64_t>(section.size()));
+    buffer.insert(buffer.end(), section.begin(), section.end());
+
+    // The directory goes first so readers can seek to the columns they
+    // need
+    std::vector<std::vector<uint8_t>> data(m_columns.size());
+    uint64_t offset = buffer.size() + sizeof(uint32_t) +
+                      m_columns.size() * DIRECTORY_ENTRY_SIZE;
+    appendLittleEndian(buffer, static_cast<uint32_t>(m_columns.size()));
+    for (size_t i = 0; i < m_columns.size(); ++i)
+    {
+        serialize(m_columns[i], data[i]);
+        appendLittleEndian(buffer, static_cast<uint32_t>(m_columns[i].id));
+        appendLittleEndian(buffer,
+                           static_cast<uint32_t>(m_columns[i].encoding));
+        appendLittleEndian(buffer, m_columns[i].valueCount);
+        appendLittleEndian(buffer, offset);
+        appendLittleEndian(buffer, static_cast<uint64_t>(data[i].size()));
+        offset += data[i].size();
+    }
+    for (const auto& column : data)
+    {
+        buffer.insert(buffer.end(), column.begin(), column.end());
+    }
+}
+
+bool ColumnarEventStorage::saveEvents(
+    const std::vector<std::unique_ptr<Core::Event>>& events,
+    const std::string& filename,
+    const Core::StorageMetadata& metadata)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "ColumnarEventStorage::saveEvents");
+    auto startTime = std::chrono::steady_clock::now();
+    spdlog::info("ColumnarEventStorage: Saving {} events to {}",
+                 events.size(),
+                 filename);
+
+    try
+    {
+        Encoder encoder;
+        Core::StorageMetadata fileMetadata = metadata;
+        Core::RecordingStatistics statistics;
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            if (i % PROGRESS_INTERVAL == 0 &&
+                !Core::StorageProgress::report(m_progress, i, events.size()))
+            {
+                setLastError(Core::StorageProgress::CANCELLED_ERROR);
+                return false;
+            }
+            if (events[i])
+            {
+                encoder.add(*events[i]);
+                statistics.add(*events[i]);
+            }
+        }
+        fileMetadata.statistics = statistics;
+
+        std::vector<uint8_t> buffer;
+        encoder.serialize(fileMetadata, buffer);
+
+        // Write to file; progress was reported per event already
+        std::string error;
+        if (!writeFileWithProgress(
+                filename,
+                std::string_view(reinterpret_cast<const char*>(buffer.data()),
+                                 buffer.size()),
+                nullptr,
+                m_syncOnSave,
+                error))
+        {
+            setLastError(error);
+            return false;
+        }
+
+        Core::StorageProgress::report(m_progress, events.size(), events.size());
+        recordStorageOperation("columnar", "save", buffer.size(), startTime);
+        spdlog::info(
+            "ColumnarEventStorage: Successfully saved {} events ({} bytes)",
+            events.size(),
+            buffer.size());
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        setLastError("Columnar serialization error: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool ColumnarEventStorage::loadEvents(
+    const std::string& filename,
+    std::vector<std::unique_ptr<Core::Event>>& events,
+    Core::StorageMetadata& metadata)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "ColumnarEventStorage::loadEvents");
+    auto startTime = std::chrono::steady_clock::now();
+    spdlog::info("ColumnarEventStorage: Loading events from {}", filename);
+
+    try
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            setLastError("Failed to open file for reading: " + filename);
+            return false;
+        }
+
+        uint64_t eventCount = 0;
+        std::vector<DirectoryEntry> directory;
+        readHeader(file, metadata, eventCount, directory);
+        if (m_progress)
+        {
+            m_progress->metadataLoaded(metadata);
+        }
+
+        ColumnValues types, timestamps, modifiers, x, y, buttons, wheelDeltas,
+            keyCodes, keyNames, repeated;
+        readColumn(file, directory, EventColumn::Type, types);
+        readColumn(file, directory, EventColumn::Timestamp, timestamps);
+        readColumn(file, directory, EventColumn::Modifiers, modifiers);
+        readColumn(file, directory, EventColumn::X, x);
+        readColumn(file, directory, EventColumn::Y, y);
+        readColumn(file, directory, EventColumn::Button, buttons);
+        readColumn(file, directory, EventColumn::WheelDelta, wheelDeltas);
+        readColumn(file, directory, EventColumn::KeyCode, keyCodes);
+        readColumn(file, directory, EventColumn::KeyName, keyNames);
+        readColumn(file, directory, EventColumn::Repeated, repeated);
+
+        // The directory has checked the counts; the types have to agree
+        uint64_t mouseEvents = 0;
+        for (uint64_t type : types.numbers)
+        {
+            if (type > static_cast<uint64_t>(Core::EventType::KeyCombination))
+            {
+                throw std::runtime_error("Unknown event type");
+            }
+            mouseEvents += isMouseType(static_cast<Core::EventType>(type));
+        }
+        if (mouseEvents != x.numbers.size())
+        {
+            throw std::runtime_error("Event types do not match the columns");
+        }
+
+        // A progress sink may take the events in chunks, so only reserve
+        // what one chunk needs then
+        events.clear();
+        events.reserve(m_progress ? std::min<uint64_t>(eventCount,
+                                                       PROGRESS_INTERVAL)
+                                  : eventCount);
+        size_t mouse = 0;
+        size_t key = 0;
+        for (uint64_t i = 0; i < eventCount; ++i)
+        {
+            if (i % PROGRESS_INTERVAL == 0)
+            {
+                if (m_progress && i > 0)
+                {
+                    m_progress->eventsLoaded(events);
+                }
+                if (!Core::StorageProgress::report(m_progress, i, eventCount))
+                {
+                    events.clear();
+                    setLastError(Core::StorageProgress::CANCELLED_ERROR);
+                    return false;
+                }
+            }
+
+            auto type = static_cast<Core::EventType>(types.numbers[i]);
+            auto modifier =
+                static_cast<Core::KeyModifier>(modifiers.numbers[i]);
+            Core::Event::EventData data;
+            if (isMouseType(type))
+            {
+                Core::MouseEventData mouseData;
+                mouseData.position = {static_cast<int32_t>(x.numbers[mouse]),
+                                      static_cast<int32_t>(y.numbers[mouse])};
+                mouseData.button =
+                    static_cast<Core::MouseButton>(buttons.numbers[mouse]);
+                mouseData.wheelDelta =
+                    static_cast<int32_t>(wheelDeltas.numbers[mouse]);
+                mouseData.modifiers = modifier;
+                data = mouseData;
+                ++mouse;
+            }
+            else
+            {
+                Core::KeyboardEventData keyData;
+                keyData.keyCode = static_cast<uint32_t>(keyCodes.numbers[key]);
+                keyData.keyName = std::move(keyNames.strings[key]);
+                keyData.modifiers = modifier;
+                keyData.isRepeated = repeated.numbers[key] != 0;
+                data = std::move(keyData);
+                ++key;
+            }
+            events.push_back(std::make_unique<Core::Event>(
+                type,
+                std::move(data),
+                Core::Event::timestampFromMs(timestamps.numbers[i])));
+        }
+
+        Core::StorageProgress::report(m_progress, eventCount, eventCount);
+        file.seekg(0, std::ios::end);
+        recordStorageOperation(
+            "columnar", "load", static_cast<uint64_t>(file.tellg()), startTime);
+        spdlog::info("ColumnarEventStorage: Successfully loaded {} events",
+                     eventCount);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        events.clear();
+        setLastError("Columnar deserialization error: " +
+                     std::string(e.what()));
+        return false;
+    }
+}
+
+bool ColumnarEventStorage::loadEventsRange(
+    const std::string& filename,
+    const Core::EventRange& range,
+    std::vector<std::unique_ptr<Core::Event>>& events,
+    Core::StorageMetadata& metadata)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage",
+                              "ColumnarEventStorage::loadEventsRange");
+    if (!loadEventsRangeStreaming(
+            *this, m_progress, filename, range, events, metadata))
+    {
+        return false;
+    }
+
+    // Stopping after the range is not an error
+    m_lastError.clear();
+    spdlog::info("ColumnarEventStorage: Loaded {} events of a range from {}",
+                 events.size(),
+                 filename);
+    return true;
+}
+
+bool ColumnarEventStorage::loadColumns(const std::string& filename,
+                                       const std::vector<EventColumn>& columns,
+                                       EventColumns& output,
+                                       Core::StorageMetadata& metadata)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "ColumnarEventStorage::loadColumns");
+    auto startTime = std::chrono::steady_clock::now();
+    output = {};
+
+    try
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            setLastError("Failed to open file for reading: " + filename);
+            return false;
+        }
+
+        uint64_t eventCount = 0;
+        std::vector<DirectoryEntry> directory;
+        readHeader(file, metadata, eventCount, directory);
+        if (m_progress)
+        {
+            m_progress->metadataLoaded(metadata);
+        }
+
+        uint64_t bytesRead = static_cast<uint64_t>(file.tellg());
+        for (size_t i = 0; i < columns.size(); ++i)
+        {
+            if (!Core::StorageProgress::report(m_progress, i, columns.size()))
+            {
+                output = {};
+                setLastError(Core::StorageProgress::CANCELLED_ERROR);
+                return false;
+            }
+
+            ColumnValues values;
+            bytesRead += readColumn(file, directory, columns[i], values);
+
+            const auto& numbers = values.numbers;
+            switch (columns[i])
+            {
+            case EventColumn::Type:
+                output.types.assign(numbers.size(), {});
+                for (size_t j = 0; j < numbers.size(); ++j)
+                {
+                    output.types[j] = static_cast<Core::EventType>(numbers[j]);
+                }
+                break;
+            case EventColumn::Timestamp:
+                output.timestampsMs = std::move(values.numbers);
+                break;
+            case EventColumn::X:
+                output.x.assign(numbers.begin(), numbers.end());
+                break;
+            case EventColumn::Y:
+                output.y.assign(numbers.begin(), numbers.end());
+                break;
+            case EventColumn::Button:
+                output.buttons.assign(numbers.size(), {});
+                for (size_t j = 0; j < numbers.size(); ++j)
+                {
+                    output.buttons[j] =
+                        static_cast<Core::MouseButton>(numbers[j]);
+                }
+                break;
+            case EventColumn::WheelDelta:
+                output.wheelDeltas.assign(numbers.begin(), numbers.end());
+                break;
+            case EventColumn::KeyCode:
+                output.keyCodes.assign(numbers.begin(), numbers.end());
+                break;
+            case EventColumn::KeyName:
+                output.keyNames = std::move(values.strings);
+                break;
+            case EventColumn::Modifiers:
+                output.modifiers.assign(numbers.size(), {});
+                for (size_t j = 0; j < numbers.size(); ++j)
+                {
+                    output.modifiers[j] =
+                        static_cast<Core::KeyModifier>(numbers[j]);
+                }
+                break;
+            case EventColumn::Repeated:
+                output.repeated.assign(numbers.begin(), numbers.end());
+                break;
+            }
+        }
+
+        Core::StorageProgress::report(
+            m_progress, columns.size(), columns.size());
+        recordStorageOperation("columnar", "load", bytesRead, startTime);
+        spdlog::debug("ColumnarEventStorage: Loaded {} columns of {} events",
+                      columns.size(),
+                      eventCount);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        output = {};
+        setLastError("Columnar deserialization error: " +
+                     std::string(e.what()));
+        return false;
+    }
+}
+
+Core::StorageFormat ColumnarEventStorage::getSupportedFormat() const noexcept
+{
+    return Core::StorageFormat::Columnar;
+}
+
+std::string ColumnarEventStorage::getFileExtension() const noexcept
+{
+    return ".mrc";
+}
+
+std::string ColumnarEventStorage::getFormatDescription() const noexcept
+{
+    return "Columnar Event Recording";
+}
+
+bool ColumnarEventStorage::validateFile(const std::string& filename) const
+{
+    Core::StorageMetadata metadata;
+    return getFileMetadata(filename, metadata);
+}
+
+bool ColumnarEventStorage::getFileMetadata(
+    const std::string& filename, Core::StorageMetadata& metadata) const
+{
+    // Only the header is read, not the columns
+    try
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        uint64_t eventCount = 0;
+        std::vector<DirectoryEntry> directory;
+        readHeader(file, metadata, eventCount, directory);
+        return true;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+void ColumnarEventStorage::setProgress(Core::StorageProgress* progress)
+{
+    m_progress = progress;
+}
+
+std::string ColumnarEventStorage::getLastError() const
+{
+    return m_lastError;
+}
+
+void ColumnarEventStorage::setCompressionLevel(int level)
+{
+    // The column encodings take the place of compression
+    (void)level;
+}
+
+bool ColumnarEventStorage::supportsCompression() const noexcept
+{
+    return false;
+}
+
+void ColumnarEventStorage::setSyncOnSave(bool sync)
+{
+    m_syncOnSave = sync;
+}
+
+void ColumnarEventStorage::readHeader(
+    std::ifstream& file,
+    Core::StorageMetadata& metadata,
+    uint64_t& eventCount,
+    std::vector<DirectoryEntry>& directory) const
+{
+    file.seekg(0, std::ios::end);
+    std::streamoff end = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (end < 0)
+    {
+        throw std::runtime_error("Failed to read file");
+    }
+    uint64_t fileSize = static_cast<uint64_t>(end);
+
+    auto header = readBytes(
+        file, fileSize, 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t));
+    ByteReader reader(header);
+    uint32_t magic = reader.read<uint32_t>();
+    uint32_t version = reader.read<uint32_t>();
+    if (magic != MAGIC_NUMBER || version != FORMAT_VERSION)
+    {
+        throw std::runtime_error("Not a columnar recording");
+    }
+    eventCount = reader.read<uint64_t>();
+    uint64_t metadataSize = reader.read<uint64_t>();
+
+    auto section = readBytes(file, fileSize, metadataSize);
+    size_t offset = 0;
+    metadata = m_codec.deserializeMetadata(section, offset);
+
+    auto sizeBytes = readBytes(file, fileSize, sizeof(uint64_t));
+    uint64_t statisticsSize = ByteReader(sizeBytes).read<uint64_t>();
+    metadata.statistics.reset();
+    if (statisticsSize > 0)
+    {
+        section = readBytes(file, fileSize, statisticsSize);
+        offset = 0;
+        metadata.statistics = m_codec.deserializeStatistics(section, offset);
+    }
+
+    auto countBytes = readBytes(file, fileSize, sizeof(uint32_t));
+    uint32_t columnCount = ByteReader(countBytes).read<uint32_t>();
+    if (columnCount > MAX_COLUMNS)
+    {
+        throw std::runtime_error("Too many columns");
+    }
+    section = readBytes(file, fileSize, columnCount * DIRECTORY_ENTRY_SIZE);
+    ByteReader entries(section);
+
+    // Columns of a group hold the same number of values
+    std::optional<uint64_t> counts[3];
+    directory.clear();
+    for (uint32_t i = 0; i < columnCount; ++i)
+    {
+        DirectoryEntry entry;
+        uint32_t id = entries.read<uint32_t>();
+        uint32_t encoding = entries.read<uint32_t>();
+        entry.valueCount = entries.read<uint64_t>();
+        entry.offset = entries.read<uint64_t>();
+        entry.size = entries.read<uint64_t>();
+        if (id > static_cast<uint32_t>(LAST_COLUMN) ||
+            encoding > static_cast<uint32_t>(LAST_ENCODING))
+        {
+            throw std::runtime_error("Unknown column or encoding");
+        }
+        if (entry.offset > fileSize || entry.size > fileSize - entry.offset)
+        {
+            throw std::runtime_error("Column lies outside the file");
+        }
+        entry.id = static_cast<EventColumn>(id);
+        entry.encoding = static_cast<ColumnEncoding>(encoding);
+
+        auto& count = counts[static_cast<size_t>(groupOf(entry.id))];
+        if (count && *count != entry.valueCount)
+        {
+            throw std::runtime_error("Column sizes do not match");
+        }
+        count = entry.valueCount;
+        directory.push_back(entry);
+    }
+
+    auto& [events, mouse, keyboard] = counts;
+    if ((events && *events != eventCount) ||
+        (mouse && *mouse > eventCount) ||
+        (mouse && keyboard && *mouse + *keyboard != eventCount))
+    {
+        throw std::runtime_error("Column sizes do not match the event count");
+    }
+}
+
+uint64_t ColumnarEventStorage::readColumn(
+    std::ifstream& file,
+    const std::vector<DirectoryEntry>& directory,
+    EventColumn id,
+    ColumnValues& values) const
+{
+    auto entry = std::find_if(directory.begin(),
+                              directory.end(),
+                              [id](const DirectoryEntry& candidate)
+                              { return candidate.id == id; });
+    if (entry == directory.end())
+    {
+        throw std::runtime_error("Missing column");
+    }
+
+    file.seekg(static_cast<std::streamoff>(entry->offset));
+    std::vector<uint8_t> data(entry->size);
+    file.read(reinterpret_cast<char*>(data.data()),
+              static_cast<std::streamsize>(data.size()));
+    if (!file)
+    {
+        throw std::runtime_error("Failed to read column");
+    }
+
+    // Every value takes at least a byte, except in runs
+    const uint64_t count = entry->valueCount;
+    if (entry->encoding != ColumnEncoding::RunLength && count > data.size())
+    {
+        throw std::runtime_error("Column is too short");
+    }
+
+    ByteReader reader(data);
+    values = {};
+    uint64_t previous = 0;
+    switch (entry->encoding)
+    {
+    case ColumnEncoding::Plain:
+        values.numbers.reserve(count);
+        while (values.numbers.size() < count)
+        {
+            values.numbers.push_back(reader.readVarint());
+        }
+        break;
+    case ColumnEncoding::Delta:
+        values.numbers.reserve(count);
+        while (values.numbers.size() < count)
+        {
+            previous += unzigzag(reader.readVarint());
+            values.numbers.push_back(previous);
+        }
+        break;
+    case ColumnEncoding::RunLength:
+        while (values.numbers.size() < count)
+        {
+            uint64_t value = reader.readVarint();
+            uint64_t length = reader.readVarint();
+            if (length == 0 || length > count - values.numbers.size())
+            {
+                throw std::runtime_error("Invalid run length");
+            }
+            values.numbers.insert(values.numbers.end(), length, value);
+        }
+        break;
+    case ColumnEncoding::Dictionary: {
+        uint64_t size = reader.readVarint();
+        if (size > reader.remaining())
+        {
+            throw std::runtime_error("Dictionary is too large");
+        }
+        std::vector<std::string> dictionary(size);
+        for (auto& value : dictionary)
+        {
+            value = reader.readString();
+        }
+        values.strings.reserve(count);
+        while (values.strings.size() < count)
+        {
+            uint64_t index = reader.readVarint();
+            if (index >= dictionary.size())
+            {
+                throw std::runtime_error("Invalid dictionary index");
+            }
+            values.strings.push_back(dictionary[index]);
+        }
+        break;
+    }
+    }
+    if (reader.remaining() != 0)
+    {
+        throw std::runtime_error("Column has trailing data");
+    }
+    return entry->size;
+}
+
+void ColumnarEventStorage::setLastError(const std::string& error) const
+{
+    m_lastError = error;
+    if (error == Core::StorageProgress::CANCELLED_ERROR)
+    {
+        spdlog::info("ColumnarEventStorage: {}", error);
+    }
+    else
+    {
+        spdlog::error("ColumnarEventStorage: {}", error);
+    }
+}
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,276 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "BinaryEventStorage.hpp"
+#include "core/IEventStorage.hpp"
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Columns of a columnar recording
+ */
+enum class EventColumn : uint32_t
+{
+    Type,
+    Timestamp,
+    X,
+    Y,
+    Button,
+    WheelDelta,
+    KeyCode,
+    KeyName,
+    Modifiers,
+    Repeated
+};
+
+/**
+ * @brief Decoded columns of a recording, see
+ * ColumnarEventStorage::loadColumns()
+ *
+ * types, timestampsMs and modifiers hold one value per event. The mouse
+ * columns x, y, buttons and wheelDeltas hold one value per mouse event,
+ * the key columns keyCodes, keyNames and repeated one per keyboard event,
+ * both in recording order. Columns that were not loaded are empty.
+ */
+struct EventColumns
+{
+    std::vector<Core::EventType> types;
+    std::vector<uint64_t> timestampsMs;
+    std::vector<int32_t> x;
+    std::vector<int32_t> y;
+    std::vector<Core::MouseButton> buttons;
+    std::vector<int32_t> wheelDeltas;
+    std::vector<uint32_t> keyCodes;
+    std::vector<std::string> keyNames;
+    std::vector<Core::KeyModifier> modifiers;
+    std::vector<bool> repeated;
+};
+
+/**
+ * @brief Columnar implementation of event storage
+ *
+ * Stores each field of the events in a column of its own, so that a query
+ * like "all click positions" reads the type, x and y columns and skips the
+ * rest, see loadColumns(). Loading whole events works like with the other
+ * formats.
+ *
+ * Columnar Format, all values little-endian:
+ * - Header: Magic number (4 bytes) + Version (4 bytes) + Event count (8
+ * bytes) + Metadata size (8 bytes)
+ * - Metadata: Serialized metadata structure, as in BinaryEventStorage
+ * - Statistics: Size (8 bytes), zero if there are none, + serialized
+ * statistics
+ * - Column directory: Column count (4 bytes) + per column its EventColumn
+ * (4 bytes), ColumnEncoding (4 bytes), value count (8 bytes), offset in
+ * the file (8 bytes) and size (8 bytes)
+ * - Column data
+ *
+ * Integers inside the columns are LEB128 varints. The encoding of each
+ * column is stored with it, so readers do not depend on which encoding
+ * the writer picked for a column.
+ */
+class ColumnarEventStorage : public Core::IEventStorage
+{
+  public:
+    /**
+     * @brief How the values of a column are encoded
+     */
+    enum class ColumnEncoding : uint32_t
+    {
+        // Varint per value
+        Plain,
+
+        // Zigzag varint of the difference to the previous value, which
+        // starts at zero
+        Delta,
+
+        // Varint value and run length per run of equal values
+        RunLength,
+
+        // Varint count and length-prefixed strings, then the varint index
+        // of each value in them
+        Dictionary
+    };
+
+    /**
+     * @brief Splits events into encoded columns
+     *
+     * The columns stay in memory until serialize(), at a few bytes per
+     * event for typical recordings.
+     */
+    class Encoder
+    {
+      public:
+        Encoder();
+
+        /**
+         * @brief Append an event to the columns
+         */
+        void add(const Core::Event& event);
+
+        /**
+         * @brief Serialize the complete file
+         * @param metadata Metadata to include, with its statistics
+         * @param buffer Output buffer
+         */
+        void serialize(const Core::StorageMetadata& metadata,
+                       std::vector<uint8_t>& buffer) const;
+
+      private:
+        struct Column
+        {
+            Column(EventColumn id, ColumnEncoding encoding)
+                : id(id),
+                  encoding(encoding)
+            {
+            }
+
+            EventColumn id;
+            ColumnEncoding encoding;
+            uint64_t valueCount{0};
+            std::vector<uint8_t> data;
+
+            // Value before the next one for Delta, value of the open run
+            // for RunLength
+            uint64_t previous{0};
+            uint64_t runLength{0};
+
+            // Strings in order of their index for Dictionary
+            std::vector<std::string> dictionary;
+            std::map<std::string, uint64_t> indices;
+        };
+
+        void add(EventColumn id, uint64_t value);
+        void add(EventColumn id, const std::string& value);
+
+        /**
+         * @brief Append the encoded values of a column, closing its open
+         * run
+         */
+        static void serialize(const Column& column,
+                              std::vector<uint8_t>& buffer);
+
+        std::vector<Column> m_columns;
+        uint64_t m_eventCount{0};
+        BinaryEventStorage m_codec;
+    };
+
+    ColumnarEventStorage() = default;
+    ~ColumnarEventStorage() override = default;
+
+    // IEventStorage interface
+    bool saveEvents(const std::vector<std::unique_ptr<Core::Event>>& events,
+                    const std::string& filename,
+                    const Core::StorageMetadata& metadata = {}) override;
+
+    bool loadEvents(const std::string& filename,
+                    std::vector<std::unique_ptr<Core::Event>>& events,
+                    Core::StorageMetadata& metadata) override;
+
+    bool loadEventsRange(const std::string& filename,
+                         const Core::EventRange& range,
+                         std::vector<std::unique_ptr<Core::Event>>& events,
+                         Core::StorageMetadata& metadata) override;
+
+    Core::StorageFormat getSupportedFormat() const noexcept override;
+    std::string getFileExtension() const noexcept override;
+    std::string getFormatDescription() const noexcept override;
+    bool validateFile(const std::string& filename) const override;
+    bool getFileMetadata(const std::string& filename,
+                         Core::StorageMetadata& metadata) const override;
+    void setProgress(Core::StorageProgress* progress) override;
+    std::string getLastError() const override;
+    void setCompressionLevel(int level) override;
+    bool supportsCompression() const noexcept override;
+    void setSyncOnSave(bool sync) override;
+
+    /**
+     * @brief Load some columns of a file without building events
+     *
+     * Only the directory and the requested columns are read from the
+     * file. Progress is reported per column.
+     * @param filename Path to the input file
+     * @param columns Columns to load
+     * @param output Set to the loaded columns, the others are left empty
+     * @param metadata Output metadata
+     * @return true if the columns were loaded
+     */
+    bool loadColumns(const std::string& filename,
+                     const std::vector<EventColumn>& columns,
+                     EventColumns& output,
+                     Core::StorageMetadata& metadata);
+
+    static constexpr uint32_t MAGIC_NUMBER =
+        0x4C43524D; // "MRCL" - MouseRecorder CoLumns
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+  private:
+    // Events rebuilt between progress reports and chunks handed out
+    static constexpr uint32_t PROGRESS_INTERVAL = 4096;
+
+    struct DirectoryEntry
+    {
+        EventColumn id;
+        ColumnEncoding encoding;
+        uint64_t valueCount{0};
+        uint64_t offset{0};
+        uint64_t size{0};
+    };
+
+    /**
+     * @brief Decoded values of a column; strings for Dictionary columns,
+     * numbers for the others
+     */
+    struct ColumnValues
+    {
+        std::vector<uint64_t> numbers;
+        std::vector<std::string> strings;
+    };
+
+    /**
+     * @brief Read everything up to the column data
+     *
+     * Checks that the value counts of the columns fit together.
+     * @param file File being read
+     * @param metadata Output metadata with the statistics
+     * @param eventCount Output number of events
+     * @param directory Output column directory
+     * @throws std::runtime_error if the header is invalid
+     */
+    void readHeader(std::ifstream& file,
+                    Core::StorageMetadata& metadata,
+                    uint64_t& eventCount,
+                    std::vector<DirectoryEntry>& directory) const;
+
+    /**
+     * @brief Read and decode a column of directory
+     * @param values Output values, as many as the directory lists
+     * @return size of the column in the file
+     * @throws std::runtime_error if the column is missing or cannot be
+     * decoded
+     */
+    uint64_t readColumn(std::ifstream& file,
+                    const std::vector<DirectoryEntry>& directory,
+                    EventColumn id,
+                    ColumnValues& values) const;
+
+    void setLastError(const std::string& error) const;
+
+  private:
+    BinaryEventStorage m_codec;
+    Core::StorageProgress* m_progress{nullptr};
+    bool m_syncOnSave{true};
+    mutable std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Storage
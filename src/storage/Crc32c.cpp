@@ -0,0 +1,177 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "Crc32c.hpp"
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MOUSERECORDER_CRC32C_X86
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define MOUSERECORDER_CRC32C_ARM
+#include <arm_acle.h>
+#endif
+
+namespace MouseRecorder::Storage
+{
+
+namespace
+{
+
+// Reflected Castagnoli polynomial
+constexpr std::uint32_t POLYNOMIAL = 0x82F63B78;
+
+/**
+ * @brief Tables for slicing by 8 bytes; table[k][b] is the CRC of byte b
+ * followed by k zero bytes
+ */
+constexpr std::array<std::array<std::uint32_t, 256>, 8> makeTables()
+{
+    std::array<std::array<std::uint32_t, 256>, 8> tables{};
+    for (std::uint32_t byte = 0; byte < 256; ++byte)
+    {
+        std::uint32_t crc = byte;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+        }
+        tables[0][byte] = crc;
+    }
+    for (std::uint32_t byte = 0; byte < 256; ++byte)
+    {
+        for (size_t k = 1; k < tables.size(); ++k)
+        {
+            std::uint32_t previous = tables[k - 1][byte];
+            tables[k][byte] = (previous >> 8) ^ tables[0][previous & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr auto TABLES = makeTables();
+
+std::uint32_t crc32cTable(std::uint32_t crc,
+                          const std::uint8_t* data,
+                          std::size_t size) noexcept
+{
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        // Little-endian word, independent of the host byte order
+        std::uint32_t low = crc ^ (data[0] | data[1] << 8 | data[2] << 16 |
+                                   static_cast<std::uint32_t>(data[3]) << 24);
+        crc = TABLES[7][low & 0xFF] ^ TABLES[6][(low >> 8) & 0xFF] ^
+              TABLES[5][(low >> 16) & 0xFF] ^ TABLES[4][low >> 24] ^
+              TABLES[3][data[4]] ^ TABLES[2][data[5]] ^ TABLES[1][data[6]] ^
+              TABLES[0][data[7]];
+    }
+    for (; size > 0; ++data, --size)
+    {
+        crc = (crc >> 8) ^ TABLES[0][(crc ^ *data) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(MOUSERECORDER_CRC32C_X86)
+
+#if defined(__GNUC__)
+__attribute__((target("sse4.2")))
+#endif
+std::uint32_t
+crc32cHardware(std::uint32_t crc,
+               const std::uint8_t* data,
+               std::size_t size) noexcept
+{
+    std::uint64_t wide = crc;
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        wide = _mm_crc32_u64(wide, word);
+    }
+    crc = static_cast<std::uint32_t>(wide);
+    for (; size > 0; ++data, --size)
+    {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+    return crc;
+}
+
+bool detectHardware() noexcept
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    return __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+#elif defined(MOUSERECORDER_CRC32C_ARM)
+
+std::uint32_t crc32cHardware(std::uint32_t crc,
+                             const std::uint8_t* data,
+                             std::size_t size) noexcept
+{
+    for (; size >= 8; data += 8, size -= 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        crc = __crc32cd(crc, word);
+    }
+    for (; size > 0; ++data, --size)
+    {
+        crc = __crc32cb(crc, *data);
+    }
+    return crc;
+}
+
+// Compiled for a CPU with the CRC extension
+bool detectHardware() noexcept
+{
+    return true;
+}
+
+#else
+
+std::uint32_t crc32cHardware(std::uint32_t crc,
+                             const std::uint8_t* data,
+                             std::size_t size) noexcept
+{
+    return crc32cTable(crc, data, size);
+}
+
+bool detectHardware() noexcept
+{
+    return false;
+}
+
+#endif
+
+const bool HAS_HARDWARE = detectHardware();
+
+} // namespace
+
+std::uint32_t crc32c(std::uint32_t crc,
+                     const void* data,
+                     std::size_t size) noexcept
+{
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    crc = ~crc;
+    crc = HAS_HARDWARE ? crc32cHardware(crc, bytes, size)
+                       : crc32cTable(crc, bytes, size);
+    return ~crc;
+}
+
+bool crc32cIsHardwareAccelerated() noexcept
+{
+    return HAS_HARDWARE;
+}
+
+} // namespace MouseRecorder::Storage
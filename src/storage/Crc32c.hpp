@@ -0,0 +1,33 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Extend a CRC32C (Castagnoli) checksum by size bytes
+ *
+ * Uses the SSE4.2 or ARMv8 CRC instructions when the CPU has them and a
+ * table otherwise; all give the same result.
+ * @param crc Checksum of the data before, 0 to start
+ * @param data Bytes to add
+ * @param size Number of bytes
+ * @return checksum of the data before followed by data
+ */
+std::uint32_t crc32c(std::uint32_t crc,
+                     const void* data,
+                     std::size_t size) noexcept;
+
+/**
+ * @brief Check whether crc32c() uses CRC instructions of the CPU
+ */
+bool crc32cIsHardwareAccelerated() noexcept;
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "EventRangeFilter.hpp"
+#include "core/Event.hpp"
+
+namespace MouseRecorder::Storage
+{
+
+EventRangeFilter::EventRangeFilter(
+    const Core::EventRange& range,
+    std::vector<std::unique_ptr<Core::Event>>& output,
+    Core::StorageProgress* progress)
+    : m_range(range),
+      m_output(output),
+      m_progress(progress)
+{
+}
+
+bool EventRangeFilter::add(std::unique_ptr<Core::Event> event)
+{
+    if (m_complete || !event)
+    {
+        return !m_complete;
+    }
+
+    uint64_t key = m_position++;
+    if (m_range.kind == Core::EventRange::Kind::Time)
+    {
+        uint64_t timestamp = event->getTimestampMs();
+        if (!m_startMs)
+        {
+            m_startMs = timestamp;
+        }
+        key = timestamp > *m_startMs ? timestamp - *m_startMs : 0;
+        if (key > m_range.last)
+        {
+            m_complete = true;
+            return false;
+        }
+    }
+    else if (key >= m_range.last)
+    {
+        m_complete = true;
+        return false;
+    }
+
+    if (key >= m_range.first)
+    {
+        m_output.push_back(std::move(event));
+    }
+    return true;
+}
+
+bool EventRangeFilter::update(std::uint64_t done, std::uint64_t total)
+{
+    return !m_complete && report(m_progress, done, total);
+}
+
+void EventRangeFilter::metadataLoaded(const Core::StorageMetadata& metadata)
+{
+    if (m_progress)
+    {
+        m_progress->metadataLoaded(metadata);
+    }
+}
+
+void EventRangeFilter::eventsLoaded(
+    std::vector<std::unique_ptr<Core::Event>>& events)
+{
+    for (auto& event : events)
+    {
+        if (!add(std::move(event)))
+        {
+            break;
+        }
+    }
+    events.clear();
+}
+
+bool loadEventsRangeStreaming(Core::IEventStorage& storage,
+                              Core::StorageProgress* progress,
+                              const std::string& filename,
+                              const Core::EventRange& range,
+                              std::vector<std::unique_ptr<Core::Event>>& events,
+                              Core::StorageMetadata& metadata)
+{
+    events.clear();
+    EventRangeFilter filter(range, events, progress);
+
+    // The last chunk is left in chunk rather than handed to the filter
+    std::vector<std::unique_ptr<Core::Event>> chunk;
+    storage.setProgress(&filter);
+    bool loaded = storage.loadEvents(filename, chunk, metadata);
+    storage.setProgress(progress);
+    filter.eventsLoaded(chunk);
+
+    if (!loaded && !filter.isComplete())
+    {
+        events.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,90 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "core/IEventStorage.hpp"
+#include "core/StorageTask.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Keeps the events of a range from a load that streams its events
+ *
+ * Installed as the progress sink of a storage, it takes each decoded chunk,
+ * keeps the events inside the range and drops the rest right away. Once
+ * an event after the range has been seen, the next progress report asks
+ * the storage to stop, so the remainder of the file is never decoded.
+ * Progress reports and metadata are passed on to another sink.
+ */
+class EventRangeFilter : public Core::StorageProgress
+{
+  public:
+    /**
+     * @param range Events to keep
+     * @param output Receives the events of the range in file order
+     * @param progress Sink receiving progress and metadata, may be null
+     */
+    EventRangeFilter(const Core::EventRange& range,
+                     std::vector<std::unique_ptr<Core::Event>>& output,
+                     Core::StorageProgress* progress);
+
+    /**
+     * @brief Offer the next event of the file
+     * @return false once the range is complete
+     */
+    bool add(std::unique_ptr<Core::Event> event);
+
+    /**
+     * @brief Check whether an event after the range has been seen
+     */
+    bool isComplete() const noexcept
+    {
+        return m_complete;
+    }
+
+    // StorageProgress interface
+    bool update(std::uint64_t done, std::uint64_t total) override;
+    void metadataLoaded(const Core::StorageMetadata& metadata) override;
+    void eventsLoaded(
+        std::vector<std::unique_ptr<Core::Event>>& events) override;
+
+  private:
+    Core::EventRange m_range;
+    std::vector<std::unique_ptr<Core::Event>>& m_output;
+    Core::StorageProgress* m_progress;
+    uint64_t m_position{0};
+    std::optional<uint64_t> m_startMs;
+    bool m_complete{false};
+};
+
+/**
+ * @brief Load a range through the streaming loadEvents() of a storage
+ *
+ * Used by storages for files they cannot seek in. The storage stops with
+ * a cancellation error once the range is complete, which counts as
+ * success here; callers clear their last error then.
+ * @param storage Storage to load with
+ * @param progress Progress sink of the storage, restored afterwards
+ * @param filename Path to the input file
+ * @param range Events to load
+ * @param events Output vector to store the events of the range
+ * @param metadata Output metadata of the whole file
+ * @return true if the range was loaded
+ */
+bool loadEventsRangeStreaming(Core::IEventStorage& storage,
+                              Core::StorageProgress* progress,
+                              const std::string& filename,
+                              const Core::EventRange& range,
+                              std::vector<std::unique_ptr<Core::Event>>& events,
+                              Core::StorageMetadata& metadata);
+
+} // namespace MouseRecorder::Storage
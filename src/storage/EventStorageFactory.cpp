@@ -6,6 +6,7 @@
 #include "EventStorageFactory.hpp"
 #include "JsonEventStorage.hpp"
 #include "BinaryEventStorage.hpp"
+#include "ColumnarEventStorage.hpp"
 #include "XmlEventStorage.hpp"
 #include "core/SpdlogConfig.hpp"
 #include <algorithm>
@@ -31,6 +32,9 @@ std::unique_ptr<Core::IEventStorage> EventStorageFactory::createStorage(
     case Core::StorageFormat::Xml:
         return std::make_unique<XmlEventStorage>();
 
+    case Core::StorageFormat::Columnar:
+        return std::make_unique<ColumnarEventStorage>();
+
     default:
         spdlog::error("EventStorageFactory: Unsupported storage format {}",
                       static_cast<int>(format));
@@ -64,7 +68,8 @@ std::vector<Core::StorageFormat> EventStorageFactory::getSupportedFormats()
 {
     return {Core::StorageFormat::Json,
             Core::StorageFormat::Binary,
-            Core::StorageFormat::Xml};
+            Core::StorageFormat::Xml,
+            Core::StorageFormat::Columnar};
 }
 
 std::string EventStorageFactory::getFileExtension(Core::StorageFormat format)
@@ -122,6 +127,10 @@ std::optional<Core::StorageFormat> EventStorageFactory::getFormatFromExtension(
     {
         return Core::StorageFormat::Xml;
     }
+    if (ext == "mrc")
+    {
+        return Core::StorageFormat::Columnar;
+    }
 
     return std::nullopt;
 }
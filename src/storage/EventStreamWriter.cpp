@@ -0,0 +1,573 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "EventStreamWriter.hpp"
+#include "BinaryEventStorage.hpp"
+#include "ColumnarEventStorage.hpp"
+#include "Crc32c.hpp"
+#include "JsonStreamScanner.hpp"
+#include "StorageFileIO.hpp"
+#include "XmlStreamUtils.hpp"
+#include "core/Event.hpp"
+#include "core/SpdlogConfig.hpp"
+#include "core/serialization/EventSerializerFactory.hpp"
+#include <QFile>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace MouseRecorder::Storage
+{
+
+namespace
+{
+
+using Core::Serialization::EventSerializerFactory;
+using Core::Serialization::IEventSerializer;
+using Core::Serialization::SerializationFormat;
+
+/**
+ * @brief Position scanner on the value of a member of the root object
+ * @return false if the document has no such member
+ */
+bool findJsonMember(JsonStreamScanner& scanner, const std::string& name)
+{
+    if (!scanner.consume('{') || scanner.consume('}'))
+    {
+        return false;
+    }
+
+    std::string key;
+    do
+    {
+        if (!scanner.readString(key) || !scanner.consume(':'))
+        {
+            return false;
+        }
+        if (key == name)
+        {
+            return true;
+        }
+        if (!scanner.readValue(nullptr))
+        {
+            return false;
+        }
+    } while (scanner.consume(','));
+    return false;
+}
+
+/**
+ * @brief JSON writer taking the event and metadata objects from the
+ * serializer
+ *
+ * Writes the metadata after the events, where the serializers put it too.
+ */
+class JsonEventStreamWriter : public EventStreamWriter
+{
+  protected:
+    bool openFile(const std::string& filename,
+                  const Core::StorageMetadata& metadata) override
+    {
+        (void)metadata;
+        m_serializer =
+            EventSerializerFactory::createSerializer(SerializationFormat::Json);
+        if (!m_serializer)
+        {
+            setLastError("No serializer available");
+            return false;
+        }
+
+        m_file.open(filename, std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open())
+        {
+            setLastError("Failed to open file for writing: " + filename);
+            return false;
+        }
+        m_file << "{\"events\":[";
+        return check();
+    }
+
+    bool writeEvents(
+        const std::vector<std::unique_ptr<Core::Event>>& events) override
+    {
+        std::istringstream document(
+            m_serializer->serializeEvents(events, {}, false));
+        JsonStreamScanner scanner(document);
+        if (!findJsonMember(scanner, "events") || !scanner.consume('['))
+        {
+            setLastError("Failed to serialize events to JSON: " +
+                         m_serializer->getLastError());
+            return false;
+        }
+
+        std::string event;
+        bool more = !scanner.consume(']');
+        while (more)
+        {
+            event.clear();
+            if (!scanner.readValue(&event))
+            {
+                setLastError("Serializer produced invalid JSON");
+                return false;
+            }
+            m_file << (m_firstEvent ? "\n" : ",\n") << event;
+            m_firstEvent = false;
+            more = scanner.consume(',');
+        }
+        return check();
+    }
+
+    bool finish(const Core::StorageMetadata& metadata) override
+    {
+        std::istringstream document(
+            m_serializer->serializeEvents({}, metadata, false));
+        JsonStreamScanner scanner(document);
+        std::string metadataJson;
+        if (!findJsonMember(scanner, "metadata") ||
+            !scanner.readValue(&metadataJson))
+        {
+            setLastError("Failed to serialize metadata to JSON: " +
+                         m_serializer->getLastError());
+            return false;
+        }
+
+        m_file << "\n],\"metadata\":" << metadataJson << "}\n";
+        m_file.close();
+        return check();
+    }
+
+  private:
+    bool check()
+    {
+        if (m_file.fail())
+        {
+            setLastError("Failed to write JSON data to file");
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    std::unique_ptr<IEventSerializer> m_serializer;
+    std::ofstream m_file;
+    bool m_firstEvent{true};
+};
+
+/**
+ * @brief XML writer copying the event and metadata elements from the
+ * serializer
+ *
+ * Writes the metadata after the events so it can carry the final totals.
+ */
+class XmlEventStreamWriter : public EventStreamWriter
+{
+  protected:
+    bool openFile(const std::string& filename,
+                  const Core::StorageMetadata& metadata) override
+    {
+        (void)metadata;
+        m_serializer =
+            EventSerializerFactory::createSerializer(SerializationFormat::Xml);
+        if (!m_serializer || !detectXmlLayout(*m_serializer, m_layout))
+        {
+            setLastError("No usable XML serializer available");
+            return false;
+        }
+
+        m_file.setFileName(QString::fromStdString(filename));
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            setLastError("Failed to open file for writing: " + filename);
+            return false;
+        }
+
+        m_writer.setDevice(&m_file);
+        m_writer.setAutoFormatting(true);
+        m_writer.writeStartDocument();
+        m_writer.writeStartElement(m_layout.root);
+        m_writer.writeStartElement(m_layout.events);
+        return check();
+    }
+
+    bool writeEvents(
+        const std::vector<std::unique_ptr<Core::Event>>& events) override
+    {
+        return copyElements(m_serializer->serializeEvents(events, {}, false),
+                            m_layout.events,
+                            m_layout.event);
+    }
+
+    bool finish(const Core::StorageMetadata& metadata) override
+    {
+        m_writer.writeEndElement();
+
+        // The metadata element is a direct child of the root
+        if (!copyElements(m_serializer->serializeEvents({}, metadata, false),
+                          m_layout.root,
+                          m_layout.metadata))
+        {
+            return false;
+        }
+
+        m_writer.writeEndElement();
+        m_writer.writeEndDocument();
+        m_file.close();
+        return check();
+    }
+
+  private:
+    /**
+     * @brief Copy the children named child of the element named parent
+     * from a serialized document
+     */
+    bool copyElements(const std::string& document,
+                      const QString& parent,
+                      const QString& child)
+    {
+        QXmlStreamReader reader(QString::fromStdString(document));
+        if (!reader.readNextStartElement())
+        {
+            setLastError("Failed to serialize XML: " +
+                         m_serializer->getLastError());
+            return false;
+        }
+
+        if (parent != m_layout.root)
+        {
+            while (reader.readNextStartElement() && reader.name() != parent)
+            {
+                reader.skipCurrentElement();
+            }
+        }
+
+        while (reader.readNextStartElement())
+        {
+            if (reader.name() != child)
+            {
+                reader.skipCurrentElement();
+                continue;
+            }
+            if (!copyXmlElement(reader, m_writer))
+            {
+                break;
+            }
+        }
+
+        if (reader.hasError())
+        {
+            setLastError(xmlReaderError(reader));
+            return false;
+        }
+        return check();
+    }
+
+    bool check()
+    {
+        if (m_writer.hasError() || m_file.error() != QFileDevice::NoError)
+        {
+            setLastError("Failed to write XML data to file: " +
+                         m_file.errorString().toStdString());
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    std::unique_ptr<IEventSerializer> m_serializer;
+    XmlDocumentLayout m_layout;
+    QFile m_file;
+    QXmlStreamWriter m_writer;
+};
+
+/**
+ * @brief Binary writer patching the totals into the header when closed
+ * and appending the block index and statistics footers
+ *
+ * Files are written uncompressed.
+ */
+class BinaryEventStreamWriter : public EventStreamWriter
+{
+  protected:
+    bool openFile(const std::string& filename,
+                  const Core::StorageMetadata& metadata) override
+    {
+        m_file.open(filename, std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open())
+        {
+            setLastError("Failed to open file for writing: " + filename);
+            return false;
+        }
+
+        // The event count is filled in by finish(); until then the events
+        // of an interrupted recording run to the end of the file
+        m_buffer.clear();
+        m_codec.serializeHeader(
+            metadata, BinaryEventStorage::UNKNOWN_EVENT_COUNT, m_buffer);
+        m_headerSize = m_buffer.size();
+        m_index = {};
+        m_offset = 0;
+        return flush();
+    }
+
+    bool writeEvents(
+        const std::vector<std::unique_ptr<Core::Event>>& events) override
+    {
+        m_buffer.clear();
+        for (const auto& event : events)
+        {
+            if (event)
+            {
+                m_index.add(*event, m_offset + m_buffer.size());
+                m_codec.serializeEvent(*event, m_buffer);
+            }
+        }
+        m_index.addBytes(m_buffer.data(), m_buffer.size(), m_offset);
+        return flush();
+    }
+
+    bool finish(const Core::StorageMetadata& metadata) override
+    {
+        // The header with the event count goes in before the footers, so
+        // they are never taken for events
+        m_buffer.clear();
+        m_codec.serializeHeader(metadata, getEventCount(), m_buffer);
+        if (m_buffer.size() != m_headerSize)
+        {
+            setLastError("Metadata changed size while writing");
+            return false;
+        }
+        m_index.headerChecksum = crc32c(0, m_buffer.data(), m_buffer.size());
+        m_file.seekp(0, std::ios::beg);
+        if (!flush())
+        {
+            return false;
+        }
+
+        // The block index and statistics follow the events
+        m_buffer.clear();
+        m_codec.serializeBlockIndexFooter(m_index, m_buffer);
+        if (metadata.statistics)
+        {
+            m_codec.serializeStatisticsFooter(*metadata.statistics, m_buffer);
+        }
+        m_file.seekp(0, std::ios::end);
+        if (!flush())
+        {
+            return false;
+        }
+        m_file.close();
+        if (m_file.fail())
+        {
+            setLastError("Failed to close binary file");
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    bool flush()
+    {
+        m_file.write(reinterpret_cast<const char*>(m_buffer.data()),
+                     static_cast<std::streamsize>(m_buffer.size()));
+        if (m_file.fail())
+        {
+            setLastError("Failed to write binary data to file");
+            return false;
+        }
+        m_offset += m_buffer.size();
+        return true;
+    }
+
+  private:
+    BinaryEventStorage m_codec;
+    std::ofstream m_file;
+    std::vector<uint8_t> m_buffer;
+
+    // Offset of the first event
+    size_t m_headerSize{0};
+
+    // Bytes written so far, for the offsets of the block index
+    uint64_t m_offset{0};
+    BinaryEventStorage::BlockIndex m_index;
+};
+
+/**
+ * @brief Columnar writer encoding the events as they come and writing the
+ * columns when closed
+ *
+ * The columns follow a directory of their offsets, so nothing can be
+ * written before the last event; only the encoded columns are kept in
+ * memory until then.
+ */
+class ColumnarEventStreamWriter : public EventStreamWriter
+{
+  protected:
+    bool openFile(const std::string& filename,
+                  const Core::StorageMetadata& metadata) override
+    {
+        (void)metadata;
+        m_file.open(filename, std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open())
+        {
+            setLastError("Failed to open file for writing: " + filename);
+            return false;
+        }
+        m_encoder = {};
+        return true;
+    }
+
+    bool writeEvents(
+        const std::vector<std::unique_ptr<Core::Event>>& events) override
+    {
+        for (const auto& event : events)
+        {
+            if (event)
+            {
+                m_encoder.add(*event);
+            }
+        }
+        return true;
+    }
+
+    bool finish(const Core::StorageMetadata& metadata) override
+    {
+        std::vector<uint8_t> buffer;
+        m_encoder.serialize(metadata, buffer);
+        m_encoder = {};
+        m_file.write(reinterpret_cast<const char*>(buffer.data()),
+                     static_cast<std::streamsize>(buffer.size()));
+        m_file.close();
+        if (m_file.fail())
+        {
+            setLastError("Failed to write columnar file");
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    std::ofstream m_file;
+    ColumnarEventStorage::Encoder m_encoder;
+};
+
+} // namespace
+
+std::unique_ptr<EventStreamWriter> EventStreamWriter::create(
+    Core::StorageFormat format)
+{
+    switch (format)
+    {
+    case Core::StorageFormat::Json:
+        return std::make_unique<JsonEventStreamWriter>();
+    case Core::StorageFormat::Xml:
+        return std::make_unique<XmlEventStreamWriter>();
+    case Core::StorageFormat::Binary:
+        return std::make_unique<BinaryEventStreamWriter>();
+    case Core::StorageFormat::Columnar:
+        return std::make_unique<ColumnarEventStreamWriter>();
+    }
+    return nullptr;
+}
+
+EventStreamWriter::~EventStreamWriter()
+{
+    // Derived writers have closed their files by now
+    if (m_open)
+    {
+        std::error_code error;
+        std::filesystem::remove(m_tempPath, error);
+    }
+}
+
+bool EventStreamWriter::open(const std::string& filename,
+                             const Core::StorageMetadata& metadata)
+{
+    if (m_open)
+    {
+        setLastError("Writer is already open");
+        return false;
+    }
+
+    m_filename = filename;
+    m_tempPath = makeTempPath(filename);
+    m_metadata = metadata;
+    m_eventCount = 0;
+    m_statistics = {};
+    m_lastError.clear();
+
+    if (!openFile(m_tempPath, metadata))
+    {
+        std::error_code error;
+        std::filesystem::remove(m_tempPath, error);
+        return false;
+    }
+    m_open = true;
+    spdlog::debug("EventStreamWriter: Writing {}", filename);
+    return true;
+}
+
+bool EventStreamWriter::write(
+    const std::vector<std::unique_ptr<Core::Event>>& events)
+{
+    if (!m_open)
+    {
+        setLastError("Writer is not open");
+        return false;
+    }
+
+    for (const auto& event : events)
+    {
+        if (event)
+        {
+            m_statistics.add(*event);
+            ++m_eventCount;
+        }
+    }
+    return writeEvents(events);
+}
+
+bool EventStreamWriter::close()
+{
+    if (!m_open)
+    {
+        setLastError("Writer is not open");
+        return false;
+    }
+
+    m_metadata.totalEvents = m_eventCount;
+    m_metadata.totalDurationMs = m_statistics.getDurationMs();
+    m_metadata.statistics = m_statistics;
+    if (!finish(m_metadata))
+    {
+        return false;
+    }
+
+    // The temporary file is gone after this, whether it succeeded or not
+    m_open = false;
+    std::string error;
+    if (!replaceFile(m_tempPath, m_filename, m_syncOnClose, error))
+    {
+        setLastError(error);
+        return false;
+    }
+    spdlog::debug(
+        "EventStreamWriter: Wrote {} events to {}", m_eventCount, m_filename);
+    return true;
+}
+
+std::string EventStreamWriter::getLastError() const
+{
+    return m_lastError;
+}
+
+void EventStreamWriter::setLastError(const std::string& error)
+{
+    m_lastError = error;
+    spdlog::error("EventStreamWriter: {}", error);
+}
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,123 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "core/IEventStorage.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Writes a recording in chunks of events
+ *
+ * Counterpart of a load that streams its events through a progress sink:
+ * only the events of one write() call have to be in memory. The files
+ * are read by the matching IEventStorage. totalEvents, totalDurationMs
+ * and the statistics of the metadata are taken from the written events.
+ *
+ * The events go to a temporary file next to the output file, which
+ * replaces the output file when close() succeeds. A writer destroyed
+ * before that removes the temporary file and leaves an existing output
+ * file untouched.
+ */
+class EventStreamWriter
+{
+  public:
+    /**
+     * @brief Create a writer for a storage format
+     * @return writer or nullptr if the format is not supported
+     */
+    static std::unique_ptr<EventStreamWriter> create(
+        Core::StorageFormat format);
+
+    virtual ~EventStreamWriter();
+
+    EventStreamWriter(const EventStreamWriter&) = delete;
+    EventStreamWriter& operator=(const EventStreamWriter&) = delete;
+
+    /**
+     * @brief Create the temporary file and start the recording
+     * @param filename Path to the output file
+     * @param metadata Metadata to include
+     * @return true if the file was created
+     */
+    bool open(const std::string& filename,
+              const Core::StorageMetadata& metadata);
+
+    /**
+     * @brief Append events in recording order
+     * @return true if the events were written
+     */
+    bool write(const std::vector<std::unique_ptr<Core::Event>>& events);
+
+    /**
+     * @brief Write the final metadata and put the file in place
+     * @return true if the complete file was written
+     */
+    bool close();
+
+    /**
+     * @brief Flush the file to disk before close() puts it in place
+     *
+     * On by default, see Core::IEventStorage::setSyncOnSave().
+     */
+    void setSyncOnClose(bool sync) noexcept
+    {
+        m_syncOnClose = sync;
+    }
+
+    /**
+     * @brief Get the number of events written so far
+     */
+    size_t getEventCount() const noexcept
+    {
+        return m_eventCount;
+    }
+
+    /**
+     * @brief Get the last error message if any operation failed
+     */
+    std::string getLastError() const;
+
+  protected:
+    EventStreamWriter() = default;
+
+    /**
+     * @brief Create filename and write what precedes the events
+     */
+    virtual bool openFile(const std::string& filename,
+                          const Core::StorageMetadata& metadata) = 0;
+
+    /**
+     * @brief Write non-null events
+     */
+    virtual bool writeEvents(
+        const std::vector<std::unique_ptr<Core::Event>>& events) = 0;
+
+    /**
+     * @brief Write what follows the events and close the file
+     * @param metadata Metadata with the final totals and statistics
+     */
+    virtual bool finish(const Core::StorageMetadata& metadata) = 0;
+
+    void setLastError(const std::string& error);
+
+  private:
+    std::string m_filename;
+    std::string m_tempPath;
+    Core::StorageMetadata m_metadata;
+    bool m_open{false};
+    size_t m_eventCount{0};
+    bool m_syncOnClose{true};
+    Core::RecordingStatistics m_statistics;
+    std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,260 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "EventTranscoder.hpp"
+#include "BinaryEventStorage.hpp"
+#include "EventStorageFactory.hpp"
+#include "core/SpdlogConfig.hpp"
+#include "core/Tracing.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace MouseRecorder::Storage
+{
+
+EventTranscoder::EventTranscoder(TranscodeOptions options)
+    : m_options(std::move(options))
+{
+}
+
+bool EventTranscoder::transcode(const std::string& input,
+                                const std::string& output)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "EventTranscoder::transcode");
+    m_output = output;
+    m_writerOpen = false;
+    m_failed = false;
+    m_eventsRead = 0;
+    m_eventsWritten = 0;
+    m_lastError.clear();
+
+    auto storage = EventStorageFactory::createStorageFromFilename(input);
+    if (!storage)
+    {
+        setLastError("Unsupported input file: " + input);
+        return false;
+    }
+
+    if (m_options.detectLoops)
+    {
+        return transcodeLooped(*storage, input, output);
+    }
+
+    m_writer = EventStreamWriter::create(m_options.outputFormat);
+    if (!m_writer)
+    {
+        setLastError("Unsupported output format");
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Core::Event>> events;
+    Core::StorageMetadata metadata;
+    storage->setProgress(this);
+    bool loaded = storage->loadEvents(input, events, metadata);
+    storage->setProgress(nullptr);
+
+    // Pass on whatever the storage did not stream itself
+    if (loaded)
+    {
+        metadataLoaded(metadata);
+        if (!events.empty())
+        {
+            eventsLoaded(events);
+        }
+    }
+
+    // A failing writer has stopped the load and set the error already
+    bool success = false;
+    if (!m_failed && !loaded)
+    {
+        setLastError(storage->getLastError());
+    }
+    else if (!m_failed)
+    {
+        success = m_writer->close();
+        if (!success)
+        {
+            setLastError(m_writer->getLastError());
+        }
+    }
+
+    m_eventsWritten = m_writer->getEventCount();
+
+    // Removes the incomplete output of a failed run
+    m_writer.reset();
+
+    if (success)
+    {
+        spdlog::info("EventTranscoder: {} -> {}: {} events read, {} written",
+                     input,
+                     output,
+                     m_eventsRead,
+                     m_eventsWritten);
+    }
+    return success;
+}
+
+size_t EventTranscoder::transcodeFiles(std::vector<TranscodeJob>& jobs,
+                                       const TranscodeOptions& options,
+                                       unsigned threads)
+{
+    if (jobs.empty())
+    {
+        return 0;
+    }
+
+    std::atomic<size_t> nextJob{0};
+    std::atomic<size_t> failures{0};
+
+    auto worker = [&jobs, &options, &nextJob, &failures]()
+    {
+        // Storages and writers are per thread, only the job index is shared
+        EventTranscoder transcoder(options);
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++)
+        {
+            TranscodeJob& job = jobs[i];
+            job.success = transcoder.transcode(job.input, job.output);
+            job.error = job.success ? std::string{} : transcoder.getLastError();
+            job.eventsRead = transcoder.getEventsRead();
+            job.eventsWritten = transcoder.getEventsWritten();
+            if (!job.success)
+            {
+                ++failures;
+            }
+        }
+    };
+
+    size_t threadCount = std::clamp<size_t>(threads, 1, jobs.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers)
+    {
+        thread.join();
+    }
+
+    return failures.load();
+}
+
+bool EventTranscoder::transcodeLooped(Core::IEventStorage& storage,
+                                      const std::string& input,
+                                      const std::string& output)
+{
+    if (m_options.outputFormat != Core::StorageFormat::Binary)
+    {
+        setLastError("Repeated segments are only stored in binary files");
+        return false;
+    }
+
+    // Repetitions may span decoded chunks, so the search takes all events
+    std::vector<std::unique_ptr<Core::Event>> events;
+    Core::StorageMetadata metadata;
+    if (!storage.loadEvents(input, events, metadata))
+    {
+        setLastError(storage.getLastError());
+        return false;
+    }
+    m_eventsRead = events.size();
+    if (m_options.optimize)
+    {
+        Core::MouseMovementOptimizer::optimizeEvents(events,
+                                                     m_options.optimization);
+    }
+    metadata.totalEvents = events.size();
+    metadata.totalDurationMs =
+        events.empty() ? 0
+                       : events.back()->getTimestampMs() -
+                             events.front()->getTimestampMs();
+    metadata.statistics.reset();
+
+    auto recording = Core::RepeatedSegmentDetector::compress(
+        std::move(events), m_options.loopDetection);
+    BinaryEventStorage binary;
+    if (!binary.saveLoopedEvents(recording, output, metadata))
+    {
+        setLastError(binary.getLastError());
+        return false;
+    }
+    m_eventsWritten = recording.events.size();
+
+    spdlog::info("EventTranscoder: {} -> {}: {} events read, {} written "
+                 "with {} repeated segments",
+                 input,
+                 output,
+                 m_eventsRead,
+                 m_eventsWritten,
+                 recording.index.getSegments().size());
+    return true;
+}
+
+std::string EventTranscoder::getLastError() const
+{
+    return m_lastError;
+}
+
+bool EventTranscoder::update(std::uint64_t done, std::uint64_t total)
+{
+    (void)done;
+    (void)total;
+
+    // Stops the load once the writer has failed
+    return !m_failed;
+}
+
+void EventTranscoder::metadataLoaded(const Core::StorageMetadata& metadata)
+{
+    if (m_writerOpen || m_failed)
+    {
+        return;
+    }
+
+    if (!m_writer->open(m_output, metadata))
+    {
+        m_failed = true;
+        setLastError(m_writer->getLastError());
+        return;
+    }
+    m_writerOpen = true;
+}
+
+void EventTranscoder::eventsLoaded(
+    std::vector<std::unique_ptr<Core::Event>>& events)
+{
+    m_eventsRead += events.size();
+    if (!m_failed && !m_writerOpen)
+    {
+        // Storages hand out the metadata first; be safe with defaults
+        metadataLoaded({});
+    }
+
+    if (!m_failed)
+    {
+        if (m_options.optimize)
+        {
+            Core::MouseMovementOptimizer::optimizeEvents(
+                events, m_options.optimization);
+        }
+        if (!m_writer->write(events))
+        {
+            m_failed = true;
+            setLastError(m_writer->getLastError());
+        }
+    }
+
+    // Hand the memory back to the storage for the next chunk
+    events.clear();
+}
+
+void EventTranscoder::setLastError(const std::string& error)
+{
+    m_lastError = error;
+    spdlog::error("EventTranscoder: {}", error);
+}
+
+} // namespace MouseRecorder::Storage
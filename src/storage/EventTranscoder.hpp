@@ -0,0 +1,130 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "core/MouseMovementOptimizer.hpp"
+#include "core/RepeatedSegmentDetector.hpp"
+#include "core/StorageTask.hpp"
+#include "EventStreamWriter.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Settings of a transcoding run
+ */
+struct TranscodeOptions
+{
+    Core::StorageFormat outputFormat{Core::StorageFormat::Binary};
+
+    // Optimize mouse movements of each decoded chunk before writing it
+    bool optimize{false};
+    Core::MouseMovementOptimizer::OptimizationConfig optimization;
+
+    // Store repeated segments once, see
+    // BinaryEventStorage::saveLoopedEvents(). Binary output only; the
+    // recording is held in memory as a whole to search it.
+    bool detectLoops{false};
+    Core::LoopDetectionConfig loopDetection;
+};
+
+/**
+ * @brief A file to transcode and its outcome
+ */
+struct TranscodeJob
+{
+    std::string input;
+    std::string output;
+
+    bool success{false};
+    std::string error;
+    size_t eventsRead{0};
+    size_t eventsWritten{0};
+};
+
+/**
+ * @brief Converts recordings between storage formats in bounded memory
+ *
+ * Pipeline of the streaming load of the input storage, an optional
+ * optimizer stage and an EventStreamWriter. Events pass through one
+ * decoded chunk at a time, so memory does not grow with the recording.
+ * The optimizer only sees one chunk at a time and keeps the first and
+ * last movement of every chunk. Loop detection is the exception: it needs
+ * the whole recording, which it loads at once.
+ */
+class EventTranscoder : private Core::StorageProgress
+{
+  public:
+    explicit EventTranscoder(TranscodeOptions options = {});
+
+    /**
+     * @brief Transcode one file
+     *
+     * The input format is taken from the file extension. A failed run
+     * leaves no output file behind.
+     * @param input Path to the input recording
+     * @param output Path to the output file
+     * @return true if the output was written completely
+     */
+    bool transcode(const std::string& input, const std::string& output);
+
+    /**
+     * @brief Transcode files in parallel, one file per thread at a time
+     * @param jobs Files to transcode, outcomes are filled in
+     * @param options Settings used for every file
+     * @param threads Number of worker threads, at least one is used
+     * @return number of files that failed
+     */
+    static size_t transcodeFiles(std::vector<TranscodeJob>& jobs,
+                                 const TranscodeOptions& options,
+                                 unsigned threads);
+
+    size_t getEventsRead() const noexcept
+    {
+        return m_eventsRead;
+    }
+
+    size_t getEventsWritten() const noexcept
+    {
+        return m_eventsWritten;
+    }
+
+    std::string getLastError() const;
+
+  private:
+    // StorageProgress interface, fed by the input storage
+    bool update(std::uint64_t done, std::uint64_t total) override;
+    void metadataLoaded(const Core::StorageMetadata& metadata) override;
+    void eventsLoaded(
+        std::vector<std::unique_ptr<Core::Event>>& events) override;
+
+    /**
+     * @brief Transcode one file to a binary file with its repeated
+     * segments stored once
+     */
+    bool transcodeLooped(Core::IEventStorage& storage,
+                         const std::string& input,
+                         const std::string& output);
+
+    void setLastError(const std::string& error);
+
+  private:
+    TranscodeOptions m_options;
+
+    // State of the running transcode()
+    std::unique_ptr<EventStreamWriter> m_writer;
+    std::string m_output;
+    bool m_writerOpen{false};
+    bool m_failed{false};
+    size_t m_eventsRead{0};
+    size_t m_eventsWritten{0};
+    std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Storage
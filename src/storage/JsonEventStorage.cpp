@@ -8,6 +8,13 @@
 #include "core/serialization/EventSerializerFactory.hpp"
 #include <fstream>
 #include "core/SpdlogConfig.hpp"
+#include "core/Tracing.hpp"
+#include "core/StorageTask.hpp"
+#include "JsonStreamScanner.hpp"
+#include "EventRangeFilter.hpp"
+#include "StorageFileIO.hpp"
+#include "StorageMetrics.hpp"
+#include <iterator>
 
 namespace MouseRecorder::Storage
 {
@@ -49,6 +56,8 @@ bool JsonEventStorage::saveEvents(
     const std::string& filename,
     const Core::StorageMetadata& metadata)
 {
+    MOUSERECORDER_TRACE_SCOPE("storage", "JsonEventStorage::saveEvents");
+    auto startTime = std::chrono::steady_clock::now();
     if (!m_serializer)
     {
         setLastError("No serializer available");
@@ -61,26 +70,24 @@ bool JsonEventStorage::saveEvents(
                       events.size(),
                       filename);
 
+        // Store the statistics with the metadata
+        Core::StorageMetadata fileMetadata = metadata;
+        fileMetadata.statistics = Core::RecordingStatistics::fromEvents(events);
+
         // Serialize events to JSON string
-        std::string jsonData = m_serializer->serializeEvents(events, metadata);
+        std::string jsonData =
+            m_serializer->serializeEvents(events, fileMetadata);
 
         // Write to file
-        std::ofstream file(filename);
-        if (!file.is_open())
-        {
-            setLastError("Failed to open file for writing: " + filename);
-            return false;
-        }
-
-        file << jsonData;
-        file.close();
-
-        if (file.fail())
+        std::string error;
+        if (!writeFileWithProgress(
+                filename, jsonData, m_progress, m_syncOnSave, error))
         {
-            setLastError("Failed to write data to file: " + filename);
+            setLastError(error);
             return false;
         }
 
+        recordStorageOperation("json", "save", jsonData.size(), startTime);
         spdlog::info("JsonEventStorage: Successfully saved {} events to {}",
                      events.size(),
                      filename);
@@ -98,6 +105,8 @@ bool JsonEventStorage::loadEvents(
     std::vector<std::unique_ptr<Core::Event>>& events,
     Core::StorageMetadata& metadata)
 {
+    MOUSERECORDER_TRACE_SCOPE("storage", "JsonEventStorage::loadEvents");
+    auto startTime = std::chrono::steady_clock::now();
     if (!m_serializer)
     {
         setLastError("No serializer available");
@@ -108,36 +117,38 @@ bool JsonEventStorage::loadEvents(
     {
         spdlog::debug("JsonEventStorage: Loading events from {}", filename);
 
-        // Read file content
-        std::ifstream file(filename);
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
         if (!file.is_open())
         {
             setLastError("Failed to open file for reading: " + filename);
             return false;
         }
+        const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0, std::ios::beg);
 
-        std::string fileContent((std::istreambuf_iterator<char>(file)),
-                                std::istreambuf_iterator<char>());
-        file.close();
-
-        if (file.fail())
+        // Serializers write the metadata after the events, find it first
+        // so it can be handed out before them
+        metadata = {};
+        if (!readMetadata(file, metadata))
         {
-            setLastError("Failed to read file: " + filename);
             return false;
         }
+        if (m_progress)
+        {
+            m_progress->metadataLoaded(metadata);
+        }
 
-        // Clear existing events
+        file.clear();
+        file.seekg(0, std::ios::beg);
         events.clear();
-
-        // Deserialize events
-        if (!m_serializer->deserializeEvents(fileContent, events, metadata))
+        if (!readEvents(file, fileSize, events))
         {
-            setLastError("Failed to deserialize events from JSON");
+            events.clear();
             return false;
         }
 
-        spdlog::info("JsonEventStorage: Successfully loaded {} events from {}",
-                     events.size(),
+        recordStorageOperation("json", "load", fileSize, startTime);
+        spdlog::info("JsonEventStorage: Successfully loaded events from {}",
                      filename);
         return true;
     }
@@ -149,6 +160,203 @@ bool JsonEventStorage::loadEvents(
     }
 }
 
+bool JsonEventStorage::loadEventsRange(
+    const std::string& filename,
+    const Core::EventRange& range,
+    std::vector<std::unique_ptr<Core::Event>>& events,
+    Core::StorageMetadata& metadata)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "JsonEventStorage::loadEventsRange");
+    if (!loadEventsRangeStreaming(
+            *this, m_progress, filename, range, events, metadata))
+    {
+        return false;
+    }
+
+    // Stopping after the range is not an error
+    m_lastError.clear();
+    spdlog::info("JsonEventStorage: Loaded {} events of a range from {}",
+                 events.size(),
+                 filename);
+    return true;
+}
+
+bool JsonEventStorage::readMetadata(std::istream& input,
+                                    Core::StorageMetadata& metadata) const
+{
+    JsonStreamScanner scanner(input);
+    if (!scanner.consume('{'))
+    {
+        setLastError("Invalid JSON: root element is not an object");
+        return false;
+    }
+    if (scanner.consume('}'))
+    {
+        return true;
+    }
+
+    std::string key;
+    do
+    {
+        if (!scanner.readString(key) || !scanner.consume(':'))
+        {
+            break;
+        }
+
+        if (key == "metadata")
+        {
+            std::string document = "{\"metadata\":";
+            if (!scanner.readValue(&document))
+            {
+                break;
+            }
+            document += "}";
+
+            std::vector<std::unique_ptr<Core::Event>> none;
+            if (!m_serializer->deserializeEvents(document, none, metadata))
+            {
+                setLastError("Failed to deserialize metadata from JSON: " +
+                             m_serializer->getLastError());
+                return false;
+            }
+            return true;
+        }
+
+        if (!scanner.readValue(nullptr))
+        {
+            break;
+        }
+    } while (scanner.consume(','));
+
+    if (!scanner.consume('}'))
+    {
+        setLastError("Invalid JSON near byte " +
+                     std::to_string(scanner.getPosition()));
+        return false;
+    }
+    return true;
+}
+
+bool JsonEventStorage::readEvents(
+    std::istream& input,
+    uint64_t size,
+    std::vector<std::unique_ptr<Core::Event>>& events)
+{
+    JsonStreamScanner scanner(input);
+    auto malformed = [this, &scanner]()
+    {
+        setLastError("Invalid JSON near byte " +
+                     std::to_string(scanner.getPosition()));
+        return false;
+    };
+
+    if (!scanner.consume('{'))
+    {
+        return malformed();
+    }
+
+    std::string key;
+    bool more = !scanner.consume('}');
+    while (more)
+    {
+        if (!scanner.readString(key) || !scanner.consume(':'))
+        {
+            return malformed();
+        }
+
+        if (key != "events" || !scanner.consume('['))
+        {
+            if (!scanner.readValue(nullptr))
+            {
+                return malformed();
+            }
+        }
+        else if (!scanner.consume(']'))
+        {
+            // Collect the events of a batch into a document of their own
+            const std::string prefix = "{\"events\":[";
+            std::string document = prefix;
+            size_t batched = 0;
+            do
+            {
+                if (batched > 0)
+                {
+                    document += ',';
+                }
+                if (!scanner.readValue(&document))
+                {
+                    return malformed();
+                }
+                if (++batched < PROGRESS_INTERVAL)
+                {
+                    continue;
+                }
+
+                if (!decodeEvents(document, events))
+                {
+                    return false;
+                }
+                document = prefix;
+                batched = 0;
+
+                if (m_progress)
+                {
+                    m_progress->eventsLoaded(events);
+                }
+                if (!Core::StorageProgress::report(
+                        m_progress, scanner.getPosition(), size))
+                {
+                    setLastError(Core::StorageProgress::CANCELLED_ERROR);
+                    return false;
+                }
+            } while (scanner.consume(','));
+
+            if (!scanner.consume(']'))
+            {
+                return malformed();
+            }
+            if (batched > 0 && !decodeEvents(document, events))
+            {
+                return false;
+            }
+        }
+
+        more = scanner.consume(',');
+        if (!more && !scanner.consume('}'))
+        {
+            return malformed();
+        }
+    }
+
+    if (!scanner.atEnd())
+    {
+        return malformed();
+    }
+
+    Core::StorageProgress::report(m_progress, size, size);
+    return true;
+}
+
+bool JsonEventStorage::decodeEvents(
+    std::string& document, std::vector<std::unique_ptr<Core::Event>>& events)
+{
+    document += "]}";
+
+    std::vector<std::unique_ptr<Core::Event>> decoded;
+    Core::StorageMetadata unused;
+    if (!m_serializer->deserializeEvents(document, decoded, unused))
+    {
+        setLastError("Failed to deserialize events from JSON: " +
+                     m_serializer->getLastError());
+        return false;
+    }
+
+    events.insert(events.end(),
+                  std::make_move_iterator(decoded.begin()),
+                  std::make_move_iterator(decoded.end()));
+    return true;
+}
+
 Core::StorageFormat JsonEventStorage::getSupportedFormat() const noexcept
 {
     return Core::StorageFormat::Json;
@@ -201,21 +409,15 @@ bool JsonEventStorage::getFileMetadata(const std::string& filename,
 
     try
     {
-        std::ifstream file(filename);
+        std::ifstream file(filename, std::ios::binary);
         if (!file.is_open())
         {
             return false;
         }
 
-        // Read entire file into string
-        std::string fileContent((std::istreambuf_iterator<char>(file)),
-                                std::istreambuf_iterator<char>());
-        file.close();
-
-        // Use a temporary vector to deserialize and get metadata
-        std::vector<std::unique_ptr<Core::Event>> tempEvents;
-        return m_serializer->deserializeEvents(
-            fileContent, tempEvents, metadata);
+        // Only the metadata object is decoded, the events are skipped
+        metadata = {};
+        return readMetadata(file, metadata);
     }
     catch (const std::exception&)
     {
@@ -223,6 +425,11 @@ bool JsonEventStorage::getFileMetadata(const std::string& filename,
     }
 }
 
+void JsonEventStorage::setProgress(Core::StorageProgress* progress)
+{
+    m_progress = progress;
+}
+
 std::string JsonEventStorage::getLastError() const
 {
     return m_lastError;
@@ -240,9 +447,19 @@ bool JsonEventStorage::supportsCompression() const noexcept
     return false; // JSON itself doesn't support compression
 }
 
-void JsonEventStorage::setLastError(const std::string& error)
+void JsonEventStorage::setSyncOnSave(bool sync)
+{
+    m_syncOnSave = sync;
+}
+
+void JsonEventStorage::setLastError(const std::string& error) const
 {
     m_lastError = error;
+    if (error == Core::StorageProgress::CANCELLED_ERROR)
+    {
+        spdlog::info("JsonEventStorage: {}", error);
+        return;
+    }
     spdlog::error("JsonEventStorage: {}", error);
 }
 
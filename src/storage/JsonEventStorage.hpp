@@ -7,6 +7,8 @@
 
 #include "core/IEventStorage.hpp"
 #include "core/serialization/IEventSerializer.hpp"
+#include <cstdint>
+#include <iosfwd>
 #include <memory>
 
 namespace MouseRecorder::Storage
@@ -19,6 +21,10 @@ namespace MouseRecorder::Storage
  * the IEventSerializer interface for abstracted serialization.
  * The storage class now focuses on file I/O while delegating
  * serialization/deserialization to the serializer.
+ *
+ * Loading scans the file block by block and decodes the events in
+ * batches, so a progress sink can take them while the rest of the file
+ * is still on disk.
  */
 class JsonEventStorage : public Core::IEventStorage
 {
@@ -43,26 +49,64 @@ class JsonEventStorage : public Core::IEventStorage
                     std::vector<std::unique_ptr<Core::Event>>& events,
                     Core::StorageMetadata& metadata) override;
 
+    bool loadEventsRange(const std::string& filename,
+                         const Core::EventRange& range,
+                         std::vector<std::unique_ptr<Core::Event>>& events,
+                         Core::StorageMetadata& metadata) override;
+
     Core::StorageFormat getSupportedFormat() const noexcept override;
     std::string getFileExtension() const noexcept override;
     std::string getFormatDescription() const noexcept override;
     bool validateFile(const std::string& filename) const override;
     bool getFileMetadata(const std::string& filename,
                          Core::StorageMetadata& metadata) const override;
+    void setProgress(Core::StorageProgress* progress) override;
     std::string getLastError() const override;
     void setCompressionLevel(int level) override;
     bool supportsCompression() const noexcept override;
+    void setSyncOnSave(bool sync) override;
 
   private:
+    // Events decoded between progress reports
+    static constexpr size_t PROGRESS_INTERVAL = 4096;
+
+    /**
+     * @brief Find and decode the metadata object of a document
+     *
+     * Leaves metadata unchanged if the document has none.
+     */
+    bool readMetadata(std::istream& input,
+                      Core::StorageMetadata& metadata) const;
+
+    /**
+     * @brief Decode the events array of a document in batches
+     * @param input Document
+     * @param size Size of the document in bytes, for progress
+     * @param events Output vector, handed to the progress sink per batch
+     */
+    bool readEvents(std::istream& input,
+                    uint64_t size,
+                    std::vector<std::unique_ptr<Core::Event>>& events);
+
+    /**
+     * @brief Decode a document holding a batch of events
+     * @param document Events document, consumed
+     * @param events Decoded events are appended here
+     */
+    bool decodeEvents(std::string& document,
+                      std::vector<std::unique_ptr<Core::Event>>& events);
+
     /**
      * @brief Set last error message
      * @param error Error message
      */
-    void setLastError(const std::string& error);
+    void setLastError(const std::string& error) const;
 
   private:
     mutable std::string m_lastError;
     std::unique_ptr<Core::Serialization::IEventSerializer> m_serializer;
+    Core::StorageProgress* m_progress{nullptr};
+    bool m_syncOnSave{true};
 };
 
 } // namespace MouseRecorder::Storage
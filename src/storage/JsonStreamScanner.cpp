@@ -0,0 +1,199 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "JsonStreamScanner.hpp"
+
+namespace MouseRecorder::Storage
+{
+
+namespace
+{
+
+// Bytes read from the input at a time
+constexpr size_t READ_BLOCK_SIZE = 64 * 1024;
+
+bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool endsLiteral(char c)
+{
+    return isWhitespace(c) || c == ',' || c == ':' || c == '}' || c == ']' ||
+           c == '{' || c == '[' || c == '"';
+}
+
+} // namespace
+
+JsonStreamScanner::JsonStreamScanner(std::istream& input) : m_input(input)
+{
+}
+
+bool JsonStreamScanner::next(char& c)
+{
+    if (m_offset == m_buffer.size())
+    {
+        if (!m_input.good())
+        {
+            return false;
+        }
+        m_buffer.resize(READ_BLOCK_SIZE);
+        m_input.read(m_buffer.data(),
+                     static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.resize(static_cast<size_t>(m_input.gcount()));
+        m_offset = 0;
+        if (m_buffer.empty())
+        {
+            return false;
+        }
+    }
+    c = m_buffer[m_offset];
+    return true;
+}
+
+void JsonStreamScanner::advance(std::string* raw)
+{
+    if (raw)
+    {
+        raw->push_back(m_buffer[m_offset]);
+    }
+    ++m_offset;
+    ++m_position;
+}
+
+void JsonStreamScanner::skipWhitespace()
+{
+    char c;
+    while (next(c) && isWhitespace(c))
+    {
+        advance(nullptr);
+    }
+}
+
+bool JsonStreamScanner::consume(char c)
+{
+    if (peek() != c || c == '\0')
+    {
+        return false;
+    }
+    advance(nullptr);
+    return true;
+}
+
+char JsonStreamScanner::peek()
+{
+    skipWhitespace();
+    char c;
+    return next(c) ? c : '\0';
+}
+
+bool JsonStreamScanner::readStringBody(std::string* raw)
+{
+    char c;
+    while (next(c))
+    {
+        if (c == '"')
+        {
+            advance(nullptr);
+            return true;
+        }
+
+        advance(raw);
+        if (c == '\\')
+        {
+            // The escaped character cannot end the string
+            if (!next(c))
+            {
+                return false;
+            }
+            advance(raw);
+        }
+    }
+    return false;
+}
+
+bool JsonStreamScanner::readString(std::string& value)
+{
+    value.clear();
+    return consume('"') && readStringBody(&value);
+}
+
+bool JsonStreamScanner::readValue(std::string* raw)
+{
+    char c = peek();
+    if (c == '"')
+    {
+        advance(raw);
+        if (!readStringBody(raw))
+        {
+            return false;
+        }
+        if (raw)
+        {
+            raw->push_back('"');
+        }
+        return true;
+    }
+
+    if (c != '{' && c != '[')
+    {
+        // Number, true, false or null; the parser checks which
+        size_t length = 0;
+        while (next(c) && !endsLiteral(c))
+        {
+            advance(raw);
+            ++length;
+        }
+        return length > 0;
+    }
+
+    // Track the brackets that still have to be closed
+    std::string closers;
+    while (next(c))
+    {
+        advance(raw);
+        switch (c)
+        {
+        case '{':
+            closers.push_back('}');
+            break;
+        case '[':
+            closers.push_back(']');
+            break;
+        case '}':
+        case ']':
+            if (closers.empty() || closers.back() != c)
+            {
+                return false;
+            }
+            closers.pop_back();
+            if (closers.empty())
+            {
+                return true;
+            }
+            break;
+        case '"':
+            if (!readStringBody(raw))
+            {
+                return false;
+            }
+            if (raw)
+            {
+                raw->push_back('"');
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+
+bool JsonStreamScanner::atEnd()
+{
+    return peek() == '\0';
+}
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,94 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Incremental scanner over the structure of a JSON document
+ *
+ * Walks a document read block by block without building it, so single
+ * values can be captured as text and parsed one batch at a time. Only the
+ * structure is checked; the captured values are validated by whoever
+ * parses them.
+ */
+class JsonStreamScanner
+{
+  public:
+    explicit JsonStreamScanner(std::istream& input);
+
+    /**
+     * @brief Skip whitespace and consume c if it comes next
+     * @return true if c was consumed
+     */
+    bool consume(char c);
+
+    /**
+     * @brief Skip whitespace and return the next character without
+     * consuming it
+     * @return the character or '\0' at the end of the input
+     */
+    char peek();
+
+    /**
+     * @brief Read a string, keeping escape sequences as they are
+     * @param value Set to the characters between the quotes
+     * @return false if no string comes next
+     */
+    bool readString(std::string& value);
+
+    /**
+     * @brief Read any value
+     * @param raw Text of the value is appended here unless nullptr
+     * @return false if no well-formed value comes next
+     */
+    bool readValue(std::string* raw);
+
+    /**
+     * @brief Check that only whitespace is left
+     */
+    bool atEnd();
+
+    /**
+     * @brief Get the number of bytes consumed so far
+     */
+    uint64_t getPosition() const noexcept
+    {
+        return m_position;
+    }
+
+  private:
+    /**
+     * @brief Get the next character without consuming it
+     * @return false at the end of the input
+     */
+    bool next(char& c);
+
+    /**
+     * @brief Consume the character returned by next()
+     */
+    void advance(std::string* raw);
+
+    void skipWhitespace();
+
+    /**
+     * @brief Read the rest of a string after its opening quote
+     */
+    bool readStringBody(std::string* raw);
+
+  private:
+    std::istream& m_input;
+    std::string m_buffer;
+    size_t m_offset{0};
+    uint64_t m_position{0};
+};
+
+} // namespace MouseRecorder::Storage
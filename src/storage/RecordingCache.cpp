@@ -0,0 +1,255 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "RecordingCache.hpp"
+#include "core/Event.hpp"
+#include "core/Metrics.hpp"
+#include "core/SpdlogConfig.hpp"
+#include <filesystem>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace MouseRecorder::Storage
+{
+
+namespace
+{
+
+/**
+ * @brief Count a lookup, result is "hit" or "miss"
+ */
+void recordLookup(const char* result)
+{
+    Core::MetricsRegistry::instance()
+        .counter(Core::MetricNames::RECORDING_CACHE_LOOKUPS,
+                 "Lookups in the cache of decoded recordings",
+                 {{"result", result}})
+        .increment();
+}
+
+// Heap memory of a string beyond the object itself
+size_t stringMemory(const std::string& text)
+{
+    // Short strings live inside the object
+    return text.capacity() > std::string().capacity() ? text.capacity() + 1
+                                                      : 0;
+}
+
+} // namespace
+
+Core::EventVector CachedRecording::copyEvents() const
+{
+    Core::EventVector copies;
+    copies.reserve(events->size());
+    for (const auto& event : *events)
+    {
+        copies.push_back(std::make_unique<Core::Event>(*event));
+    }
+    return copies;
+}
+
+std::optional<FileStamp> FileStamp::of(const std::string& filename)
+{
+    std::error_code error;
+    fs::path path = fs::absolute(filename, error);
+    if (error)
+    {
+        return std::nullopt;
+    }
+
+    FileStamp stamp;
+    stamp.path = path.lexically_normal().string();
+    stamp.size = fs::file_size(path, error);
+    if (error)
+    {
+        return std::nullopt;
+    }
+    auto modified = fs::last_write_time(path, error);
+    if (error)
+    {
+        return std::nullopt;
+    }
+    stamp.modifiedTime =
+        static_cast<int64_t>(modified.time_since_epoch().count());
+    return stamp;
+}
+
+RecordingCache::RecordingCache(size_t budgetBytes)
+    : m_budgetBytes(budgetBytes)
+{
+}
+
+std::shared_ptr<const CachedRecording> RecordingCache::find(
+    const FileStamp& stamp)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_lookup.find(stamp.path);
+    if (it == m_lookup.end())
+    {
+        recordLookup("miss");
+        return nullptr;
+    }
+    if (it->second->stamp != stamp)
+    {
+        // The file changed since it was cached
+        erase(it->second);
+        publishUsage();
+        recordLookup("miss");
+        return nullptr;
+    }
+
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    recordLookup("hit");
+    return m_entries.front().recording;
+}
+
+bool RecordingCache::insert(const FileStamp& stamp,
+                            std::shared_ptr<const Core::EventVector> events,
+                            const Core::StorageMetadata& metadata)
+{
+    size_t memoryBytes = estimateMemory(*events, metadata);
+    const size_t eventCount = events->size();
+    auto recording = std::make_shared<CachedRecording>();
+    recording->events = std::move(events);
+    recording->metadata = metadata;
+    recording->memoryBytes = memoryBytes;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto it = m_lookup.find(stamp.path); it != m_lookup.end())
+    {
+        erase(it->second);
+    }
+
+    if (memoryBytes > m_budgetBytes)
+    {
+        spdlog::debug("RecordingCache: {} takes {} bytes, more than the "
+                      "budget of {}",
+                      stamp.path,
+                      memoryBytes,
+                      m_budgetBytes);
+        publishUsage();
+        return false;
+    }
+    evict(m_budgetBytes - memoryBytes);
+    m_entries.push_front({stamp, std::move(recording)});
+    m_lookup[stamp.path] = m_entries.begin();
+    m_memoryBytes += memoryBytes;
+    publishUsage();
+
+    spdlog::debug("RecordingCache: Cached {} ({} events, {} bytes, {} of {} "
+                  "bytes used)",
+                  stamp.path,
+                  eventCount,
+                  memoryBytes,
+                  m_memoryBytes,
+                  m_budgetBytes);
+    return true;
+}
+
+void RecordingCache::remove(const std::string& filename)
+{
+    std::error_code error;
+    fs::path path = fs::absolute(filename, error);
+    if (error)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto it = m_lookup.find(path.lexically_normal().string());
+        it != m_lookup.end())
+    {
+        erase(it->second);
+        publishUsage();
+    }
+}
+
+void RecordingCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lookup.clear();
+    m_memoryBytes = 0;
+    publishUsage();
+}
+
+void RecordingCache::setBudget(size_t budgetBytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budgetBytes = budgetBytes;
+    evict(budgetBytes);
+    publishUsage();
+}
+
+size_t RecordingCache::getBudget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budgetBytes;
+}
+
+size_t RecordingCache::getMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memoryBytes;
+}
+
+size_t RecordingCache::getEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+size_t RecordingCache::estimateMemory(const Core::EventVector& events,
+                                      const Core::StorageMetadata& metadata)
+{
+    size_t bytes = sizeof(CachedRecording) +
+                   events.size() * (sizeof(Core::EventVector::value_type) +
+                                    sizeof(Core::Event));
+    for (const auto& event : events)
+    {
+        if (const auto* key = event->getKeyboardData())
+        {
+            bytes += stringMemory(key->keyName);
+        }
+    }
+    for (const std::string* text : {&metadata.version,
+                                    &metadata.applicationName,
+                                    &metadata.createdBy,
+                                    &metadata.description,
+                                    &metadata.platform,
+                                    &metadata.screenResolution})
+    {
+        bytes += stringMemory(*text);
+    }
+    return bytes;
+}
+
+void RecordingCache::erase(std::list<Entry>::iterator entry)
+{
+    m_memoryBytes -= entry->recording->memoryBytes;
+    m_lookup.erase(entry->stamp.path);
+    m_entries.erase(entry);
+}
+
+void RecordingCache::evict(size_t budgetBytes)
+{
+    while (!m_entries.empty() && m_memoryBytes > budgetBytes)
+    {
+        spdlog::debug("RecordingCache: Evicting {}",
+                      m_entries.back().stamp.path);
+        erase(std::prev(m_entries.end()));
+    }
+}
+
+void RecordingCache::publishUsage() const
+{
+    Core::MetricsRegistry::instance()
+        .gauge(Core::MetricNames::RECORDING_CACHE_BYTES,
+               "Estimated memory held by cached recordings")
+        .set(static_cast<double>(m_memoryBytes));
+}
+
+} // namespace MouseRecorder::Storage
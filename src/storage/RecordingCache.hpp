@@ -0,0 +1,163 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "core/EventTypes.hpp"
+#include "core/IEventStorage.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Decoded recording held by a RecordingCache
+ *
+ * Shared between the cache and its readers and never changed after it
+ * was inserted; readers copy the events they want to own.
+ */
+struct CachedRecording
+{
+    // Shared with whoever inserted them, who must not change them either
+    std::shared_ptr<const Core::EventVector> events;
+    Core::StorageMetadata metadata;
+
+    // Estimated memory held by the recording
+    size_t memoryBytes{0};
+
+    /**
+     * @brief Copies of the events
+     */
+    Core::EventVector copyEvents() const;
+};
+
+/**
+ * @brief Size and modification time of a file when it was read
+ *
+ * A cached recording is only used while its file still has the same
+ * stamp, so files changed on disk are decoded again.
+ */
+struct FileStamp
+{
+    // Absolute, normalized path
+    std::string path;
+    uint64_t size{0};
+    int64_t modifiedTime{0};
+
+    bool operator==(const FileStamp& other) const = default;
+
+    /**
+     * @brief Stamp of a file as it is on disk now
+     * @return stamp, or std::nullopt if the file cannot be found
+     */
+    static std::optional<FileStamp> of(const std::string& filename);
+};
+
+/**
+ * @brief Least recently used cache of decoded recordings
+ *
+ * Switching between a few large recordings or reloading one re-parses the
+ * file every time; the cache keeps the decoded events of recently loaded
+ * files within a memory budget, evicting the least recently used ones.
+ * Recordings larger than the whole budget are not cached.
+ *
+ * Thread safe. Entries are handed out as shared pointers, so evicting a
+ * recording that is still being read only drops the cache's reference.
+ */
+class RecordingCache
+{
+  public:
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 256 * 1024 * 1024;
+
+    /**
+     * @param budgetBytes Memory the cached recordings may take, 0
+     * disables the cache
+     */
+    explicit RecordingCache(size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+
+    RecordingCache(const RecordingCache&) = delete;
+    RecordingCache& operator=(const RecordingCache&) = delete;
+
+    /**
+     * @brief Look up the recording of a file and mark it as recently used
+     * @param stamp Current stamp of the file, see FileStamp::of()
+     * @return recording, or nullptr if it is not cached or the cached one
+     * was read from a different version of the file
+     */
+    std::shared_ptr<const CachedRecording> find(const FileStamp& stamp);
+
+    /**
+     * @brief Cache a decoded recording
+     *
+     * Replaces an older version of the file and evicts least recently
+     * used recordings until the new one fits the budget. The events are
+     * shared, not copied.
+     * @param stamp Stamp of the file taken before it was read, so changes
+     * made during the load are not hidden by the cache
+     * @param events Decoded events, which must not change any more
+     * @param metadata Metadata of the recording
+     * @return true if the recording was cached
+     */
+    bool insert(const FileStamp& stamp,
+                std::shared_ptr<const Core::EventVector> events,
+                const Core::StorageMetadata& metadata);
+
+    /**
+     * @brief Drop the recording of a file, if cached
+     */
+    void remove(const std::string& filename);
+
+    void clear();
+
+    /**
+     * @brief Change the budget, evicting recordings that no longer fit
+     */
+    void setBudget(size_t budgetBytes);
+
+    size_t getBudget() const;
+
+    /**
+     * @brief Estimated memory held by the cached recordings
+     */
+    size_t getMemoryUsage() const;
+
+    size_t getEntryCount() const;
+
+    /**
+     * @brief Estimate the memory a recording takes once decoded
+     */
+    static size_t estimateMemory(const Core::EventVector& events,
+                                 const Core::StorageMetadata& metadata);
+
+  private:
+    struct Entry
+    {
+        FileStamp stamp;
+        std::shared_ptr<const CachedRecording> recording;
+    };
+
+    // Callers hold m_mutex
+    void erase(std::list<Entry>::iterator entry);
+    void evict(size_t budgetBytes);
+    void publishUsage() const;
+
+  private:
+    mutable std::mutex m_mutex;
+
+    // Most recently used first
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_lookup;
+    size_t m_budgetBytes;
+    size_t m_memoryBytes{0};
+};
+
+} // namespace MouseRecorder::Storage
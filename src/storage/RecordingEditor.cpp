@@ -0,0 +1,306 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "RecordingEditor.hpp"
+#include "EventRangeFilter.hpp"
+#include "EventStorageFactory.hpp"
+#include "core/Event.hpp"
+#include "core/SpdlogConfig.hpp"
+#include "core/Tracing.hpp"
+#include <algorithm>
+#include <filesystem>
+
+namespace MouseRecorder::Storage
+{
+
+namespace
+{
+
+std::optional<Core::StorageFormat> formatOf(const std::string& filename)
+{
+    return EventStorageFactory::getFormatFromExtension(
+        std::filesystem::path(filename).extension().string());
+}
+
+} // namespace
+
+bool RecordingEditor::trim(const std::string& input,
+                           const std::string& output,
+                           const Core::EventRange& range)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingEditor::trim");
+    m_eventsWritten = 0;
+    m_eventsDecoded = 0;
+    m_lastError.clear();
+    return splice({{input, range, false}}, output, 0);
+}
+
+bool RecordingEditor::split(const std::string& input,
+                            const std::vector<uint64_t>& splitPointsMs,
+                            const std::vector<std::string>& outputs)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingEditor::split");
+    m_eventsWritten = 0;
+    m_eventsDecoded = 0;
+    m_lastError.clear();
+
+    if (outputs.size() != splitPointsMs.size() + 1)
+    {
+        setLastError("Splitting needs one output more than split points");
+        return false;
+    }
+    if (!std::is_sorted(splitPointsMs.begin(), splitPointsMs.end()))
+    {
+        setLastError("Split points must be in ascending order");
+        return false;
+    }
+
+    uint64_t from = 0;
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        // Time ranges include their end, so stop short of the next point
+        Core::EventRange range = Core::EventRange::byTime(from, UINT64_MAX);
+        if (i < splitPointsMs.size())
+        {
+            uint64_t to = splitPointsMs[i];
+            range = to > from ? Core::EventRange::byTime(from, to - 1)
+                              : Core::EventRange::byIndex(0, 0);
+            from = to;
+        }
+        if (!splice({{input, range, false}}, outputs[i], 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RecordingEditor::concatenate(const std::vector<std::string>& inputs,
+                                  const std::string& output,
+                                  uint64_t gapMs)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingEditor::concatenate");
+    m_eventsWritten = 0;
+    m_eventsDecoded = 0;
+    m_lastError.clear();
+
+    if (inputs.empty())
+    {
+        setLastError("Nothing to concatenate");
+        return false;
+    }
+
+    std::vector<Segment> segments;
+    for (const auto& input : inputs)
+    {
+        segments.push_back(
+            {input, Core::EventRange::byIndex(0, UINT64_MAX), true});
+    }
+    return splice(segments, output, gapMs);
+}
+
+std::string RecordingEditor::getLastError() const
+{
+    return m_lastError;
+}
+
+bool RecordingEditor::splice(const std::vector<Segment>& segments,
+                             const std::string& output,
+                             uint64_t gapMs)
+{
+    // Copying needs a binary output and an index in every input
+    BinaryEventStorage binary;
+    bool copy = formatOf(output) == Core::StorageFormat::Binary &&
+                std::all_of(segments.begin(),
+                            segments.end(),
+                            [&binary](const Segment& segment)
+                            {
+                                return formatOf(segment.filename) ==
+                                           Core::StorageFormat::Binary &&
+                                       binary.hasBlockIndex(segment.filename);
+                            });
+    return copy ? spliceBinary(segments, output, gapMs)
+                : spliceStreaming(segments, output, gapMs);
+}
+
+bool RecordingEditor::spliceBinary(const std::vector<Segment>& segments,
+                                   const std::string& output,
+                                   uint64_t gapMs)
+{
+    BinaryEventStorage storage;
+    Core::StorageMetadata metadata;
+    if (!storage.getFileMetadata(segments.front().filename, metadata) ||
+        !storage.splice(segments, output, gapMs, metadata))
+    {
+        setLastError(storage.getLastError());
+        return false;
+    }
+
+    m_eventsWritten += metadata.totalEvents;
+    spdlog::info("RecordingEditor: Copied {} events to {}",
+                 metadata.totalEvents,
+                 output);
+    return true;
+}
+
+bool RecordingEditor::spliceStreaming(const std::vector<Segment>& segments,
+                                      const std::string& output,
+                                      uint64_t gapMs)
+{
+    auto format = formatOf(output);
+    m_writer = format ? EventStreamWriter::create(*format) : nullptr;
+    if (!m_writer)
+    {
+        setLastError("Unsupported output file: " + output);
+        return false;
+    }
+    m_output = output;
+    m_writerOpen = false;
+    m_failed = false;
+    m_gapMs = gapMs;
+    m_lastTimestampMs.reset();
+
+    for (const auto& segment : segments)
+    {
+        auto storage =
+            EventStorageFactory::createStorageFromFilename(segment.filename);
+        if (!storage)
+        {
+            setLastError("Unsupported input file: " + segment.filename);
+            m_writer.reset();
+            return false;
+        }
+
+        m_rebase = segment.rebase;
+        m_shiftMs.reset();
+        m_kept.clear();
+
+        // The filter hands the events of the range to m_kept, which
+        // update() writes out between chunks
+        EventRangeFilter filter(segment.range, m_kept, this);
+        std::vector<std::unique_ptr<Core::Event>> chunk;
+        Core::StorageMetadata metadata;
+        storage->setProgress(&filter);
+        bool loaded = storage->loadEvents(segment.filename, chunk, metadata);
+        storage->setProgress(nullptr);
+
+        // Pass on whatever the storage did not stream itself
+        if (loaded)
+        {
+            metadataLoaded(metadata);
+        }
+        filter.eventsLoaded(chunk);
+        writeKept();
+
+        // A failing writer has stopped the load and set the error already
+        if (!m_failed && !loaded && !filter.isComplete())
+        {
+            setLastError(storage->getLastError());
+            m_failed = true;
+        }
+        if (m_failed)
+        {
+            // Removes the incomplete output
+            m_writer.reset();
+            return false;
+        }
+    }
+
+    if (!m_writerOpen)
+    {
+        metadataLoaded({});
+    }
+    bool success = !m_failed && m_writer->close();
+    if (!success && !m_failed)
+    {
+        setLastError(m_writer->getLastError());
+    }
+    size_t written = m_writer->getEventCount();
+    m_eventsWritten += written;
+    m_eventsDecoded += written;
+    m_writer.reset();
+
+    if (success)
+    {
+        spdlog::info("RecordingEditor: Wrote {} events to {}", written, output);
+    }
+    return success;
+}
+
+void RecordingEditor::writeKept()
+{
+    if (m_kept.empty())
+    {
+        return;
+    }
+    if (!m_failed && !m_writerOpen)
+    {
+        // Storages hand out the metadata first; be safe with defaults
+        metadataLoaded({});
+    }
+
+    if (!m_failed)
+    {
+        for (auto& event : m_kept)
+        {
+            uint64_t timestamp = event->getTimestampMs();
+            if (m_rebase && !m_shiftMs)
+            {
+                m_shiftMs = m_lastTimestampMs
+                                ? *m_lastTimestampMs + m_gapMs - timestamp
+                                : 0;
+            }
+            if (m_shiftMs && *m_shiftMs != 0)
+            {
+                timestamp += *m_shiftMs;
+                event = std::make_unique<Core::Event>(
+                    event->getType(),
+                    event->getData(),
+                    Core::Event::timestampFromMs(timestamp));
+            }
+            m_lastTimestampMs = timestamp;
+        }
+        if (!m_writer->write(m_kept))
+        {
+            m_failed = true;
+            setLastError(m_writer->getLastError());
+        }
+    }
+    m_kept.clear();
+}
+
+bool RecordingEditor::update(std::uint64_t done, std::uint64_t total)
+{
+    (void)done;
+    (void)total;
+
+    // Stops the load once the writer has failed
+    writeKept();
+    return !m_failed;
+}
+
+void RecordingEditor::metadataLoaded(const Core::StorageMetadata& metadata)
+{
+    if (m_writerOpen || m_failed)
+    {
+        return;
+    }
+
+    if (!m_writer->open(m_output, metadata))
+    {
+        m_failed = true;
+        setLastError(m_writer->getLastError());
+        return;
+    }
+    m_writerOpen = true;
+}
+
+void RecordingEditor::setLastError(const std::string& error)
+{
+    m_lastError = error;
+    spdlog::error("RecordingEditor: {}", error);
+}
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,135 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "BinaryEventStorage.hpp"
+#include "core/StorageTask.hpp"
+#include "EventStreamWriter.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Cuts recordings into pieces and joins them without loading them
+ *
+ * When every input is an indexed binary file and the output is binary too,
+ * the serialized events are copied block by block without being decoded,
+ * see BinaryEventStorage::splice(). Otherwise the inputs are streamed
+ * through an EventRangeFilter into an EventStreamWriter one chunk at a
+ * time, like EventTranscoder does. Either way memory does not grow with
+ * the recordings, and a failed edit leaves no output file behind.
+ */
+class RecordingEditor : private Core::StorageProgress
+{
+  public:
+    /**
+     * @brief Write the events of a range of input to output
+     *
+     * Timestamps are kept as they are.
+     * @return true if the output was written
+     */
+    bool trim(const std::string& input,
+              const std::string& output,
+              const Core::EventRange& range);
+
+    /**
+     * @brief Split input into consecutive parts at points in time
+     *
+     * Part i holds the events from splitPointsMs[i - 1] up to, but not
+     * including, splitPointsMs[i], in ms after the first event. Each part
+     * is a separate pass over the input; copied parts only read their
+     * own blocks.
+     * @param input Path to the input recording
+     * @param splitPointsMs Ascending split points
+     * @param outputs One path per part, splitPointsMs.size() + 1 of them
+     * @return true if every part was written
+     */
+    bool split(const std::string& input,
+               const std::vector<uint64_t>& splitPointsMs,
+               const std::vector<std::string>& outputs);
+
+    /**
+     * @brief Join recordings one after another
+     *
+     * Each input after the first is moved in time to start gapMs after
+     * the last event of the one before it. The metadata is that of the
+     * first input.
+     * @return true if the output was written
+     */
+    bool concatenate(const std::vector<std::string>& inputs,
+                     const std::string& output,
+                     uint64_t gapMs = 0);
+
+    /**
+     * @brief Events written by the last edit, over all of its outputs
+     */
+    size_t getEventsWritten() const noexcept
+    {
+        return m_eventsWritten;
+    }
+
+    /**
+     * @brief Events the last edit decoded and encoded again, zero if it
+     * copied them
+     */
+    size_t getEventsDecoded() const noexcept
+    {
+        return m_eventsDecoded;
+    }
+
+    std::string getLastError() const;
+
+  private:
+    using Segment = BinaryEventStorage::SpliceSegment;
+
+    /**
+     * @brief Write segments to output, copying them if possible
+     */
+    bool splice(const std::vector<Segment>& segments,
+                const std::string& output,
+                uint64_t gapMs);
+
+    bool spliceBinary(const std::vector<Segment>& segments,
+                      const std::string& output,
+                      uint64_t gapMs);
+
+    bool spliceStreaming(const std::vector<Segment>& segments,
+                         const std::string& output,
+                         uint64_t gapMs);
+
+    /**
+     * @brief Write the events kept by the range filter so far
+     */
+    void writeKept();
+
+    // StorageProgress interface, fed by the range filter
+    bool update(std::uint64_t done, std::uint64_t total) override;
+    void metadataLoaded(const Core::StorageMetadata& metadata) override;
+
+    void setLastError(const std::string& error);
+
+  private:
+    // State of the running spliceStreaming()
+    std::unique_ptr<EventStreamWriter> m_writer;
+    std::string m_output;
+    bool m_writerOpen{false};
+    bool m_failed{false};
+    std::vector<std::unique_ptr<Core::Event>> m_kept;
+    bool m_rebase{false};
+    uint64_t m_gapMs{0};
+    std::optional<uint64_t> m_shiftMs;
+    std::optional<uint64_t> m_lastTimestampMs;
+
+    size_t m_eventsWritten{0};
+    size_t m_eventsDecoded{0};
+    std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,479 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "RecordingIndex.hpp"
+#include "BinaryEventStorage.hpp"
+#include "EventStorageFactory.hpp"
+#include "RecordingCache.hpp"
+#include "StorageFileIO.hpp"
+#include "core/SpdlogConfig.hpp"
+#include "core/StorageTask.hpp"
+#include "core/Tracing.hpp"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace MouseRecorder::Storage
+{
+
+namespace
+{
+
+// Entries use the little-endian codec and the metadata and statistics
+// layout of binary recordings
+void writeEntry(const BinaryEventStorage& codec,
+                const RecordingIndexEntry& entry,
+                std::vector<uint8_t>& buffer)
+{
+    codec.writeString(buffer, entry.fileName);
+    codec.writeBinary(buffer, entry.fileSize);
+    codec.writeBinary(buffer, entry.modifiedTime);
+    codec.writeString(buffer, entry.error);
+    codec.serializeMetadata(entry.metadata, buffer);
+    codec.serializeStatistics(entry.statistics, buffer);
+}
+
+RecordingIndexEntry readEntry(const BinaryEventStorage& codec,
+                              const std::vector<uint8_t>& buffer,
+                              size_t& offset)
+{
+    RecordingIndexEntry entry;
+    entry.fileName = codec.readString(buffer, offset);
+    entry.fileSize = codec.readBinary<uint64_t>(buffer, offset);
+    entry.modifiedTime = codec.readBinary<int64_t>(buffer, offset);
+    entry.error = codec.readString(buffer, offset);
+    entry.metadata = codec.deserializeMetadata(buffer, offset);
+    entry.statistics = codec.deserializeStatistics(buffer, offset);
+    return entry;
+}
+
+/**
+ * @brief Collects metadata and statistics of a streaming load
+ *
+ * Counts the events of every chunk and drops them right away.
+ */
+class ScanSink : public Core::StorageProgress
+{
+  public:
+    explicit ScanSink(RecordingIndexEntry& entry,
+                      Core::StorageProgress* progress)
+        : m_entry(entry), m_progress(progress)
+    {
+    }
+
+    bool update(std::uint64_t done, std::uint64_t total) override
+    {
+        m_cancelled = m_cancelled ||
+                      !Core::StorageProgress::report(m_progress, done, total);
+        return !m_cancelled;
+    }
+
+    void eventsLoaded(
+        std::vector<std::unique_ptr<Core::Event>>& events) override
+    {
+        for (const auto& event : events)
+        {
+            m_entry.statistics.add(*event);
+        }
+        events.clear();
+    }
+
+    bool isCancelled() const noexcept
+    {
+        return m_cancelled;
+    }
+
+  private:
+    RecordingIndexEntry& m_entry;
+    Core::StorageProgress* m_progress;
+    bool m_cancelled{false};
+};
+
+/**
+ * @brief Reports the file an update() is at while that file is scanned
+ */
+class FileStepProgress : public Core::StorageProgress
+{
+  public:
+    FileStepProgress(Core::StorageProgress* progress,
+                     std::uint64_t file,
+                     std::uint64_t files)
+        : m_progress(progress), m_file(file), m_files(files)
+    {
+    }
+
+    bool update(std::uint64_t done, std::uint64_t total) override
+    {
+        (void)done;
+        (void)total;
+        return Core::StorageProgress::report(m_progress, m_file, m_files);
+    }
+
+  private:
+    Core::StorageProgress* m_progress;
+    std::uint64_t m_file;
+    std::uint64_t m_files;
+};
+
+bool containsIgnoringCase(const std::string& text, const std::string& query)
+{
+    auto equal = [](char a, char b)
+    {
+        return std::tolower(static_cast<unsigned char>(a)) ==
+               std::tolower(static_cast<unsigned char>(b));
+    };
+    return std::search(
+               text.begin(), text.end(), query.begin(), query.end(), equal) !=
+           text.end();
+}
+
+} // namespace
+
+RecordingIndex::RecordingIndex(std::string directory)
+    : m_directory(std::move(directory))
+{
+}
+
+std::string RecordingIndex::getIndexPath() const
+{
+    return (fs::path(m_directory) / INDEX_FILE_NAME).string();
+}
+
+bool RecordingIndex::load()
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingIndex::load");
+    m_entries.clear();
+    m_modified = false;
+
+    std::ifstream file(getIndexPath(), std::ios::binary);
+    if (!file.is_open())
+    {
+        return true;
+    }
+
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+    if (file.bad())
+    {
+        setLastError("Failed to read index file: " + getIndexPath());
+        return false;
+    }
+
+    try
+    {
+        BinaryEventStorage codec;
+        size_t offset = 0;
+        if (codec.readBinary<uint32_t>(data, offset) != MAGIC_NUMBER)
+        {
+            setLastError("Not an index file: " + getIndexPath());
+            return false;
+        }
+        uint32_t version = codec.readBinary<uint32_t>(data, offset);
+        if (version != FORMAT_VERSION)
+        {
+            setLastError("Unsupported index version " +
+                         std::to_string(version) + ": " + getIndexPath());
+            return false;
+        }
+
+        uint32_t count = codec.readBinary<uint32_t>(data, offset);
+        std::vector<RecordingIndexEntry> entries;
+        entries.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            entries.push_back(readEntry(codec, data, offset));
+        }
+        m_entries = std::move(entries);
+    }
+    catch (const std::exception& e)
+    {
+        setLastError(std::string(e.what()) + ": " + getIndexPath());
+        return false;
+    }
+
+    std::sort(m_entries.begin(),
+              m_entries.end(),
+              [](const auto& a, const auto& b)
+              { return a.fileName < b.fileName; });
+
+    spdlog::debug("RecordingIndex: Loaded {} entries from {}",
+                  m_entries.size(),
+                  getIndexPath());
+    return true;
+}
+
+bool RecordingIndex::save()
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingIndex::save");
+    BinaryEventStorage codec;
+    std::vector<uint8_t> data;
+    codec.writeBinary(data, MAGIC_NUMBER);
+    codec.writeBinary(data, FORMAT_VERSION);
+    codec.writeBinary(data, static_cast<uint32_t>(m_entries.size()));
+    for (const auto& entry : m_entries)
+    {
+        writeEntry(codec, entry, data);
+    }
+
+    const std::string indexPath = getIndexPath();
+    const std::string tempPath = makeTempPath(indexPath);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()),
+                   static_cast<std::streamsize>(data.size()));
+        file.close();
+        if (!file)
+        {
+            std::error_code ignored;
+            fs::remove(tempPath, ignored);
+            setLastError("Failed to write index file: " + tempPath);
+            return false;
+        }
+    }
+
+    // The index is rebuilt from the recordings if it is lost, so it is
+    // not worth waiting for the disk
+    std::string error;
+    if (!replaceFile(tempPath, indexPath, false, error))
+    {
+        setLastError("Failed to replace index file: " + error);
+        return false;
+    }
+
+    m_modified = false;
+    return true;
+}
+
+bool RecordingIndex::update(Core::StorageProgress* progress)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingIndex::update");
+    m_scannedFiles = 0;
+
+    // Recordings currently in the directory, sorted like the entries
+    std::vector<fs::path> files;
+    std::error_code error;
+    for (fs::directory_iterator it(m_directory, error), end;
+         !error && it != end;
+         it.increment(error))
+    {
+        std::error_code ignored;
+        if (it->is_regular_file(ignored) &&
+            EventStorageFactory::getFormatFromExtension(
+                it->path().extension().string()))
+        {
+            files.push_back(it->path());
+        }
+    }
+    if (error)
+    {
+        setLastError("Failed to list " + m_directory + ": " + error.message());
+        return false;
+    }
+    std::sort(files.begin(),
+              files.end(),
+              [](const fs::path& a, const fs::path& b)
+              { return a.filename().string() < b.filename().string(); });
+
+    std::vector<RecordingIndexEntry> entries;
+    entries.reserve(files.size());
+    bool cancelled = false;
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        std::string fileName = files[i].filename().string();
+        const RecordingIndexEntry* previous = find(fileName);
+
+        if (!cancelled && !Core::StorageProgress::report(
+                              progress, i, files.size()))
+        {
+            cancelled = true;
+        }
+        if (cancelled)
+        {
+            if (previous)
+            {
+                entries.push_back(*previous);
+            }
+            continue;
+        }
+
+        std::error_code statError;
+        uint64_t size = fs::file_size(files[i], statError);
+        auto modified = fs::last_write_time(files[i], statError);
+        if (statError)
+        {
+            // Removed while listing
+            continue;
+        }
+        int64_t modifiedTime =
+            static_cast<int64_t>(modified.time_since_epoch().count());
+
+        if (previous && previous->fileSize == size &&
+            previous->modifiedTime == modifiedTime)
+        {
+            entries.push_back(*previous);
+            continue;
+        }
+
+        RecordingIndexEntry entry;
+        entry.fileName = std::move(fileName);
+        entry.fileSize = size;
+        entry.modifiedTime = modifiedTime;
+        FileStepProgress fileProgress(progress, i, files.size());
+        if (!scanFile(files[i].string(), entry, &fileProgress, m_cache))
+        {
+            cancelled = true;
+            if (previous)
+            {
+                entries.push_back(*previous);
+            }
+            continue;
+        }
+
+        ++m_scannedFiles;
+        entries.push_back(std::move(entry));
+    }
+
+    m_modified = m_modified || m_scannedFiles > 0 ||
+                 entries.size() != m_entries.size();
+    m_entries = std::move(entries);
+
+    if (cancelled)
+    {
+        setLastError(Core::StorageProgress::CANCELLED_ERROR);
+        return false;
+    }
+
+    Core::StorageProgress::report(progress, files.size(), files.size());
+    spdlog::debug("RecordingIndex: {} recordings in {}, {} scanned",
+                  m_entries.size(),
+                  m_directory,
+                  m_scannedFiles);
+    return true;
+}
+
+bool RecordingIndex::scanFile(const std::string& path,
+                              RecordingIndexEntry& entry,
+                              Core::StorageProgress* progress,
+                              RecordingCache* cache)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingIndex::scanFile");
+    entry.error.clear();
+    entry.metadata = {};
+    entry.statistics = {};
+
+    auto storage = EventStorageFactory::createStorageFromFilename(path);
+    if (!storage)
+    {
+        entry.error = "Unsupported file format";
+        return true;
+    }
+
+    // Recordings saved with their statistics need not be decoded
+    Core::StorageMetadata stored;
+    if (storage->getFileMetadata(path, stored) && stored.statistics)
+    {
+        entry.statistics = std::move(*stored.statistics);
+        stored.statistics.reset();
+        entry.metadata = std::move(stored);
+        return true;
+    }
+
+    // Nor recordings that were loaded recently
+    auto stamp = cache ? FileStamp::of(path) : std::nullopt;
+    if (auto cached = stamp ? cache->find(*stamp) : nullptr)
+    {
+        for (const auto& event : *cached->events)
+        {
+            entry.statistics.add(*event);
+        }
+        entry.metadata = cached->metadata;
+        entry.metadata.statistics.reset();
+        return true;
+    }
+
+    ScanSink sink(entry, progress);
+    std::vector<std::unique_ptr<Core::Event>> events;
+    Core::StorageMetadata metadata;
+    storage->setProgress(&sink);
+    bool loaded = storage->loadEvents(path, events, metadata);
+    storage->setProgress(nullptr);
+
+    if (sink.isCancelled())
+    {
+        return false;
+    }
+    if (!loaded)
+    {
+        entry.error = storage->getLastError();
+        entry.statistics = {};
+        return true;
+    }
+
+    // Events the storage did not stream itself
+    for (const auto& event : events)
+    {
+        entry.statistics.add(*event);
+    }
+    entry.metadata = std::move(metadata);
+    entry.metadata.statistics.reset();
+    return true;
+}
+
+const RecordingIndexEntry* RecordingIndex::find(
+    const std::string& fileName) const
+{
+    auto it = std::lower_bound(m_entries.begin(),
+                               m_entries.end(),
+                               fileName,
+                               [](const RecordingIndexEntry& entry,
+                                  const std::string& name)
+                               { return entry.fileName < name; });
+    if (it == m_entries.end() || it->fileName != fileName)
+    {
+        return nullptr;
+    }
+    return &*it;
+}
+
+bool RecordingIndex::matches(const RecordingIndexEntry& entry,
+                             const std::string& query)
+{
+    return query.empty() || containsIgnoringCase(entry.fileName, query) ||
+           containsIgnoringCase(entry.metadata.description, query) ||
+           containsIgnoringCase(entry.metadata.createdBy, query) ||
+           containsIgnoringCase(entry.metadata.platform, query);
+}
+
+std::vector<const RecordingIndexEntry*> RecordingIndex::search(
+    const std::string& query) const
+{
+    std::vector<const RecordingIndexEntry*> result;
+    for (const auto& entry : m_entries)
+    {
+        if (matches(entry, query))
+        {
+            result.push_back(&entry);
+        }
+    }
+    return result;
+}
+
+std::string RecordingIndex::getLastError() const
+{
+    return m_lastError;
+}
+
+void RecordingIndex::setLastError(const std::string& error)
+{
+    m_lastError = error;
+    spdlog::error("RecordingIndex: {}", error);
+}
+
+} // namespace MouseRecorder::Storage
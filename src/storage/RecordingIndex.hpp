@@ -0,0 +1,182 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "core/IEventStorage.hpp"
+#include "core/RecordingStatistics.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MouseRecorder::Core
+{
+class StorageProgress;
+}
+
+namespace MouseRecorder::Storage
+{
+
+class RecordingCache;
+
+/**
+ * @brief What the index knows about one recording
+ */
+struct RecordingIndexEntry
+{
+    // File name within the indexed directory
+    std::string fileName;
+
+    // Size and modification time when the file was scanned
+    uint64_t fileSize{0};
+    int64_t modifiedTime{0};
+
+    // Why the file could not be read, empty if it was scanned successfully
+    std::string error;
+
+    Core::StorageMetadata metadata;
+    Core::RecordingStatistics statistics;
+};
+
+/**
+ * @brief Catalog of the recordings in one directory
+ *
+ * Kept in a compact little-endian binary file inside the directory, so
+ * listing and searching recordings needs one small read instead of
+ * loading every recording. update() only scans files whose size or
+ * modification time changed since they were indexed.
+ *
+ * Not thread safe; RecordingLibrary runs indexes on a background thread.
+ */
+class RecordingIndex
+{
+  public:
+    static constexpr const char* INDEX_FILE_NAME = ".mouserecorder-index";
+    static constexpr uint32_t MAGIC_NUMBER = 0x494C524D; // "MRLI"
+    static constexpr uint32_t FORMAT_VERSION = 3;
+
+    explicit RecordingIndex(std::string directory);
+
+    /**
+     * @brief Read the index file of the directory
+     *
+     * A directory without an index file gives an empty index.
+     * @return false if the index file exists but cannot be read
+     */
+    bool load();
+
+    /**
+     * @brief Write the index file of the directory
+     *
+     * Writes a temporary file first and renames it over the old index,
+     * so readers never see a partial index.
+     * @return true if the index file was written
+     */
+    bool save();
+
+    /**
+     * @brief Bring the index up to date with the recordings on disk
+     *
+     * Drops removed files and scans new and changed ones. If progress asks
+     * to stop, files not scanned yet keep their previous entry, which the
+     * next update() scans again.
+     * @param progress Optional sink, reports files checked of the total
+     * @return false if the directory cannot be listed or the update was
+     * stopped
+     */
+    bool update(Core::StorageProgress* progress = nullptr);
+
+    /**
+     * @brief Read a recording into an index entry
+     *
+     * Events are only counted, never kept, so memory does not grow with
+     * the recording for formats that load incrementally.
+     * @param path Path to the recording
+     * @param entry Filled in, error is set if the file cannot be read
+     * @param progress Optional sink, reports bytes or events of the load
+     * @param cache Optional cache of decoded recordings, consulted before
+     * a file is decoded
+     * @return false if progress stopped the scan
+     */
+    static bool scanFile(const std::string& path,
+                         RecordingIndexEntry& entry,
+                         Core::StorageProgress* progress = nullptr,
+                         RecordingCache* cache = nullptr);
+
+    /**
+     * @brief Take the events of recordings loaded recently from a cache
+     * instead of decoding them in update()
+     * @param cache Cache, which must outlive the index, or nullptr
+     */
+    void setRecordingCache(RecordingCache* cache) noexcept
+    {
+        m_cache = cache;
+    }
+
+    /**
+     * @brief Entries sorted by file name
+     */
+    const std::vector<RecordingIndexEntry>& getEntries() const noexcept
+    {
+        return m_entries;
+    }
+
+    /**
+     * @brief Find the entry of a file
+     * @return entry or nullptr if the file is not indexed
+     */
+    const RecordingIndexEntry* find(const std::string& fileName) const;
+
+    /**
+     * @brief Entries whose file name, description, author or platform
+     * contain query, ignoring case; an empty query matches all
+     */
+    std::vector<const RecordingIndexEntry*> search(
+        const std::string& query) const;
+
+    /**
+     * @brief Whether the entries changed since the last load() or save()
+     */
+    bool isModified() const noexcept
+    {
+        return m_modified;
+    }
+
+    /**
+     * @brief Number of files scanned by the last update()
+     */
+    size_t getScannedFiles() const noexcept
+    {
+        return m_scannedFiles;
+    }
+
+    const std::string& getDirectory() const noexcept
+    {
+        return m_directory;
+    }
+
+    std::string getIndexPath() const;
+
+    std::string getLastError() const;
+
+    /**
+     * @brief Whether an entry matches a search query, see search()
+     */
+    static bool matches(const RecordingIndexEntry& entry,
+                        const std::string& query);
+
+  private:
+    void setLastError(const std::string& error);
+
+  private:
+    std::string m_directory;
+    std::vector<RecordingIndexEntry> m_entries;
+    bool m_modified{false};
+    size_t m_scannedFiles{0};
+    RecordingCache* m_cache{nullptr};
+    std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Storage
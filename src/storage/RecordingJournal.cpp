@@ -0,0 +1,295 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "RecordingJournal.hpp"
+#include "BinaryEventStorage.hpp"
+#include "Crc32c.hpp"
+#include "StorageFileIO.hpp"
+#include "core/Event.hpp"
+#include "core/SpdlogConfig.hpp"
+#include "core/Tracing.hpp"
+#include <iterator>
+#include <stdexcept>
+
+namespace MouseRecorder::Storage
+{
+
+RecordingJournal::~RecordingJournal()
+{
+    close();
+}
+
+std::string RecordingJournal::getJournalPath(const std::string& recordingPath)
+{
+    return recordingPath + FILE_EXTENSION;
+}
+
+bool RecordingJournal::create(const std::string& path,
+                              const std::string& targetPath,
+                              const Core::StorageMetadata& metadata)
+{
+    close();
+    m_path = path;
+
+    BinaryEventStorage codec;
+    std::vector<uint8_t> header;
+    codec.writeBinary(header, MAGIC_NUMBER);
+    codec.writeBinary(header, FORMAT_VERSION);
+    codec.writeString(header, targetPath);
+
+    std::vector<uint8_t> metadataBuffer;
+    codec.serializeMetadata(metadata, metadataBuffer);
+    codec.writeBinary(header, static_cast<uint32_t>(metadataBuffer.size()));
+    header.insert(header.end(), metadataBuffer.begin(), metadataBuffer.end());
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        setLastError("Failed to create journal: " + path);
+        return false;
+    }
+    m_file.write(reinterpret_cast<const char*>(header.data()),
+                 static_cast<std::streamsize>(header.size()));
+    m_file.flush();
+    if (!m_file)
+    {
+        m_file.close();
+        setLastError("Failed to write journal: " + path);
+        return false;
+    }
+
+    spdlog::debug("RecordingJournal: Created {}", path);
+    return true;
+}
+
+bool RecordingJournal::append(const std::vector<uint8_t>& events,
+                              uint32_t eventCount,
+                              bool sync)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingJournal::append");
+    if (!m_file.is_open())
+    {
+        setLastError("Journal is not open");
+        return false;
+    }
+
+    // The checksum covers the count and size too, so a block whose
+    // header made it to disk but whose events did not is recognized
+    BinaryEventStorage codec;
+    std::vector<uint8_t> blockHeader;
+    codec.writeBinary(blockHeader, eventCount);
+    codec.writeBinary(blockHeader, static_cast<uint32_t>(events.size()));
+    uint32_t checksum = crc32c(0, blockHeader.data(), blockHeader.size());
+    checksum = crc32c(checksum, events.data(), events.size());
+    codec.writeBinary(blockHeader, checksum);
+    m_file.write(reinterpret_cast<const char*>(blockHeader.data()),
+                 static_cast<std::streamsize>(blockHeader.size()));
+    m_file.write(reinterpret_cast<const char*>(events.data()),
+                 static_cast<std::streamsize>(events.size()));
+    m_file.flush();
+    if (!m_file)
+    {
+        setLastError("Failed to append to journal: " + m_path);
+        return false;
+    }
+
+    std::string error;
+    if (sync && !syncFile(m_path, error))
+    {
+        setLastError(error);
+        return false;
+    }
+    return true;
+}
+
+void RecordingJournal::close()
+{
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+}
+
+bool RecordingJournal::read(const std::string& path,
+                            RecordingJournalContents& contents,
+                            std::string& error)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingJournal::read");
+    ReadPosition position;
+    if (!readAppended(path, position, contents, error))
+    {
+        return false;
+    }
+    spdlog::info("RecordingJournal: Read {} events from {}",
+                 contents.events.size(),
+                 path);
+    return true;
+}
+
+bool RecordingJournal::readAppended(const std::string& path,
+                                    ReadPosition& position,
+                                    RecordingJournalContents& contents,
+                                    std::string& error)
+{
+    contents = {};
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        error = "Failed to open journal: " + path;
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    // The header is read piece by piece, it is small next to the blocks
+    std::vector<uint8_t> header;
+    auto readHeader = [&](uint64_t size)
+    {
+        size_t start = header.size();
+        if (fileSize - start < size)
+        {
+            throw std::runtime_error("Journal is truncated");
+        }
+        header.resize(start + size);
+        file.read(reinterpret_cast<char*>(header.data() + start),
+                  static_cast<std::streamsize>(size));
+        if (!file)
+        {
+            throw std::runtime_error("Failed to read journal");
+        }
+    };
+
+    BinaryEventStorage decoder;
+    size_t offset = 0;
+    try
+    {
+        readHeader(2 * sizeof(uint32_t));
+        if (decoder.readBinary<uint32_t>(header, offset) != MAGIC_NUMBER)
+        {
+            error = "Not a recording journal: " + path;
+            return false;
+        }
+        uint32_t version = decoder.readBinary<uint32_t>(header, offset);
+        if (version != FORMAT_VERSION)
+        {
+            error = "Unsupported journal version " + std::to_string(version);
+            return false;
+        }
+
+        readHeader(sizeof(uint32_t));
+        uint32_t targetSize = decoder.readBinary<uint32_t>(header, offset);
+        readHeader(uint64_t{targetSize} + sizeof(uint32_t));
+        contents.targetPath.assign(
+            reinterpret_cast<const char*>(header.data() + offset), targetSize);
+        offset += targetSize;
+
+        uint32_t metadataSize = decoder.readBinary<uint32_t>(header, offset);
+        readHeader(metadataSize);
+        size_t metadataOffset = offset;
+        contents.metadata = decoder.deserializeMetadata(header, metadataOffset);
+    }
+    catch (const std::exception& e)
+    {
+        error = "Invalid journal header in " + path + ": " + e.what();
+        return false;
+    }
+
+    // A journal created again for another recording starts over
+    ReadPosition next = position;
+    const uint32_t checksum = crc32c(0, header.data(), header.size());
+    if (next.offset == 0)
+    {
+        next.offset = header.size();
+        next.headerChecksum = checksum;
+    }
+    else if (checksum != next.headerChecksum || fileSize < next.offset)
+    {
+        error = "Journal was replaced since it was last read: " + path;
+        return false;
+    }
+
+    std::vector<uint8_t> data(fileSize - next.offset);
+    file.seekg(static_cast<std::streamoff>(next.offset));
+    file.read(reinterpret_cast<char*>(data.data()),
+              static_cast<std::streamsize>(data.size()));
+    if (!file)
+    {
+        error = "Failed to read journal: " + path;
+        return false;
+    }
+
+    // Keep the complete blocks; a crash can only cut off the last one or
+    // leave it with bytes that were never written
+    offset = 0;
+    while (offset < data.size())
+    {
+        size_t blockStart = offset;
+        try
+        {
+            uint32_t eventCount = decoder.readBinary<uint32_t>(data, offset);
+            uint32_t size = decoder.readBinary<uint32_t>(data, offset);
+            uint32_t checksum =
+                crc32c(0, data.data() + blockStart, offset - blockStart);
+            uint32_t expected = decoder.readBinary<uint32_t>(data, offset);
+            if (data.size() - offset < size)
+            {
+                throw std::runtime_error("Block is truncated");
+            }
+            if (crc32c(checksum, data.data() + offset, size) != expected)
+            {
+                throw std::runtime_error("Block checksum mismatch");
+            }
+
+            std::vector<std::unique_ptr<Core::Event>> block;
+            block.reserve(eventCount);
+            size_t eventOffset = offset;
+            for (uint32_t i = 0; i < eventCount; ++i)
+            {
+                auto event = decoder.deserializeEvent(data, eventOffset);
+                if (!event || eventOffset > offset + size)
+                {
+                    throw std::runtime_error("Invalid event");
+                }
+                block.push_back(std::move(event));
+            }
+            contents.events.insert(contents.events.end(),
+                                   std::make_move_iterator(block.begin()),
+                                   std::make_move_iterator(block.end()));
+            offset += size;
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::warn("RecordingJournal: Ignoring the end of {} from byte "
+                         "{} on: {}",
+                         path,
+                         next.offset + blockStart,
+                         e.what());
+            contents.truncated = true;
+            offset = blockStart;
+            break;
+        }
+    }
+
+    next.offset += offset;
+    next.eventCount += contents.events.size();
+    position = next;
+    contents.metadata.totalEvents = position.eventCount;
+    return true;
+}
+
+std::string RecordingJournal::getLastError() const
+{
+    return m_lastError;
+}
+
+void RecordingJournal::setLastError(const std::string& error)
+{
+    m_lastError = error;
+    spdlog::error("RecordingJournal: {}", error);
+}
+
+} // namespace MouseRecorder::Storage
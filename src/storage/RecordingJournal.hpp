@@ -0,0 +1,165 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "core/IEventStorage.hpp"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief What a recording journal holds
+ */
+struct RecordingJournalContents
+{
+    // Recording the journal belongs to, empty if it was not saved yet
+    std::string targetPath;
+    Core::StorageMetadata metadata;
+    std::vector<std::unique_ptr<Core::Event>> events;
+
+    // Set if the journal ends in an incomplete or damaged block, e.g.
+    // because the application crashed while appending it; its events are
+    // lost
+    bool truncated{false};
+};
+
+/**
+ * @brief Append-only file of the events of a recording in progress
+ *
+ * Binary file format, all values little-endian:
+ * - Magic number (4 bytes): "MRJL"
+ * - Version (4 bytes)
+ * - Target path (length-prefixed string)
+ * - Metadata size (4 bytes) and metadata as in BinaryEventStorage
+ * - Blocks, each an event count (4 bytes), a size (4 bytes), the CRC32C
+ *   of the count, the size and the events (4 bytes) and size bytes of
+ *   events serialized as in BinaryEventStorage
+ *
+ * Appending a block never rewrites what is already in the file, so the
+ * cost of an append only depends on the number of new events.
+ */
+class RecordingJournal
+{
+  public:
+    static constexpr uint32_t MAGIC_NUMBER = 0x4C4A524D; // "MRJL"
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr const char* FILE_EXTENSION = ".autosave";
+
+    RecordingJournal() = default;
+    ~RecordingJournal();
+
+    RecordingJournal(const RecordingJournal&) = delete;
+    RecordingJournal& operator=(const RecordingJournal&) = delete;
+
+    /**
+     * @brief Path of the journal kept next to a recording
+     */
+    static std::string getJournalPath(const std::string& recordingPath);
+
+    /**
+     * @brief Create or truncate the journal and write its header
+     * @param path Path to the journal
+     * @param targetPath Recording the journal belongs to, may be empty
+     * @param metadata Metadata of the recording
+     * @return true if the journal was created
+     */
+    bool create(const std::string& path,
+                const std::string& targetPath,
+                const Core::StorageMetadata& metadata);
+
+    /**
+     * @brief Append a block of serialized events
+     * @param events Events serialized by BinaryEventStorage::serializeEvent
+     * @param eventCount Number of events in events
+     * @param sync Flush the journal to disk before returning
+     * @return true if the block was written
+     */
+    bool append(const std::vector<uint8_t>& events,
+                uint32_t eventCount,
+                bool sync);
+
+    /**
+     * @brief Close the journal, keeping the file
+     */
+    void close();
+
+    bool isOpen() const noexcept
+    {
+        return m_file.is_open();
+    }
+
+    const std::string& getPath() const noexcept
+    {
+        return m_path;
+    }
+
+    /**
+     * @brief Read the events of all complete blocks of a journal
+     * @param path Path to the journal
+     * @param contents Set to the journal content
+     * @param error Set to the failure reason
+     * @return true if the journal header could be read
+     */
+    static bool read(const std::string& path,
+                     RecordingJournalContents& contents,
+                     std::string& error);
+
+    /**
+     * @brief How far readAppended() got into a journal
+     */
+    struct ReadPosition
+    {
+        // Offset after the last complete block read, 0 before the first
+        // call
+        uint64_t offset{0};
+
+        // Events before offset
+        uint64_t eventCount{0};
+
+        // CRC32C of the header, to tell a journal created again from one
+        // that grew
+        uint32_t headerChecksum{0};
+    };
+
+    /**
+     * @brief Read the blocks appended to a journal since the last call
+     *
+     * For following a recording in progress; only the bytes after
+     * position are read. The last block may still be being appended, it
+     * is picked up by a later call.
+     * @param path Path to the journal
+     * @param position Where the last call stopped, advanced past the
+     * complete blocks read; unchanged on failure
+     * @param contents Set to the header and the events of the new blocks;
+     * metadata.totalEvents counts all events up to position
+     * @param error Set to the failure reason
+     * @return false if the journal cannot be read or was created again
+     * since position was taken
+     */
+    static bool readAppended(const std::string& path,
+                             ReadPosition& position,
+                             RecordingJournalContents& contents,
+                             std::string& error);
+
+    /**
+     * @brief Get the last error message if any operation failed
+     */
+    std::string getLastError() const;
+
+  private:
+    void setLastError(const std::string& error);
+
+    std::ofstream m_file;
+    std::string m_path;
+    std::string m_lastError;
+};
+
+} // namespace MouseRecorder::Storage
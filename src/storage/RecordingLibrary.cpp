@@ -0,0 +1,227 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "RecordingLibrary.hpp"
+#include "core/SpdlogConfig.hpp"
+#include "core/Tracing.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace MouseRecorder::Storage
+{
+
+RecordingLibrary::RecordingLibrary(std::string rootDirectory, bool recursive)
+    : m_rootDirectory(std::move(rootDirectory)), m_recursive(recursive)
+{
+}
+
+RecordingLibrary::~RecordingLibrary()
+{
+    stopScan();
+}
+
+void RecordingLibrary::setUpdateCallback(UpdateCallback callback)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_updateCallback = std::move(callback);
+}
+
+bool RecordingLibrary::startScan()
+{
+    if (m_scanning.load())
+    {
+        return false;
+    }
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    m_stopRequested = false;
+    m_scannedFiles = 0;
+    m_scanning = true;
+    m_thread = std::thread(&RecordingLibrary::scan, this);
+    return true;
+}
+
+void RecordingLibrary::stopScan()
+{
+    m_stopRequested = true;
+    waitForScan();
+}
+
+void RecordingLibrary::waitForScan()
+{
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+size_t RecordingLibrary::getRecordingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& [directory, entries] : m_directories)
+    {
+        count += entries.size();
+    }
+    return count;
+}
+
+std::vector<RecordingLibraryEntry> RecordingLibrary::getEntries() const
+{
+    return search({});
+}
+
+std::vector<RecordingLibraryEntry> RecordingLibrary::search(
+    const std::string& query) const
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingLibrary::search");
+    std::vector<RecordingLibraryEntry> result;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [directory, entries] : m_directories)
+    {
+        const fs::path directoryPath = fs::path(m_rootDirectory) / directory;
+        for (const auto& entry : entries)
+        {
+            if (RecordingIndex::matches(entry, query))
+            {
+                result.push_back(
+                    {(directoryPath / entry.fileName).string(), entry});
+            }
+        }
+    }
+    return result;
+}
+
+void RecordingLibrary::scan()
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "RecordingLibrary::scan");
+    spdlog::info("RecordingLibrary: Scanning {}", m_rootDirectory);
+
+    // Show what the index files know before checking any recording
+    std::vector<std::pair<std::string, RecordingIndex>> indexes;
+    std::map<std::string, std::vector<RecordingIndexEntry>> directories;
+    for (const auto& directory : collectDirectories())
+    {
+        RecordingIndex index((fs::path(m_rootDirectory) / directory).string());
+        index.setRecordingCache(m_recordingCache);
+        if (!index.load())
+        {
+            spdlog::warn("RecordingLibrary: Rebuilding index: {}",
+                         index.getLastError());
+        }
+        directories[directory] = index.getEntries();
+        indexes.emplace_back(directory, std::move(index));
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_directories = std::move(directories);
+    }
+    notify();
+
+    for (auto& [directory, index] : indexes)
+    {
+        if (m_stopRequested.load())
+        {
+            break;
+        }
+
+        index.update(this);
+        m_scannedFiles += index.getScannedFiles();
+        if (!index.isModified())
+        {
+            continue;
+        }
+
+        // An index that cannot be saved, e.g. on a read-only share, still
+        // serves this session
+        if (!index.save())
+        {
+            spdlog::warn("RecordingLibrary: {}", index.getLastError());
+        }
+        publish(directory, index.getEntries());
+    }
+
+    spdlog::info("RecordingLibrary: {} recordings in {}, {} scanned",
+                 getRecordingCount(),
+                 m_rootDirectory,
+                 m_scannedFiles.load());
+    m_scanning = false;
+    notify();
+}
+
+std::vector<std::string> RecordingLibrary::collectDirectories() const
+{
+    std::vector<std::string> directories{std::string{}};
+    if (!m_recursive)
+    {
+        return directories;
+    }
+
+    std::error_code error;
+    fs::recursive_directory_iterator it(
+        m_rootDirectory, fs::directory_options::skip_permission_denied, error);
+    for (fs::recursive_directory_iterator end; !error && it != end;
+         it.increment(error))
+    {
+        if (m_stopRequested.load())
+        {
+            break;
+        }
+
+        std::error_code ignored;
+        if (it->is_directory(ignored) && !it->is_symlink(ignored))
+        {
+            directories.push_back(
+                fs::relative(it->path(), m_rootDirectory).generic_string());
+        }
+    }
+    if (error)
+    {
+        spdlog::warn("RecordingLibrary: Failed to list {}: {}",
+                     m_rootDirectory,
+                     error.message());
+    }
+
+    std::sort(directories.begin(), directories.end());
+    return directories;
+}
+
+void RecordingLibrary::publish(const std::string& directory,
+                               const std::vector<RecordingIndexEntry>& entries)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_directories[directory] = entries;
+    }
+    notify();
+}
+
+void RecordingLibrary::notify()
+{
+    UpdateCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        callback = m_updateCallback;
+    }
+    if (callback)
+    {
+        callback();
+    }
+}
+
+bool RecordingLibrary::update(std::uint64_t done, std::uint64_t total)
+{
+    (void)done;
+    (void)total;
+    return !m_stopRequested.load();
+}
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,159 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "RecordingIndex.hpp"
+#include "core/StorageTask.hpp"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief A recording found by a RecordingLibrary
+ */
+struct RecordingLibraryEntry
+{
+    // Path to the recording
+    std::string path;
+
+    RecordingIndexEntry info;
+};
+
+/**
+ * @brief Browsable catalog of the recordings below a directory
+ *
+ * Keeps one RecordingIndex per directory. A scan on a background thread
+ * first loads the existing index files, which makes the library usable
+ * right away, and then brings each index up to date with the files on
+ * disk and saves it. Listing and searching only touch memory and may be
+ * called from any thread while a scan runs.
+ */
+class RecordingLibrary : private Core::StorageProgress
+{
+  public:
+    /**
+     * @brief Called on the scanner thread when entries changed and once
+     * when a scan has finished
+     */
+    using UpdateCallback = std::function<void()>;
+
+    /**
+     * @param rootDirectory Directory whose recordings are cataloged
+     * @param recursive Include the recordings of subdirectories
+     */
+    explicit RecordingLibrary(std::string rootDirectory,
+                              bool recursive = true);
+
+    /**
+     * @brief Stops a running scan and waits for it
+     */
+    ~RecordingLibrary() override;
+
+    RecordingLibrary(const RecordingLibrary&) = delete;
+    RecordingLibrary& operator=(const RecordingLibrary&) = delete;
+
+    void setUpdateCallback(UpdateCallback callback);
+
+    /**
+     * @brief Share a cache of decoded recordings with the scans, see
+     * RecordingIndex::setRecordingCache()
+     *
+     * Must not be called while a scan runs.
+     * @param cache Cache, which must outlive the library, or nullptr
+     */
+    void setRecordingCache(RecordingCache* cache) noexcept
+    {
+        m_recordingCache = cache;
+    }
+
+    /**
+     * @brief Start a scan on the background thread
+     * @return false if a scan is already running
+     */
+    bool startScan();
+
+    /**
+     * @brief Stop a running scan at the next file and wait for it
+     *
+     * Work done so far is kept and saved; the next scan continues with
+     * the files that were not scanned.
+     */
+    void stopScan();
+
+    /**
+     * @brief Wait until a running scan has finished
+     */
+    void waitForScan();
+
+    bool isScanning() const noexcept
+    {
+        return m_scanning.load();
+    }
+
+    /**
+     * @brief Number of recordings scanned by the current or last scan
+     */
+    size_t getScannedFiles() const noexcept
+    {
+        return m_scannedFiles.load();
+    }
+
+    size_t getRecordingCount() const;
+
+    /**
+     * @brief All recordings, sorted by path
+     */
+    std::vector<RecordingLibraryEntry> getEntries() const;
+
+    /**
+     * @brief Recordings matching a query, see RecordingIndex::search()
+     */
+    std::vector<RecordingLibraryEntry> search(const std::string& query) const;
+
+    const std::string& getRootDirectory() const noexcept
+    {
+        return m_rootDirectory;
+    }
+
+  private:
+    void scan();
+
+    /**
+     * @brief Directories to catalog, relative to the root
+     */
+    std::vector<std::string> collectDirectories() const;
+
+    void publish(const std::string& directory,
+                 const std::vector<RecordingIndexEntry>& entries);
+    void notify();
+
+    // StorageProgress interface, stops index updates
+    bool update(std::uint64_t done, std::uint64_t total) override;
+
+  private:
+    const std::string m_rootDirectory;
+    const bool m_recursive;
+
+    std::thread m_thread;
+    std::atomic<bool> m_scanning{false};
+    std::atomic<bool> m_stopRequested{false};
+    std::atomic<size_t> m_scannedFiles{0};
+
+    // Entries of each directory relative to the root, "" for the root
+    mutable std::mutex m_mutex;
+    std::map<std::string, std::vector<RecordingIndexEntry>> m_directories;
+    UpdateCallback m_updateCallback;
+    RecordingCache* m_recordingCache{nullptr};
+};
+
+} // namespace MouseRecorder::Storage
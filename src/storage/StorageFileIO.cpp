@@ -0,0 +1,414 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "StorageFileIO.hpp"
+#include "core/SpdlogConfig.hpp"
+#include "core/StorageTask.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <random>
+#include <system_error>
+#include <thread>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MouseRecorder::Storage
+{
+
+namespace
+{
+
+// Large enough that progress reports cost nothing, small enough that
+// cancellation takes effect quickly on slow disks
+constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+std::string errnoMessage()
+{
+    return std::error_code(errno, std::generic_category()).message();
+}
+
+/**
+ * @brief Flush a file, or a directory entry on POSIX systems, to disk
+ * @return empty string on success, else the failure reason
+ */
+std::string syncPath(const std::string& path, bool directory)
+{
+#ifdef _WIN32
+    if (directory)
+    {
+        // Renames are journaled by NTFS; directories cannot be flushed
+        return {};
+    }
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0)
+    {
+        return "Failed to open " + path + " for flushing: " + errnoMessage();
+    }
+    bool synced = _commit(fd) == 0;
+    std::string reason = synced ? std::string{} : errnoMessage();
+    _close(fd);
+#else
+    // Directories are opened and flushed like files
+    (void)directory;
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return "Failed to open " + path + " for flushing: " + errnoMessage();
+    }
+    bool synced = ::fsync(fd) == 0;
+    std::string reason = synced ? std::string{} : errnoMessage();
+    ::close(fd);
+#endif
+    if (!synced)
+    {
+        return "Failed to flush " + path + " to disk: " + reason;
+    }
+    return {};
+}
+
+/**
+ * @brief Background thread flushing files to disk
+ *
+ * A flush can take hundreds of milliseconds on a busy disk. Running all of
+ * them on one I/O thread keeps concurrent saves from competing for the
+ * disk, and keeps them off the threads that record and play events.
+ */
+class FileSyncThread
+{
+  public:
+    static FileSyncThread& instance()
+    {
+        static FileSyncThread thread;
+        return thread;
+    }
+
+    ~FileSyncThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_one();
+        m_thread.join();
+    }
+
+    FileSyncThread(const FileSyncThread&) = delete;
+    FileSyncThread& operator=(const FileSyncThread&) = delete;
+
+    /**
+     * @brief Queue a flush of path
+     * @return future of the failure reason, empty on success
+     */
+    std::future<std::string> sync(std::string path, bool directory)
+    {
+        std::packaged_task<std::string()> task(
+            [path = std::move(path), directory]()
+            { return syncPath(path, directory); });
+        std::future<std::string> result = task.get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(task));
+        }
+        m_condition.notify_one();
+        return result;
+    }
+
+  private:
+    FileSyncThread() : m_thread([this]() { run(); })
+    {
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_condition.wait(
+                lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_queue.empty())
+            {
+                return;
+            }
+
+            auto task = std::move(m_queue.front());
+            m_queue.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<std::packaged_task<std::string()>> m_queue;
+    bool m_stopping{false};
+
+    // Started last, once the queue exists
+    std::thread m_thread;
+};
+
+void removeTempFile(const std::string& tempPath)
+{
+    std::error_code ignored;
+    std::filesystem::remove(tempPath, ignored);
+}
+
+/**
+ * @brief Follow filename to the file it links to
+ *
+ * Replacing a symlink would turn it into a copy; replacing its target keeps
+ * the link. A dangling or unreadable link is replaced itself.
+ */
+std::string resolveSymlinks(const std::string& filename)
+{
+    std::error_code error;
+    if (!std::filesystem::is_symlink(
+            std::filesystem::symlink_status(filename, error)))
+    {
+        return filename;
+    }
+    std::filesystem::path target =
+        std::filesystem::weakly_canonical(filename, error);
+    return error ? filename : target.string();
+}
+
+/**
+ * @brief Give tempPath the permissions and, where allowed, the owner of
+ * filename before it takes its place
+ * @return empty string on success or if filename doesn't exist, else the
+ * failure reason
+ */
+std::string copyOwnerAndMode(const std::string& filename,
+                             const std::string& tempPath)
+{
+#ifdef _WIN32
+    // The replaced file's ACL is not carried over
+    (void)filename;
+    (void)tempPath;
+#else
+    struct stat info;
+    if (::stat(filename.c_str(), &info) != 0)
+    {
+        return errno == ENOENT ? std::string{}
+                               : "Failed to read permissions of " + filename +
+                                     ": " + errnoMessage();
+    }
+
+    // Only root may give a file away, so keep at least the group if the
+    // process is a member. Changing the owner may clear set-id bits, so the
+    // mode comes after
+    if (::chown(tempPath.c_str(), info.st_uid, info.st_gid) != 0)
+    {
+        if (errno != EPERM)
+        {
+            return "Failed to set the owner of " + tempPath + ": " +
+                   errnoMessage();
+        }
+        if (::chown(tempPath.c_str(), static_cast<uid_t>(-1), info.st_gid) !=
+            0)
+        {
+            spdlog::debug("StorageFileIO: Could not set the group of {}: {}",
+                          tempPath,
+                          errnoMessage());
+        }
+    }
+    if (::chmod(tempPath.c_str(), info.st_mode & 07777) != 0)
+    {
+        return "Failed to set permissions of " + tempPath + ": " +
+               errnoMessage();
+    }
+#endif
+    return {};
+}
+
+} // namespace
+
+std::string makeTempPath(const std::string& filename)
+{
+    thread_local std::mt19937 generator{std::random_device{}()};
+    char suffix[16];
+    std::snprintf(suffix,
+                  sizeof(suffix),
+                  ".%08x.tmp",
+                  static_cast<unsigned>(generator()));
+    return resolveSymlinks(filename) + suffix;
+}
+
+bool syncFile(const std::string& filename, std::string& error)
+{
+    std::string reason = syncPath(filename, false);
+    if (!reason.empty())
+    {
+        error = reason;
+        return false;
+    }
+    return true;
+}
+
+bool replaceFile(const std::string& tempPath,
+                 const std::string& filename,
+                 bool sync,
+                 std::string& error)
+{
+    const std::string target = resolveSymlinks(filename);
+    std::string reason = copyOwnerAndMode(target, tempPath);
+    if (!reason.empty())
+    {
+        removeTempFile(tempPath);
+        error = reason;
+        return false;
+    }
+
+    if (sync)
+    {
+        reason = FileSyncThread::instance().sync(tempPath, false).get();
+        if (!reason.empty())
+        {
+            removeTempFile(tempPath);
+            error = reason;
+            return false;
+        }
+    }
+
+    std::error_code renameError;
+    std::filesystem::rename(tempPath, target, renameError);
+    if (renameError)
+    {
+        removeTempFile(tempPath);
+        error = "Failed to replace " + target + ": " + renameError.message();
+        return false;
+    }
+
+    if (sync)
+    {
+        // Makes the rename itself durable; the new file is in place either
+        // way, so a failure here is not an error of the save
+        std::filesystem::path directory =
+            std::filesystem::path(target).parent_path();
+        reason = FileSyncThread::instance()
+                     .sync(directory.empty() ? "." : directory.string(), true)
+                     .get();
+        if (!reason.empty())
+        {
+            spdlog::warn("StorageFileIO: {}", reason);
+        }
+    }
+    return true;
+}
+
+bool writeFileWithProgress(const std::string& filename,
+                           std::string_view data,
+                           Core::StorageProgress* progress,
+                           bool sync,
+                           std::string& error)
+{
+    const std::string tempPath = makeTempPath(filename);
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        error = "Failed to open file for writing: " + filename;
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < data.size())
+    {
+        if (!Core::StorageProgress::report(progress, written, data.size()))
+        {
+            file.close();
+            removeTempFile(tempPath);
+            error = Core::StorageProgress::CANCELLED_ERROR;
+            return false;
+        }
+
+        size_t chunk = std::min(CHUNK_SIZE, data.size() - written);
+        file.write(data.data() + written, static_cast<std::streamsize>(chunk));
+        if (!file)
+        {
+            file.close();
+            removeTempFile(tempPath);
+            error = "Failed to write data to file: " + filename;
+            return false;
+        }
+        written += chunk;
+    }
+
+    file.close();
+    if (file.fail())
+    {
+        removeTempFile(tempPath);
+        error = "Failed to write data to file: " + filename;
+        return false;
+    }
+    if (!replaceFile(tempPath, filename, sync, error))
+    {
+        return false;
+    }
+    Core::StorageProgress::report(progress, data.size(), data.size());
+    return true;
+}
+
+bool readFileWithProgress(const std::string& filename,
+                          std::string& data,
+                          Core::StorageProgress* progress,
+                          std::string& error)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        error = "Failed to open file for reading: " + filename;
+        return false;
+    }
+
+    const std::streamoff size = file.tellg();
+    if (size < 0)
+    {
+        error = "Failed to read file: " + filename;
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+
+    const size_t total = static_cast<size_t>(size);
+    data.resize(total);
+    size_t read = 0;
+    while (read < total)
+    {
+        if (!Core::StorageProgress::report(progress, read, total))
+        {
+            data.clear();
+            error = Core::StorageProgress::CANCELLED_ERROR;
+            return false;
+        }
+
+        size_t chunk = std::min(CHUNK_SIZE, total - read);
+        file.read(data.data() + read, static_cast<std::streamsize>(chunk));
+        if (!file)
+        {
+            data.clear();
+            error = "Failed to read file: " + filename;
+            return false;
+        }
+        read += chunk;
+    }
+
+    Core::StorageProgress::report(progress, total, total);
+    return true;
+}
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,90 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace MouseRecorder::Core
+{
+class StorageProgress;
+}
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Path for a temporary file next to filename
+ *
+ * Unique per call, so concurrent saves of the same file don't collide. A
+ * symlink is followed, so the path is next to the file it links to.
+ */
+std::string makeTempPath(const std::string& filename);
+
+/**
+ * @brief Flush a file to disk on the calling thread
+ * @param filename Path to the file
+ * @param error Set to the failure reason
+ * @return true if the file content is on disk
+ */
+bool syncFile(const std::string& filename, std::string& error);
+
+/**
+ * @brief Replace filename with a completely written temporary file
+ *
+ * With sync set, the temporary file is flushed to disk on the background
+ * I/O thread before it is renamed over filename, and the directory after
+ * that, so a crash or power failure leaves either the old or the new file.
+ * Without sync, only crashes of the application are covered. The
+ * temporary file is removed if the replacement fails.
+ *
+ * If filename is a symlink, the file it links to is replaced and the link
+ * stays. The new file gets the permissions of the one it replaces, and its
+ * owner and group where the process may set them.
+ * @param tempPath Path returned by makeTempPath(filename)
+ * @param filename Path of the file to replace or create
+ * @param sync Flush the data to disk before the rename
+ * @param error Set to the failure reason
+ * @return true if filename now has the new content
+ */
+bool replaceFile(const std::string& tempPath,
+                 const std::string& filename,
+                 bool sync,
+                 std::string& error);
+
+/**
+ * @brief Write a file in chunks, reporting bytes written as progress
+ *
+ * The data goes to a temporary file that replaces filename once it is
+ * complete, see replaceFile(). A cancelled or failed write leaves an
+ * existing file untouched.
+ * @param filename Path to the output file
+ * @param data File content
+ * @param progress Optional progress sink
+ * @param sync Flush the data to disk before replacing filename
+ * @param error Set to the failure reason
+ * @return true if the whole file was written
+ */
+bool writeFileWithProgress(const std::string& filename,
+                           std::string_view data,
+                           Core::StorageProgress* progress,
+                           bool sync,
+                           std::string& error);
+
+/**
+ * @brief Read a file in chunks, reporting bytes read as progress
+ * @param filename Path to the input file
+ * @param data Set to the file content
+ * @param progress Optional progress sink
+ * @param error Set to the failure reason
+ * @return true if the whole file was read
+ */
+bool readFileWithProgress(const std::string& filename,
+                          std::string& data,
+                          Core::StorageProgress* progress,
+                          std::string& error);
+
+} // namespace MouseRecorder::Storage
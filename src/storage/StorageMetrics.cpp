@@ -0,0 +1,42 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "StorageMetrics.hpp"
+#include "core/Metrics.hpp"
+
+namespace MouseRecorder::Storage
+{
+
+void recordStorageOperation(const char* format,
+                            const char* operation,
+                            std::uint64_t bytes,
+                            std::chrono::steady_clock::time_point start)
+{
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    // Saves and loads are rare, so the registry lookup per call is fine
+    auto& registry = Core::MetricsRegistry::instance();
+    Core::MetricLabels labels = {{"format", format}, {"operation", operation}};
+
+    registry
+        .counter(Core::MetricNames::STORAGE_BYTES,
+                 "Bytes written or read by event storage",
+                 labels)
+        .increment(bytes);
+    registry
+        .counter(Core::MetricNames::STORAGE_OPERATIONS,
+                 "Completed event storage saves and loads",
+                 labels)
+        .increment();
+    registry
+        .histogram(Core::MetricNames::STORAGE_DURATION,
+                   "Time taken by event storage saves and loads",
+                   Core::MetricsRegistry::durationBuckets(),
+                   labels)
+        .observe(elapsed.count());
+}
+
+} // namespace MouseRecorder::Storage
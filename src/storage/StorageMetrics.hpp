@@ -0,0 +1,26 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Record a completed save or load in the metrics registry
+ * @param format Storage format label, e.g. "json"
+ * @param operation "save" or "load"
+ * @param bytes Bytes written or read
+ * @param start Time the operation started
+ */
+void recordStorageOperation(const char* format,
+                            const char* operation,
+                            std::uint64_t bytes,
+                            std::chrono::steady_clock::time_point start);
+
+} // namespace MouseRecorder::Storage
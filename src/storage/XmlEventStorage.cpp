@@ -8,6 +8,16 @@
 #include "core/serialization/EventSerializerFactory.hpp"
 #include <fstream>
 #include "core/SpdlogConfig.hpp"
+#include "core/Tracing.hpp"
+#include "core/StorageTask.hpp"
+#include "EventRangeFilter.hpp"
+#include "StorageFileIO.hpp"
+#include "StorageMetrics.hpp"
+#include "XmlStreamUtils.hpp"
+#include <QFile>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <iterator>
 
 namespace MouseRecorder::Storage
 {
@@ -49,6 +59,8 @@ bool XmlEventStorage::saveEvents(
     const std::string& filename,
     const Core::StorageMetadata& metadata)
 {
+    MOUSERECORDER_TRACE_SCOPE("storage", "XmlEventStorage::saveEvents");
+    auto startTime = std::chrono::steady_clock::now();
     if (!m_serializer)
     {
         setLastError("No serializer available");
@@ -60,26 +72,24 @@ bool XmlEventStorage::saveEvents(
         spdlog::debug(
             "XmlEventStorage: Saving {} events to {}", events.size(), filename);
 
+        // Store the statistics with the metadata
+        Core::StorageMetadata fileMetadata = metadata;
+        fileMetadata.statistics = Core::RecordingStatistics::fromEvents(events);
+
         // Serialize events to XML string
-        std::string xmlData = m_serializer->serializeEvents(events, metadata);
+        std::string xmlData =
+            m_serializer->serializeEvents(events, fileMetadata);
 
         // Write to file
-        std::ofstream file(filename);
-        if (!file.is_open())
-        {
-            setLastError("Failed to open file for writing: " + filename);
-            return false;
-        }
-
-        file << xmlData;
-        file.close();
-
-        if (file.fail())
+        std::string error;
+        if (!writeFileWithProgress(
+                filename, xmlData, m_progress, m_syncOnSave, error))
         {
-            setLastError("Failed to write data to file: " + filename);
+            setLastError(error);
             return false;
         }
 
+        recordStorageOperation("xml", "save", xmlData.size(), startTime);
         spdlog::info("XmlEventStorage: Successfully saved {} events to {}",
                      events.size(),
                      filename);
@@ -97,6 +107,8 @@ bool XmlEventStorage::loadEvents(
     std::vector<std::unique_ptr<Core::Event>>& events,
     Core::StorageMetadata& metadata)
 {
+    MOUSERECORDER_TRACE_SCOPE("storage", "XmlEventStorage::loadEvents");
+    auto startTime = std::chrono::steady_clock::now();
     if (!m_serializer)
     {
         setLastError("No serializer available");
@@ -107,36 +119,47 @@ bool XmlEventStorage::loadEvents(
     {
         spdlog::debug("XmlEventStorage: Loading events from {}", filename);
 
-        // Read file content
-        std::ifstream file(filename);
-        if (!file.is_open())
+        XmlDocumentLayout layout;
+        if (!detectXmlLayout(*m_serializer, layout))
         {
-            setLastError("Failed to open file for reading: " + filename);
+            setLastError("Failed to determine the XML layout of the "
+                         "serializer");
             return false;
         }
 
-        std::string fileContent((std::istreambuf_iterator<char>(file)),
-                                std::istreambuf_iterator<char>());
-        file.close();
+        QFile file(QString::fromStdString(filename));
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            setLastError("Failed to open file for reading: " + filename);
+            return false;
+        }
 
-        if (file.fail())
+        // Hand out the metadata before the events wherever it is stored
+        metadata = {};
+        if (!readMetadata(file, layout, metadata))
         {
-            setLastError("Failed to read file: " + filename);
             return false;
         }
+        if (m_progress)
+        {
+            m_progress->metadataLoaded(metadata);
+        }
 
-        // Clear existing events
+        if (!file.seek(0))
+        {
+            setLastError("Failed to rewind file: " + filename);
+            return false;
+        }
         events.clear();
-
-        // Deserialize events
-        if (!m_serializer->deserializeEvents(fileContent, events, metadata))
+        if (!readEvents(file, layout, events))
         {
-            setLastError("Failed to deserialize events from XML");
+            events.clear();
             return false;
         }
 
-        spdlog::info("XmlEventStorage: Successfully loaded {} events from {}",
-                     events.size(),
+        recordStorageOperation(
+            "xml", "load", static_cast<size_t>(file.size()), startTime);
+        spdlog::info("XmlEventStorage: Successfully loaded events from {}",
                      filename);
         return true;
     }
@@ -148,6 +171,199 @@ bool XmlEventStorage::loadEvents(
     }
 }
 
+bool XmlEventStorage::loadEventsRange(
+    const std::string& filename,
+    const Core::EventRange& range,
+    std::vector<std::unique_ptr<Core::Event>>& events,
+    Core::StorageMetadata& metadata)
+{
+    MOUSERECORDER_TRACE_SCOPE("storage", "XmlEventStorage::loadEventsRange");
+    if (!loadEventsRangeStreaming(
+            *this, m_progress, filename, range, events, metadata))
+    {
+        return false;
+    }
+
+    // Stopping after the range is not an error
+    m_lastError.clear();
+    spdlog::info("XmlEventStorage: Loaded {} events of a range from {}",
+                 events.size(),
+                 filename);
+    return true;
+}
+
+bool XmlEventStorage::openDocument(QXmlStreamReader& reader,
+                                   const XmlDocumentLayout& layout) const
+{
+    if (!reader.readNextStartElement())
+    {
+        setLastError(reader.hasError() ? xmlReaderError(reader)
+                                       : "Invalid XML: no root element");
+        return false;
+    }
+    if (reader.name() != layout.root)
+    {
+        setLastError("Invalid XML: root element should be '" +
+                     layout.root.toStdString() + "'");
+        return false;
+    }
+    return true;
+}
+
+bool XmlEventStorage::readMetadata(QIODevice& input,
+                                   const XmlDocumentLayout& layout,
+                                   Core::StorageMetadata& metadata) const
+{
+    QXmlStreamReader reader(&input);
+    if (!openDocument(reader, layout))
+    {
+        return false;
+    }
+
+    while (reader.readNextStartElement())
+    {
+        if (reader.name() != layout.metadata)
+        {
+            reader.skipCurrentElement();
+            continue;
+        }
+
+        QString document;
+        {
+            QXmlStreamWriter writer(&document);
+            writer.writeStartElement(layout.root);
+            if (!copyXmlElement(reader, writer))
+            {
+                break;
+            }
+            writer.writeEndElement();
+        }
+
+        std::vector<std::unique_ptr<Core::Event>> none;
+        if (!m_serializer->deserializeEvents(
+                document.toStdString(), none, metadata))
+        {
+            setLastError("Failed to deserialize metadata from XML: " +
+                         m_serializer->getLastError());
+            return false;
+        }
+        return true;
+    }
+
+    if (reader.hasError())
+    {
+        setLastError(xmlReaderError(reader));
+        return false;
+    }
+    return true;
+}
+
+bool XmlEventStorage::readEvents(
+    QIODevice& input,
+    const XmlDocumentLayout& layout,
+    std::vector<std::unique_ptr<Core::Event>>& events)
+{
+    const qint64 size = input.size();
+    QXmlStreamReader reader(&input);
+    if (!openDocument(reader, layout))
+    {
+        return false;
+    }
+
+    while (reader.readNextStartElement())
+    {
+        if (reader.name() != layout.events)
+        {
+            reader.skipCurrentElement();
+            continue;
+        }
+
+        // Copy the events of a batch into a document of their own
+        QString batch;
+        size_t batched = 0;
+        while (reader.readNextStartElement())
+        {
+            if (reader.name() != layout.event)
+            {
+                reader.skipCurrentElement();
+                continue;
+            }
+
+            QXmlStreamWriter writer(&batch);
+            if (!copyXmlElement(reader, writer))
+            {
+                break;
+            }
+            if (++batched < PROGRESS_INTERVAL)
+            {
+                continue;
+            }
+
+            if (!decodeEvents(batch, layout, events))
+            {
+                return false;
+            }
+            batched = 0;
+
+            if (m_progress)
+            {
+                m_progress->eventsLoaded(events);
+            }
+            if (!Core::StorageProgress::report(
+                    m_progress, static_cast<uint64_t>(input.pos()), size))
+            {
+                setLastError(Core::StorageProgress::CANCELLED_ERROR);
+                return false;
+            }
+        }
+
+        if (!reader.hasError() && batched > 0 &&
+            !decodeEvents(batch, layout, events))
+        {
+            return false;
+        }
+    }
+
+    // Read past the root element so trailing garbage is found too
+    while (!reader.atEnd())
+    {
+        reader.readNext();
+    }
+    if (reader.hasError())
+    {
+        setLastError(xmlReaderError(reader));
+        return false;
+    }
+
+    Core::StorageProgress::report(m_progress, size, size);
+    return true;
+}
+
+bool XmlEventStorage::decodeEvents(
+    QString& batch,
+    const XmlDocumentLayout& layout,
+    std::vector<std::unique_ptr<Core::Event>>& events)
+{
+    QString document = QString("<%1><%2>%3</%2></%1>")
+                           .arg(layout.root, layout.events, batch);
+    batch.clear();
+
+    std::vector<std::unique_ptr<Core::Event>> decoded;
+    Core::StorageMetadata unused;
+    if (!m_serializer->deserializeEvents(
+            document.toStdString(), decoded, unused))
+    {
+        setLastError("Failed to deserialize events from XML: " +
+                     m_serializer->getLastError());
+        return false;
+    }
+
+    events.insert(events.end(),
+                  std::make_move_iterator(decoded.begin()),
+                  std::make_move_iterator(decoded.end()));
+    return true;
+}
+
 Core::StorageFormat XmlEventStorage::getSupportedFormat() const noexcept
 {
     return Core::StorageFormat::Xml;
@@ -200,21 +416,21 @@ bool XmlEventStorage::getFileMetadata(const std::string& filename,
 
     try
     {
-        std::ifstream file(filename);
-        if (!file.is_open())
+        XmlDocumentLayout layout;
+        if (!detectXmlLayout(*m_serializer, layout))
         {
             return false;
         }
 
-        // Read entire file into string
-        std::string fileContent((std::istreambuf_iterator<char>(file)),
-                                std::istreambuf_iterator<char>());
-        file.close();
+        QFile file(QString::fromStdString(filename));
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return false;
+        }
 
-        // Use a temporary vector to deserialize and get metadata
-        std::vector<std::unique_ptr<Core::Event>> tempEvents;
-        return m_serializer->deserializeEvents(
-            fileContent, tempEvents, metadata);
+        // Only the metadata element is decoded, the events are skipped
+        metadata = {};
+        return readMetadata(file, layout, metadata);
     }
     catch (const std::exception&)
     {
@@ -222,6 +438,11 @@ bool XmlEventStorage::getFileMetadata(const std::string& filename,
     }
 }
 
+void XmlEventStorage::setProgress(Core::StorageProgress* progress)
+{
+    m_progress = progress;
+}
+
 std::string XmlEventStorage::getLastError() const
 {
     return m_lastError;
@@ -239,9 +460,19 @@ bool XmlEventStorage::supportsCompression() const noexcept
     return false; // XML itself doesn't support compression
 }
 
-void XmlEventStorage::setLastError(const std::string& error)
+void XmlEventStorage::setSyncOnSave(bool sync)
+{
+    m_syncOnSave = sync;
+}
+
+void XmlEventStorage::setLastError(const std::string& error) const
 {
     m_lastError = error;
+    if (error == Core::StorageProgress::CANCELLED_ERROR)
+    {
+        spdlog::info("XmlEventStorage: {}", error);
+        return;
+    }
     spdlog::error("XmlEventStorage: {}", error);
 }
 
@@ -9,15 +9,25 @@
 #include "core/serialization/IEventSerializer.hpp"
 #include <memory>
 
+class QIODevice;
+class QString;
+class QXmlStreamReader;
+
 namespace MouseRecorder::Storage
 {
 
+struct XmlDocumentLayout;
+
 /**
  * @brief XML implementation of event storage
  *
  * This class handles saving and loading events in XML format using
  * the abstract serialization framework. It can work with Qt's XML
  * serialization or third-party libraries like pugixml.
+ *
+ * Loading reads the file with a stream reader and decodes the events in
+ * batches, so a progress sink can take them while the rest of the file
+ * is still on disk.
  */
 class XmlEventStorage : public Core::IEventStorage
 {
@@ -45,26 +55,73 @@ class XmlEventStorage : public Core::IEventStorage
                     std::vector<std::unique_ptr<Core::Event>>& events,
                     Core::StorageMetadata& metadata) override;
 
+    bool loadEventsRange(const std::string& filename,
+                         const Core::EventRange& range,
+                         std::vector<std::unique_ptr<Core::Event>>& events,
+                         Core::StorageMetadata& metadata) override;
+
     Core::StorageFormat getSupportedFormat() const noexcept override;
     std::string getFileExtension() const noexcept override;
     std::string getFormatDescription() const noexcept override;
     bool validateFile(const std::string& filename) const override;
     bool getFileMetadata(const std::string& filename,
                          Core::StorageMetadata& metadata) const override;
+    void setProgress(Core::StorageProgress* progress) override;
     std::string getLastError() const override;
     void setCompressionLevel(int level) override;
     bool supportsCompression() const noexcept override;
+    void setSyncOnSave(bool sync) override;
 
   private:
+    // Events decoded between progress reports
+    static constexpr size_t PROGRESS_INTERVAL = 4096;
+
+    /**
+     * @brief Position reader inside the root element of a document
+     */
+    bool openDocument(QXmlStreamReader& reader,
+                      const XmlDocumentLayout& layout) const;
+
+    /**
+     * @brief Find and decode the metadata element of a document
+     *
+     * Leaves metadata unchanged if the document has none.
+     */
+    bool readMetadata(QIODevice& input,
+                      const XmlDocumentLayout& layout,
+                      Core::StorageMetadata& metadata) const;
+
+    /**
+     * @brief Decode the event elements of a document in batches
+     * @param input Document
+     * @param layout Element names of the serializer
+     * @param events Output vector, handed to the progress sink per batch
+     */
+    bool readEvents(QIODevice& input,
+                    const XmlDocumentLayout& layout,
+                    std::vector<std::unique_ptr<Core::Event>>& events);
+
+    /**
+     * @brief Decode a batch of copied event elements
+     * @param batch Event elements, cleared afterwards
+     * @param layout Element names of the serializer
+     * @param events Decoded events are appended here
+     */
+    bool decodeEvents(QString& batch,
+                      const XmlDocumentLayout& layout,
+                      std::vector<std::unique_ptr<Core::Event>>& events);
+
     /**
      * @brief Set last error message
      * @param error Error message
      */
-    void setLastError(const std::string& error);
+    void setLastError(const std::string& error) const;
 
   private:
     mutable std::string m_lastError;
     std::unique_ptr<Core::Serialization::IEventSerializer> m_serializer;
+    Core::StorageProgress* m_progress{nullptr};
+    bool m_syncOnSave{true};
 };
 
 } // namespace MouseRecorder::Storage
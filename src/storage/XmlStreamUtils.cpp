@@ -0,0 +1,78 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "XmlStreamUtils.hpp"
+#include "core/Event.hpp"
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+namespace MouseRecorder::Storage
+{
+
+bool detectXmlLayout(const Core::Serialization::IEventSerializer& serializer,
+                     XmlDocumentLayout& layout)
+{
+    std::vector<std::unique_ptr<Core::Event>> sample;
+    sample.push_back(Core::EventFactory::createMouseMoveEvent({0, 0}));
+
+    QXmlStreamReader reader(
+        QString::fromStdString(serializer.serializeEvents(sample, {}, false)));
+    if (!reader.readNextStartElement())
+    {
+        return false;
+    }
+    layout.root = reader.name().toString();
+
+    // The events element is the one with children
+    while (reader.readNextStartElement())
+    {
+        QString name = reader.name().toString();
+        if (reader.readNextStartElement())
+        {
+            layout.events = name;
+            layout.event = reader.name().toString();
+            reader.skipCurrentElement();
+            reader.skipCurrentElement();
+        }
+        else
+        {
+            // Already on the end element of the childless element
+            layout.metadata = name;
+        }
+    }
+
+    return !reader.hasError() && !layout.metadata.isEmpty() &&
+           !layout.events.isEmpty();
+}
+
+bool copyXmlElement(QXmlStreamReader& reader, QXmlStreamWriter& writer)
+{
+    int depth = 0;
+    while (!reader.atEnd() && !reader.hasError())
+    {
+        writer.writeCurrentToken(reader);
+        if (reader.isStartElement())
+        {
+            ++depth;
+        }
+        else if (reader.isEndElement() && --depth == 0)
+        {
+            return true;
+        }
+        reader.readNext();
+    }
+    return false;
+}
+
+std::string xmlReaderError(const QXmlStreamReader& reader)
+{
+    return QString("XML parse error at line %1, column %2: %3")
+        .arg(reader.lineNumber())
+        .arg(reader.columnNumber())
+        .arg(reader.errorString())
+        .toStdString();
+}
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,55 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+
+#include "core/serialization/IEventSerializer.hpp"
+#include <QString>
+#include <string>
+
+class QXmlStreamReader;
+class QXmlStreamWriter;
+
+namespace MouseRecorder::Storage
+{
+
+/**
+ * @brief Element names a serializer uses for its XML documents
+ *
+ * Documents consist of a root element holding a metadata element and an
+ * events element, which holds one element per event. Only the names
+ * differ between serializers.
+ */
+struct XmlDocumentLayout
+{
+    QString root;
+    QString metadata;
+    QString events;
+    QString event;
+};
+
+/**
+ * @brief Find the element names of a serializer from a sample document
+ * @param serializer XML serializer
+ * @param layout Set to the element names
+ * @return false if the sample does not have the expected structure
+ */
+bool detectXmlLayout(const Core::Serialization::IEventSerializer& serializer,
+                     XmlDocumentLayout& layout);
+
+/**
+ * @brief Copy the element reader is positioned on, including its content
+ *
+ * Leaves reader on the end element.
+ * @return false if the input ended or is not well-formed
+ */
+bool copyXmlElement(QXmlStreamReader& reader, QXmlStreamWriter& writer);
+
+/**
+ * @brief Describe the parse error of reader
+ */
+std::string xmlReaderError(const QXmlStreamReader& reader);
+
+} // namespace MouseRecorder::Storage
@@ -0,0 +1,264 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include "version.hpp"
+#include "core/SpdlogConfig.hpp"
+#include "storage/EventStorageFactory.hpp"
+#include "storage/EventTranscoder.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <thread>
+
+namespace fs = std::filesystem;
+using MouseRecorder::Core::StorageFormat;
+using MouseRecorder::Storage::EventStorageFactory;
+using MouseRecorder::Storage::EventTranscoder;
+using MouseRecorder::Storage::TranscodeJob;
+using MouseRecorder::Storage::TranscodeOptions;
+
+namespace
+{
+
+std::optional<StorageFormat> parseFormat(const std::string& name)
+{
+    if (name == "json")
+    {
+        return StorageFormat::Json;
+    }
+    if (name == "xml")
+    {
+        return StorageFormat::Xml;
+    }
+    if (name == "binary" || name == "mre")
+    {
+        return StorageFormat::Binary;
+    }
+    if (name == "columnar" || name == "mrc")
+    {
+        return StorageFormat::Columnar;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Map the recordings in inputDir to files of the same name and
+ * relative path in outputDir
+ *
+ * Creates the output directories, so the workers never race on them.
+ */
+std::vector<TranscodeJob> collectJobs(const fs::path& inputDir,
+                                      const fs::path& outputDir,
+                                      StorageFormat format,
+                                      bool recursive,
+                                      bool skipExisting)
+{
+    std::vector<fs::path> inputs;
+    auto collect = [&inputs](const fs::directory_entry& entry)
+    {
+        if (entry.is_regular_file() &&
+            EventStorageFactory::getFormatFromExtension(
+                entry.path().extension().string()))
+        {
+            inputs.push_back(entry.path());
+        }
+    };
+    if (recursive)
+    {
+        for (const auto& entry : fs::recursive_directory_iterator(inputDir))
+        {
+            collect(entry);
+        }
+    }
+    else
+    {
+        for (const auto& entry : fs::directory_iterator(inputDir))
+        {
+            collect(entry);
+        }
+    }
+    std::sort(inputs.begin(), inputs.end());
+
+    std::vector<TranscodeJob> jobs;
+    for (const auto& input : inputs)
+    {
+        fs::path output = outputDir / fs::relative(input, inputDir);
+        output.replace_extension(EventStorageFactory::getFileExtension(format));
+        if (fs::weakly_canonical(output) == fs::weakly_canonical(input) ||
+            (skipExisting && fs::exists(output)))
+        {
+            continue;
+        }
+
+        fs::create_directories(output.parent_path());
+        TranscodeJob job;
+        job.input = input.string();
+        job.output = output.string();
+        jobs.push_back(std::move(job));
+    }
+    return jobs;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("MouseRecorderTranscode");
+    app.setApplicationVersion(MouseRecorder::Version::VERSION_STRING);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Convert MouseRecorder recordings between storage formats without "
+        "loading them into memory as a whole");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("input",
+                                 "Recording or directory of recordings");
+    parser.addPositionalArgument(
+        "output", "Output file, or directory for a directory input");
+
+    QCommandLineOption formatOption(
+        QStringList() << "f"
+                      << "format",
+        "Output format (json, xml, binary, columnar)",
+        "format",
+        "binary");
+    parser.addOption(formatOption);
+
+    QCommandLineOption jobsOption(
+        QStringList() << "j"
+                      << "jobs",
+        "Number of files converted in parallel (default: all cores)",
+        "count");
+    parser.addOption(jobsOption);
+
+    QCommandLineOption optimizeOption(
+        QStringList() << "optimize", "Optimize mouse movements on the way");
+    parser.addOption(optimizeOption);
+
+    QCommandLineOption detectLoopsOption(
+        QStringList() << "detect-loops",
+        "Store repeated segments once (binary output only)");
+    parser.addOption(detectLoopsOption);
+
+    QCommandLineOption recursiveOption(QStringList() << "r"
+                                                     << "recursive",
+                                       "Include subdirectories of the input");
+    parser.addOption(recursiveOption);
+
+    QCommandLineOption skipExistingOption(
+        QStringList() << "skip-existing",
+        "Skip recordings whose output file already exists");
+    parser.addOption(skipExistingOption);
+
+    QCommandLineOption logLevelOption(
+        QStringList() << "l"
+                      << "log-level",
+        "Set log level (trace, debug, info, warn, error, critical, off)",
+        "level",
+        "warn");
+    parser.addOption(logLevelOption);
+
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 2)
+    {
+        parser.showHelp(2);
+    }
+
+    spdlog::set_level(
+        spdlog::level::from_str(parser.value(logLevelOption).toStdString()));
+
+    TranscodeOptions options;
+    auto format = parseFormat(parser.value(formatOption).toStdString());
+    if (!format)
+    {
+        std::cerr << "Unknown output format: "
+                  << parser.value(formatOption).toStdString() << std::endl;
+        return 2;
+    }
+    options.outputFormat = *format;
+    options.optimize = parser.isSet(optimizeOption);
+    options.detectLoops = parser.isSet(detectLoopsOption);
+    if (options.detectLoops && options.outputFormat != StorageFormat::Binary)
+    {
+        std::cerr << "--detect-loops needs the binary output format"
+                  << std::endl;
+        return 2;
+    }
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    if (parser.isSet(jobsOption))
+    {
+        bool ok = false;
+        threads = parser.value(jobsOption).toUInt(&ok);
+        if (!ok || threads == 0)
+        {
+            std::cerr << "Invalid number of jobs" << std::endl;
+            return 2;
+        }
+    }
+
+    const fs::path input = arguments[0].toStdString();
+    const fs::path output = arguments[1].toStdString();
+
+    std::vector<TranscodeJob> jobs;
+    try
+    {
+        if (fs::is_directory(input))
+        {
+            jobs = collectJobs(input,
+                               output,
+                               options.outputFormat,
+                               parser.isSet(recursiveOption),
+                               parser.isSet(skipExistingOption));
+        }
+        else
+        {
+            // Writing would truncate the file while it is being read
+            if (fs::weakly_canonical(output) == fs::weakly_canonical(input))
+            {
+                std::cerr << "Output is the input file: " << input.string()
+                          << std::endl;
+                return 2;
+            }
+
+            TranscodeJob job;
+            job.input = input.string();
+            job.output = output.string();
+            jobs.push_back(std::move(job));
+        }
+    }
+    catch (const fs::filesystem_error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    size_t failures = EventTranscoder::transcodeFiles(jobs, options, threads);
+
+    size_t eventsRead = 0;
+    size_t eventsWritten = 0;
+    for (const auto& job : jobs)
+    {
+        if (!job.success)
+        {
+            std::cerr << job.input << ": " << job.error << std::endl;
+        }
+        eventsRead += job.eventsRead;
+        eventsWritten += job.eventsWritten;
+    }
+
+    std::cout << "Transcoded " << jobs.size() - failures << " of "
+              << jobs.size() << " recordings (" << eventsRead
+              << " events read, " << eventsWritten << " written)"
+              << std::endl;
+    return failures == 0 ? 0 : 1;
+}
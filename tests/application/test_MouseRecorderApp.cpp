@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 #include "application/MouseRecorderApp.hpp"
 #include "core/Event.hpp"
+#include "core/QtConfiguration.hpp"
 #include <filesystem>
 #include <fstream>
 
@@ -91,6 +92,17 @@ TEST_F(MouseRecorderAppTest, InitializationWithConfig)
     EXPECT_DOUBLE_EQ(config.getDouble("playback.default_speed", 0.0), 1.0);
 }
 
+TEST_F(MouseRecorderAppTest, RecordingCacheBudgetFollowsConfiguration)
+{
+    ASSERT_TRUE(m_app->initialize(m_testConfigFile));
+
+    auto& config = dynamic_cast<QtConfiguration&>(m_app->getConfiguration());
+    config.setInt(ConfigKeys::RECORDING_CACHE_MB, 3);
+    config.flush();
+
+    EXPECT_EQ(m_app->getRecordingCache().getBudget(), 3u * 1024 * 1024);
+}
+
 TEST_F(MouseRecorderAppTest, DoubleInitialization)
 {
     EXPECT_TRUE(m_app->initialize());
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "core/Clock.hpp"
+#include <thread>
+#include <vector>
+
+using namespace MouseRecorder::Core;
+using namespace std::chrono_literals;
+
+TEST(ClockTest, SystemClockFollowsSteadyClock)
+{
+    auto& clock = SystemClock::instance();
+    auto before = std::chrono::steady_clock::now();
+    auto now = clock.now();
+    auto after = std::chrono::steady_clock::now();
+
+    EXPECT_LE(before, now);
+    EXPECT_LE(now, after);
+}
+
+TEST(ClockTest, SystemClockSleeps)
+{
+    auto& clock = SystemClock::instance();
+    auto start = clock.now();
+    clock.sleepFor(5ms);
+    EXPECT_GE(clock.now() - start, 5ms);
+
+    // Non-positive durations return immediately
+    clock.sleepFor(-1s);
+    clock.sleepFor(IClock::Duration::zero());
+}
+
+TEST(ClockTest, VirtualClockStartsAtGivenTime)
+{
+    IClock::TimePoint start(1h);
+    VirtualClock clock(start);
+    EXPECT_EQ(clock.now(), start);
+    EXPECT_EQ(clock.getSleptTime(), IClock::Duration::zero());
+}
+
+TEST(ClockTest, VirtualClockSleepAdvancesWithoutBlocking)
+{
+    VirtualClock clock;
+    auto realStart = std::chrono::steady_clock::now();
+
+    // A day of sleeps completes immediately
+    for (int i = 0; i < 24 * 60; ++i)
+    {
+        clock.sleepFor(1min);
+    }
+
+    EXPECT_EQ(clock.now(), IClock::TimePoint(24h));
+    EXPECT_EQ(clock.getSleptTime(), 24h);
+    EXPECT_LT(std::chrono::steady_clock::now() - realStart, 1s);
+}
+
+TEST(ClockTest, VirtualClockAdvance)
+{
+    VirtualClock clock;
+    clock.advance(250ms);
+    EXPECT_EQ(clock.now(), IClock::TimePoint(250ms));
+
+    // advance() moves time but is not counted as sleeping
+    EXPECT_EQ(clock.getSleptTime(), IClock::Duration::zero());
+
+    // Time never goes backwards
+    clock.advance(-1s);
+    clock.sleepFor(-1s);
+    EXPECT_EQ(clock.now(), IClock::TimePoint(250ms));
+}
+
+TEST(ClockTest, VirtualClockIsThreadSafe)
+{
+    VirtualClock clock;
+    constexpr int THREADS = 4;
+    constexpr int SLEEPS = 10000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back(
+            [&clock]()
+            {
+                for (int i = 0; i < SLEEPS; ++i)
+                {
+                    clock.sleepFor(1ms);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(clock.now(), IClock::TimePoint(THREADS * SLEEPS * 1ms));
+}
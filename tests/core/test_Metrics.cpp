@@ -0,0 +1,184 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "core/Metrics.hpp"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace MouseRecorder::Core;
+
+class MetricsTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_tempDir = std::filesystem::temp_directory_path() /
+                    ("mouserecorder_metrics_test_" +
+                     std::to_string(::testing::UnitTest::GetInstance()
+                                        ->random_seed()));
+        std::filesystem::create_directories(m_tempDir);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_tempDir);
+    }
+
+    static bool contains(const std::string& text, const std::string& pattern)
+    {
+        return text.find(pattern) != std::string::npos;
+    }
+
+    std::filesystem::path m_tempDir;
+    // Local registry so tests don't see metrics of other components
+    MetricsRegistry m_registry;
+};
+
+TEST_F(MetricsTest, CounterAndGaugeExport)
+{
+    m_registry.counter("test_events_total", "Test events").increment(3);
+    m_registry.counter("test_events_total", "Test events").increment();
+    m_registry.gauge("test_queue_depth", "Test queue").set(7);
+
+    std::string text = m_registry.toPrometheusText();
+    EXPECT_TRUE(contains(text, "# TYPE test_events_total counter\n"));
+    EXPECT_TRUE(contains(text, "test_events_total 4\n"));
+    EXPECT_TRUE(contains(text, "# TYPE test_queue_depth gauge\n"));
+    EXPECT_TRUE(contains(text, "test_queue_depth 7\n"));
+}
+
+TEST_F(MetricsTest, LabelsSelectSeparateSeries)
+{
+    m_registry.counter("test_bytes_total", "Bytes", {{"format", "json"}})
+        .increment(10);
+    m_registry.counter("test_bytes_total", "Bytes", {{"format", "xml"}})
+        .increment(20);
+
+    std::string text = m_registry.toPrometheusText();
+    EXPECT_TRUE(contains(text, "test_bytes_total{format=\"json\"} 10\n"));
+    EXPECT_TRUE(contains(text, "test_bytes_total{format=\"xml\"} 20\n"));
+}
+
+TEST_F(MetricsTest, HistogramBucketsAreCumulative)
+{
+    auto& histogram =
+        m_registry.histogram("test_latency_seconds", "Latency", {0.1, 1.0});
+    histogram.observe(0.05);
+    histogram.observe(0.1);
+    histogram.observe(0.5);
+    histogram.observe(5.0);
+
+    EXPECT_EQ(histogram.count(), 4u);
+    EXPECT_DOUBLE_EQ(histogram.sum(), 5.65);
+
+    std::string text = m_registry.toPrometheusText();
+    EXPECT_TRUE(contains(text, "test_latency_seconds_bucket{le=\"0.1\"} 2\n"));
+    EXPECT_TRUE(contains(text, "test_latency_seconds_bucket{le=\"1\"} 3\n"));
+    EXPECT_TRUE(
+        contains(text, "test_latency_seconds_bucket{le=\"+Inf\"} 4\n"));
+    EXPECT_TRUE(contains(text, "test_latency_seconds_count 4\n"));
+}
+
+TEST_F(MetricsTest, TypeMismatchThrows)
+{
+    m_registry.counter("test_metric", "Counter");
+    EXPECT_THROW(m_registry.gauge("test_metric", "Gauge"),
+                 std::invalid_argument);
+}
+
+TEST_F(MetricsTest, ConcurrentIncrements)
+{
+    auto& counter = m_registry.counter("test_concurrent_total", "Concurrent");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&counter]()
+            {
+                for (int i = 0; i < 10000; ++i)
+                {
+                    counter.increment();
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter.value(), 40000u);
+}
+
+TEST_F(MetricsTest, WriteTextfile)
+{
+    m_registry.counter("test_written_total", "Written").increment(2);
+
+    ASSERT_TRUE(m_registry.writeTextfile(m_tempDir.string()));
+
+    std::ifstream file(m_tempDir / "mouserecorder.prom");
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_TRUE(contains(content.str(), "test_written_total 2\n"));
+    EXPECT_FALSE(std::filesystem::exists(m_tempDir / "mouserecorder.prom.tmp"));
+}
+
+TEST_F(MetricsTest, ExporterWritesOnStop)
+{
+    m_registry.counter("test_exported_total", "Exported").increment();
+
+    MetricsTextfileExporter exporter(m_registry);
+    ASSERT_TRUE(
+        exporter.start(m_tempDir.string(), std::chrono::milliseconds(60000)));
+    EXPECT_TRUE(exporter.isRunning());
+    exporter.stop();
+    EXPECT_FALSE(exporter.isRunning());
+
+    EXPECT_TRUE(std::filesystem::exists(m_tempDir / "mouserecorder.prom"));
+}
+
+TEST_F(MetricsTest, ExporterRejectsMissingDirectory)
+{
+    MetricsTextfileExporter exporter(m_registry);
+    EXPECT_FALSE(exporter.start((m_tempDir / "missing").string()));
+    EXPECT_FALSE(exporter.getLastError().empty());
+}
+
+TEST_F(MetricsTest, EstimateQuantileInterpolatesWithinBucket)
+{
+    std::vector<double> bounds = {0.01, 0.1, 1.0};
+
+    // 10 observations in (0, 0.01], 10 in (0.01, 0.1]
+    std::vector<std::uint64_t> counts = {10, 10, 0, 0};
+    EXPECT_DOUBLE_EQ(Histogram::estimateQuantile(bounds, counts, 0.5), 0.01);
+    EXPECT_NEAR(
+        Histogram::estimateQuantile(bounds, counts, 0.75), 0.055, 1e-12);
+
+    // Values above the last bound are reported as the last bound
+    std::vector<std::uint64_t> overflow = {0, 0, 0, 5};
+    EXPECT_DOUBLE_EQ(Histogram::estimateQuantile(bounds, overflow, 0.99), 1.0);
+
+    std::vector<std::uint64_t> empty = {0, 0, 0, 0};
+    EXPECT_TRUE(std::isnan(Histogram::estimateQuantile(bounds, empty, 0.5)));
+}
+
+TEST_F(MetricsTest, FindDoesNotCreateMetrics)
+{
+    EXPECT_EQ(m_registry.findCounter("test_missing_total"), nullptr);
+    EXPECT_TRUE(m_registry.toPrometheusText().empty());
+
+    auto& counter =
+        m_registry.counter("test_found_total", "Found", {{"kind", "a"}});
+    EXPECT_EQ(m_registry.findCounter("test_found_total", {{"kind", "a"}}),
+              &counter);
+    EXPECT_EQ(m_registry.findCounter("test_found_total"), nullptr);
+    EXPECT_EQ(m_registry.findGauge("test_found_total"), nullptr);
+}
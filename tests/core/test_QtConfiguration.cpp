@@ -5,12 +5,17 @@
 
 #include <gtest/gtest.h>
 #include <QCoreApplication>
+#include <QSettings>
 #include <QTemporaryFile>
 #include <QTemporaryDir>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <thread>
 
 #include "core/IConfiguration.hpp"
 #include "core/QtConfiguration.hpp"
+#include "core/ConfigSnapshot.hpp"
 
 using namespace MouseRecorder::Core;
 
@@ -33,3 +38,193 @@ TEST(SimpleConfigurationTest, BasicSetAndGet)
                      config->getDouble(ConfigKeys::DEFAULT_PLAYBACK_SPEED));
     EXPECT_STREQ("debug", config->getString(ConfigKeys::LOG_LEVEL).c_str());
 }
+
+TEST(SimpleConfigurationTest, SnapshotReflectsChanges)
+{
+    auto config = std::make_unique<QtConfiguration>();
+
+    auto before = config->getSnapshot();
+    ASSERT_NE(nullptr, before);
+
+    config->setInt(ConfigKeys::MOUSE_MOVEMENT_THRESHOLD, 42);
+    config->setString(ConfigKeys::SHORTCUT_STOP_RECORDING, "Ctrl+Alt+S");
+
+    auto after = config->getSnapshot();
+    ASSERT_NE(nullptr, after);
+    EXPECT_GT(after->getVersion(), before->getVersion());
+
+    constexpr auto thresholdId =
+        configKeyId(ConfigKeys::MOUSE_MOVEMENT_THRESHOLD);
+    EXPECT_EQ(42, after->getInt(thresholdId));
+    EXPECT_EQ("Ctrl+Alt+S",
+              after->getString(ConfigKeyId::ShortcutStopRecording));
+
+    // Published snapshots are immutable
+    EXPECT_NE(42, before->getInt(thresholdId));
+}
+
+TEST(SimpleConfigurationTest, SnapshotDefaultsForMissingKeys)
+{
+    auto config = std::make_unique<QtConfiguration>();
+    config->removeKey(ConfigKeys::LOOP_PLAYBACK);
+
+    auto snapshot = config->getSnapshot();
+    EXPECT_FALSE(snapshot->hasValue(ConfigKeyId::LoopPlayback));
+    EXPECT_TRUE(snapshot->getBool(ConfigKeyId::LoopPlayback, true));
+
+    // Wrong type falls back to the default value
+    EXPECT_EQ(7, snapshot->getInt(ConfigKeyId::LogLevel, 7));
+}
+
+TEST(SimpleConfigurationTest, SnapshotUpdatesOnlyChangedKeys)
+{
+    auto config = std::make_unique<QtConfiguration>();
+    config->setInt(ConfigKeys::MOUSE_MOVEMENT_THRESHOLD, 42);
+    auto before = config->getSnapshot();
+
+    // Keys outside CONFIG_KEY_TABLE do not publish a new snapshot
+    config->setString("custom/key", "value");
+    config->removeKey("custom/key");
+    EXPECT_EQ(before, config->getSnapshot());
+
+    config->removeKey(ConfigKeys::LOOP_PLAYBACK);
+    auto after = config->getSnapshot();
+    EXPECT_GT(after->getVersion(), before->getVersion());
+    EXPECT_FALSE(after->hasValue(ConfigKeyId::LoopPlayback));
+    EXPECT_EQ(42,
+              after->getInt(configKeyId(ConfigKeys::MOUSE_MOVEMENT_THRESHOLD)));
+}
+
+TEST(SimpleConfigurationTest, WriteBehindCoalescesChanges)
+{
+    auto config = std::make_unique<QtConfiguration>();
+    config->setWriteDelay(std::chrono::hours(1));
+
+    std::vector<ConfigChange> received;
+    int batches = 0;
+    config->registerBatchChangeCallback(
+        [&](const std::vector<ConfigChange>& changes)
+        {
+            ++batches;
+            received = changes;
+        });
+
+    // Pending values are visible to readers before they are written
+    for (int i = 1; i <= 10; ++i)
+    {
+        config->setInt(ConfigKeys::MOUSE_MOVEMENT_THRESHOLD, 100 + i);
+    }
+    config->setBool(ConfigKeys::LOOP_PLAYBACK, true);
+    EXPECT_EQ(110, config->getInt(ConfigKeys::MOUSE_MOVEMENT_THRESHOLD));
+    EXPECT_EQ(0, batches);
+
+    config->flush();
+
+    ASSERT_EQ(1, batches);
+    ASSERT_EQ(2u, received.size());
+    for (const auto& change : received)
+    {
+        if (change.key == ConfigKeys::MOUSE_MOVEMENT_THRESHOLD)
+        {
+            EXPECT_EQ(110, std::get<int>(change.value));
+        }
+        else
+        {
+            EXPECT_EQ(ConfigKeys::LOOP_PLAYBACK, change.key);
+            EXPECT_TRUE(std::get<bool>(change.value));
+        }
+    }
+}
+
+TEST(SimpleConfigurationTest, DebouncedChangesAreDeliveredOnOwnerThread)
+{
+    auto config = std::make_unique<QtConfiguration>();
+    config->setWriteDelay(std::chrono::milliseconds(10));
+
+    std::optional<std::thread::id> callbackThread;
+    auto id = config->registerBatchChangeCallback(
+        [&](const std::vector<ConfigChange>&)
+        { callbackThread = std::this_thread::get_id(); });
+
+    config->setInt(ConfigKeys::MOUSE_MOVEMENT_THRESHOLD, 77);
+
+    // The flush thread posts the write, the event loop runs it
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!callbackThread && std::chrono::steady_clock::now() < deadline)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    ASSERT_TRUE(callbackThread.has_value());
+    EXPECT_EQ(std::this_thread::get_id(), *callbackThread);
+    config->unregisterChangeCallback(id);
+}
+
+TEST(SimpleConfigurationTest, DestructionDeliversPendingChanges)
+{
+    int batches = 0;
+    auto config = std::make_unique<QtConfiguration>();
+    config->setWriteDelay(std::chrono::hours(1));
+    config->registerBatchChangeCallback(
+        [&](const std::vector<ConfigChange>&) { ++batches; });
+
+    config->setBool(ConfigKeys::LOOP_PLAYBACK, true);
+    EXPECT_EQ(0, batches);
+    config.reset();
+    EXPECT_EQ(1, batches);
+}
+
+TEST(SimpleConfigurationTest, WriteThroughWithZeroDelay)
+{
+    auto config = std::make_unique<QtConfiguration>();
+    config->setWriteDelay(std::chrono::milliseconds::zero());
+
+    std::string lastKey;
+    std::string lastValue;
+    config->registerChangeCallback(
+        [&](const std::string& key, const std::string& value)
+        {
+            lastKey = key;
+            lastValue = value;
+        });
+
+    config->setString(ConfigKeys::LOG_LEVEL, "trace");
+    EXPECT_EQ(ConfigKeys::LOG_LEVEL, lastKey);
+    EXPECT_EQ("trace", lastValue);
+}
+
+TEST(SimpleConfigurationTest, LoadFromFileSupersedesPendingNotifications)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const std::string filename = dir.filePath("config.ini").toStdString();
+    {
+        QSettings file(QString::fromStdString(filename), QSettings::IniFormat);
+        file.setValue(QString(ConfigKeys::LOG_LEVEL), "warn");
+        file.sync();
+    }
+
+    auto config = std::make_unique<QtConfiguration>();
+    config->setWriteDelay(std::chrono::hours(1));
+
+    std::vector<ConfigChange> received;
+    config->registerBatchChangeCallback(
+        [&](const std::vector<ConfigChange>& changes)
+        {
+            received.insert(received.end(), changes.begin(), changes.end());
+        });
+
+    config->setString(ConfigKeys::LOG_LEVEL, "trace");
+    config->setBool(ConfigKeys::LOOP_PLAYBACK, true);
+    ASSERT_TRUE(config->loadFromFile(filename));
+    EXPECT_EQ("warn", config->getString(ConfigKeys::LOG_LEVEL));
+
+    // The change the file overrode is not reported, the other one is, once
+    ASSERT_EQ(1u, received.size());
+    EXPECT_EQ(ConfigKeys::LOOP_PLAYBACK, received[0].key);
+
+    received.clear();
+    config->flush();
+    EXPECT_TRUE(received.empty());
+}
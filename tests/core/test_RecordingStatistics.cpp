@@ -0,0 +1,130 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "core/RecordingStatistics.hpp"
+#include <numeric>
+
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+std::unique_ptr<Event> mouseMove(int x, int y, uint64_t timestampMs)
+{
+    MouseEventData mouse;
+    mouse.position = {x, y};
+    return std::make_unique<Event>(
+        EventType::MouseMove, mouse, Event::timestampFromMs(timestampMs));
+}
+
+std::unique_ptr<Event> key(EventType type,
+                           uint32_t keyCode,
+                           const std::string& keyName,
+                           uint64_t timestampMs)
+{
+    KeyboardEventData data;
+    data.keyCode = keyCode;
+    data.keyName = keyName;
+    return std::make_unique<Event>(
+        type, data, Event::timestampFromMs(timestampMs));
+}
+
+uint64_t activityTotal(const RecordingStatistics& statistics)
+{
+    return std::accumulate(
+        statistics.activity.begin(), statistics.activity.end(), uint64_t{0});
+}
+
+} // namespace
+
+TEST(RecordingStatisticsTest, EmptyRecording)
+{
+    RecordingStatistics statistics = RecordingStatistics::fromEvents({});
+    EXPECT_EQ(statistics.getTotalEvents(), 0u);
+    EXPECT_EQ(statistics.getDurationMs(), 0u);
+    EXPECT_FALSE(statistics.hasPointerBounds);
+    EXPECT_TRUE(statistics.keysUsed.empty());
+    EXPECT_EQ(activityTotal(statistics), 0u);
+}
+
+TEST(RecordingStatisticsTest, CountsEventsAndBounds)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    events.push_back(mouseMove(100, 50, 1000));
+    events.push_back(key(EventType::KeyPress, 65, "A", 1100));
+    events.push_back(key(EventType::KeyRelease, 65, "A", 1150));
+    events.push_back(mouseMove(-20, 300, 1200));
+    events.push_back(key(EventType::KeyPress, 200, "", 1300));
+    events.push_back(key(EventType::KeyRelease, 66, "B", 1400));
+
+    RecordingStatistics statistics = RecordingStatistics::fromEvents(events);
+    EXPECT_EQ(statistics.getTotalEvents(), 6u);
+    EXPECT_EQ(statistics.getMouseEvents(), 2u);
+    EXPECT_EQ(statistics.getKeyboardEvents(), 4u);
+    EXPECT_EQ(statistics.getCount(EventType::KeyPress), 2u);
+    EXPECT_EQ(statistics.firstTimestampMs, 1000u);
+    EXPECT_EQ(statistics.getDurationMs(), 400u);
+
+    ASSERT_TRUE(statistics.hasPointerBounds);
+    EXPECT_EQ(statistics.pointerMin, (Point{-20, 50}));
+    EXPECT_EQ(statistics.pointerMax, (Point{100, 300}));
+
+    // Releases alone don't count as using a key
+    EXPECT_EQ(statistics.keysUsed, (std::set<std::string>{"A", "200"}));
+}
+
+TEST(RecordingStatisticsTest, ActivityHistogramCoversRecording)
+{
+    RecordingStatistics statistics;
+    statistics.add(*mouseMove(0, 0, 5000));
+    statistics.add(*mouseMove(0, 0, 5005));
+    EXPECT_EQ(statistics.activityStartMs, 5000u);
+    EXPECT_EQ(statistics.activityBucketMs,
+              RecordingStatistics::MIN_ACTIVITY_BUCKET_MS);
+    EXPECT_EQ(statistics.activity[0], 2u);
+
+    // One hour is far beyond 64 buckets of 10 ms
+    constexpr uint64_t HOUR_MS = 60 * 60 * 1000;
+    for (uint64_t t = 1000; t <= HOUR_MS; t += 1000)
+    {
+        statistics.add(*mouseMove(0, 0, 5000 + t));
+    }
+
+    uint64_t coveredMs =
+        statistics.activityBucketMs * RecordingStatistics::ACTIVITY_BUCKETS;
+    EXPECT_GT(coveredMs, HOUR_MS);
+    EXPECT_LE(coveredMs / 2, HOUR_MS);
+    EXPECT_EQ(activityTotal(statistics), statistics.getTotalEvents());
+    // The first two events and every full second inside the first bucket
+    EXPECT_EQ(statistics.activity[0],
+              (statistics.activityBucketMs - 1) / 1000 + 2);
+}
+
+TEST(RecordingStatisticsTest, EventsBeforeStartGoToFirstBucket)
+{
+    RecordingStatistics statistics;
+    statistics.add(*mouseMove(0, 0, 1000));
+    statistics.add(*mouseMove(0, 0, 900));
+    EXPECT_EQ(statistics.firstTimestampMs, 900u);
+    EXPECT_EQ(statistics.lastTimestampMs, 1000u);
+    EXPECT_EQ(statistics.activity[0], 2u);
+}
+
+TEST(RecordingStatisticsTest, IncrementalMatchesWholeRecording)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < 1000; ++i)
+    {
+        events.push_back(mouseMove(i, -i, 100 + i * 37));
+    }
+
+    RecordingStatistics incremental;
+    for (const auto& event : events)
+    {
+        incremental.add(*event);
+    }
+    EXPECT_EQ(incremental, RecordingStatistics::fromEvents(events));
+}
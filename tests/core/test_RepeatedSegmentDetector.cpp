@@ -0,0 +1,195 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "core/RepeatedSegmentDetector.hpp"
+#include "core/Event.hpp"
+
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+/**
+ * @brief Types "abc", clicks and waits, like a data entry macro, with a
+ * few milliseconds of jitter between repetitions
+ */
+void addRepetition(EventVector& events, uint64_t& timeMs, int jitterMs)
+{
+    for (char key : std::string("abc"))
+    {
+        KeyboardEventData data;
+        data.keyCode = static_cast<uint32_t>(key);
+        data.keyName = std::string(1, key);
+        events.push_back(std::make_unique<Event>(
+            EventType::KeyPress, data, Event::timestampFromMs(timeMs)));
+        timeMs += 50 + static_cast<uint64_t>(jitterMs);
+    }
+    MouseEventData click;
+    click.position = {400, 300};
+    events.push_back(std::make_unique<Event>(
+        EventType::MouseClick, click, Event::timestampFromMs(timeMs)));
+    timeMs += 500;
+}
+
+std::unique_ptr<Event> makeMove(int x, uint64_t timeMs)
+{
+    MouseEventData data;
+    data.position = {x, 0};
+    return std::make_unique<Event>(
+        EventType::MouseMove, data, Event::timestampFromMs(timeMs));
+}
+
+/**
+ * @brief Moves, 100 repetitions of the macro, then more moves
+ */
+EventVector makeRecording(int jitterMs = 3)
+{
+    EventVector events;
+    uint64_t timeMs = 1000;
+    for (int i = 0; i < 10; ++i, timeMs += 16)
+    {
+        events.push_back(makeMove(i, timeMs));
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        addRepetition(events, timeMs, i % 2 == 0 ? 0 : jitterMs);
+    }
+    for (int i = 0; i < 10; ++i, timeMs += 16)
+    {
+        events.push_back(makeMove(100 + i, timeMs));
+    }
+    return events;
+}
+
+} // namespace
+
+TEST(RepeatedSegmentDetectorTest, FindsRepetitionsDespiteJitter)
+{
+    auto events = makeRecording();
+    auto segments = RepeatedSegmentDetector::findSegments(events);
+
+    ASSERT_EQ(segments.size(), 1u);
+    EXPECT_EQ(segments[0].start, 10u);
+    EXPECT_EQ(segments[0].length, 4u);
+    EXPECT_EQ(segments[0].repeatCount, 100u);
+    EXPECT_NEAR(static_cast<double>(segments[0].periodMs), 654.0, 3.0);
+}
+
+TEST(RepeatedSegmentDetectorTest, RespectsTheTimingTolerance)
+{
+    // Every other repetition is typed much slower, so only pairs of them
+    // repeat within the tolerance
+    auto events = makeRecording(200);
+    LoopDetectionConfig config;
+    config.timingToleranceMs = 20;
+    auto segments = RepeatedSegmentDetector::findSegments(events, config);
+    ASSERT_EQ(segments.size(), 1u);
+    EXPECT_EQ(segments[0].length, 8u);
+    EXPECT_EQ(segments[0].repeatCount, 50u);
+
+    config.timingToleranceMs = 200;
+    segments = RepeatedSegmentDetector::findSegments(events, config);
+    ASSERT_EQ(segments.size(), 1u);
+    EXPECT_EQ(segments[0].length, 4u);
+    EXPECT_EQ(segments[0].repeatCount, 100u);
+}
+
+TEST(RepeatedSegmentDetectorTest, SkipsShortRepetitions)
+{
+    EventVector events;
+    uint64_t timeMs = 0;
+    addRepetition(events, timeMs, 0);
+    addRepetition(events, timeMs, 0);
+    EXPECT_TRUE(RepeatedSegmentDetector::findSegments(events).empty());
+
+    LoopDetectionConfig config;
+    config.minSavedEvents = 4;
+    EXPECT_EQ(RepeatedSegmentDetector::findSegments(events, config).size(),
+              1u);
+}
+
+TEST(RepeatedSegmentDetectorTest, CompressesAndExpands)
+{
+    auto events = makeRecording(0);
+    auto recording = RepeatedSegmentDetector::compress(makeRecording(0));
+
+    EXPECT_EQ(recording.events.size(), 24u);
+    EXPECT_EQ(recording.getExpandedCount(), events.size());
+    ASSERT_EQ(recording.index.getSegments().size(), 1u);
+    EXPECT_EQ(recording.index.getSegments()[0].start, 10u);
+
+    // Without jitter the expanded recording is the original one
+    auto expanded = recording.expand();
+    ASSERT_EQ(expanded.size(), events.size());
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        EXPECT_EQ(expanded[i]->toString(), events[i]->toString());
+        EXPECT_EQ(expanded[i]->getTimestampMs(), events[i]->getTimestampMs());
+    }
+}
+
+TEST(RepeatedSegmentDetectorTest, KeepsExpandedTimestampsInOrder)
+{
+    // The first of five repetitions is typed almost three times slower;
+    // each delay is within the tolerance, the whole repetition is not
+    auto makeUneven = []()
+    {
+        EventVector events;
+        uint64_t timeMs = 1000;
+        for (int repetition = 0; repetition < 5; ++repetition)
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                events.push_back(makeMove(i, timeMs));
+                timeMs += repetition == 0 ? 30 : 11;
+            }
+        }
+        return events;
+    };
+    LoopDetectionConfig config;
+    config.timingToleranceMs = 20;
+    auto recording = RepeatedSegmentDetector::compress(makeUneven(), config);
+
+    EXPECT_FALSE(recording.index.empty());
+    auto events = makeUneven();
+    auto expanded = recording.expand();
+    ASSERT_EQ(expanded.size(), events.size());
+    for (size_t i = 1; i < expanded.size(); ++i)
+    {
+        EXPECT_LE(expanded[i - 1]->getTimestampMs(),
+                  expanded[i]->getTimestampMs())
+            << i;
+    }
+    EXPECT_LE(expanded.back()->getTimestampMs(),
+              events.back()->getTimestampMs());
+}
+
+TEST(RepeatedSegmentDetectorTest, LocatesExpandedPositions)
+{
+    SegmentIndex index({{2, 3, 4, 100}, {7, 1, 10, 5}});
+    EXPECT_TRUE(SegmentIndex::isValid(index.getSegments(), 9));
+    EXPECT_EQ(index.getExpandedCount(9), 9u + 9u + 9u);
+
+    auto check = [&index](uint64_t position, uint64_t event, uint64_t offset)
+    {
+        auto location = index.locate(position);
+        EXPECT_EQ(location.event, event) << position;
+        EXPECT_EQ(location.offsetMs, offset) << position;
+    };
+    check(0, 0, 0);
+    check(2, 2, 0);
+    check(5, 2, 100);
+    check(13, 4, 300);
+    check(14, 5, 0);
+    check(16, 7, 0);
+    check(25, 7, 45);
+    check(26, 8, 0);
+
+    // Overlapping, too short or out of range
+    EXPECT_FALSE(SegmentIndex::isValid({{2, 3, 2, 0}, {4, 1, 2, 0}}, 9));
+    EXPECT_FALSE(SegmentIndex::isValid({{2, 3, 1, 0}}, 9));
+    EXPECT_FALSE(SegmentIndex::isValid({{8, 3, 2, 0}}, 9));
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "core/Tracing.hpp"
+#include <string>
+#include <thread>
+
+using namespace MouseRecorder::Core;
+
+class TracingTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        Tracer::instance().setEnabled(false);
+        Tracer::instance().clear();
+    }
+
+    void TearDown() override
+    {
+        Tracer::instance().setEnabled(false);
+        Tracer::instance().clear();
+    }
+
+    static size_t countOccurrences(const std::string& text,
+                                   const std::string& pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos;
+             pos = text.find(pattern, pos + pattern.size()))
+        {
+            ++count;
+        }
+        return count;
+    }
+};
+
+TEST_F(TracingTest, DisabledTracerRecordsNothing)
+{
+    {
+        MOUSERECORDER_TRACE_SCOPE("test", "disabledSpan");
+    }
+
+    std::string json = Tracer::instance().toChromeTraceJson();
+    EXPECT_EQ(json.find("disabledSpan"), std::string::npos);
+}
+
+TEST_F(TracingTest, SpansFromMultipleThreadsAreExported)
+{
+    auto& tracer = Tracer::instance();
+    tracer.setEnabled(true);
+
+    auto worker = [](const char* threadName)
+    {
+        Tracer::instance().setThreadName(threadName);
+        for (int i = 0; i < 3; ++i)
+        {
+            MOUSERECORDER_TRACE_SCOPE("test", "workerSpan");
+        }
+    };
+
+    std::thread first(worker, "tracing-worker-1");
+    std::thread second(worker, "tracing-worker-2");
+    first.join();
+    second.join();
+
+    std::string json = tracer.toChromeTraceJson();
+    EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+    EXPECT_EQ(countOccurrences(json, "\"name\":\"workerSpan\""), 6u);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("tracing-worker-1"), std::string::npos);
+    EXPECT_NE(json.find("tracing-worker-2"), std::string::npos);
+}
+
+TEST_F(TracingTest, ClearDropsRecordedSpans)
+{
+    auto& tracer = Tracer::instance();
+    tracer.setEnabled(true);
+    {
+        MOUSERECORDER_TRACE_SCOPE("test", "spanBeforeClear");
+    }
+    EXPECT_NE(tracer.toChromeTraceJson().find("spanBeforeClear"),
+              std::string::npos);
+
+    tracer.clear();
+    {
+        MOUSERECORDER_TRACE_SCOPE("test", "spanAfterClear");
+    }
+
+    std::string json = tracer.toChromeTraceJson();
+    EXPECT_EQ(json.find("spanBeforeClear"), std::string::npos);
+    EXPECT_NE(json.find("spanAfterClear"), std::string::npos);
+}
+
+TEST_F(TracingTest, WriteChromeTraceFailsForInvalidPath)
+{
+    auto& tracer = Tracer::instance();
+    EXPECT_FALSE(tracer.writeChromeTrace("/nonexistent/dir/trace.json"));
+    EXPECT_FALSE(tracer.getLastError().empty());
+}
+
+TEST_F(TracingTest, BuffersOfExitedThreadsAreFreed)
+{
+    auto& tracer = Tracer::instance();
+    tracer.setEnabled(true);
+    {
+        // Give this thread its buffer before counting
+        MOUSERECORDER_TRACE_SCOPE("test", "mainSpan");
+    }
+    tracer.clear();
+    const size_t before = tracer.getThreadBufferCount();
+
+    // One short-lived thread per operation, like StorageTask
+    for (size_t i = 0; i < 2 * Tracer::MAX_RETIRED_BUFFERS; ++i)
+    {
+        std::thread worker(
+            []() { MOUSERECORDER_TRACE_SCOPE("test", "workerSpan"); });
+        worker.join();
+    }
+    // The last worker retired after the others were pruned
+    EXPECT_LE(tracer.getThreadBufferCount(),
+              before + Tracer::MAX_RETIRED_BUFFERS + 1);
+
+    tracer.clear();
+    EXPECT_LE(tracer.getThreadBufferCount(), before);
+}
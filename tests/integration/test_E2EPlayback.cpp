@@ -15,6 +15,7 @@
 #include "application/MouseRecorderApp.hpp"
 #include "gui/MainWindow.hpp"
 #include "gui/PlaybackWidget.hpp"
+#include "core/Clock.hpp"
 #include "core/Event.hpp"
 #include "storage/JsonEventStorage.hpp"
 #include <memory>
@@ -36,8 +37,10 @@ class EndToEndPlaybackTest : public ::testing::Test
             app = std::make_unique<QApplication>(argc, argv);
         }
 
-        // Initialize MouseRecorderApp (NOT headless for testing)
-        mouseRecorderApp = std::make_unique<Application::MouseRecorderApp>();
+        // Initialize MouseRecorderApp (NOT headless for testing); replays
+        // run on a virtual clock so they don't wait for the event gaps
+        mouseRecorderApp =
+            std::make_unique<Application::MouseRecorderApp>(virtualClock);
         ASSERT_TRUE(
             mouseRecorderApp->initialize("", false)); // headless = false
     }
@@ -79,6 +82,7 @@ class EndToEndPlaybackTest : public ::testing::Test
     }
 
     std::unique_ptr<QApplication> app;
+    Core::VirtualClock virtualClock;
     std::unique_ptr<Application::MouseRecorderApp> mouseRecorderApp;
     std::vector<std::unique_ptr<QTemporaryFile>> tempFiles;
 };
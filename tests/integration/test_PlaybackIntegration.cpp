@@ -8,6 +8,7 @@
 #include <QTemporaryFile>
 #include <QtTest/QTest>
 #include "application/MouseRecorderApp.hpp"
+#include "core/Clock.hpp"
 #include "core/Event.hpp"
 #include "storage/JsonEventStorage.hpp"
 #ifdef __linux__
@@ -24,6 +25,12 @@
 #ifdef None
 #undef None
 #endif
+#ifdef KeyPress
+#undef KeyPress
+#endif
+#ifdef KeyRelease
+#undef KeyRelease
+#endif
 
 namespace MouseRecorder::Tests::Integration
 {
@@ -43,7 +50,8 @@ class PlaybackIntegrationTest : public ::testing::Test
         }
 
         // Initialize MouseRecorderApp (NOT headless for testing)
-        mouseRecorderApp = std::make_unique<Application::MouseRecorderApp>();
+        mouseRecorderApp =
+            std::make_unique<Application::MouseRecorderApp>(replayClock());
         ASSERT_TRUE(
             mouseRecorderApp->initialize("", false)); // headless = false
     }
@@ -57,40 +65,64 @@ class PlaybackIntegrationTest : public ::testing::Test
         mouseRecorderApp.reset();
     }
 
-    // Create a comprehensive test recording
+    // Replays run on a virtual clock so they don't sleep through the gaps
+    // between events
+    virtual Core::IClock& replayClock()
+    {
+        return virtualClock;
+    }
+
+    // Create a comprehensive test recording, timestamped on a virtual clock
+    // so building it doesn't wait for the gaps between events
     std::vector<std::unique_ptr<Core::Event>> createTestEvents()
     {
         std::vector<std::unique_ptr<Core::Event>> events;
+        Core::VirtualClock clock(std::chrono::steady_clock::now());
+        auto add = [&events, &clock](Core::EventType type,
+                                     Core::Event::EventData data,
+                                     std::chrono::milliseconds gap)
+        {
+            events.push_back(std::make_unique<Core::Event>(
+                type, std::move(data), clock.now()));
+            clock.advance(gap);
+        };
+        auto mouse = [](Core::Point position, int wheelDelta = 0)
+        {
+            Core::MouseEventData data;
+            data.position = position;
+            data.wheelDelta = wheelDelta;
+            return data;
+        };
+        auto key = [](const std::string& name)
+        {
+            Core::KeyboardEventData data;
+            data.keyCode = static_cast<uint32_t>(name[0]);
+            data.keyName = name;
+            return data;
+        };
+        using namespace std::chrono_literals;
 
         // Mouse move events
         for (int i = 0; i < 5; ++i)
         {
-            auto event = Core::EventFactory::createMouseMoveEvent(
-                {100 + i * 10, 200 + i * 5});
-            events.push_back(std::move(event));
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            add(Core::EventType::MouseMove,
+                mouse({100 + i * 10, 200 + i * 5}),
+                10ms);
         }
 
         // Mouse click
-        events.push_back(Core::EventFactory::createMouseClickEvent(
-            {150, 225}, Core::MouseButton::Left));
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        add(Core::EventType::MouseClick, mouse({150, 225}), 50ms);
 
         // Key sequence: "hello"
         std::vector<std::string> keys = {"h", "e", "l", "l", "o"};
-        for (const auto& key : keys)
+        for (const auto& name : keys)
         {
-            events.push_back(Core::EventFactory::createKeyPressEvent(
-                static_cast<uint32_t>(key[0]), key, Core::KeyModifier::None));
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
-            events.push_back(Core::EventFactory::createKeyReleaseEvent(
-                static_cast<uint32_t>(key[0]), key, Core::KeyModifier::None));
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            add(Core::EventType::KeyPress, key(name), 20ms);
+            add(Core::EventType::KeyRelease, key(name), 10ms);
         }
 
         // Mouse wheel event
-        events.push_back(
-            Core::EventFactory::createMouseWheelEvent({200, 250}, 120));
+        add(Core::EventType::MouseWheel, mouse({200, 250}, 120), 0ms);
 
         return events;
     }
@@ -121,10 +153,21 @@ class PlaybackIntegrationTest : public ::testing::Test
     }
 
     std::unique_ptr<QApplication> app;
+    Core::VirtualClock virtualClock;
     std::unique_ptr<Application::MouseRecorderApp> mouseRecorderApp;
     std::vector<std::unique_ptr<QTemporaryFile>> tempFiles;
 };
 
+// For tests that need a playback to still be running when they check it
+class RealTimePlaybackIntegrationTest : public PlaybackIntegrationTest
+{
+  protected:
+    Core::IClock& replayClock() override
+    {
+        return Core::SystemClock::instance();
+    }
+};
+
 TEST_F(PlaybackIntegrationTest, EndToEndPlaybackFlow)
 {
     // Create test events
@@ -316,7 +359,7 @@ TEST_F(PlaybackIntegrationTest, SeekFunctionality)
     }
 }
 
-TEST_F(PlaybackIntegrationTest, ErrorHandling)
+TEST_F(RealTimePlaybackIntegrationTest, ErrorHandling)
 {
     auto& player = mouseRecorderApp->getEventPlayer();
 
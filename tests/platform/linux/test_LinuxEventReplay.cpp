@@ -5,11 +5,21 @@
 
 #include <gtest/gtest.h>
 #include "platform/linux/LinuxEventReplay.hpp"
+#include "core/Clock.hpp"
 #include "core/Event.hpp"
+#include "core/RepeatedSegmentDetector.hpp"
 #include <thread>
 #include <chrono>
 #include <atomic>
 
+// Undefine X11 macros that conflict with our enums
+#ifdef KeyPress
+#undef KeyPress
+#endif
+#ifdef KeyRelease
+#undef KeyRelease
+#endif
+
 using namespace MouseRecorder::Platform::Linux;
 using namespace MouseRecorder::Core;
 
@@ -35,18 +45,28 @@ class LinuxEventReplayTest : public ::testing::Test
     {
         std::vector<std::unique_ptr<Event>> events;
 
-        // Create some test events
-        events.push_back(EventFactory::createMouseMoveEvent({100, 100}));
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // Create some test events 10ms apart without waiting for real
+        VirtualClock clock(std::chrono::steady_clock::now());
+        MouseEventData mouseData;
+        mouseData.position = {100, 100};
+        KeyboardEventData keyData;
+        keyData.keyCode = 65;
+        keyData.keyName = "A";
 
-        events.push_back(
-            EventFactory::createMouseClickEvent({100, 100}, MouseButton::Left));
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        events.push_back(std::make_unique<Event>(
+            EventType::MouseMove, mouseData, clock.now()));
+        clock.advance(std::chrono::milliseconds(10));
 
-        events.push_back(EventFactory::createKeyPressEvent(65, "A"));
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        events.push_back(std::make_unique<Event>(
+            EventType::MouseClick, mouseData, clock.now()));
+        clock.advance(std::chrono::milliseconds(10));
+
+        events.push_back(std::make_unique<Event>(
+            EventType::KeyPress, keyData, clock.now()));
+        clock.advance(std::chrono::milliseconds(10));
 
-        events.push_back(EventFactory::createKeyReleaseEvent(65, "A"));
+        events.push_back(std::make_unique<Event>(
+            EventType::KeyRelease, keyData, clock.now()));
 
         return events;
     }
@@ -238,3 +258,204 @@ TEST_F(LinuxEventReplayTest, EventCallback)
         EXPECT_GT(eventCallbackCount.load(), 0);
     }
 }
+
+TEST_F(LinuxEventReplayTest, VirtualClockReplaysScheduleWithoutWaiting)
+{
+    // An hour-long recording, one event every two seconds
+    constexpr int EVENT_COUNT = 1800;
+    VirtualClock clock;
+    LinuxEventReplay player(clock);
+
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        MouseEventData data;
+        data.position = {100 + i % 100, 100};
+        events.push_back(std::make_unique<Event>(
+            EventType::MouseMove,
+            data,
+            Event::TimePoint(std::chrono::seconds(2 * i))));
+    }
+    ASSERT_TRUE(player.loadEvents(std::move(events)));
+    player.setPlaybackSpeed(2.0);
+
+    if (!player.startPlayback())
+    {
+        GTEST_SKIP() << "Playback needs an X11 display: "
+                     << player.getLastError();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (player.getState() == PlaybackState::Playing &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(player.getState(), PlaybackState::Completed);
+    EXPECT_EQ(player.getCurrentPosition(), static_cast<size_t>(EVENT_COUNT));
+
+    // Every gap was scheduled at playback speed on the virtual clock
+    EXPECT_EQ(clock.getSleptTime(),
+              std::chrono::seconds(EVENT_COUNT - 1));
+    player.stopPlayback();
+}
+
+TEST_F(LinuxEventReplayTest, SlowEventsDoNotDelayTheSchedule)
+{
+    // One event every 100 ms, each taking 30 ms to handle
+    constexpr int EVENT_COUNT = 10;
+    VirtualClock clock;
+    LinuxEventReplay player(clock);
+
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        MouseEventData data;
+        data.position = {100 + i, 100};
+        events.push_back(std::make_unique<Event>(
+            EventType::MouseMove,
+            data,
+            Event::TimePoint(std::chrono::milliseconds(100 * i))));
+    }
+    ASSERT_TRUE(player.loadEvents(std::move(events)));
+    player.setEventCallback([&clock](const Event&)
+                            { clock.advance(std::chrono::milliseconds(30)); });
+
+    if (!player.startPlayback())
+    {
+        GTEST_SKIP() << "Playback needs an X11 display: "
+                     << player.getLastError();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (player.getState() == PlaybackState::Playing &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_EQ(player.getState(), PlaybackState::Completed);
+
+    // Handling time comes out of the waits instead of adding up
+    EXPECT_EQ(clock.getSleptTime(),
+              std::chrono::milliseconds(70 * (EVENT_COUNT - 1)));
+    player.stopPlayback();
+}
+
+TEST_F(LinuxEventReplayTest, AppendEvents)
+{
+    ASSERT_TRUE(m_eventPlayer->loadEvents(createTestEvents()));
+    EXPECT_TRUE(m_eventPlayer->appendEvents(createTestEvents()));
+    EXPECT_EQ(m_eventPlayer->getTotalEvents(), 8u);
+
+    // Appended events can be sought to like loaded ones
+    EXPECT_TRUE(m_eventPlayer->seekToPosition(7));
+}
+
+TEST_F(LinuxEventReplayTest, PlaybackWaitsForPendingEvents)
+{
+    VirtualClock clock;
+    LinuxEventReplay player(clock);
+
+    auto createEvents = [](int first, int count)
+    {
+        std::vector<std::unique_ptr<Event>> events;
+        for (int i = first; i < first + count; ++i)
+        {
+            MouseEventData data;
+            data.position = {100 + i, 100};
+            events.push_back(std::make_unique<Event>(
+                EventType::MouseMove,
+                data,
+                Event::TimePoint(std::chrono::milliseconds(10 * i))));
+        }
+        return events;
+    };
+
+    auto waitWhile = [](auto condition)
+    {
+        auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (condition() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    };
+
+    // Start with the head of the recording while the rest is "loading"
+    ASSERT_TRUE(player.loadEvents(createEvents(0, 50)));
+    player.setMoreEventsPending(true);
+    if (!player.startPlayback())
+    {
+        GTEST_SKIP() << "Playback needs an X11 display: "
+                     << player.getLastError();
+    }
+
+    waitWhile([&player]() { return player.getCurrentPosition() < 50; });
+    EXPECT_EQ(player.getCurrentPosition(), 50u);
+    EXPECT_EQ(player.getState(), PlaybackState::Playing);
+
+    ASSERT_TRUE(player.appendEvents(createEvents(50, 50)));
+    player.setMoreEventsPending(false);
+
+    waitWhile([&player]()
+              { return player.getState() == PlaybackState::Playing; });
+    ASSERT_EQ(player.getState(), PlaybackState::Completed);
+    EXPECT_EQ(player.getCurrentPosition(), 100u);
+
+    // The gap across the append is scheduled like any other
+    EXPECT_EQ(clock.getSleptTime(), std::chrono::milliseconds(10 * 99));
+    player.stopPlayback();
+}
+
+TEST_F(LinuxEventReplayTest, ExpandsRepeatedSegmentsWhilePlaying)
+{
+    VirtualClock clock;
+    LinuxEventReplay player(clock);
+
+    // Two events repeated 50 times, 100 ms per repetition, then one more
+    EventVector events;
+    for (int i = 0; i < 3; ++i)
+    {
+        MouseEventData data;
+        data.position = {100 + i, 100};
+        int timeMs = i == 2 ? 5000 : 10 * i;
+        events.push_back(std::make_unique<Event>(
+            EventType::MouseMove,
+            data,
+            Event::TimePoint(std::chrono::milliseconds(timeMs))));
+    }
+    LoopedRecording recording{std::move(events),
+                              SegmentIndex({{0, 2, 50, 100}})};
+    ASSERT_TRUE(player.loadLoopedEvents(std::move(recording)));
+    EXPECT_EQ(player.getTotalEvents(), 101u);
+    EXPECT_TRUE(player.seekToPosition(100));
+    EXPECT_TRUE(player.seekToPosition(0));
+
+    std::vector<int> played;
+    player.setEventCallback(
+        [&played](const Event& event)
+        { played.push_back(event.getMouseData()->position.x); });
+    if (!player.startPlayback())
+    {
+        GTEST_SKIP() << "Playback needs an X11 display: "
+                     << player.getLastError();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (player.getState() == PlaybackState::Playing &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ASSERT_EQ(player.getState(), PlaybackState::Completed);
+    ASSERT_EQ(played.size(), 101u);
+    EXPECT_EQ(played[98], 100);
+    EXPECT_EQ(played[99], 101);
+    EXPECT_EQ(played[100], 102);
+
+    // The repetitions are scheduled 100 ms apart, the last event at 5 s
+    EXPECT_EQ(clock.getSleptTime(), std::chrono::milliseconds(5000));
+    player.stopPlayback();
+}
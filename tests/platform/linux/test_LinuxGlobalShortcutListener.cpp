@@ -0,0 +1,143 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "platform/linux/LinuxGlobalShortcutListener.hpp"
+
+using namespace MouseRecorder::Platform::Linux;
+
+using Listener = LinuxGlobalShortcutListener;
+
+class LinuxGlobalShortcutListenerTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_listener = std::make_unique<LinuxGlobalShortcutListener>();
+    }
+
+    void TearDown() override
+    {
+        m_listener.reset();
+    }
+
+    std::unique_ptr<LinuxGlobalShortcutListener> m_listener;
+};
+
+TEST_F(LinuxGlobalShortcutListenerTest, InitialState)
+{
+    EXPECT_FALSE(m_listener->isRunning());
+    EXPECT_TRUE(m_listener->getLastError().empty());
+}
+
+TEST_F(LinuxGlobalShortcutListenerTest, ParseModifiersAndKey)
+{
+    Listener::KeySequence sequence;
+
+    ASSERT_TRUE(Listener::parseKeySequence("Ctrl+Shift+R", sequence));
+    EXPECT_EQ(sequence.modifiers,
+              Listener::CtrlModifier | Listener::ShiftModifier);
+    EXPECT_EQ(sequence.keyName, "r");
+
+    ASSERT_TRUE(Listener::parseKeySequence("Alt+F5", sequence));
+    EXPECT_EQ(sequence.modifiers, Listener::AltModifier);
+    EXPECT_EQ(sequence.keyName, "F5");
+
+    ASSERT_TRUE(Listener::parseKeySequence("Ctrl+Esc", sequence));
+    EXPECT_EQ(sequence.keyName, "Escape");
+}
+
+TEST_F(LinuxGlobalShortcutListenerTest, ParseRejectsInvalidSequences)
+{
+    Listener::KeySequence sequence;
+
+    EXPECT_FALSE(Listener::parseKeySequence("", sequence));
+    EXPECT_FALSE(Listener::parseKeySequence("Ctrl+", sequence));
+    EXPECT_FALSE(Listener::parseKeySequence("Hyper+R", sequence));
+}
+
+TEST_F(LinuxGlobalShortcutListenerTest, RegisterShortcut)
+{
+    EXPECT_TRUE(m_listener->registerShortcut(0, "Ctrl+R"));
+    EXPECT_FALSE(m_listener->registerShortcut(1, "Ctrl+NoSuchKey"));
+    EXPECT_FALSE(m_listener->getLastError().empty());
+    EXPECT_NO_THROW(m_listener->unregisterShortcut(0));
+}
+
+TEST_F(LinuxGlobalShortcutListenerTest, StartWithoutCallback)
+{
+    EXPECT_FALSE(m_listener->start(nullptr));
+    EXPECT_FALSE(m_listener->isRunning());
+}
+
+TEST_F(LinuxGlobalShortcutListenerTest, StartAndStop)
+{
+    m_listener->registerShortcut(0, "Ctrl+R");
+
+    // Might fail in headless environments without X11
+    if (!m_listener->start([](int) {}))
+    {
+        GTEST_SKIP() << "X11 display not available: "
+                     << m_listener->getLastError();
+    }
+
+    EXPECT_TRUE(m_listener->isRunning());
+    m_listener->stop();
+    EXPECT_FALSE(m_listener->isRunning());
+}
+
+namespace
+{
+
+/**
+ * @brief Listener whose wait for input fails, as poll() does when its
+ * descriptors become invalid
+ */
+class FailingListener : public LinuxGlobalShortcutListener
+{
+  public:
+    ~FailingListener() override
+    {
+        stop();
+    }
+
+  protected:
+    int waitForInput(pollfd*, unsigned long) override
+    {
+        errno = EBADF;
+        return -1;
+    }
+};
+
+} // namespace
+
+TEST(LinuxGlobalShortcutListenerFailureTest, StopsWhenWaitingFails)
+{
+    FailingListener listener;
+    listener.registerShortcut(0, "Ctrl+R");
+    if (!listener.start([](int) {}))
+    {
+        GTEST_SKIP() << "X11 display not available: "
+                     << listener.getLastError();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (listener.isRunning() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_FALSE(listener.isRunning());
+    EXPECT_NE(listener.getLastError().find("poll failed"), std::string::npos);
+
+    // The dead listener can be started again
+    EXPECT_TRUE(listener.start([](int) {}));
+    listener.stop();
+    EXPECT_FALSE(listener.isRunning());
+}
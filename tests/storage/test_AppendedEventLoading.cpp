@@ -0,0 +1,109 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/BinaryEventStorage.hpp"
+#include "storage/RecordingJournal.hpp"
+#include "core/Event.hpp"
+#include "core/EventTypes.hpp"
+#include <filesystem>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+std::unique_ptr<Event> makeEvent(int i)
+{
+    MouseEventData data;
+    data.position = {i, 0};
+    return std::make_unique<Event>(
+        EventType::MouseMove,
+        data,
+        Event::timestampFromMs(1000 + static_cast<uint64_t>(i) * 10));
+}
+
+EventVector makeEvents(int first, int count)
+{
+    EventVector events;
+    for (int i = first; i < first + count; ++i)
+    {
+        events.push_back(makeEvent(i));
+    }
+    return events;
+}
+
+} // namespace
+
+class AppendedEventLoadingTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() /
+                      "mouserecorder_appended_test";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+        m_filename = (m_directory / "live.mre").string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::filesystem::path m_directory;
+    std::string m_filename;
+    BinaryEventStorage m_storage;
+};
+
+TEST_F(AppendedEventLoadingTest, FollowsAJournal)
+{
+    std::string path = RecordingJournal::getJournalPath(m_filename);
+    RecordingJournal journal;
+    StorageMetadata metadata;
+    metadata.description = "journaled";
+    ASSERT_TRUE(journal.create(path, m_filename, metadata));
+
+    auto appendBlock = [&](int first, int count)
+    {
+        std::vector<uint8_t> block;
+        for (const auto& event : makeEvents(first, count))
+        {
+            m_storage.serializeEvent(*event, block);
+        }
+        ASSERT_TRUE(
+            journal.append(block, static_cast<uint32_t>(count), false));
+    };
+    appendBlock(0, 100);
+
+    RecordingJournal::ReadPosition position;
+    RecordingJournalContents contents;
+    std::string error;
+    ASSERT_TRUE(
+        RecordingJournal::readAppended(path, position, contents, error))
+        << error;
+    EXPECT_EQ(contents.events.size(), 100u);
+    EXPECT_EQ(contents.metadata.description, "journaled");
+    EXPECT_EQ(contents.targetPath, m_filename);
+
+    appendBlock(100, 50);
+    appendBlock(150, 50);
+    ASSERT_TRUE(
+        RecordingJournal::readAppended(path, position, contents, error));
+    ASSERT_EQ(contents.events.size(), 100u);
+    EXPECT_EQ(contents.events.front()->getMouseData()->position.x, 100);
+    EXPECT_EQ(contents.metadata.totalEvents, 200u);
+    EXPECT_EQ(position.offset, std::filesystem::file_size(path));
+
+    // A new recording creates the journal again
+    metadata.description = "next recording";
+    ASSERT_TRUE(journal.create(path, m_filename, metadata));
+    appendBlock(0, 300);
+    EXPECT_FALSE(
+        RecordingJournal::readAppended(path, position, contents, error));
+    EXPECT_EQ(position.eventCount, 200u);
+}
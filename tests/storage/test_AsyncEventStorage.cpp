@@ -0,0 +1,262 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/EventStorageFactory.hpp"
+#include "core/Event.hpp"
+#include "core/StorageTask.hpp"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <thread>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+class AsyncEventStorageTest : public ::testing::TestWithParam<StorageFormat>
+{
+  protected:
+    void SetUp() override
+    {
+        m_storage = EventStorageFactory::createStorage(GetParam());
+        ASSERT_NE(m_storage, nullptr);
+        m_filename = (std::filesystem::temp_directory_path() /
+                      ("mouserecorder_async_test" +
+                       m_storage->getFileExtension()))
+                         .string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(m_filename);
+    }
+
+    static std::vector<std::unique_ptr<Event>> createEvents(int count)
+    {
+        std::vector<std::unique_ptr<Event>> events;
+        for (int i = 0; i < count; ++i)
+        {
+            events.push_back(
+                EventFactory::createMouseMoveEvent({i % 1000, i / 1000}));
+        }
+        return events;
+    }
+
+    std::unique_ptr<IEventStorage> m_storage;
+    std::string m_filename;
+};
+
+TEST_P(AsyncEventStorageTest, SaveAndLoadRoundTrip)
+{
+    std::atomic<int> completions{0};
+    std::atomic<bool> progressReported{false};
+
+    StorageTaskCallbacks callbacks;
+    callbacks.progress = [&](std::uint64_t done, std::uint64_t total)
+    {
+        EXPECT_LE(done, total);
+        progressReported = true;
+    };
+    callbacks.completion = [&](bool success)
+    {
+        EXPECT_TRUE(success);
+        ++completions;
+    };
+
+    StorageMetadata metadata;
+    metadata.description = "async";
+    auto save = m_storage->saveEventsAsync(
+        createEvents(100), m_filename, metadata, callbacks);
+    ASSERT_TRUE(save->wait()) << save->getError();
+    EXPECT_TRUE(save->succeeded());
+    EXPECT_DOUBLE_EQ(save->getProgress(), 1.0);
+    save.reset();
+
+    auto load = m_storage->loadEventsAsync(m_filename, callbacks);
+    ASSERT_TRUE(load->wait()) << load->getError();
+    auto events = load->takeEvents();
+    EXPECT_EQ(events.size(), 100u);
+    EXPECT_EQ(load->getMetadata().description, "async");
+    load.reset();
+
+    EXPECT_TRUE(progressReported.load());
+    EXPECT_EQ(completions.load(), 2);
+}
+
+TEST_P(AsyncEventStorageTest, PrepareRunsBeforeSaving)
+{
+    std::thread::id callerThread = std::this_thread::get_id();
+    StorageTaskCallbacks callbacks;
+    callbacks.prepare =
+        [callerThread](std::vector<std::unique_ptr<Event>>& events,
+                       StorageMetadata& metadata)
+    {
+        EXPECT_NE(std::this_thread::get_id(), callerThread);
+        events.resize(10);
+        metadata.totalEvents = events.size();
+    };
+
+    auto save = m_storage->saveEventsAsync(
+        createEvents(50), m_filename, {}, callbacks);
+    ASSERT_TRUE(save->wait()) << save->getError();
+
+    std::vector<std::unique_ptr<Event>> loaded;
+    StorageMetadata metadata;
+    ASSERT_TRUE(m_storage->loadEvents(m_filename, loaded, metadata));
+    EXPECT_EQ(loaded.size(), 10u);
+    EXPECT_EQ(metadata.totalEvents, 10u);
+}
+
+TEST_P(AsyncEventStorageTest, StreamsLoadedEvents)
+{
+    constexpr int EVENT_COUNT = 10000;
+    StorageMetadata saved;
+    saved.description = "streamed";
+    saved.totalEvents = EVENT_COUNT;
+    std::vector<std::unique_ptr<Event>> events = createEvents(EVENT_COUNT);
+    ASSERT_TRUE(m_storage->saveEvents(events, m_filename, saved));
+
+    // Callbacks run on the storage thread one after another
+    bool metadataFirst = false;
+    std::string description;
+    int chunks = 0;
+    std::vector<std::unique_ptr<Event>> streamed;
+
+    StorageTaskCallbacks callbacks;
+    callbacks.metadata = [&](const StorageMetadata& metadata)
+    {
+        metadataFirst = streamed.empty();
+        description = metadata.description;
+    };
+    callbacks.events = [&](std::vector<std::unique_ptr<Event>> chunk)
+    {
+        EXPECT_FALSE(chunk.empty());
+        ++chunks;
+        for (auto& event : chunk)
+        {
+            streamed.push_back(std::move(event));
+        }
+    };
+
+    auto load = m_storage->loadEventsAsync(m_filename, callbacks);
+    ASSERT_TRUE(load->wait()) << load->getError();
+    EXPECT_TRUE(load->takeEvents().empty());
+
+    EXPECT_TRUE(metadataFirst);
+    EXPECT_EQ(description, "streamed");
+    ASSERT_EQ(streamed.size(), static_cast<size_t>(EVENT_COUNT));
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        ASSERT_EQ(streamed[i]->getMouseData()->position.x, i % 1000);
+        ASSERT_EQ(streamed[i]->getMouseData()->position.y, i / 1000);
+    }
+
+    // All formats decode incrementally
+    EXPECT_GT(chunks, 1);
+}
+
+TEST_P(AsyncEventStorageTest, LoadMissingFileFails)
+{
+    auto load = m_storage->loadEventsAsync(m_filename + ".missing");
+    EXPECT_FALSE(load->wait());
+    EXPECT_FALSE(load->succeeded());
+    EXPECT_FALSE(load->getError().empty());
+    EXPECT_TRUE(load->takeEvents().empty());
+}
+
+TEST_P(AsyncEventStorageTest, CancelStopsSave)
+{
+    // Hold the save in its first progress report until it was cancelled
+    std::promise<void> cancelled;
+    std::shared_future<void> cancelledFuture = cancelled.get_future().share();
+
+    StorageTaskCallbacks callbacks;
+    callbacks.progress = [cancelledFuture](std::uint64_t, std::uint64_t)
+    {
+        cancelledFuture.wait();
+    };
+
+    auto save = m_storage->saveEventsAsync(
+        createEvents(10000), m_filename, {}, callbacks);
+    save->cancel();
+    cancelled.set_value();
+
+    EXPECT_FALSE(save->wait());
+    EXPECT_TRUE(save->isCancelled());
+    EXPECT_EQ(save->getError(), StorageProgress::CANCELLED_ERROR);
+    EXPECT_FALSE(std::filesystem::exists(m_filename));
+}
+
+TEST_P(AsyncEventStorageTest, DestroyingTaskWaitsForIt)
+{
+    std::atomic<bool> completed{false};
+    StorageTaskCallbacks callbacks;
+    callbacks.completion = [&completed](bool)
+    {
+        completed = true;
+    };
+
+    auto save = m_storage->saveEventsAsync(
+        createEvents(1000), m_filename, {}, callbacks);
+    save.reset();
+
+    EXPECT_TRUE(completed.load());
+
+    // The storage is usable again afterwards
+    std::vector<std::unique_ptr<Event>> events = createEvents(5);
+    EXPECT_TRUE(m_storage->saveEvents(events, m_filename));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllFormats,
+                         AsyncEventStorageTest,
+                         ::testing::Values(StorageFormat::Json,
+                                           StorageFormat::Xml,
+                                           StorageFormat::Binary));
+
+TEST(StorageTaskTest, LoadsWithAFunction)
+{
+    std::vector<std::unique_ptr<Event>> streamed;
+    std::string description;
+    StorageTaskCallbacks callbacks;
+    callbacks.metadata = [&](const StorageMetadata& metadata)
+    {
+        description = metadata.description;
+    };
+    callbacks.events = [&](std::vector<std::unique_ptr<Event>> events)
+    {
+        for (auto& event : events)
+        {
+            streamed.push_back(std::move(event));
+        }
+    };
+
+    auto load = StorageTask::startLoad(
+        [](std::vector<std::unique_ptr<Event>>& events,
+           StorageMetadata& metadata,
+           std::string&)
+        {
+            events.push_back(EventFactory::createMouseMoveEvent({1, 2}));
+            metadata.description = "function";
+            return true;
+        },
+        callbacks);
+    ASSERT_TRUE(load->wait()) << load->getError();
+    EXPECT_EQ(description, "function");
+    ASSERT_EQ(streamed.size(), 1u);
+    EXPECT_EQ(streamed[0]->getMouseData()->position.y, 2);
+
+    auto failed = StorageTask::startLoad(
+        [](std::vector<std::unique_ptr<Event>>&,
+           StorageMetadata&,
+           std::string& error)
+        {
+            error = "unreadable";
+            return false;
+        },
+        {});
+    EXPECT_FALSE(failed->wait());
+    EXPECT_EQ(failed->getError(), "unreadable");
+}
@@ -0,0 +1,274 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/AutosaveService.hpp"
+#include "storage/RecordingJournal.hpp"
+#include "core/Event.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+class AutosaveServiceTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() /
+                      "mouserecorder_autosave_test";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+        m_journalPath = (m_directory / "recording.mre.autosave").string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    static AutosaveOptions manualOptions()
+    {
+        // Only flush(), stop() or a large backlog write the journal
+        AutosaveOptions options;
+        options.interval = std::chrono::hours(1);
+        options.eventThreshold = 1000000;
+        options.sync = false;
+        return options;
+    }
+
+    RecordingJournalContents readJournal()
+    {
+        RecordingJournalContents contents;
+        std::string error;
+        EXPECT_TRUE(RecordingJournal::read(m_journalPath, contents, error))
+            << error;
+        return contents;
+    }
+
+    std::filesystem::path m_directory;
+    std::string m_journalPath;
+};
+
+TEST_F(AutosaveServiceTest, JournalRoundTrip)
+{
+    StorageMetadata metadata;
+    metadata.description = "autosave test";
+    metadata.platform = "test";
+
+    RecordingJournal journal;
+    ASSERT_TRUE(journal.create(m_journalPath, "/tmp/target.mre", metadata));
+
+    BinaryEventStorage encoder;
+    std::vector<uint8_t> block;
+    encoder.serializeEvent(*EventFactory::createMouseMoveEvent({10, 20}),
+                           block);
+    encoder.serializeEvent(*EventFactory::createKeyPressEvent(65, "A"), block);
+    ASSERT_TRUE(journal.append(block, 2, false));
+
+    block.clear();
+    encoder.serializeEvent(*EventFactory::createMouseMoveEvent({30, 40}),
+                           block);
+    ASSERT_TRUE(journal.append(block, 1, true));
+    journal.close();
+
+    auto contents = readJournal();
+    EXPECT_EQ(contents.targetPath, "/tmp/target.mre");
+    EXPECT_EQ(contents.metadata.description, "autosave test");
+    EXPECT_EQ(contents.metadata.totalEvents, 3u);
+    EXPECT_FALSE(contents.truncated);
+    ASSERT_EQ(contents.events.size(), 3u);
+    EXPECT_EQ(contents.events[0]->getMouseData()->position.x, 10);
+    EXPECT_EQ(contents.events[1]->getKeyboardData()->keyName, "A");
+    EXPECT_EQ(contents.events[2]->getMouseData()->position.y, 40);
+}
+
+TEST_F(AutosaveServiceTest, TornBlockIsDropped)
+{
+    RecordingJournal journal;
+    ASSERT_TRUE(journal.create(m_journalPath, "", {}));
+
+    BinaryEventStorage encoder;
+    std::vector<uint8_t> block;
+    encoder.serializeEvent(*EventFactory::createMouseMoveEvent({1, 2}), block);
+    ASSERT_TRUE(journal.append(block, 1, false));
+    ASSERT_TRUE(journal.append(block, 1, false));
+    journal.close();
+
+    // Cut the second block short, as a crash during the append would
+    auto size = std::filesystem::file_size(m_journalPath);
+    std::filesystem::resize_file(m_journalPath, size - 3);
+
+    auto contents = readJournal();
+    EXPECT_TRUE(contents.truncated);
+    EXPECT_EQ(contents.events.size(), 1u);
+}
+
+TEST_F(AutosaveServiceTest, BlockWithUnwrittenEventsIsDropped)
+{
+    RecordingJournal journal;
+    ASSERT_TRUE(journal.create(m_journalPath, "", {}));
+
+    BinaryEventStorage encoder;
+    std::vector<uint8_t> block;
+    encoder.serializeEvent(*EventFactory::createMouseMoveEvent({1, 2}), block);
+    ASSERT_TRUE(journal.append(block, 1, false));
+    ASSERT_TRUE(journal.append(block, 1, false));
+    journal.close();
+
+    // Zero the events of the second block, as a crash can leave them when
+    // the file grew but the data never reached the disk
+    auto size = std::filesystem::file_size(m_journalPath);
+    {
+        std::fstream file(m_journalPath,
+                          std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(size - block.size()));
+        std::vector<char> zeros(block.size(), 0);
+        file.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+    }
+
+    auto contents = readJournal();
+    EXPECT_TRUE(contents.truncated);
+    EXPECT_EQ(contents.events.size(), 1u);
+}
+
+TEST_F(AutosaveServiceTest, RejectsOtherFiles)
+{
+    {
+        std::ofstream file(m_journalPath, std::ios::binary);
+        file << "not a journal";
+    }
+
+    RecordingJournalContents contents;
+    std::string error;
+    EXPECT_FALSE(RecordingJournal::read(m_journalPath, contents, error));
+    EXPECT_FALSE(error.empty());
+}
+
+TEST_F(AutosaveServiceTest, FlushAppendsOnlyNewEvents)
+{
+    AutosaveService autosave(manualOptions());
+    ASSERT_TRUE(autosave.start(m_journalPath, "target.mre"));
+
+    for (int i = 0; i < 10; ++i)
+    {
+        autosave.addEvent(*EventFactory::createMouseMoveEvent({i, i}));
+    }
+    ASSERT_TRUE(autosave.flush());
+    EXPECT_EQ(autosave.getSavedEventCount(), 10u);
+    auto sizeAfterFirst = std::filesystem::file_size(m_journalPath);
+
+    // Nothing new, nothing written
+    ASSERT_TRUE(autosave.flush());
+    EXPECT_EQ(std::filesystem::file_size(m_journalPath), sizeAfterFirst);
+
+    autosave.addEvent(*EventFactory::createMouseMoveEvent({100, 100}));
+    ASSERT_TRUE(autosave.flush());
+    auto sizeAfterSecond = std::filesystem::file_size(m_journalPath);
+    EXPECT_LT(sizeAfterSecond - sizeAfterFirst, sizeAfterFirst);
+
+    auto contents = readJournal();
+    ASSERT_EQ(contents.events.size(), 11u);
+    EXPECT_EQ(contents.events[10]->getMouseData()->position.x, 100);
+    EXPECT_EQ(contents.targetPath, "target.mre");
+}
+
+TEST_F(AutosaveServiceTest, StopWritesQueuedEventsAndKeepsJournal)
+{
+    AutosaveService autosave(manualOptions());
+    ASSERT_TRUE(autosave.start(m_journalPath, ""));
+    autosave.addEvent(*EventFactory::createKeyPressEvent(65, "A"));
+    autosave.addEvent(*EventFactory::createKeyReleaseEvent(65, "A"));
+
+    ASSERT_TRUE(autosave.stop());
+    EXPECT_FALSE(autosave.isRunning());
+    EXPECT_EQ(autosave.getSavedEventCount(), 2u);
+    ASSERT_TRUE(std::filesystem::exists(m_journalPath));
+
+    // Events after stop() are ignored
+    autosave.addEvent(*EventFactory::createKeyPressEvent(66, "B"));
+    EXPECT_EQ(readJournal().events.size(), 2u);
+}
+
+TEST_F(AutosaveServiceTest, ThresholdTriggersWrite)
+{
+    AutosaveOptions options = manualOptions();
+    options.eventThreshold = 5;
+    AutosaveService autosave(options);
+    ASSERT_TRUE(autosave.start(m_journalPath, ""));
+
+    for (int i = 0; i < 5; ++i)
+    {
+        autosave.addEvent(*EventFactory::createMouseMoveEvent({i, 0}));
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (autosave.getSavedEventCount() < 5 &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(autosave.getSavedEventCount(), 5u);
+}
+
+TEST_F(AutosaveServiceTest, IntervalTriggersWrite)
+{
+    AutosaveOptions options = manualOptions();
+    options.interval = std::chrono::milliseconds(20);
+    AutosaveService autosave(options);
+    ASSERT_TRUE(autosave.start(m_journalPath, ""));
+    autosave.addEvent(*EventFactory::createMouseMoveEvent({1, 1}));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (autosave.getSavedEventCount() < 1 &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(autosave.getSavedEventCount(), 1u);
+}
+
+TEST_F(AutosaveServiceTest, ConcurrentCaptureIsComplete)
+{
+    AutosaveOptions options = manualOptions();
+    options.eventThreshold = 64;
+    options.interval = std::chrono::milliseconds(1);
+    AutosaveService autosave(options);
+    ASSERT_TRUE(autosave.start(m_journalPath, ""));
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t)
+    {
+        producers.emplace_back(
+            [&autosave, t]()
+            {
+                for (int i = 0; i < 500; ++i)
+                {
+                    autosave.addEvent(
+                        *EventFactory::createMouseMoveEvent({t, i}));
+                }
+            });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_TRUE(autosave.stop());
+    EXPECT_EQ(autosave.getSavedEventCount(), 2000u);
+    EXPECT_EQ(readJournal().events.size(), 2000u);
+}
+
+TEST_F(AutosaveServiceTest, StartFailsForMissingDirectory)
+{
+    AutosaveService autosave(manualOptions());
+    EXPECT_FALSE(autosave.start(
+        (m_directory / "missing" / "journal.autosave").string(), ""));
+    EXPECT_FALSE(autosave.isRunning());
+    EXPECT_FALSE(autosave.getLastError().empty());
+}
@@ -0,0 +1,242 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/ColumnarEventStorage.hpp"
+#include "storage/BinaryEventStorage.hpp"
+#include "storage/EventStorageFactory.hpp"
+#include "storage/EventStreamWriter.hpp"
+#include "core/Event.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+constexpr int EVENT_COUNT = 10000;
+constexpr uint64_t START_MS = 1000000;
+
+/**
+ * @brief Mostly moves, with a click every 50th event and a key press
+ * every 20th, including negative coordinates and wheel deltas
+ */
+std::unique_ptr<Event> makeEvent(int i)
+{
+    auto timestamp =
+        Event::timestampFromMs(START_MS + static_cast<uint64_t>(i) * 7);
+    if (i % 20 == 19)
+    {
+        KeyboardEventData data;
+        data.keyCode = static_cast<uint32_t>(65 + i % 26);
+        data.keyName = std::string(1, static_cast<char>('A' + i % 26));
+        data.modifiers = i % 40 == 39 ? KeyModifier::Shift : KeyModifier::None;
+        data.isRepeated = i % 60 == 59;
+        return std::make_unique<Event>(EventType::KeyPress, data, timestamp);
+    }
+
+    MouseEventData data;
+    data.position = {i % 1920 - 100, -(i % 1080)};
+    if (i % 50 == 0)
+    {
+        data.button = MouseButton::Right;
+        return std::make_unique<Event>(EventType::MouseClick, data, timestamp);
+    }
+    if (i % 333 == 0)
+    {
+        data.wheelDelta = -120;
+        return std::make_unique<Event>(EventType::MouseWheel, data, timestamp);
+    }
+    return std::make_unique<Event>(EventType::MouseMove, data, timestamp);
+}
+
+std::vector<std::unique_ptr<Event>> makeEvents()
+{
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        events.push_back(makeEvent(i));
+    }
+    return events;
+}
+
+} // namespace
+
+class ColumnarEventStorageTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() /
+                      "mouserecorder_columnar_test";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+        m_filename = (m_directory / "recording.mrc").string();
+        m_events = makeEvents();
+
+        StorageMetadata metadata;
+        metadata.description = "columnar test";
+        ASSERT_TRUE(m_storage.saveEvents(m_events, m_filename, metadata))
+            << m_storage.getLastError();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::filesystem::path m_directory;
+    std::string m_filename;
+    std::vector<std::unique_ptr<Event>> m_events;
+    ColumnarEventStorage m_storage;
+};
+
+TEST_F(ColumnarEventStorageTest, RoundTripsEvents)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    StorageMetadata metadata;
+    ASSERT_TRUE(m_storage.loadEvents(m_filename, events, metadata))
+        << m_storage.getLastError();
+
+    ASSERT_EQ(events.size(), m_events.size());
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        EXPECT_EQ(events[i]->toString(), m_events[i]->toString());
+        EXPECT_EQ(events[i]->getTimestampMs(), m_events[i]->getTimestampMs());
+    }
+    const auto* key = events[59]->getKeyboardData();
+    ASSERT_NE(key, nullptr);
+    EXPECT_EQ(key->keyName, m_events[59]->getKeyboardData()->keyName);
+    EXPECT_TRUE(key->isRepeated);
+    EXPECT_EQ(events[0]->getMouseData()->position, Point(-100, 0));
+    EXPECT_EQ(metadata.description, "columnar test");
+    ASSERT_TRUE(metadata.statistics.has_value());
+    EXPECT_EQ(*metadata.statistics, RecordingStatistics::fromEvents(m_events));
+}
+
+TEST_F(ColumnarEventStorageTest, LoadsOnlyRequestedColumns)
+{
+    EventColumns columns;
+    StorageMetadata metadata;
+    ASSERT_TRUE(m_storage.loadColumns(
+        m_filename,
+        {EventColumn::Type, EventColumn::X, EventColumn::Y},
+        columns,
+        metadata))
+        << m_storage.getLastError();
+
+    EXPECT_EQ(columns.types.size(), static_cast<size_t>(EVENT_COUNT));
+    EXPECT_TRUE(columns.timestampsMs.empty());
+    EXPECT_TRUE(columns.keyNames.empty());
+    EXPECT_EQ(metadata.description, "columnar test");
+
+    // All click positions: mouse columns follow the mouse events in order
+    std::vector<Point> clicks;
+    size_t mouse = 0;
+    for (EventType type : columns.types)
+    {
+        if (type == EventType::MouseClick)
+        {
+            clicks.emplace_back(columns.x[mouse], columns.y[mouse]);
+        }
+        if (type != EventType::KeyPress)
+        {
+            ++mouse;
+        }
+    }
+    EXPECT_EQ(mouse, columns.x.size());
+    ASSERT_EQ(clicks.size(), static_cast<size_t>(EVENT_COUNT / 50));
+    EXPECT_EQ(clicks[1], m_events[50]->getMouseData()->position);
+}
+
+TEST_F(ColumnarEventStorageTest, LoadsKeyColumns)
+{
+    EventColumns columns;
+    StorageMetadata metadata;
+    ASSERT_TRUE(m_storage.loadColumns(
+        m_filename,
+        {EventColumn::Timestamp, EventColumn::KeyName, EventColumn::Repeated},
+        columns,
+        metadata));
+
+    ASSERT_EQ(columns.keyNames.size(), static_cast<size_t>(EVENT_COUNT / 20));
+    EXPECT_EQ(columns.keyNames[0], m_events[19]->getKeyboardData()->keyName);
+    EXPECT_EQ(columns.repeated.size(), columns.keyNames.size());
+    EXPECT_TRUE(columns.repeated[2]);
+    EXPECT_EQ(columns.timestampsMs.back(), m_events.back()->getTimestampMs());
+}
+
+TEST_F(ColumnarEventStorageTest, IsSmallerThanBinary)
+{
+    std::string binary = (m_directory / "recording.mre").string();
+    BinaryEventStorage storage;
+    ASSERT_TRUE(storage.saveEvents(m_events, binary));
+    EXPECT_LT(std::filesystem::file_size(m_filename) * 4,
+              std::filesystem::file_size(binary));
+}
+
+TEST_F(ColumnarEventStorageTest, StreamWriterMatchesSave)
+{
+    std::string streamed = (m_directory / "streamed.mrc").string();
+    auto writer = EventStreamWriter::create(StorageFormat::Columnar);
+    ASSERT_NE(writer, nullptr);
+    StorageMetadata metadata;
+    metadata.description = "columnar test";
+    ASSERT_TRUE(writer->open(streamed, metadata));
+    for (int chunk = 0; chunk < EVENT_COUNT / 1000; ++chunk)
+    {
+        std::vector<std::unique_ptr<Event>> events;
+        for (int i = 0; i < 1000; ++i)
+        {
+            events.push_back(makeEvent(chunk * 1000 + i));
+        }
+        ASSERT_TRUE(writer->write(events));
+    }
+    ASSERT_TRUE(writer->close()) << writer->getLastError();
+
+    std::vector<std::unique_ptr<Event>> events;
+    ASSERT_TRUE(m_storage.loadEvents(streamed, events, metadata));
+    ASSERT_EQ(events.size(), m_events.size());
+    EXPECT_EQ(events.back()->toString(), m_events.back()->toString());
+    EXPECT_EQ(metadata.totalEvents, static_cast<uint64_t>(EVENT_COUNT));
+    EXPECT_TRUE(metadata.statistics.has_value());
+}
+
+TEST_F(ColumnarEventStorageTest, FactoryKnowsTheFormat)
+{
+    EXPECT_EQ(EventStorageFactory::getFormatFromExtension(".mrc"),
+              StorageFormat::Columnar);
+    auto storage = EventStorageFactory::createStorageFromFilename(m_filename);
+    ASSERT_NE(storage, nullptr);
+    EXPECT_EQ(storage->getSupportedFormat(), StorageFormat::Columnar);
+    EXPECT_TRUE(storage->validateFile(m_filename));
+
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage->getFileMetadata(m_filename, metadata));
+    EXPECT_EQ(metadata.description, "columnar test");
+    EXPECT_TRUE(metadata.statistics.has_value());
+}
+
+TEST_F(ColumnarEventStorageTest, RejectsCorruptedFiles)
+{
+    // Cut the file short inside the column data
+    auto size = std::filesystem::file_size(m_filename);
+    std::filesystem::resize_file(m_filename, size - 10);
+    EXPECT_FALSE(m_storage.validateFile(m_filename));
+
+    std::vector<std::unique_ptr<Event>> events;
+    StorageMetadata metadata;
+    EXPECT_FALSE(m_storage.loadEvents(m_filename, events, metadata));
+    EXPECT_FALSE(m_storage.getLastError().empty());
+    EXPECT_TRUE(events.empty());
+
+    // A binary recording is not a columnar one
+    std::string binary = (m_directory / "recording.mre").string();
+    BinaryEventStorage storage;
+    ASSERT_TRUE(storage.saveEvents(m_events, binary));
+    EXPECT_FALSE(m_storage.validateFile(binary));
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/Crc32c.hpp"
+#include <string>
+#include <vector>
+
+using namespace MouseRecorder::Storage;
+
+TEST(Crc32cTest, MatchesKnownValues)
+{
+    std::string check = "123456789";
+    EXPECT_EQ(crc32c(0, check.data(), check.size()), 0xE3069283u);
+    EXPECT_EQ(crc32c(0, nullptr, 0), 0u);
+
+    std::vector<uint8_t> zeros(32, 0);
+    EXPECT_EQ(crc32c(0, zeros.data(), zeros.size()), 0x8A9136AAu);
+    std::vector<uint8_t> ones(32, 0xFF);
+    EXPECT_EQ(crc32c(0, ones.data(), ones.size()), 0x62A8AB43u);
+}
+
+TEST(Crc32cTest, CanBeComputedInPieces)
+{
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    uint32_t whole = crc32c(0, data.data(), data.size());
+
+    // Splits at every alignment, including inside the 8 byte steps
+    for (size_t split : {1u, 3u, 8u, 13u, 500u, 999u})
+    {
+        uint32_t crc = crc32c(0, data.data(), split);
+        crc = crc32c(crc, data.data() + split, data.size() - split);
+        EXPECT_EQ(crc, whole) << "split at " << split;
+    }
+}
@@ -0,0 +1,357 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/BinaryEventStorage.hpp"
+#include "storage/EventStorageFactory.hpp"
+#include "storage/EventStreamWriter.hpp"
+#include "core/Event.hpp"
+#include "core/StorageTask.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+constexpr int EVENT_COUNT = 10000;
+constexpr uint64_t START_MS = 1000000;
+constexpr uint64_t INTERVAL_MS = 10;
+
+/**
+ * @brief Move to (i, 0) at START_MS + i * INTERVAL_MS
+ */
+std::unique_ptr<Event> makeEvent(int i)
+{
+    MouseEventData data;
+    data.position = {i, 0};
+    return std::make_unique<Event>(
+        EventType::MouseMove,
+        data,
+        Event::timestampFromMs(START_MS + static_cast<uint64_t>(i) *
+                                              INTERVAL_MS));
+}
+
+/**
+ * @brief Invert the byte at offset of a file
+ */
+void flipByte(const std::string& filename, std::streamoff offset)
+{
+    std::fstream file(filename,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(offset);
+    char byte = 0;
+    file.get(byte);
+    file.seekp(offset);
+    file.put(static_cast<char>(~byte));
+}
+
+/**
+ * @brief Remembers the last progress report, optionally cancelling
+ */
+class RecordingProgress : public StorageProgress
+{
+  public:
+    bool update(std::uint64_t /*done*/, std::uint64_t total) override
+    {
+        lastTotal = total;
+        return !cancel;
+    }
+
+    std::uint64_t lastTotal{0};
+    bool cancel{false};
+};
+
+} // namespace
+
+class EventRangeLoadingTest : public ::testing::TestWithParam<StorageFormat>
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() /
+                      "mouserecorder_range_test";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+
+        m_storage = EventStorageFactory::createStorage(GetParam());
+        ASSERT_NE(m_storage, nullptr);
+        m_filename =
+            (m_directory / ("recording" + m_storage->getFileExtension()))
+                .string();
+
+        std::vector<std::unique_ptr<Event>> events;
+        for (int i = 0; i < EVENT_COUNT; ++i)
+        {
+            events.push_back(makeEvent(i));
+        }
+        StorageMetadata metadata;
+        metadata.description = "range test";
+        ASSERT_TRUE(m_storage->saveEvents(events, m_filename, metadata));
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    static void expectPositions(
+        const std::vector<std::unique_ptr<Event>>& events, int first, int count)
+    {
+        ASSERT_EQ(events.size(), static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(events[i]->getMouseData()->position.x, first + i);
+        }
+    }
+
+    std::filesystem::path m_directory;
+    std::unique_ptr<IEventStorage> m_storage;
+    std::string m_filename;
+};
+
+TEST_P(EventRangeLoadingTest, LoadsIndexRange)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    StorageMetadata metadata;
+    ASSERT_TRUE(m_storage->loadEventsRange(
+        m_filename, EventRange::byIndex(5000, 100), events, metadata))
+        << m_storage->getLastError();
+
+    expectPositions(events, 5000, 100);
+    EXPECT_EQ(metadata.description, "range test");
+    EXPECT_TRUE(m_storage->getLastError().empty());
+}
+
+TEST_P(EventRangeLoadingTest, LoadsTimeRange)
+{
+    // Both ends are included: events 2000 to 2100
+    std::vector<std::unique_ptr<Event>> events;
+    StorageMetadata metadata;
+    ASSERT_TRUE(m_storage->loadEventsRange(
+        m_filename, EventRange::byTime(20000, 21000), events, metadata))
+        << m_storage->getLastError();
+
+    expectPositions(events, 2000, 101);
+}
+
+TEST_P(EventRangeLoadingTest, RangesAtTheEdges)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    StorageMetadata metadata;
+
+    ASSERT_TRUE(m_storage->loadEventsRange(
+        m_filename, EventRange::byIndex(0, 3), events, metadata));
+    expectPositions(events, 0, 3);
+
+    auto tail = EventRange::byIndex(EVENT_COUNT - 2, 10);
+    ASSERT_TRUE(m_storage->loadEventsRange(m_filename, tail, events, metadata));
+    expectPositions(events, EVENT_COUNT - 2, 2);
+
+    ASSERT_TRUE(m_storage->loadEventsRange(
+        m_filename, EventRange::byIndex(EVENT_COUNT, 10), events, metadata));
+    EXPECT_TRUE(events.empty());
+
+    ASSERT_TRUE(m_storage->loadEventsRange(
+        m_filename, EventRange::byTime(0, UINT64_MAX), events, metadata));
+    expectPositions(events, 0, EVENT_COUNT);
+}
+
+TEST_P(EventRangeLoadingTest, CancellationFailsTheLoad)
+{
+    RecordingProgress progress;
+    progress.cancel = true;
+    m_storage->setProgress(&progress);
+
+    std::vector<std::unique_ptr<Event>> events;
+    StorageMetadata metadata;
+    EXPECT_FALSE(m_storage->loadEventsRange(
+        m_filename, EventRange::byIndex(5000, 100), events, metadata));
+    EXPECT_EQ(m_storage->getLastError(), StorageProgress::CANCELLED_ERROR);
+    EXPECT_TRUE(events.empty());
+    m_storage->setProgress(nullptr);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllFormats,
+                         EventRangeLoadingTest,
+                         ::testing::Values(StorageFormat::Json,
+                                           StorageFormat::Xml,
+                                           StorageFormat::Binary,
+                                           StorageFormat::Columnar));
+
+class BinaryRangeLoadingTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() /
+                      "mouserecorder_binary_range_test";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+        m_filename = (m_directory / "recording.mre").string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::filesystem::path m_directory;
+    std::string m_filename;
+};
+
+TEST_F(BinaryRangeLoadingTest, ReadsOnlyOverlappingBlocks)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        events.push_back(makeEvent(i));
+    }
+    BinaryEventStorage storage;
+    ASSERT_TRUE(storage.saveEvents(events, m_filename));
+
+    RecordingProgress progress;
+    storage.setProgress(&progress);
+    StorageMetadata metadata;
+
+    // Events 5000 to 5099 lie in the second block
+    ASSERT_TRUE(storage.loadEventsRange(
+        m_filename, EventRange::byIndex(5000, 100), events, metadata));
+    EXPECT_EQ(events.size(), 100u);
+    EXPECT_EQ(progress.lastTotal, BinaryEventStorage::INDEX_BLOCK_EVENTS);
+
+    // 50 s to 60 s are events 5000 to 6000, still the second block
+    ASSERT_TRUE(storage.loadEventsRange(
+        m_filename, EventRange::byTime(50000, 60000), events, metadata));
+    EXPECT_EQ(events.size(), 1001u);
+    EXPECT_EQ(progress.lastTotal, BinaryEventStorage::INDEX_BLOCK_EVENTS);
+    storage.setProgress(nullptr);
+}
+
+TEST_F(BinaryRangeLoadingTest, StreamWriterFilesAreIndexed)
+{
+    auto writer = EventStreamWriter::create(StorageFormat::Binary);
+    ASSERT_TRUE(writer->open(m_filename, {}));
+    for (int chunk = 0; chunk < EVENT_COUNT / 1000; ++chunk)
+    {
+        std::vector<std::unique_ptr<Event>> events;
+        for (int i = 0; i < 1000; ++i)
+        {
+            events.push_back(makeEvent(chunk * 1000 + i));
+        }
+        ASSERT_TRUE(writer->write(events));
+    }
+    ASSERT_TRUE(writer->close());
+
+    BinaryEventStorage storage;
+    RecordingProgress progress;
+    storage.setProgress(&progress);
+    std::vector<std::unique_ptr<Event>> events;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage.loadEventsRange(
+        m_filename, EventRange::byIndex(9000, 500), events, metadata));
+    ASSERT_EQ(events.size(), 500u);
+    EXPECT_EQ(events.front()->getMouseData()->position.x, 9000);
+    EXPECT_LT(progress.lastTotal, static_cast<uint64_t>(EVENT_COUNT));
+    storage.setProgress(nullptr);
+
+    // The index does not get in the way of full loads
+    ASSERT_TRUE(storage.loadEvents(m_filename, events, metadata));
+    EXPECT_EQ(events.size(), static_cast<size_t>(EVENT_COUNT));
+    EXPECT_TRUE(metadata.statistics.has_value());
+}
+
+TEST_F(BinaryRangeLoadingTest, CompressedFilesAreStreamed)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        events.push_back(makeEvent(i));
+    }
+    BinaryEventStorage storage;
+    storage.setCompressionLevel(6);
+    ASSERT_TRUE(storage.saveEvents(events, m_filename));
+
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage.loadEventsRange(
+        m_filename, EventRange::byTime(100, 200), events, metadata))
+        << storage.getLastError();
+    ASSERT_EQ(events.size(), 11u);
+    EXPECT_EQ(events.front()->getMouseData()->position.x, 10);
+    EXPECT_TRUE(storage.getLastError().empty());
+}
+
+TEST_F(BinaryRangeLoadingTest, DetectsCorruptedBlocks)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        events.push_back(makeEvent(i));
+    }
+    BinaryEventStorage storage;
+    ASSERT_TRUE(storage.saveEvents(events, m_filename));
+    flipByte(m_filename,
+             static_cast<std::streamoff>(
+                 std::filesystem::file_size(m_filename) / 2));
+
+    StorageMetadata metadata;
+    EXPECT_FALSE(storage.loadEvents(m_filename, events, metadata));
+    EXPECT_NE(storage.getLastError().find("checksum mismatch in block"),
+              std::string::npos)
+        << storage.getLastError();
+    EXPECT_TRUE(events.empty());
+
+    // Blocks before the damage are still readable
+    ASSERT_TRUE(storage.loadEventsRange(
+        m_filename, EventRange::byIndex(0, 100), events, metadata))
+        << storage.getLastError();
+    EXPECT_EQ(events.size(), 100u);
+}
+
+TEST_F(BinaryRangeLoadingTest, DetectsCorruptedMetadata)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        events.push_back(makeEvent(i));
+    }
+    StorageMetadata metadata;
+    metadata.description = "checksummed";
+    BinaryEventStorage storage;
+    ASSERT_TRUE(storage.saveEvents(events, m_filename, metadata));
+
+    // Inside the description
+    flipByte(m_filename, 40);
+    EXPECT_FALSE(storage.loadEvents(m_filename, events, metadata));
+    EXPECT_NE(storage.getLastError().find("metadata checksum mismatch"),
+              std::string::npos)
+        << storage.getLastError();
+}
+
+TEST_F(BinaryRangeLoadingTest, StreamWriterFilesAreChecksummed)
+{
+    auto writer = EventStreamWriter::create(StorageFormat::Binary);
+    ASSERT_TRUE(writer->open(m_filename, {}));
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < EVENT_COUNT; ++i)
+    {
+        events.push_back(makeEvent(i));
+    }
+    ASSERT_TRUE(writer->write(events));
+    ASSERT_TRUE(writer->close());
+
+    BinaryEventStorage storage;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage.loadEvents(m_filename, events, metadata))
+        << storage.getLastError();
+    EXPECT_EQ(events.size(), static_cast<size_t>(EVENT_COUNT));
+
+    flipByte(m_filename,
+             static_cast<std::streamoff>(
+                 std::filesystem::file_size(m_filename) / 2));
+    EXPECT_FALSE(storage.loadEvents(m_filename, events, metadata));
+}
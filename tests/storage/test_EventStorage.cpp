@@ -178,6 +178,130 @@ TEST_F(EventStorageTest, BinaryStorageSaveAndLoad)
     verifyEventsEqual(m_testEvents, loadedEvents);
 }
 
+TEST_F(EventStorageTest, BinaryStorageLoadsFilesLargerThanReadBlock)
+{
+    BinaryEventStorage storage;
+
+    // Several MiB of events with long key names, so events straddle the
+    // boundaries of the blocks the file is read in
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < 20000; ++i)
+    {
+        events.push_back(EventFactory::createKeyPressEvent(
+            static_cast<uint32_t>(i), std::string(100 + i % 300, 'k')));
+        events.push_back(EventFactory::createMouseMoveEvent({i, -i}));
+    }
+    ASSERT_TRUE(storage.saveEvents(events, m_binaryFile));
+    ASSERT_GT(std::filesystem::file_size(m_binaryFile), 4u << 20);
+
+    std::vector<std::unique_ptr<Event>> loadedEvents;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage.loadEvents(m_binaryFile, loadedEvents, metadata));
+    verifyEventsEqual(events, loadedEvents);
+}
+
+TEST_F(EventStorageTest, BinaryStorageWritesLittleEndianHeader)
+{
+    BinaryEventStorage storage;
+    ASSERT_TRUE(
+        storage.saveEvents(createEventCopies(m_testEvents), m_binaryFile));
+
+    std::ifstream file(m_binaryFile, std::ios::binary);
+    std::vector<uint8_t> header(BinaryEventStorage::METADATA_OFFSET);
+    file.read(reinterpret_cast<char*>(header.data()), header.size());
+    ASSERT_TRUE(file);
+
+    // "MRRE", version 2, then the event count as 64 bits
+    const std::vector<uint8_t> expected = {
+        0x45, 0x52, 0x52, 0x4D, 2, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0};
+    EXPECT_EQ(std::vector<uint8_t>(header.begin(), header.begin() + 16),
+              expected);
+}
+
+TEST_F(EventStorageTest, BinaryStorageLoadsLegacyFiles)
+{
+    // Version 1: 32-bit metadata size, metadata, 32-bit event count
+    auto appendUint32 = [](std::vector<uint8_t>& buffer, uint32_t value)
+    {
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            buffer.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    };
+
+    BinaryEventStorage storage;
+    StorageMetadata metadata;
+    metadata.description = "legacy";
+    std::vector<uint8_t> metadataBuffer;
+    storage.serializeMetadata(metadata, metadataBuffer);
+
+    std::vector<uint8_t> data;
+    appendUint32(data, BinaryEventStorage::MAGIC_NUMBER);
+    appendUint32(data, BinaryEventStorage::LEGACY_FORMAT_VERSION);
+    appendUint32(data, static_cast<uint32_t>(metadataBuffer.size()));
+    data.insert(data.end(), metadataBuffer.begin(), metadataBuffer.end());
+    appendUint32(data, static_cast<uint32_t>(m_testEvents.size()));
+    for (const auto& event : m_testEvents)
+    {
+        storage.serializeEvent(*event, data);
+    }
+    std::ofstream(m_binaryFile, std::ios::binary)
+        .write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    EXPECT_TRUE(storage.validateFile(m_binaryFile));
+    StorageMetadata fileMetadata;
+    ASSERT_TRUE(storage.getFileMetadata(m_binaryFile, fileMetadata));
+    EXPECT_EQ(fileMetadata.description, "legacy");
+
+    std::vector<std::unique_ptr<Event>> loadedEvents;
+    ASSERT_TRUE(storage.loadEvents(m_binaryFile, loadedEvents, fileMetadata))
+        << storage.getLastError();
+    verifyEventsEqual(m_testEvents, loadedEvents);
+}
+
+TEST_F(EventStorageTest, BinaryStorageLoadsUnfinishedFiles)
+{
+    // A streaming writer that never finished leaves the event count
+    // unknown and may have been cut off in the middle of an event
+    BinaryEventStorage storage;
+    std::vector<uint8_t> data;
+    storage.serializeHeader({}, BinaryEventStorage::UNKNOWN_EVENT_COUNT, data);
+    for (const auto& event : m_testEvents)
+    {
+        storage.serializeEvent(*event, data);
+    }
+    data.resize(data.size() - 3);
+    std::ofstream(m_binaryFile, std::ios::binary)
+        .write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    std::vector<std::unique_ptr<Event>> loadedEvents;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage.loadEvents(m_binaryFile, loadedEvents, metadata))
+        << storage.getLastError();
+    m_testEvents.pop_back();
+    verifyEventsEqual(m_testEvents, loadedEvents);
+}
+
+TEST_F(EventStorageTest, BinaryStorageStopsAtTheEndOfShortFiles)
+{
+    // The header claims more events than the file holds
+    BinaryEventStorage storage;
+    std::vector<uint8_t> data;
+    storage.serializeHeader({}, 100000, data);
+    for (const auto& event : m_testEvents)
+    {
+        storage.serializeEvent(*event, data);
+    }
+    std::ofstream(m_binaryFile, std::ios::binary)
+        .write(reinterpret_cast<const char*>(data.data()), data.size());
+
+    std::vector<std::unique_ptr<Event>> loadedEvents;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage.loadEvents(m_binaryFile, loadedEvents, metadata))
+        << storage.getLastError();
+    verifyEventsEqual(m_testEvents, loadedEvents);
+}
+
 TEST_F(EventStorageTest, StorageFactory)
 {
     // Test JSON storage creation
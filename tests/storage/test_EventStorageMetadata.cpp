@@ -8,6 +8,7 @@
 #include "storage/XmlEventStorage.hpp"
 #include "storage/BinaryEventStorage.hpp"
 #include "storage/EventStorageFactory.hpp"
+#include "storage/EventStreamWriter.hpp"
 #include "core/Event.hpp"
 #include <filesystem>
 #include <fstream>
@@ -245,3 +246,85 @@ TEST_F(EventStorageMetadataTest, MetadataWithSpecialCharacters)
         std::filesystem::remove(filename);
     }
 }
+
+TEST_F(EventStorageMetadataTest, StatisticsSavedWithMetadata)
+{
+    const RecordingStatistics expected =
+        RecordingStatistics::fromEvents(m_testEvents);
+
+    for (StorageFormat format :
+         {StorageFormat::Json, StorageFormat::Xml, StorageFormat::Binary})
+    {
+        SCOPED_TRACE(static_cast<int>(format));
+        auto storage = EventStorageFactory::createStorage(format);
+        const std::string filename =
+            "test_metadata" + EventStorageFactory::getFileExtension(format);
+        ASSERT_TRUE(storage->saveEvents(m_testEvents, filename, m_testMetadata))
+            << storage->getLastError();
+
+        std::vector<std::unique_ptr<Event>> loadedEvents;
+        StorageMetadata loadedMetadata;
+        ASSERT_TRUE(
+            storage->loadEvents(filename, loadedEvents, loadedMetadata));
+        ASSERT_TRUE(loadedMetadata.statistics.has_value());
+        EXPECT_EQ(*loadedMetadata.statistics, expected);
+
+        // Available without loading the events
+        StorageMetadata fileMetadata;
+        ASSERT_TRUE(storage->getFileMetadata(filename, fileMetadata));
+        verifyMetadata(m_testMetadata, fileMetadata);
+        ASSERT_TRUE(fileMetadata.statistics.has_value());
+        EXPECT_EQ(*fileMetadata.statistics, expected);
+        EXPECT_TRUE(fileMetadata.statistics->keysUsed.contains("A"));
+    }
+}
+
+TEST_F(EventStorageMetadataTest, StreamWriterSavesStatistics)
+{
+    const RecordingStatistics expected =
+        RecordingStatistics::fromEvents(m_testEvents);
+
+    for (StorageFormat format :
+         {StorageFormat::Json, StorageFormat::Xml, StorageFormat::Binary})
+    {
+        SCOPED_TRACE(static_cast<int>(format));
+        const std::string filename =
+            "test_metadata" + EventStorageFactory::getFileExtension(format);
+        auto writer = EventStreamWriter::create(format);
+        ASSERT_TRUE(writer->open(filename, m_testMetadata));
+        ASSERT_TRUE(writer->write(m_testEvents));
+        ASSERT_TRUE(writer->close());
+
+        auto storage = EventStorageFactory::createStorage(format);
+        StorageMetadata fileMetadata;
+        ASSERT_TRUE(storage->getFileMetadata(filename, fileMetadata));
+        ASSERT_TRUE(fileMetadata.statistics.has_value());
+        EXPECT_EQ(*fileMetadata.statistics, expected);
+        EXPECT_EQ(fileMetadata.totalEvents, m_testEvents.size());
+    }
+}
+
+TEST_F(EventStorageMetadataTest, BinaryWithoutStatisticsStillLoads)
+{
+    const std::string filename = "test_metadata.mre";
+    BinaryEventStorage storage;
+    ASSERT_TRUE(storage.saveEvents(m_testEvents, filename, m_testMetadata));
+
+    // Files written before the statistics footer end after the last event
+    std::vector<uint8_t> footer;
+    storage.serializeStatisticsFooter(
+        RecordingStatistics::fromEvents(m_testEvents), footer);
+    std::filesystem::resize_file(
+        filename, std::filesystem::file_size(filename) - footer.size());
+
+    std::vector<std::unique_ptr<Event>> loadedEvents;
+    StorageMetadata loadedMetadata;
+    ASSERT_TRUE(storage.loadEvents(filename, loadedEvents, loadedMetadata))
+        << storage.getLastError();
+    EXPECT_EQ(loadedEvents.size(), m_testEvents.size());
+    EXPECT_FALSE(loadedMetadata.statistics.has_value());
+
+    StorageMetadata fileMetadata;
+    ASSERT_TRUE(storage.getFileMetadata(filename, fileMetadata));
+    EXPECT_FALSE(fileMetadata.statistics.has_value());
+}
@@ -0,0 +1,340 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/BinaryEventStorage.hpp"
+#include "storage/EventStorageFactory.hpp"
+#include "storage/EventStreamWriter.hpp"
+#include "storage/EventTranscoder.hpp"
+#include "core/Event.hpp"
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+std::vector<std::unique_ptr<Event>> createEvents(int count)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < count; ++i)
+    {
+        auto timestamp = Event::timestampFromMs(1000 + i * 10);
+        if (i % 100 == 50)
+        {
+            KeyboardEventData key;
+            key.keyCode = 60;
+            key.keyName = "<&\">";
+            events.push_back(std::make_unique<Event>(
+                EventType::KeyPress, key, timestamp));
+            continue;
+        }
+
+        MouseEventData mouse;
+        mouse.position = {i % 1000, i / 1000};
+        events.push_back(
+            std::make_unique<Event>(EventType::MouseMove, mouse, timestamp));
+    }
+    return events;
+}
+
+std::string tempFile(const std::string& name, StorageFormat format)
+{
+    return (std::filesystem::temp_directory_path() /
+            ("mouserecorder_transcode_" + name +
+             EventStorageFactory::getFileExtension(format)))
+        .string();
+}
+
+} // namespace
+
+class EventTranscoderTest
+    : public ::testing::TestWithParam<std::tuple<StorageFormat, StorageFormat>>
+{
+  protected:
+    void SetUp() override
+    {
+        m_input = tempFile("input", std::get<0>(GetParam()));
+        m_output = tempFile("output", std::get<1>(GetParam()));
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(m_input);
+        std::filesystem::remove(m_output);
+    }
+
+    void saveInput(const std::vector<std::unique_ptr<Event>>& events,
+                   const StorageMetadata& metadata = {})
+    {
+        auto storage =
+            EventStorageFactory::createStorage(std::get<0>(GetParam()));
+        ASSERT_TRUE(storage->saveEvents(events, m_input, metadata))
+            << storage->getLastError();
+    }
+
+    void loadOutput(std::vector<std::unique_ptr<Event>>& events,
+                    StorageMetadata& metadata)
+    {
+        auto storage =
+            EventStorageFactory::createStorage(std::get<1>(GetParam()));
+        ASSERT_TRUE(storage->loadEvents(m_output, events, metadata))
+            << storage->getLastError();
+    }
+
+    std::string m_input;
+    std::string m_output;
+};
+
+TEST_P(EventTranscoderTest, ConvertsAllEvents)
+{
+    constexpr int EVENT_COUNT = 10000;
+    auto events = createEvents(EVENT_COUNT);
+    StorageMetadata metadata;
+    metadata.description = "archived";
+    metadata.platform = "Linux";
+    saveInput(events, metadata);
+
+    TranscodeOptions options;
+    options.outputFormat = std::get<1>(GetParam());
+    EventTranscoder transcoder(options);
+    ASSERT_TRUE(transcoder.transcode(m_input, m_output))
+        << transcoder.getLastError();
+    EXPECT_EQ(transcoder.getEventsRead(), static_cast<size_t>(EVENT_COUNT));
+    EXPECT_EQ(transcoder.getEventsWritten(), static_cast<size_t>(EVENT_COUNT));
+
+    std::vector<std::unique_ptr<Event>> converted;
+    StorageMetadata convertedMetadata;
+    loadOutput(converted, convertedMetadata);
+
+    EXPECT_EQ(convertedMetadata.description, "archived");
+    EXPECT_EQ(convertedMetadata.platform, "Linux");
+    EXPECT_EQ(convertedMetadata.totalEvents, static_cast<size_t>(EVENT_COUNT));
+    EXPECT_EQ(convertedMetadata.totalDurationMs,
+              static_cast<uint64_t>((EVENT_COUNT - 1) * 10));
+
+    ASSERT_EQ(converted.size(), events.size());
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        ASSERT_EQ(converted[i]->getType(), events[i]->getType()) << i;
+        ASSERT_EQ(converted[i]->getTimestampMs(), events[i]->getTimestampMs());
+        if (events[i]->isKeyboardEvent())
+        {
+            ASSERT_EQ(converted[i]->getKeyboardData()->keyName, "<&\">");
+        }
+        else
+        {
+            ASSERT_EQ(converted[i]->getMouseData()->position,
+                      events[i]->getMouseData()->position);
+        }
+    }
+}
+
+TEST_P(EventTranscoderTest, ConvertsEmptyRecording)
+{
+    saveInput({});
+
+    TranscodeOptions options;
+    options.outputFormat = std::get<1>(GetParam());
+    EventTranscoder transcoder(options);
+    ASSERT_TRUE(transcoder.transcode(m_input, m_output))
+        << transcoder.getLastError();
+
+    std::vector<std::unique_ptr<Event>> converted;
+    StorageMetadata metadata;
+    loadOutput(converted, metadata);
+    EXPECT_TRUE(converted.empty());
+    EXPECT_EQ(metadata.totalEvents, 0u);
+}
+
+TEST_P(EventTranscoderTest, OptimizesMouseMovements)
+{
+    saveInput(createEvents(5000));
+
+    TranscodeOptions options;
+    options.outputFormat = std::get<1>(GetParam());
+    options.optimize = true;
+    EventTranscoder transcoder(options);
+    ASSERT_TRUE(transcoder.transcode(m_input, m_output))
+        << transcoder.getLastError();
+    EXPECT_LT(transcoder.getEventsWritten(), transcoder.getEventsRead());
+
+    std::vector<std::unique_ptr<Event>> converted;
+    StorageMetadata metadata;
+    loadOutput(converted, metadata);
+    EXPECT_EQ(converted.size(), transcoder.getEventsWritten());
+    EXPECT_EQ(metadata.totalEvents, converted.size());
+}
+
+TEST_P(EventTranscoderTest, FailureLeavesNoOutput)
+{
+    // Cut a valid recording off in the middle of its events; binary loads
+    // keep what they can decode, so break the header of those instead
+    saveInput(createEvents(1000));
+    if (std::get<0>(GetParam()) == StorageFormat::Binary)
+    {
+        std::ofstream(m_input, std::ios::binary | std::ios::trunc)
+            << "not a recording";
+    }
+    else
+    {
+        std::filesystem::resize_file(
+            m_input, std::filesystem::file_size(m_input) / 2);
+    }
+
+    TranscodeOptions options;
+    options.outputFormat = std::get<1>(GetParam());
+    EventTranscoder transcoder(options);
+    EXPECT_FALSE(transcoder.transcode(m_input, m_output));
+    EXPECT_FALSE(transcoder.getLastError().empty());
+    EXPECT_FALSE(std::filesystem::exists(m_output));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    FormatPairs,
+    EventTranscoderTest,
+    ::testing::Combine(::testing::Values(StorageFormat::Json,
+                                         StorageFormat::Xml,
+                                         StorageFormat::Binary),
+                       ::testing::Values(StorageFormat::Json,
+                                         StorageFormat::Xml,
+                                         StorageFormat::Binary)));
+
+TEST(EventTranscoderFilesTest, TranscodesFilesInParallel)
+{
+    constexpr int FILE_COUNT = 8;
+    auto xmlStorage = EventStorageFactory::createStorage(StorageFormat::Xml);
+    std::vector<TranscodeJob> jobs;
+    for (int i = 0; i < FILE_COUNT; ++i)
+    {
+        TranscodeJob job;
+        job.input = tempFile("batch" + std::to_string(i), StorageFormat::Xml);
+        job.output =
+            tempFile("batch" + std::to_string(i), StorageFormat::Binary);
+        ASSERT_TRUE(
+            xmlStorage->saveEvents(createEvents(100 * (i + 1)), job.input));
+        jobs.push_back(std::move(job));
+    }
+
+    // One input is missing
+    std::filesystem::remove(jobs[3].input);
+
+    size_t failures = EventTranscoder::transcodeFiles(jobs, {}, 4);
+    EXPECT_EQ(failures, 1u);
+
+    auto binaryStorage =
+        EventStorageFactory::createStorage(StorageFormat::Binary);
+    for (int i = 0; i < FILE_COUNT; ++i)
+    {
+        const TranscodeJob& job = jobs[i];
+        if (i == 3)
+        {
+            EXPECT_FALSE(job.success);
+            EXPECT_FALSE(job.error.empty());
+            EXPECT_FALSE(std::filesystem::exists(job.output));
+            continue;
+        }
+
+        EXPECT_TRUE(job.success) << job.error;
+        EXPECT_EQ(job.eventsWritten, static_cast<size_t>(100 * (i + 1)));
+
+        std::vector<std::unique_ptr<Event>> events;
+        StorageMetadata metadata;
+        ASSERT_TRUE(binaryStorage->loadEvents(job.output, events, metadata));
+        EXPECT_EQ(events.size(), static_cast<size_t>(100 * (i + 1)));
+
+        std::filesystem::remove(job.input);
+        std::filesystem::remove(job.output);
+    }
+}
+
+TEST(EventTranscoderFilesTest, StoresRepeatedSegmentsOnce)
+{
+    // The same keys typed 300 times, 30 ms apart
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < 300 * 2; ++i)
+    {
+        KeyboardEventData key;
+        key.keyName = i % 2 == 0 ? "A" : "B";
+        key.keyCode = i % 2 == 0 ? 65 : 66;
+        events.push_back(std::make_unique<Event>(
+            EventType::KeyPress, key, Event::timestampFromMs(1000 + i * 30)));
+    }
+    std::string input = tempFile("repeated", StorageFormat::Binary);
+    std::string output = tempFile("looped", StorageFormat::Binary);
+    BinaryEventStorage storage;
+    ASSERT_TRUE(storage.saveEvents(events, input));
+
+    TranscodeOptions options;
+    options.detectLoops = true;
+    EventTranscoder transcoder(options);
+    ASSERT_TRUE(transcoder.transcode(input, output))
+        << transcoder.getLastError();
+    EXPECT_EQ(transcoder.getEventsRead(), events.size());
+    EXPECT_LT(transcoder.getEventsWritten(), events.size());
+
+    LoopedRecording recording;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage.loadLoopedEvents(output, recording, metadata))
+        << storage.getLastError();
+    EXPECT_FALSE(recording.index.empty());
+    EXPECT_EQ(recording.getExpandedCount(), events.size());
+    EXPECT_EQ(metadata.totalEvents, events.size());
+
+    // Other formats have no loop table
+    std::filesystem::remove(output);
+    options.outputFormat = StorageFormat::Xml;
+    EventTranscoder xmlTranscoder(options);
+    EXPECT_FALSE(xmlTranscoder.transcode(input, output));
+    EXPECT_FALSE(std::filesystem::exists(output));
+
+    std::filesystem::remove(input);
+}
+
+TEST(EventStreamWriterTest, WriterRemovesUnclosedFile)
+{
+    std::string filename = tempFile("unclosed", StorageFormat::Binary);
+    {
+        auto writer = EventStreamWriter::create(StorageFormat::Binary);
+        ASSERT_TRUE(writer->open(filename, {}));
+        ASSERT_TRUE(writer->write(createEvents(10)));
+
+        // Written to a temporary file until closed
+        EXPECT_FALSE(std::filesystem::exists(filename));
+    }
+    EXPECT_FALSE(std::filesystem::exists(filename));
+
+    // Nor did the temporary file survive the writer
+    const std::string prefix =
+        std::filesystem::path(filename).filename().string();
+    for (const auto& entry : std::filesystem::directory_iterator(
+             std::filesystem::temp_directory_path()))
+    {
+        EXPECT_FALSE(entry.path().filename().string().starts_with(prefix))
+            << entry.path();
+    }
+}
+
+TEST(EventStreamWriterTest, UnclosedWriterKeepsExistingFile)
+{
+    std::string filename = tempFile("existing", StorageFormat::Json);
+    auto storage = EventStorageFactory::createStorage(StorageFormat::Json);
+    ASSERT_TRUE(storage->saveEvents(createEvents(20), filename));
+    {
+        auto writer = EventStreamWriter::create(StorageFormat::Json);
+        writer->setSyncOnClose(false);
+        ASSERT_TRUE(writer->open(filename, {}));
+        ASSERT_TRUE(writer->write(createEvents(5)));
+    }
+
+    std::vector<std::unique_ptr<Event>> events;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage->loadEvents(filename, events, metadata));
+    EXPECT_EQ(events.size(), 20u);
+    std::filesystem::remove(filename);
+}
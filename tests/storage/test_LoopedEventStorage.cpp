@@ -0,0 +1,202 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/BinaryEventStorage.hpp"
+#include "core/Event.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+/**
+ * @brief A few moves, then the same keys typed 500 times, 40 ms apart
+ */
+EventVector makeEvents()
+{
+    EventVector events;
+    uint64_t timeMs = 1000;
+    for (int i = 0; i < 5; ++i, timeMs += 10)
+    {
+        MouseEventData data;
+        data.position = {i, i};
+        events.push_back(std::make_unique<Event>(
+            EventType::MouseMove, data, Event::timestampFromMs(timeMs)));
+    }
+    for (int i = 0; i < 500; ++i)
+    {
+        for (const char* key : {"Tab", "1", "Return"})
+        {
+            KeyboardEventData data;
+            data.keyName = key;
+            data.keyCode = static_cast<uint32_t>(key[0]);
+            events.push_back(std::make_unique<Event>(
+                EventType::KeyPress, data, Event::timestampFromMs(timeMs)));
+            timeMs += 40;
+        }
+    }
+    return events;
+}
+
+} // namespace
+
+class LoopedEventStorageTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() /
+                      "mouserecorder_looped_test";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+        m_filename = (m_directory / "macro.mre").string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::filesystem::path m_directory;
+    std::string m_filename;
+    BinaryEventStorage m_storage;
+};
+
+TEST_F(LoopedEventStorageTest, StoresRepetitionsOnce)
+{
+    auto recording = RepeatedSegmentDetector::compress(makeEvents());
+    ASSERT_EQ(recording.events.size(), 8u);
+    StorageMetadata metadata;
+    metadata.description = "macro";
+    ASSERT_TRUE(m_storage.saveLoopedEvents(recording, m_filename, metadata))
+        << m_storage.getLastError();
+
+    std::string plain = (m_directory / "plain.mre").string();
+    ASSERT_TRUE(m_storage.saveEvents(makeEvents(), plain));
+    EXPECT_LT(std::filesystem::file_size(m_filename) * 20,
+              std::filesystem::file_size(plain));
+
+    LoopedRecording loaded;
+    StorageMetadata loadedMetadata;
+    ASSERT_TRUE(m_storage.loadLoopedEvents(m_filename, loaded, loadedMetadata))
+        << m_storage.getLastError();
+    EXPECT_EQ(loaded.events.size(), 8u);
+    EXPECT_EQ(loaded.index.getSegments(), recording.index.getSegments());
+    EXPECT_EQ(loadedMetadata.description, "macro");
+    EXPECT_TRUE(m_storage.validateFile(m_filename));
+    EXPECT_FALSE(m_storage.hasBlockIndex(m_filename));
+    EXPECT_TRUE(m_storage.isLoopedFile(m_filename));
+    EXPECT_FALSE(m_storage.isLoopedFile(plain));
+}
+
+TEST_F(LoopedEventStorageTest, LoadEventsExpands)
+{
+    auto events = makeEvents();
+    auto recording = RepeatedSegmentDetector::compress(makeEvents());
+    ASSERT_TRUE(m_storage.saveLoopedEvents(recording, m_filename));
+
+    EventVector loaded;
+    StorageMetadata metadata;
+    ASSERT_TRUE(m_storage.loadEvents(m_filename, loaded, metadata))
+        << m_storage.getLastError();
+    ASSERT_EQ(loaded.size(), events.size());
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        EXPECT_EQ(loaded[i]->toString(), events[i]->toString());
+        EXPECT_EQ(loaded[i]->getTimestampMs(), events[i]->getTimestampMs());
+    }
+
+    // Ranges are taken from the expanded events
+    ASSERT_TRUE(m_storage.loadEventsRange(
+        m_filename, EventRange::byIndex(1000, 10), loaded, metadata));
+    ASSERT_EQ(loaded.size(), 10u);
+    EXPECT_EQ(loaded[0]->getTimestampMs(), events[1000]->getTimestampMs());
+
+    // Also when compressed
+    m_storage.setCompressionLevel(6);
+    ASSERT_TRUE(m_storage.saveLoopedEvents(recording, m_filename));
+    ASSERT_TRUE(m_storage.loadEvents(m_filename, loaded, metadata));
+    EXPECT_EQ(loaded.size(), events.size());
+}
+
+TEST_F(LoopedEventStorageTest, FootersPrecedeTheLoopTable)
+{
+    auto events = makeEvents();
+    RecordingStatistics expected;
+    for (const auto& event : events)
+    {
+        expected.add(*event);
+    }
+
+    auto recording = RepeatedSegmentDetector::compress(makeEvents());
+    ASSERT_TRUE(m_storage.saveLoopedEvents(recording, m_filename));
+
+    // The statistics are those of the events as they are played
+    StorageMetadata metadata;
+    ASSERT_TRUE(m_storage.getFileMetadata(m_filename, metadata));
+    ASSERT_TRUE(metadata.statistics.has_value());
+    EXPECT_EQ(*metadata.statistics, expected);
+    LoopedRecording loaded;
+    ASSERT_TRUE(m_storage.loadLoopedEvents(m_filename, loaded, metadata));
+    ASSERT_TRUE(metadata.statistics.has_value());
+    EXPECT_EQ(metadata.statistics->getTotalEvents(), events.size());
+
+    // The block index checksums catch a changed event
+    {
+        std::vector<uint8_t> header;
+        m_storage.serializeHeader({}, 0, header);
+        std::fstream file(m_filename,
+                          std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(static_cast<std::streamoff>(header.size()) + 12);
+        char byte = 0;
+        file.read(&byte, 1);
+        byte = static_cast<char>(byte ^ 0x40);
+        file.seekp(static_cast<std::streamoff>(header.size()) + 12);
+        file.write(&byte, 1);
+    }
+    EXPECT_FALSE(m_storage.loadLoopedEvents(m_filename, loaded, metadata));
+    EXPECT_NE(m_storage.getLastError().find("checksum"), std::string::npos);
+}
+
+TEST_F(LoopedEventStorageTest, PlainFilesHaveNoSegments)
+{
+    ASSERT_TRUE(m_storage.saveEvents(makeEvents(), m_filename));
+    LoopedRecording loaded;
+    StorageMetadata metadata;
+    ASSERT_TRUE(m_storage.loadLoopedEvents(m_filename, loaded, metadata));
+    EXPECT_EQ(loaded.events.size(), 1505u);
+    EXPECT_TRUE(loaded.index.empty());
+}
+
+TEST_F(LoopedEventStorageTest, RejectsInvalidLoopTables)
+{
+    auto recording = RepeatedSegmentDetector::compress(makeEvents());
+    ASSERT_TRUE(m_storage.saveLoopedEvents(recording, m_filename));
+
+    // Point the segment past the stored events
+    auto size = std::filesystem::file_size(m_filename);
+    {
+        std::fstream file(m_filename,
+                          std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(size) - 8 - 32);
+        uint64_t start = 100;
+        file.write(reinterpret_cast<const char*>(&start), sizeof(start));
+    }
+
+    LoopedRecording loaded;
+    StorageMetadata metadata;
+    EXPECT_FALSE(m_storage.loadLoopedEvents(m_filename, loaded, metadata));
+    EXPECT_NE(m_storage.getLastError().find("loop table"), std::string::npos);
+    EventVector events;
+    EXPECT_FALSE(m_storage.loadEvents(m_filename, events, metadata));
+
+    // Segments must index the stored events
+    recording.index = SegmentIndex({{7, 3, 2, 0}});
+    EXPECT_FALSE(m_storage.saveLoopedEvents(recording, m_filename));
+}
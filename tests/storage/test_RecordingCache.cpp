@@ -0,0 +1,173 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/RecordingCache.hpp"
+#include "storage/RecordingIndex.hpp"
+#include "core/Event.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+std::shared_ptr<const EventVector> makeEvents(int count)
+{
+    auto events = std::make_shared<EventVector>();
+    for (int i = 0; i < count; ++i)
+    {
+        MouseEventData data;
+        data.position = {i, i};
+        events->push_back(std::make_unique<Event>(
+            EventType::MouseMove,
+            data,
+            Event::timestampFromMs(static_cast<uint64_t>(i) * 10)));
+    }
+    return events;
+}
+
+} // namespace
+
+class RecordingCacheTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() /
+                      "mouserecorder_cache_test";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    /**
+     * @brief Write a file of size bytes and return its stamp
+     */
+    FileStamp writeFile(const std::string& name, size_t size = 16)
+    {
+        std::string path = (m_directory / name).string();
+        std::ofstream(path) << std::string(size, 'x');
+        auto stamp = FileStamp::of(path);
+        EXPECT_TRUE(stamp.has_value());
+        return stamp.value_or(FileStamp{});
+    }
+
+    std::filesystem::path m_directory;
+};
+
+TEST_F(RecordingCacheTest, SharesInsertedRecordings)
+{
+    RecordingCache cache;
+    FileStamp stamp = writeFile("a.json");
+    EXPECT_EQ(cache.find(stamp), nullptr);
+
+    auto events = makeEvents(100);
+    StorageMetadata metadata;
+    metadata.description = "cached";
+    ASSERT_TRUE(cache.insert(stamp, events, metadata));
+
+    // The events are shared with the caller, not copied
+    auto cached = cache.find(stamp);
+    ASSERT_NE(cached, nullptr);
+    EXPECT_EQ(cached->events, events);
+    ASSERT_EQ(cached->events->size(), 100u);
+    EXPECT_EQ(cached->metadata.description, "cached");
+    EXPECT_EQ(cached->copyEvents()[42]->getMouseData()->position,
+              Point(42, 42));
+    EXPECT_EQ(cache.getMemoryUsage(), cached->memoryBytes);
+
+    // Relative and absolute paths name the same file
+    auto relative = FileStamp::of(
+        std::filesystem::relative(m_directory / "a.json").string());
+    ASSERT_TRUE(relative.has_value());
+    EXPECT_EQ(cache.find(*relative), cached);
+}
+
+TEST_F(RecordingCacheTest, ChangedFilesAreNotServed)
+{
+    RecordingCache cache;
+    FileStamp stamp = writeFile("a.json");
+    ASSERT_TRUE(cache.insert(stamp, makeEvents(10), {}));
+
+    FileStamp changed = writeFile("a.json", 32);
+    EXPECT_EQ(cache.find(changed), nullptr);
+    EXPECT_EQ(cache.getEntryCount(), 0u);
+    EXPECT_EQ(cache.getMemoryUsage(), 0u);
+}
+
+TEST_F(RecordingCacheTest, StampsOnlyReadableFiles)
+{
+    EXPECT_FALSE(
+        FileStamp::of((m_directory / "missing.json").string()).has_value());
+
+    // A directory has a modification time but no file size
+    EXPECT_FALSE(FileStamp::of(m_directory.string()).has_value());
+}
+
+TEST_F(RecordingCacheTest, EvictsLeastRecentlyUsed)
+{
+    auto events = makeEvents(1000);
+    size_t size = RecordingCache::estimateMemory(*events, {});
+    RecordingCache cache(size * 2 + size / 2);
+
+    FileStamp a = writeFile("a.json");
+    FileStamp b = writeFile("b.json");
+    FileStamp c = writeFile("c.json");
+    ASSERT_TRUE(cache.insert(a, events, {}));
+    ASSERT_TRUE(cache.insert(b, events, {}));
+
+    // a becomes the most recently used, so b goes for c
+    EXPECT_NE(cache.find(a), nullptr);
+    ASSERT_TRUE(cache.insert(c, events, {}));
+    EXPECT_NE(cache.find(a), nullptr);
+    EXPECT_EQ(cache.find(b), nullptr);
+    EXPECT_NE(cache.find(c), nullptr);
+    EXPECT_EQ(cache.getMemoryUsage(), size * 2);
+
+    // Shrinking the budget evicts until the rest fits
+    cache.setBudget(size);
+    EXPECT_EQ(cache.getEntryCount(), 1u);
+    EXPECT_NE(cache.find(c), nullptr);
+}
+
+TEST_F(RecordingCacheTest, SkipsRecordingsLargerThanTheBudget)
+{
+    auto events = makeEvents(1000);
+    RecordingCache cache(RecordingCache::estimateMemory(*events, {}) - 1);
+    FileStamp stamp = writeFile("a.json");
+    EXPECT_FALSE(cache.insert(stamp, events, {}));
+    EXPECT_EQ(cache.find(stamp), nullptr);
+
+    // A zero budget disables the cache
+    cache.setBudget(0);
+    EXPECT_FALSE(cache.insert(stamp, makeEvents(1), {}));
+}
+
+TEST_F(RecordingCacheTest, IndexScansUseTheCache)
+{
+    // Not a valid recording, so only the cache can make sense of it
+    FileStamp stamp = writeFile("a.json");
+    RecordingCache cache;
+    StorageMetadata metadata;
+    metadata.description = "from the cache";
+    ASSERT_TRUE(cache.insert(stamp, makeEvents(10), metadata));
+
+    RecordingIndexEntry entry;
+    ASSERT_TRUE(RecordingIndex::scanFile(stamp.path, entry, nullptr, &cache));
+    EXPECT_TRUE(entry.error.empty()) << entry.error;
+    EXPECT_EQ(entry.metadata.description, "from the cache");
+    EXPECT_EQ(entry.statistics.getTotalEvents(), 10u);
+
+    RecordingIndexEntry uncached;
+    ASSERT_TRUE(RecordingIndex::scanFile(stamp.path, uncached));
+    EXPECT_FALSE(uncached.error.empty());
+}
@@ -0,0 +1,245 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/RecordingEditor.hpp"
+#include "storage/BinaryEventStorage.hpp"
+#include "storage/EventStorageFactory.hpp"
+#include "core/Event.hpp"
+#include <filesystem>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+constexpr int EVENT_COUNT = 10000;
+constexpr uint64_t START_MS = 1000000;
+constexpr uint64_t INTERVAL_MS = 10;
+
+/**
+ * @brief Move to (i, 0) at START_MS + i * INTERVAL_MS, with a key press
+ * every hundredth event
+ */
+std::unique_ptr<Event> makeEvent(int i)
+{
+    auto timestamp = Event::timestampFromMs(
+        START_MS + static_cast<uint64_t>(i) * INTERVAL_MS);
+    if (i % 100 == 99)
+    {
+        KeyboardEventData data;
+        data.keyCode = static_cast<uint32_t>(i);
+        data.keyName = "Key" + std::to_string(i);
+        return std::make_unique<Event>(EventType::KeyPress, data, timestamp);
+    }
+    MouseEventData data;
+    data.position = {i, 0};
+    return std::make_unique<Event>(EventType::MouseMove, data, timestamp);
+}
+
+} // namespace
+
+class RecordingEditorTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() /
+                      "mouserecorder_editor_test";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+        m_input = path("recording.mre");
+        save(m_input, 0, EVENT_COUNT);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::string path(const std::string& name) const
+    {
+        return (m_directory / name).string();
+    }
+
+    static void save(const std::string& filename, int first, int count)
+    {
+        std::vector<std::unique_ptr<Event>> events;
+        for (int i = first; i < first + count; ++i)
+        {
+            events.push_back(makeEvent(i));
+        }
+        StorageMetadata metadata;
+        metadata.description = "editor test";
+        auto storage = EventStorageFactory::createStorageFromFilename(filename);
+        ASSERT_TRUE(storage->saveEvents(events, filename, metadata));
+    }
+
+    static std::vector<std::unique_ptr<Event>> load(
+        const std::string& filename, StorageMetadata& metadata)
+    {
+        std::vector<std::unique_ptr<Event>> events;
+        auto storage = EventStorageFactory::createStorageFromFilename(filename);
+        EXPECT_TRUE(storage->loadEvents(filename, events, metadata))
+            << storage->getLastError();
+        return events;
+    }
+
+    static void expectSame(const std::vector<std::unique_ptr<Event>>& actual,
+                           const std::vector<std::unique_ptr<Event>>& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i)
+        {
+            EXPECT_EQ(actual[i]->toString(), expected[i]->toString());
+        }
+    }
+
+    std::filesystem::path m_directory;
+    std::string m_input;
+};
+
+TEST_F(RecordingEditorTest, TrimMatchesRangeLoad)
+{
+    for (auto range : {EventRange::byTime(12345, 54321),
+                       EventRange::byIndex(4000, 4500)})
+    {
+        RecordingEditor editor;
+        std::string output = path("trimmed.mre");
+        ASSERT_TRUE(editor.trim(m_input, output, range))
+            << editor.getLastError();
+        EXPECT_EQ(editor.getEventsDecoded(), 0u);
+
+        BinaryEventStorage storage;
+        std::vector<std::unique_ptr<Event>> expected;
+        StorageMetadata metadata;
+        ASSERT_TRUE(
+            storage.loadEventsRange(m_input, range, expected, metadata));
+
+        auto events = load(output, metadata);
+        expectSame(events, expected);
+        EXPECT_EQ(editor.getEventsWritten(), expected.size());
+        EXPECT_EQ(metadata.totalEvents, expected.size());
+        EXPECT_EQ(metadata.description, "editor test");
+        EXPECT_EQ(metadata.totalDurationMs,
+                  expected.back()->getTimestampMs() -
+                      expected.front()->getTimestampMs());
+    }
+}
+
+TEST_F(RecordingEditorTest, TrimmedFileIsIndexed)
+{
+    RecordingEditor editor;
+    std::string output = path("trimmed.mre");
+    ASSERT_TRUE(editor.trim(m_input, output, EventRange::byIndex(1000, 9000)));
+
+    // The copied events get a block index of their own
+    BinaryEventStorage storage;
+    EXPECT_TRUE(storage.hasBlockIndex(output));
+    std::vector<std::unique_ptr<Event>> events;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage.loadEventsRange(
+        output, EventRange::byIndex(5000, 10), events, metadata));
+    ASSERT_EQ(events.size(), 10u);
+    EXPECT_EQ(events.front()->getMouseData()->position.x, 6000);
+}
+
+TEST_F(RecordingEditorTest, SplitPartsCoverTheRecording)
+{
+    RecordingEditor editor;
+    std::vector<std::string> outputs = {
+        path("part0.mre"), path("part1.mre"), path("part2.mre")};
+    ASSERT_TRUE(editor.split(m_input, {25000, 70000}, outputs))
+        << editor.getLastError();
+    EXPECT_EQ(editor.getEventsWritten(), static_cast<size_t>(EVENT_COUNT));
+
+    StorageMetadata metadata;
+    std::vector<std::unique_ptr<Event>> joined;
+    std::vector<size_t> sizes;
+    for (const auto& output : outputs)
+    {
+        auto events = load(output, metadata);
+        sizes.push_back(events.size());
+        for (auto& event : events)
+        {
+            joined.push_back(std::move(event));
+        }
+    }
+    EXPECT_EQ(sizes, (std::vector<size_t>{2500, 4500, 3000}));
+    expectSame(joined, load(m_input, metadata));
+}
+
+TEST_F(RecordingEditorTest, SplitRejectsMismatchedOutputs)
+{
+    RecordingEditor editor;
+    EXPECT_FALSE(editor.split(m_input, {1000}, {path("only.mre")}));
+    EXPECT_FALSE(editor.getLastError().empty());
+    EXPECT_FALSE(std::filesystem::exists(path("only.mre")));
+}
+
+TEST_F(RecordingEditorTest, ConcatenateRebasesTimestamps)
+{
+    std::string second = path("second.mre");
+    save(second, 0, 500);
+
+    RecordingEditor editor;
+    std::string output = path("joined.mre");
+    ASSERT_TRUE(editor.concatenate({m_input, second}, output, 2000))
+        << editor.getLastError();
+    EXPECT_EQ(editor.getEventsDecoded(), 0u);
+
+    StorageMetadata metadata;
+    auto events = load(output, metadata);
+    ASSERT_EQ(events.size(), static_cast<size_t>(EVENT_COUNT + 500));
+    EXPECT_EQ(metadata.totalEvents, events.size());
+
+    // The second recording starts 2 s after the end of the first
+    uint64_t end = events[EVENT_COUNT - 1]->getTimestampMs();
+    EXPECT_EQ(events[EVENT_COUNT]->getTimestampMs(), end + 2000);
+    EXPECT_EQ(events.back()->getTimestampMs(), end + 2000 + 499 * INTERVAL_MS);
+    EXPECT_EQ(events[EVENT_COUNT]->getMouseData()->position.x, 0);
+    EXPECT_EQ(events.back()->getKeyboardData()->keyName, "Key499");
+    EXPECT_EQ(metadata.totalDurationMs,
+              events.back()->getTimestampMs() - START_MS);
+}
+
+TEST_F(RecordingEditorTest, OtherFormatsAreStreamed)
+{
+    std::string json = path("second.json");
+    save(json, 0, 500);
+
+    RecordingEditor editor;
+    std::string output = path("joined.json");
+    ASSERT_TRUE(editor.concatenate({m_input, json}, output, 0))
+        << editor.getLastError();
+    EXPECT_EQ(editor.getEventsDecoded(),
+              static_cast<size_t>(EVENT_COUNT + 500));
+
+    StorageMetadata metadata;
+    auto events = load(output, metadata);
+    ASSERT_EQ(events.size(), static_cast<size_t>(EVENT_COUNT + 500));
+    EXPECT_EQ(events[EVENT_COUNT]->getTimestampMs(),
+              events[EVENT_COUNT - 1]->getTimestampMs());
+    EXPECT_EQ(metadata.description, "editor test");
+
+    // Trimming a JSON file goes through the range filter
+    ASSERT_TRUE(
+        editor.trim(json, path("trimmed.mre"), EventRange::byIndex(100, 50)));
+    EXPECT_EQ(editor.getEventsDecoded(), 50u);
+    events = load(path("trimmed.mre"), metadata);
+    ASSERT_EQ(events.size(), 50u);
+    EXPECT_EQ(events.front()->getMouseData()->position.x, 100);
+}
+
+TEST_F(RecordingEditorTest, MissingInputFails)
+{
+    RecordingEditor editor;
+    std::string output = path("joined.mre");
+    EXPECT_FALSE(
+        editor.concatenate({m_input, path("missing.mre")}, output, 0));
+    EXPECT_FALSE(editor.getLastError().empty());
+    EXPECT_FALSE(std::filesystem::exists(output));
+}
@@ -0,0 +1,275 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/EventStorageFactory.hpp"
+#include "storage/RecordingIndex.hpp"
+#include "storage/RecordingLibrary.hpp"
+#include "core/Event.hpp"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+std::vector<std::unique_ptr<Event>> createEvents(int count)
+{
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < count; ++i)
+    {
+        auto timestamp = Event::timestampFromMs(1000 + i * 10);
+        if (i % 10 == 9)
+        {
+            KeyboardEventData key;
+            key.keyCode = 65;
+            key.keyName = "A";
+            events.push_back(std::make_unique<Event>(
+                EventType::KeyPress, key, timestamp));
+            continue;
+        }
+
+        MouseEventData mouse;
+        mouse.position = {i, i};
+        events.push_back(
+            std::make_unique<Event>(EventType::MouseMove, mouse, timestamp));
+    }
+    return events;
+}
+
+} // namespace
+
+class RecordingIndexTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = fs::temp_directory_path() / "mouserecorder_index_test";
+        fs::remove_all(m_directory);
+        fs::create_directories(m_directory);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(m_directory);
+    }
+
+    std::string saveRecording(const std::string& name,
+                              int eventCount,
+                              const std::string& description = {},
+                              const fs::path& directory = {})
+    {
+        fs::path path = (directory.empty() ? m_directory : directory) / name;
+        auto storage = EventStorageFactory::createStorageFromFilename(path);
+        StorageMetadata metadata;
+        metadata.description = description;
+        EXPECT_TRUE(
+            storage->saveEvents(createEvents(eventCount), path, metadata))
+            << storage->getLastError();
+        return path.string();
+    }
+
+    fs::path m_directory;
+};
+
+TEST_F(RecordingIndexTest, IndexesRecordingsOfDirectory)
+{
+    saveRecording("first.json", 100, "Login flow");
+    saveRecording("second.mre", 20);
+    saveRecording("third.xml", 30);
+    std::ofstream(m_directory / "notes.txt") << "not a recording";
+
+    RecordingIndex index(m_directory.string());
+    ASSERT_TRUE(index.load());
+    ASSERT_TRUE(index.update()) << index.getLastError();
+    EXPECT_EQ(index.getScannedFiles(), 3u);
+    EXPECT_TRUE(index.isModified());
+
+    ASSERT_EQ(index.getEntries().size(), 3u);
+    const RecordingIndexEntry* entry = index.find("first.json");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_TRUE(entry->error.empty());
+    EXPECT_EQ(entry->fileSize, fs::file_size(m_directory / "first.json"));
+    EXPECT_EQ(entry->metadata.description, "Login flow");
+    EXPECT_EQ(entry->statistics.getTotalEvents(), 100u);
+    EXPECT_EQ(entry->statistics.getCount(EventType::MouseMove), 90u);
+    EXPECT_EQ(entry->statistics.getKeyboardEvents(), 10u);
+    EXPECT_EQ(entry->statistics.getDurationMs(), 990u);
+    EXPECT_EQ(index.find("notes.txt"), nullptr);
+}
+
+TEST_F(RecordingIndexTest, SavedIndexLoadsWithoutRecordings)
+{
+    saveRecording("a.json", 10, "alpha");
+    saveRecording("b.mre", 20, "beta");
+
+    RecordingIndex index(m_directory.string());
+    ASSERT_TRUE(index.update());
+    ASSERT_TRUE(index.save()) << index.getLastError();
+    EXPECT_FALSE(index.isModified());
+    EXPECT_TRUE(fs::exists(index.getIndexPath()));
+
+    // The index alone describes the recordings
+    fs::remove(m_directory / "a.json");
+    fs::remove(m_directory / "b.mre");
+
+    RecordingIndex loaded(m_directory.string());
+    ASSERT_TRUE(loaded.load()) << loaded.getLastError();
+    ASSERT_EQ(loaded.getEntries().size(), 2u);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const auto& expected = index.getEntries()[i];
+        const auto& actual = loaded.getEntries()[i];
+        EXPECT_EQ(actual.fileName, expected.fileName);
+        EXPECT_EQ(actual.fileSize, expected.fileSize);
+        EXPECT_EQ(actual.modifiedTime, expected.modifiedTime);
+        EXPECT_EQ(actual.metadata.description, expected.metadata.description);
+        EXPECT_EQ(actual.metadata.totalEvents, expected.metadata.totalEvents);
+        EXPECT_EQ(actual.statistics, expected.statistics);
+    }
+}
+
+TEST_F(RecordingIndexTest, UpdateOnlyScansChangedFiles)
+{
+    saveRecording("kept.json", 10);
+    saveRecording("changed.json", 10);
+    saveRecording("removed.json", 10);
+
+    RecordingIndex index(m_directory.string());
+    ASSERT_TRUE(index.update());
+    ASSERT_TRUE(index.save());
+
+    ASSERT_TRUE(index.update());
+    EXPECT_EQ(index.getScannedFiles(), 0u);
+    EXPECT_FALSE(index.isModified());
+
+    saveRecording("changed.json", 25);
+    fs::remove(m_directory / "removed.json");
+    saveRecording("added.mre", 5);
+
+    ASSERT_TRUE(index.update());
+    EXPECT_EQ(index.getScannedFiles(), 2u);
+    EXPECT_TRUE(index.isModified());
+    ASSERT_EQ(index.getEntries().size(), 3u);
+    EXPECT_EQ(index.find("removed.json"), nullptr);
+    ASSERT_NE(index.find("changed.json"), nullptr);
+    EXPECT_EQ(index.find("changed.json")->statistics.getTotalEvents(), 25u);
+    ASSERT_NE(index.find("added.mre"), nullptr);
+}
+
+TEST_F(RecordingIndexTest, UnreadableRecordingIsIndexedWithError)
+{
+    std::ofstream(m_directory / "broken.json") << "{ not json";
+
+    RecordingIndex index(m_directory.string());
+    ASSERT_TRUE(index.update());
+    const RecordingIndexEntry* entry = index.find("broken.json");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_FALSE(entry->error.empty());
+    EXPECT_EQ(entry->statistics.getTotalEvents(), 0u);
+
+    // Not retried until the file changes
+    ASSERT_TRUE(index.update());
+    EXPECT_EQ(index.getScannedFiles(), 0u);
+}
+
+TEST_F(RecordingIndexTest, CorruptIndexFailsToLoad)
+{
+    std::ofstream(m_directory / RecordingIndex::INDEX_FILE_NAME,
+                  std::ios::binary)
+        << "MRLI and then nothing useful";
+
+    RecordingIndex index(m_directory.string());
+    EXPECT_FALSE(index.load());
+    EXPECT_FALSE(index.getLastError().empty());
+    EXPECT_TRUE(index.getEntries().empty());
+}
+
+TEST_F(RecordingIndexTest, SearchIgnoresCase)
+{
+    saveRecording("checkout.json", 10, "Payment form");
+    saveRecording("login.mre", 10, "Sign in");
+
+    RecordingIndex index(m_directory.string());
+    ASSERT_TRUE(index.update());
+
+    auto byDescription = index.search("PAYMENT");
+    ASSERT_EQ(byDescription.size(), 1u);
+    EXPECT_EQ(byDescription[0]->fileName, "checkout.json");
+
+    auto byName = index.search("Login");
+    ASSERT_EQ(byName.size(), 1u);
+    EXPECT_EQ(byName[0]->fileName, "login.mre");
+
+    EXPECT_EQ(index.search("").size(), 2u);
+    EXPECT_TRUE(index.search("missing").empty());
+}
+
+TEST_F(RecordingIndexTest, LibraryScansSubdirectoriesInBackground)
+{
+    fs::create_directories(m_directory / "team" / "alice");
+    saveRecording("root.json", 10);
+    saveRecording("shared.mre", 10, "Shared demo", m_directory / "team");
+    saveRecording("private.json", 10, {}, m_directory / "team" / "alice");
+
+    std::atomic<int> updates{0};
+    {
+        RecordingLibrary library(m_directory.string());
+        library.setUpdateCallback([&updates]() { ++updates; });
+        ASSERT_TRUE(library.startScan());
+        library.waitForScan();
+
+        EXPECT_FALSE(library.isScanning());
+        EXPECT_GT(updates.load(), 0);
+        EXPECT_EQ(library.getScannedFiles(), 3u);
+        EXPECT_EQ(library.getRecordingCount(), 3u);
+
+        auto found = library.search("shared");
+        ASSERT_EQ(found.size(), 1u);
+        EXPECT_EQ(fs::path(found[0].path),
+                  m_directory / "team" / "shared.mre");
+        EXPECT_EQ(found[0].info.statistics.getTotalEvents(), 10u);
+    }
+
+    // Each directory keeps its own index
+    EXPECT_TRUE(fs::exists(m_directory / RecordingIndex::INDEX_FILE_NAME));
+    EXPECT_TRUE(
+        fs::exists(m_directory / "team" / "alice" /
+                   RecordingIndex::INDEX_FILE_NAME));
+
+    // A second library starts from the saved indexes
+    RecordingLibrary library(m_directory.string());
+    ASSERT_TRUE(library.startScan());
+    library.waitForScan();
+    EXPECT_EQ(library.getScannedFiles(), 0u);
+    EXPECT_EQ(library.getEntries().size(), 3u);
+}
+
+TEST_F(RecordingIndexTest, LibraryScanCanBeStopped)
+{
+    for (int i = 0; i < 20; ++i)
+    {
+        saveRecording("recording" + std::to_string(i) + ".json", 2000);
+    }
+
+    RecordingLibrary library(m_directory.string(), false);
+    ASSERT_TRUE(library.startScan());
+    library.stopScan();
+    EXPECT_FALSE(library.isScanning());
+    EXPECT_LE(library.getScannedFiles(), 20u);
+
+    // Continues with the recordings that were not scanned
+    size_t scannedBefore = library.getScannedFiles();
+    ASSERT_TRUE(library.startScan());
+    library.waitForScan();
+    EXPECT_EQ(scannedBefore + library.getScannedFiles(), 20u);
+    EXPECT_EQ(library.getRecordingCount(), 20u);
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2025 JackLee
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <gtest/gtest.h>
+#include "storage/EventStorageFactory.hpp"
+#include "storage/StorageFileIO.hpp"
+#include "core/Event.hpp"
+#include "core/StorageTask.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace MouseRecorder::Storage;
+using namespace MouseRecorder::Core;
+
+namespace
+{
+
+/**
+ * @brief Asks to stop after a number of progress reports
+ */
+class StopAfter : public StorageProgress
+{
+  public:
+    explicit StopAfter(int reports) : m_reports(reports)
+    {
+    }
+
+    bool update(std::uint64_t, std::uint64_t) override
+    {
+        return m_reports-- > 0;
+    }
+
+  private:
+    int m_reports;
+};
+
+std::string readFile(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()};
+}
+
+} // namespace
+
+class StorageFileIOTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_directory = std::filesystem::temp_directory_path() /
+                      "mouserecorder_file_io_test";
+        std::filesystem::remove_all(m_directory);
+        std::filesystem::create_directories(m_directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(m_directory);
+    }
+
+    std::string path(const std::string& name) const
+    {
+        return (m_directory / name).string();
+    }
+
+    size_t fileCount() const
+    {
+        return static_cast<size_t>(
+            std::distance(std::filesystem::directory_iterator(m_directory),
+                          std::filesystem::directory_iterator()));
+    }
+
+    std::filesystem::path m_directory;
+};
+
+TEST_F(StorageFileIOTest, WriteReplacesFile)
+{
+    const std::string filename = path("data.bin");
+    std::string error;
+    ASSERT_TRUE(writeFileWithProgress(filename, "old", nullptr, true, error))
+        << error;
+    ASSERT_TRUE(
+        writeFileWithProgress(filename, "new content", nullptr, false, error))
+        << error;
+
+    EXPECT_EQ(readFile(filename), "new content");
+    EXPECT_EQ(fileCount(), 1u);
+}
+
+TEST_F(StorageFileIOTest, CancelledWriteKeepsOldFile)
+{
+    const std::string filename = path("data.bin");
+    std::string error;
+    ASSERT_TRUE(writeFileWithProgress(filename, "old", nullptr, true, error));
+
+    // Several chunks, cancelled after the first
+    std::string data(3 * 1024 * 1024, 'x');
+    StopAfter progress(1);
+    EXPECT_FALSE(writeFileWithProgress(filename, data, &progress, true, error));
+    EXPECT_EQ(error, StorageProgress::CANCELLED_ERROR);
+
+    EXPECT_EQ(readFile(filename), "old");
+    EXPECT_EQ(fileCount(), 1u);
+}
+
+TEST_F(StorageFileIOTest, TempPathsAreUniqueAndNextToFile)
+{
+    const std::string filename = path("data.bin");
+    const std::string first = makeTempPath(filename);
+    const std::string second = makeTempPath(filename);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(std::filesystem::path(first).parent_path(), m_directory);
+    EXPECT_TRUE(first.starts_with(filename));
+}
+
+TEST_F(StorageFileIOTest, FailedReplaceRemovesTempFile)
+{
+    // A directory is in the way of the file
+    const std::string filename = path("blocked");
+    std::filesystem::create_directories(std::filesystem::path(filename) / "x");
+
+    std::string error;
+    EXPECT_FALSE(writeFileWithProgress(filename, "data", nullptr, true, error));
+    EXPECT_FALSE(error.empty());
+    EXPECT_EQ(fileCount(), 1u);
+}
+
+TEST_F(StorageFileIOTest, ReplaceKeepsPermissions)
+{
+#ifdef _WIN32
+    GTEST_SKIP() << "Windows files only have a read-only flag";
+#endif
+    const std::string filename = path("data.bin");
+    std::string error;
+    ASSERT_TRUE(writeFileWithProgress(filename, "old", nullptr, false, error));
+    namespace fs = std::filesystem;
+    const fs::perms perms = fs::perms::owner_read | fs::perms::owner_write;
+    fs::permissions(filename, perms);
+
+    ASSERT_TRUE(writeFileWithProgress(filename, "new", nullptr, false, error))
+        << error;
+    EXPECT_EQ(readFile(filename), "new");
+    EXPECT_EQ(fs::status(filename).permissions() & fs::perms::all, perms);
+}
+
+TEST_F(StorageFileIOTest, ReplaceFollowsSymlinks)
+{
+    namespace fs = std::filesystem;
+    const std::string target = path("target.bin");
+    const std::string link = path("link.bin");
+    std::string error;
+    ASSERT_TRUE(writeFileWithProgress(target, "old", nullptr, false, error));
+    std::error_code linkError;
+    fs::create_symlink(target, link, linkError);
+    if (linkError)
+    {
+        GTEST_SKIP() << "Symlinks are not supported: " << linkError.message();
+    }
+
+    ASSERT_TRUE(writeFileWithProgress(link, "new", nullptr, true, error))
+        << error;
+    EXPECT_TRUE(fs::is_symlink(link));
+    EXPECT_EQ(readFile(target), "new");
+    EXPECT_EQ(fileCount(), 2u);
+}
+
+class AtomicSaveTest : public StorageFileIOTest,
+                       public ::testing::WithParamInterface<StorageFormat>
+{
+};
+
+TEST_P(AtomicSaveTest, CancelledSaveKeepsPreviousRecording)
+{
+    auto storage = EventStorageFactory::createStorage(GetParam());
+    const std::string filename =
+        path("recording" + storage->getFileExtension());
+
+    std::vector<std::unique_ptr<Event>> events;
+    events.push_back(EventFactory::createMouseMoveEvent({1, 2}));
+    ASSERT_TRUE(storage->saveEvents(events, filename))
+        << storage->getLastError();
+
+    std::vector<std::unique_ptr<Event>> more;
+    for (int i = 0; i < 100000; ++i)
+    {
+        more.push_back(EventFactory::createMouseMoveEvent({i, i}));
+    }
+    StopAfter progress(1);
+    storage->setProgress(&progress);
+    storage->setSyncOnSave(false);
+    EXPECT_FALSE(storage->saveEvents(more, filename));
+    storage->setProgress(nullptr);
+
+    std::vector<std::unique_ptr<Event>> loaded;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage->loadEvents(filename, loaded, metadata))
+        << storage->getLastError();
+    ASSERT_EQ(loaded.size(), 1u);
+    EXPECT_EQ(loaded[0]->getMouseData()->position, (Point{1, 2}));
+    EXPECT_EQ(fileCount(), 1u);
+}
+
+TEST_P(AtomicSaveTest, SaveWithoutSyncReplacesRecording)
+{
+    auto storage = EventStorageFactory::createStorage(GetParam());
+    storage->setSyncOnSave(false);
+    const std::string filename =
+        path("recording" + storage->getFileExtension());
+
+    for (int count : {3, 7})
+    {
+        std::vector<std::unique_ptr<Event>> events;
+        for (int i = 0; i < count; ++i)
+        {
+            events.push_back(EventFactory::createMouseMoveEvent({i, 0}));
+        }
+        ASSERT_TRUE(storage->saveEvents(events, filename))
+            << storage->getLastError();
+    }
+
+    std::vector<std::unique_ptr<Event>> loaded;
+    StorageMetadata metadata;
+    ASSERT_TRUE(storage->loadEvents(filename, loaded, metadata));
+    EXPECT_EQ(loaded.size(), 7u);
+    EXPECT_EQ(fileCount(), 1u);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllFormats,
+                         AtomicSaveTest,
+                         ::testing::Values(StorageFormat::Json,
+                                           StorageFormat::Xml,
+                                           StorageFormat::Binary));
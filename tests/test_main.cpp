@@ -5,7 +5,7 @@
 
 #include <gtest/gtest.h>
 #include <QApplication>
-#include <spdlog/spdlog.h>
+#include "core/SpdlogConfig.hpp"
 
 int main(int argc, char** argv)
 {